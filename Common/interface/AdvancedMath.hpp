@@ -28,11 +28,15 @@
 #pragma once
 
 #include <float.h>
+#include <algorithm>
+#include <deque>
+#include <limits>
 #include <vector>
 #include <type_traits>
 
 #include "../../Platforms/interface/PlatformDefinitions.h"
 #include "../../Primitives/interface/FlagEnum.h"
+#include "../../Platforms/interface/PlatformMisc.hpp"
 
 #include "BasicMath.hpp"
 
@@ -595,6 +599,453 @@ inline BoxVisibility GetBoxVisibility(const ViewFrustumExt&      ViewFrustumExt,
     return BoxVisibility::Intersecting;
 }
 
+/// Structure-of-arrays representation of axis-aligned bounding boxes
+/// that is used by the batch culling functions.
+///
+/// Min[c][i] and Max[c][i] are the c-th coordinates of the minimum and
+/// maximum corners of the i-th box.
+struct BoundBoxesSoA
+{
+    const float* Min[3] = {};
+    const float* Max[3] = {};
+
+    /// The number of boxes.
+    size_t Count = 0;
+
+    /// Returns the range of NumBoxes boxes starting with FirstBox.
+    BoundBoxesSoA GetRange(size_t FirstBox, size_t NumBoxes) const
+    {
+        VERIFY_EXPR(FirstBox + NumBoxes <= Count);
+        BoundBoxesSoA Range;
+        for (int c = 0; c < 3; ++c)
+        {
+            Range.Min[c] = Min[c] + FirstBox;
+            Range.Max[c] = Max[c] + FirstBox;
+        }
+        Range.Count = NumBoxes;
+        return Range;
+    }
+};
+
+/// Structure-of-arrays representation of oriented bounding boxes
+/// that is used by the batch culling functions.
+///
+/// Axes[a][c][i] is the c-th component of the a-th normalized axis of the i-th box.
+struct OrientedBoundingBoxesSoA
+{
+    const float* Center[3]      = {};
+    const float* Axes[3][3]     = {};
+    const float* HalfExtents[3] = {};
+
+    /// The number of boxes.
+    size_t Count = 0;
+
+    /// Returns the range of NumBoxes boxes starting with FirstBox.
+    OrientedBoundingBoxesSoA GetRange(size_t FirstBox, size_t NumBoxes) const
+    {
+        VERIFY_EXPR(FirstBox + NumBoxes <= Count);
+        OrientedBoundingBoxesSoA Range;
+        for (int a = 0; a < 3; ++a)
+        {
+            Range.Center[a]      = Center[a] + FirstBox;
+            Range.HalfExtents[a] = HalfExtents[a] + FirstBox;
+            for (int c = 0; c < 3; ++c)
+                Range.Axes[a][c] = Axes[a][c] + FirstBox;
+        }
+        Range.Count = NumBoxes;
+        return Range;
+    }
+};
+
+namespace BatchCullingInternal
+{
+
+// Active frustum planes prepared for testing multiple boxes
+struct CullingPlanes
+{
+    explicit CullingPlanes(const ViewFrustum& Frustum, FRUSTUM_PLANE_FLAGS PlaneFlags)
+    {
+        for (Uint32 plane_idx = 0; plane_idx < ViewFrustum::NUM_PLANES; ++plane_idx)
+        {
+            if ((PlaneFlags & (1 << plane_idx)) == 0)
+                continue;
+
+            const Plane3D& Plane = Frustum.GetPlane(static_cast<ViewFrustum::PLANE_IDX>(plane_idx));
+
+            Normals[NumPlanes]   = Plane.Normal;
+            Distances[NumPlanes] = Plane.Distance;
+            ++NumPlanes;
+        }
+    }
+
+    float3 Normals[ViewFrustum::NUM_PLANES];
+    float  Distances[ViewFrustum::NUM_PLANES] = {};
+    Uint32 NumPlanes                          = 0;
+};
+
+// Returns the visibility mask of up to 32 boxes starting with FirstBox.
+// Bit i is set if box FirstBox + i is not invisible.
+inline Uint32 GetBoxesVisibilityMaskWord(const CullingPlanes& Planes,
+                                         const float3*        pFrustumBounds, // Frustum AABB or null
+                                         const BoundBoxesSoA& Boxes,
+                                         size_t               FirstBox,
+                                         size_t               NumBoxes)
+{
+    VERIFY_EXPR(NumBoxes <= 32);
+
+    Uint32 Mask = 0;
+    size_t i    = 0;
+
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    for (; i < NumBoxes; i += 4)
+    {
+        __m128 Min[3], Max[3];
+        for (int c = 0; c < 3; ++c)
+        {
+            if (i + 4 <= NumBoxes)
+            {
+                Min[c] = _mm_loadu_ps(Boxes.Min[c] + FirstBox + i);
+                Max[c] = _mm_loadu_ps(Boxes.Max[c] + FirstBox + i);
+            }
+            else
+            {
+                // Pad the last group of boxes with empty boxes at the origin
+                float PadMin[4] = {}, PadMax[4] = {};
+                for (size_t j = i; j < NumBoxes; ++j)
+                {
+                    PadMin[j - i] = Boxes.Min[c][FirstBox + j];
+                    PadMax[j - i] = Boxes.Max[c][FirstBox + j];
+                }
+                Min[c] = _mm_loadu_ps(PadMin);
+                Max[c] = _mm_loadu_ps(PadMax);
+            }
+        }
+
+        const __m128 Half = _mm_set1_ps(0.5f);
+
+        const __m128 SumX  = _mm_add_ps(Max[0], Min[0]);
+        const __m128 SumY  = _mm_add_ps(Max[1], Min[1]);
+        const __m128 SumZ  = _mm_add_ps(Max[2], Min[2]);
+        const __m128 SizeX = _mm_sub_ps(Max[0], Min[0]);
+        const __m128 SizeY = _mm_sub_ps(Max[1], Min[1]);
+        const __m128 SizeZ = _mm_sub_ps(Max[2], Min[2]);
+
+        __m128 Outside   = _mm_setzero_ps();
+        __m128 AllInside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+        for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+        {
+            const float3& N = Planes.Normals[p];
+
+            // Use the same order of operations as GetBoxVisibilityAgainstPlane()
+            const __m128 Dist = _mm_add_ps(_mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(SumX, _mm_set1_ps(N.x)),
+                                                                            _mm_mul_ps(SumY, _mm_set1_ps(N.y))),
+                                                                 _mm_mul_ps(SumZ, _mm_set1_ps(N.z))),
+                                                      Half),
+                                           _mm_set1_ps(Planes.Distances[p]));
+
+            const __m128 ProjHalfLen = _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(SizeX, _mm_set1_ps(std::abs(N.x))),
+                                                                        _mm_mul_ps(SizeY, _mm_set1_ps(std::abs(N.y)))),
+                                                             _mm_mul_ps(SizeZ, _mm_set1_ps(std::abs(N.z)))),
+                                                  Half);
+
+            const __m128 NegProjHalfLen = _mm_sub_ps(_mm_setzero_ps(), ProjHalfLen);
+
+            Outside   = _mm_or_ps(Outside, _mm_cmplt_ps(Dist, NegProjHalfLen));
+            AllInside = _mm_and_ps(AllInside, _mm_cmpgt_ps(Dist, ProjHalfLen));
+        }
+
+        if (pFrustumBounds != nullptr)
+        {
+            // The box is invisible if it is intersecting the frustum planes, but
+            // all frustum corners are outside of one of the box planes
+            const float3& FrMin = pFrustumBounds[0];
+            const float3& FrMax = pFrustumBounds[1];
+
+            __m128 Separated = _mm_cmple_ps(_mm_set1_ps(FrMax.x), Min[0]);
+            Separated        = _mm_or_ps(Separated, _mm_cmple_ps(_mm_set1_ps(FrMax.y), Min[1]));
+            Separated        = _mm_or_ps(Separated, _mm_cmple_ps(_mm_set1_ps(FrMax.z), Min[2]));
+            Separated        = _mm_or_ps(Separated, _mm_cmpge_ps(_mm_set1_ps(FrMin.x), Max[0]));
+            Separated        = _mm_or_ps(Separated, _mm_cmpge_ps(_mm_set1_ps(FrMin.y), Max[1]));
+            Separated        = _mm_or_ps(Separated, _mm_cmpge_ps(_mm_set1_ps(FrMin.z), Max[2]));
+
+            Outside = _mm_or_ps(Outside, _mm_andnot_ps(AllInside, Separated));
+        }
+
+        Mask |= static_cast<Uint32>(~_mm_movemask_ps(Outside) & 0x0F) << i;
+    }
+    // Clear the bits of the padding boxes
+    Mask &= NumBoxes < 32 ? (1u << NumBoxes) - 1u : ~0u;
+#else
+    for (; i < NumBoxes; ++i)
+    {
+        const size_t Idx = FirstBox + i;
+        const float3 Min{Boxes.Min[0][Idx], Boxes.Min[1][Idx], Boxes.Min[2][Idx]};
+        const float3 Max{Boxes.Max[0][Idx], Boxes.Max[1][Idx], Boxes.Max[2][Idx]};
+
+        int  NumPlanesInside = 0;
+        bool Outside         = false;
+        for (Uint32 p = 0; p < Planes.NumPlanes && !Outside; ++p)
+        {
+            const auto Visibility = GetBoxVisibilityAgainstPlane(Plane3D{Planes.Normals[p], Planes.Distances[p]}, BoundBox{Min, Max});
+            if (Visibility == BoxVisibility::Invisible)
+                Outside = true;
+            else if (Visibility == BoxVisibility::FullyVisible)
+                ++NumPlanesInside;
+        }
+
+        if (!Outside && pFrustumBounds != nullptr && NumPlanesInside != static_cast<int>(Planes.NumPlanes))
+        {
+            const float3& FrMin = pFrustumBounds[0];
+            const float3& FrMax = pFrustumBounds[1];
+            Outside =
+                FrMax.x <= Min.x || FrMax.y <= Min.y || FrMax.z <= Min.z ||
+                FrMin.x >= Max.x || FrMin.y >= Max.y || FrMin.z >= Max.z;
+        }
+
+        if (!Outside)
+            Mask |= 1u << i;
+    }
+#endif
+
+    return Mask;
+}
+
+// Returns the visibility mask of up to 32 oriented boxes starting with FirstBox.
+inline Uint32 GetBoxesVisibilityMaskWord(const CullingPlanes&            Planes,
+                                         const OrientedBoundingBoxesSoA& Boxes,
+                                         size_t                          FirstBox,
+                                         size_t                          NumBoxes)
+{
+    VERIFY_EXPR(NumBoxes <= 32);
+
+    Uint32 Mask = 0;
+    size_t i    = 0;
+
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    auto Load = [&](const float* pData) {
+        if (i + 4 <= NumBoxes)
+            return _mm_loadu_ps(pData + FirstBox + i);
+
+        float Pad[4] = {};
+        for (size_t j = i; j < NumBoxes; ++j)
+            Pad[j - i] = pData[FirstBox + j];
+        return _mm_loadu_ps(Pad);
+    };
+
+    const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+    for (; i < NumBoxes; i += 4)
+    {
+        const __m128 Center[3] = {Load(Boxes.Center[0]), Load(Boxes.Center[1]), Load(Boxes.Center[2])};
+
+        __m128 Axes[3][3];
+        __m128 HalfExtents[3];
+        for (int a = 0; a < 3; ++a)
+        {
+            for (int c = 0; c < 3; ++c)
+                Axes[a][c] = Load(Boxes.Axes[a][c]);
+            HalfExtents[a] = Load(Boxes.HalfExtents[a]);
+        }
+
+        __m128 Outside = _mm_setzero_ps();
+        for (Uint32 p = 0; p < Planes.NumPlanes; ++p)
+        {
+            const __m128 Nx = _mm_set1_ps(Planes.Normals[p].x);
+            const __m128 Ny = _mm_set1_ps(Planes.Normals[p].y);
+            const __m128 Nz = _mm_set1_ps(Planes.Normals[p].z);
+
+            // Use the same order of operations as GetBoxVisibilityAgainstPlane()
+            auto Dot = [&](const __m128 V[3]) {
+                return _mm_add_ps(_mm_add_ps(_mm_mul_ps(V[0], Nx), _mm_mul_ps(V[1], Ny)), _mm_mul_ps(V[2], Nz));
+            };
+
+            const __m128 Dist = _mm_add_ps(Dot(Center), _mm_set1_ps(Planes.Distances[p]));
+
+            __m128 ProjHalfExtents = _mm_mul_ps(_mm_and_ps(Dot(Axes[0]), AbsMask), HalfExtents[0]);
+            ProjHalfExtents        = _mm_add_ps(ProjHalfExtents, _mm_mul_ps(_mm_and_ps(Dot(Axes[1]), AbsMask), HalfExtents[1]));
+            ProjHalfExtents        = _mm_add_ps(ProjHalfExtents, _mm_mul_ps(_mm_and_ps(Dot(Axes[2]), AbsMask), HalfExtents[2]));
+
+            Outside = _mm_or_ps(Outside, _mm_cmplt_ps(Dist, _mm_sub_ps(_mm_setzero_ps(), ProjHalfExtents)));
+        }
+
+        Mask |= static_cast<Uint32>(~_mm_movemask_ps(Outside) & 0x0F) << i;
+    }
+    // Clear the bits of the padding boxes
+    Mask &= NumBoxes < 32 ? (1u << NumBoxes) - 1u : ~0u;
+#else
+    for (; i < NumBoxes; ++i)
+    {
+        const size_t Idx = FirstBox + i;
+
+        OrientedBoundingBox Box;
+        Box.Center = float3{Boxes.Center[0][Idx], Boxes.Center[1][Idx], Boxes.Center[2][Idx]};
+        for (int a = 0; a < 3; ++a)
+        {
+            Box.Axes[a]        = float3{Boxes.Axes[a][0][Idx], Boxes.Axes[a][1][Idx], Boxes.Axes[a][2][Idx]};
+            Box.HalfExtents[a] = Boxes.HalfExtents[a][Idx];
+        }
+
+        bool Outside = false;
+        for (Uint32 p = 0; p < Planes.NumPlanes && !Outside; ++p)
+            Outside = GetBoxVisibilityAgainstPlane(Plane3D{Planes.Normals[p], Planes.Distances[p]}, Box) == BoxVisibility::Invisible;
+
+        if (!Outside)
+            Mask |= 1u << i;
+    }
+#endif
+
+    return Mask;
+}
+
+template <typename GetMaskWordType>
+void GetBoxesVisibilityMask(size_t NumBoxes, Uint32* pVisibilityMask, GetMaskWordType&& GetMaskWord)
+{
+    VERIFY_EXPR(pVisibilityMask != nullptr || NumBoxes == 0);
+    for (size_t FirstBox = 0; FirstBox < NumBoxes; FirstBox += 32)
+        pVisibilityMask[FirstBox / 32] = GetMaskWord(FirstBox, (std::min)(NumBoxes - FirstBox, size_t{32}));
+}
+
+template <typename GetMaskWordType>
+size_t GetVisibleBoxIndices(size_t NumBoxes, Uint32* pVisibleIndices, GetMaskWordType&& GetMaskWord)
+{
+    VERIFY_EXPR(pVisibleIndices != nullptr || NumBoxes == 0);
+    size_t NumVisible = 0;
+    for (size_t FirstBox = 0; FirstBox < NumBoxes; FirstBox += 32)
+    {
+        for (Uint32 Mask = GetMaskWord(FirstBox, (std::min)(NumBoxes - FirstBox, size_t{32})); Mask != 0; Mask &= Mask - 1)
+            pVisibleIndices[NumVisible++] = static_cast<Uint32>(FirstBox + PlatformMisc::GetLSB(Mask));
+    }
+    return NumVisible;
+}
+
+inline void GetFrustumBounds(const ViewFrustumExt& FrustumExt, float3 Bounds[2])
+{
+    Bounds[0] = Bounds[1] = FrustumExt.FrustumCorners[0];
+    for (size_t i = 1; i < _countof(FrustumExt.FrustumCorners); ++i)
+    {
+        Bounds[0] = (std::min)(Bounds[0], FrustumExt.FrustumCorners[i]);
+        Bounds[1] = (std::max)(Bounds[1], FrustumExt.FrustumCorners[i]);
+    }
+}
+
+} // namespace BatchCullingInternal
+
+/// Tests multiple axis-aligned bounding boxes against the view frustum.
+
+/// \param [in]  Frustum         - View frustum.
+/// \param [in]  Boxes           - Bounding boxes to test.
+/// \param [out] pVisibilityMask - Visibility mask. Bit (i % 32) of the element (i / 32) is set if
+///                                the i-th box is not invisible. The array must contain at least
+///                                (Boxes.Count + 31) / 32 elements. Unused bits of the last element
+///                                are set to zero.
+/// \param [in]  PlaneFlags      - Planes to test the boxes against.
+///
+/// \remarks    The result is the same as calling GetBoxVisibility() for every box and comparing
+///             the result with BoxVisibility::Invisible.
+///             When the target supports SIMD, four boxes are tested at a time.
+inline void GetBoxesVisibilityMask(const ViewFrustum&   Frustum,
+                                   const BoundBoxesSoA& Boxes,
+                                   Uint32*              pVisibilityMask,
+                                   FRUSTUM_PLANE_FLAGS  PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    const BatchCullingInternal::CullingPlanes Planes{Frustum, PlaneFlags};
+    BatchCullingInternal::GetBoxesVisibilityMask(Boxes.Count, pVisibilityMask, [&](size_t FirstBox, size_t NumBoxes) {
+        return BatchCullingInternal::GetBoxesVisibilityMaskWord(Planes, nullptr, Boxes, FirstBox, NumBoxes);
+    });
+}
+
+/// Tests multiple axis-aligned bounding boxes against the view frustum.
+
+/// This overload additionally tests the frustum corners against the box planes
+/// in the same way as GetBoxVisibility(const ViewFrustumExt&, const BoundBox&, FRUSTUM_PLANE_FLAGS) does.
+inline void GetBoxesVisibilityMask(const ViewFrustumExt& FrustumExt,
+                                   const BoundBoxesSoA&  Boxes,
+                                   Uint32*               pVisibilityMask,
+                                   FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    const BatchCullingInternal::CullingPlanes Planes{FrustumExt, PlaneFlags};
+
+    float3       FrustumBounds[2];
+    const bool   TestCorners    = (PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) == FRUSTUM_PLANE_FLAG_FULL_FRUSTUM;
+    const float3* pFrustumBounds = TestCorners ? FrustumBounds : nullptr;
+    if (TestCorners)
+        BatchCullingInternal::GetFrustumBounds(FrustumExt, FrustumBounds);
+
+    BatchCullingInternal::GetBoxesVisibilityMask(Boxes.Count, pVisibilityMask, [&](size_t FirstBox, size_t NumBoxes) {
+        return BatchCullingInternal::GetBoxesVisibilityMaskWord(Planes, pFrustumBounds, Boxes, FirstBox, NumBoxes);
+    });
+}
+
+/// Tests multiple oriented bounding boxes against the view frustum planes.
+
+/// \remarks    The result is the same as calling GetBoxVisibility(const ViewFrustum&, const OrientedBoundingBox&, FRUSTUM_PLANE_FLAGS)
+///             for every box. The frustum corners are not tested against the box planes.
+inline void GetBoxesVisibilityMask(const ViewFrustum&              Frustum,
+                                   const OrientedBoundingBoxesSoA& Boxes,
+                                   Uint32*                         pVisibilityMask,
+                                   FRUSTUM_PLANE_FLAGS             PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    const BatchCullingInternal::CullingPlanes Planes{Frustum, PlaneFlags};
+    BatchCullingInternal::GetBoxesVisibilityMask(Boxes.Count, pVisibilityMask, [&](size_t FirstBox, size_t NumBoxes) {
+        return BatchCullingInternal::GetBoxesVisibilityMaskWord(Planes, Boxes, FirstBox, NumBoxes);
+    });
+}
+
+/// Tests multiple axis-aligned bounding boxes against the view frustum and writes
+/// the indices of the boxes that are not invisible.
+
+/// \param [in]  Frustum         - View frustum.
+/// \param [in]  Boxes           - Bounding boxes to test.
+/// \param [out] pVisibleIndices - Indices of the visible boxes in ascending order.
+///                                The array must contain at least Boxes.Count elements.
+/// \param [in]  PlaneFlags      - Planes to test the boxes against.
+///
+/// \return     The number of visible boxes.
+inline size_t GetVisibleBoxIndices(const ViewFrustum&   Frustum,
+                                   const BoundBoxesSoA& Boxes,
+                                   Uint32*              pVisibleIndices,
+                                   FRUSTUM_PLANE_FLAGS  PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    const BatchCullingInternal::CullingPlanes Planes{Frustum, PlaneFlags};
+    return BatchCullingInternal::GetVisibleBoxIndices(Boxes.Count, pVisibleIndices, [&](size_t FirstBox, size_t NumBoxes) {
+        return BatchCullingInternal::GetBoxesVisibilityMaskWord(Planes, nullptr, Boxes, FirstBox, NumBoxes);
+    });
+}
+
+/// Tests multiple axis-aligned bounding boxes against the view frustum and writes
+/// the indices of the boxes that are not invisible.
+
+/// This overload additionally tests the frustum corners against the box planes.
+inline size_t GetVisibleBoxIndices(const ViewFrustumExt& FrustumExt,
+                                   const BoundBoxesSoA&  Boxes,
+                                   Uint32*               pVisibleIndices,
+                                   FRUSTUM_PLANE_FLAGS   PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    const BatchCullingInternal::CullingPlanes Planes{FrustumExt, PlaneFlags};
+
+    float3       FrustumBounds[2];
+    const bool   TestCorners    = (PlaneFlags & FRUSTUM_PLANE_FLAG_FULL_FRUSTUM) == FRUSTUM_PLANE_FLAG_FULL_FRUSTUM;
+    const float3* pFrustumBounds = TestCorners ? FrustumBounds : nullptr;
+    if (TestCorners)
+        BatchCullingInternal::GetFrustumBounds(FrustumExt, FrustumBounds);
+
+    return BatchCullingInternal::GetVisibleBoxIndices(Boxes.Count, pVisibleIndices, [&](size_t FirstBox, size_t NumBoxes) {
+        return BatchCullingInternal::GetBoxesVisibilityMaskWord(Planes, pFrustumBounds, Boxes, FirstBox, NumBoxes);
+    });
+}
+
+/// Tests multiple oriented bounding boxes against the view frustum planes and writes
+/// the indices of the boxes that are not invisible.
+inline size_t GetVisibleBoxIndices(const ViewFrustum&              Frustum,
+                                   const OrientedBoundingBoxesSoA& Boxes,
+                                   Uint32*                         pVisibleIndices,
+                                   FRUSTUM_PLANE_FLAGS             PlaneFlags = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM)
+{
+    const BatchCullingInternal::CullingPlanes Planes{Frustum, PlaneFlags};
+    return BatchCullingInternal::GetVisibleBoxIndices(Boxes.Count, pVisibleIndices, [&](size_t FirstBox, size_t NumBoxes) {
+        return BatchCullingInternal::GetBoxesVisibilityMaskWord(Planes, Boxes, FirstBox, NumBoxes);
+    });
+}
+
 inline float GetPointToBoxDistanceSqr(const BoundBox& BB, const float3& Pos)
 {
     VERIFY_EXPR(BB.Max.x >= BB.Min.x &&
@@ -1434,22 +1885,20 @@ std::vector<IndexType> TriangulatePolygon(const std::vector<Vector2<ComponentTyp
 }
 
 
-/// Triangulates a simple polygon in 3D.
+/// Computes the axes of the plane to project the 3D polygon onto.
 
-/// \remarks This function first projects the polygon onto the plane and then
-///          triangulates the resulting 2D polygon.
-///
-///          If vertices are not coplanar, the result is undefined.
-template <typename IndexType, typename ComponentType>
-typename std::enable_if<std::is_floating_point<ComponentType>::value, std::vector<IndexType>>::type
-TriangulatePolygon3D(const std::vector<Vector3<ComponentType>>& Polygon, bool VerifyEarAndConvexVerts = true)
+/// \return    false if all vertices are collinear, and true otherwise.
+template <typename ComponentType>
+bool GetPolygonProjectionAxes(const std::vector<Vector3<ComponentType>>& Polygon,
+                              Vector3<ComponentType>&                    Tangent,
+                              Vector3<ComponentType>&                    Bitangent)
 {
     // Find the normal
     Vector3<ComponentType> Normal;
 
     // Use the normal with the largest length.
     // Note that it does not matter if the vertex is convex or reflex as
-    // the TriangulatePolygon() function handles any orinetation.
+    // the triangulation functions handle any orinetation.
     ComponentType NormalLength = 0;
     for (size_t i = 0; i < Polygon.size(); ++i)
     {
@@ -1467,13 +1916,10 @@ TriangulatePolygon3D(const std::vector<Vector3<ComponentType>>& Polygon, bool Ve
     }
 
     if (NormalLength == 0)
-    {
-        UNEXPECTED("Failed to find a plane for the polygon, which means that all vertices are collinear.");
-        return {};
-    }
+        return false;
+
     const auto AbsNormal = abs(Normal);
 
-    Vector3<ComponentType> Tangent;
     if (AbsNormal.z > (std::max)(AbsNormal.x, AbsNormal.y))
         Tangent = cross(Vector3<ComponentType>{ComponentType{0}, ComponentType{1}, ComponentType{0}}, Normal);
     else if (AbsNormal.y > (std::max)(AbsNormal.x, AbsNormal.z))
@@ -1483,19 +1929,764 @@ TriangulatePolygon3D(const std::vector<Vector3<ComponentType>>& Polygon, bool Ve
     VERIFY_EXPR(length(Tangent) > 0);
     Tangent = normalize(Tangent);
 
-    auto Bitangent = cross(Normal, Tangent);
+    Bitangent = cross(Normal, Tangent);
     VERIFY_EXPR(length(Bitangent) > 0);
     Bitangent = normalize(Bitangent);
 
-    // Project the polygon
+    return true;
+}
+
+/// Projects the 3D polygon onto the plane defined by the tangent and bitangent.
+template <typename ComponentType>
+std::vector<Vector2<ComponentType>> ProjectPolygon(const std::vector<Vector3<ComponentType>>& Polygon,
+                                                   const Vector3<ComponentType>&              Tangent,
+                                                   const Vector3<ComponentType>&              Bitangent)
+{
     std::vector<Vector2<ComponentType>> PolygonProj;
     PolygonProj.reserve(Polygon.size());
     for (const auto& Vert : Polygon)
     {
         PolygonProj.emplace_back(dot(Tangent, Vert), dot(Bitangent, Vert));
     }
+    return PolygonProj;
+}
+
+/// Triangulates a simple polygon in 3D.
+
+/// \remarks This function first projects the polygon onto the plane and then
+///          triangulates the resulting 2D polygon.
+///
+///          If vertices are not coplanar, the result is undefined.
+template <typename IndexType, typename ComponentType>
+typename std::enable_if<std::is_floating_point<ComponentType>::value, std::vector<IndexType>>::type
+TriangulatePolygon3D(const std::vector<Vector3<ComponentType>>& Polygon, bool VerifyEarAndConvexVerts = true)
+{
+    Vector3<ComponentType> Tangent, Bitangent;
+    if (!GetPolygonProjectionAxes(Polygon, Tangent, Bitangent))
+    {
+        UNEXPECTED("Failed to find a plane for the polygon, which means that all vertices are collinear.");
+        return {};
+    }
+
+    return TriangulatePolygon<IndexType>(ProjectPolygon(Polygon, Tangent, Bitangent), VerifyEarAndConvexVerts);
+}
+
+namespace PolygonTriangulationInternal
+{
+
+// Ear-clipping triangulator that accelerates the ear test with the z-order curve hash
+// and links holes into the outer ring with bridges.
+// The implementation follows the approach of the Mapbox earcut library.
+class ZOrderEarClipper
+{
+public:
+    // Adds a ring of vertices. The ring of the outer polygon must be added first.
+    template <typename ComponentType>
+    void AddRing(const std::vector<Vector2<ComponentType>>& Ring, bool IsOuter)
+    {
+        const Uint32 FirstIdx = m_VertCount;
+        m_VertCount += static_cast<Uint32>(Ring.size());
+        if (Ring.empty())
+            return;
+
+        double SignedArea = 0;
+        for (size_t i = 0, j = Ring.size() - 1; i < Ring.size(); j = i++)
+            SignedArea += (static_cast<double>(Ring[j].x) - static_cast<double>(Ring[i].x)) * (static_cast<double>(Ring[i].y) + static_cast<double>(Ring[j].y));
+
+        // The outer ring is linked counter-clockwise, and holes are linked clockwise
+        Node* pLast = nullptr;
+        if (IsOuter == (SignedArea > 0))
+        {
+            for (size_t i = 0; i < Ring.size(); ++i)
+                pLast = InsertNode(FirstIdx + static_cast<Uint32>(i), Ring[i], pLast);
+        }
+        else
+        {
+            for (size_t i = Ring.size(); i > 0; --i)
+                pLast = InsertNode(FirstIdx + static_cast<Uint32>(i - 1), Ring[i - 1], pLast);
+        }
+
+        if (pLast != nullptr && Equals(pLast, pLast->pNext))
+        {
+            RemoveNode(pLast);
+            pLast = pLast->pNext;
+        }
+
+        if (IsOuter)
+        {
+            m_pOuter     = pLast;
+            m_IsOuterCCW = SignedArea > 0;
+        }
+        else if (pLast != nullptr)
+        {
+            if (pLast == pLast->pNext)
+                pLast->IsSteiner = true;
+            m_Holes.push_back(GetLeftmost(pLast));
+        }
+    }
+
+    template <typename IndexType>
+    std::vector<IndexType> Triangulate()
+    {
+        if (m_pOuter == nullptr || m_pOuter->pNext == m_pOuter->pPrev)
+            return {};
+
+        if (!m_Holes.empty())
+            EliminateHoles();
+
+        // Use the z-order hash only when the polygon is not too simple
+        if (m_VertCount > 80)
+        {
+            double MaxX = m_pOuter->x, MaxY = m_pOuter->y;
+            m_MinX = MaxX;
+            m_MinY = MaxY;
+            const Node* p = m_pOuter;
+            do
+            {
+                m_MinX = (std::min)(m_MinX, p->x);
+                m_MinY = (std::min)(m_MinY, p->y);
+                MaxX   = (std::max)(MaxX, p->x);
+                MaxY   = (std::max)(MaxY, p->y);
+                p      = p->pNext;
+            } while (p != m_pOuter);
+
+            // MinX, MinY and InvSize are used to transform coordinates into 15-bit integers
+            m_InvSize = (std::max)(MaxX - m_MinX, MaxY - m_MinY);
+            m_InvSize = m_InvSize != 0 ? 32767.0 / m_InvSize : 0;
+        }
+
+        m_Triangles.reserve((m_VertCount + 2 * m_Holes.size()) * 3);
+        EarClipLinked(m_pOuter, 0);
+
+        // Match the winding order of the source polygon
+        std::vector<IndexType> Triangles(m_Triangles.size());
+        for (size_t i = 0; i < m_Triangles.size(); i += 3)
+        {
+            Triangles[i + 0] = static_cast<IndexType>(m_Triangles[i + 0]);
+            Triangles[i + 1] = static_cast<IndexType>(m_Triangles[m_IsOuterCCW ? i + 1 : i + 2]);
+            Triangles[i + 2] = static_cast<IndexType>(m_Triangles[m_IsOuterCCW ? i + 2 : i + 1]);
+        }
+        return Triangles;
+    }
+
+private:
+    struct Node
+    {
+        Uint32 Idx = 0;
+        double x   = 0;
+        double y   = 0;
+
+        Node* pPrev = nullptr;
+        Node* pNext = nullptr;
+
+        // Z-order curve value and the nodes sorted by it
+        Uint32 z      = 0;
+        Node*  pPrevZ = nullptr;
+        Node*  pNextZ = nullptr;
+
+        // Whether this is a single-vertex hole
+        bool IsSteiner = false;
+    };
+
+    template <typename ComponentType>
+    Node* InsertNode(Uint32 Idx, const Vector2<ComponentType>& Vert, Node* pLast)
+    {
+        m_Nodes.emplace_back();
+        Node* p = &m_Nodes.back();
+        p->Idx  = Idx;
+        p->x    = static_cast<double>(Vert.x);
+        p->y    = static_cast<double>(Vert.y);
+        if (pLast == nullptr)
+        {
+            p->pPrev = p;
+            p->pNext = p;
+        }
+        else
+        {
+            p->pNext            = pLast->pNext;
+            p->pPrev            = pLast;
+            pLast->pNext->pPrev = p;
+            pLast->pNext        = p;
+        }
+        return p;
+    }
+
+    static void RemoveNode(Node* p)
+    {
+        p->pNext->pPrev = p->pPrev;
+        p->pPrev->pNext = p->pNext;
+        if (p->pPrevZ != nullptr)
+            p->pPrevZ->pNextZ = p->pNextZ;
+        if (p->pNextZ != nullptr)
+            p->pNextZ->pPrevZ = p->pPrevZ;
+    }
+
+    // Twice the signed area of the triangle. Negative for counter-clockwise triangles.
+    static double Area(const Node* p, const Node* q, const Node* r)
+    {
+        return (q->y - p->y) * (r->x - q->x) - (q->x - p->x) * (r->y - q->y);
+    }
+
+    static bool Equals(const Node* p1, const Node* p2)
+    {
+        return p1->x == p2->x && p1->y == p2->y;
+    }
+
+    static bool PointInTriangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py)
+    {
+        return (cx - px) * (ay - py) >= (ax - px) * (cy - py) &&
+            (ax - px) * (by - py) >= (bx - px) * (ay - py) &&
+            (bx - px) * (cy - py) >= (cx - px) * (by - py);
+    }
+
+    static Node* GetLeftmost(Node* pStart)
+    {
+        Node* p         = pStart;
+        Node* pLeftmost = pStart;
+        do
+        {
+            if (p->x < pLeftmost->x || (p->x == pLeftmost->x && p->y < pLeftmost->y))
+                pLeftmost = p;
+            p = p->pNext;
+        } while (p != pStart);
+        return pLeftmost;
+    }
+
+    // Removes duplicate and collinear points
+    static Node* FilterPoints(Node* pStart, Node* pEnd = nullptr)
+    {
+        if (pStart == nullptr)
+            return pStart;
+        if (pEnd == nullptr)
+            pEnd = pStart;
+
+        Node* p = pStart;
+        bool  Again;
+        do
+        {
+            Again = false;
+            if (!p->IsSteiner && (Equals(p, p->pNext) || Area(p->pPrev, p, p->pNext) == 0))
+            {
+                RemoveNode(p);
+                p = pEnd = p->pPrev;
+                if (p == p->pNext)
+                    break;
+                Again = true;
+            }
+            else
+            {
+                p = p->pNext;
+            }
+        } while (Again || p != pEnd);
+
+        return pEnd;
+    }
+
+    Uint32 ZOrder(double x, double y) const
+    {
+        // Transform the coordinates into the non-negative 15-bit integer range
+        Uint32 ix = static_cast<Uint32>((x - m_MinX) * m_InvSize);
+        Uint32 iy = static_cast<Uint32>((y - m_MinY) * m_InvSize);
+
+        ix = (ix | (ix << 8)) & 0x00FF00FF;
+        ix = (ix | (ix << 4)) & 0x0F0F0F0F;
+        ix = (ix | (ix << 2)) & 0x33333333;
+        ix = (ix | (ix << 1)) & 0x55555555;
+
+        iy = (iy | (iy << 8)) & 0x00FF00FF;
+        iy = (iy | (iy << 4)) & 0x0F0F0F0F;
+        iy = (iy | (iy << 2)) & 0x33333333;
+        iy = (iy | (iy << 1)) & 0x55555555;
+
+        return ix | (iy << 1);
+    }
+
+    // Links the polygon nodes in z-order
+    void IndexCurve(Node* pStart)
+    {
+        m_SortedNodes.clear();
+        Node* p = pStart;
+        do
+        {
+            if (p->z == 0)
+                p->z = ZOrder(p->x, p->y);
+            m_SortedNodes.push_back(p);
+            p = p->pNext;
+        } while (p != pStart);
+
+        std::stable_sort(m_SortedNodes.begin(), m_SortedNodes.end(), [](const Node* p0, const Node* p1) { return p0->z < p1->z; });
+
+        for (size_t i = 0; i < m_SortedNodes.size(); ++i)
+        {
+            m_SortedNodes[i]->pPrevZ = i > 0 ? m_SortedNodes[i - 1] : nullptr;
+            m_SortedNodes[i]->pNextZ = i + 1 < m_SortedNodes.size() ? m_SortedNodes[i + 1] : nullptr;
+        }
+    }
+
+    static bool IsEar(const Node* pEar)
+    {
+        const Node* a = pEar->pPrev;
+        const Node* b = pEar;
+        const Node* c = pEar->pNext;
+
+        // Reflex vertex can't be an ear
+        if (Area(a, b, c) >= 0)
+            return false;
+
+        const double x0 = (std::min)({a->x, b->x, c->x});
+        const double y0 = (std::min)({a->y, b->y, c->y});
+        const double x1 = (std::max)({a->x, b->x, c->x});
+        const double y1 = (std::max)({a->y, b->y, c->y});
+
+        // Make sure there are no other points inside the potential ear
+        for (const Node* p = c->pNext; p != a; p = p->pNext)
+        {
+            if (p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 &&
+                PointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+                Area(p->pPrev, p, p->pNext) >= 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    bool IsEarHashed(const Node* pEar) const
+    {
+        const Node* a = pEar->pPrev;
+        const Node* b = pEar;
+        const Node* c = pEar->pNext;
+
+        if (Area(a, b, c) >= 0)
+            return false;
+
+        const double x0 = (std::min)({a->x, b->x, c->x});
+        const double y0 = (std::min)({a->y, b->y, c->y});
+        const double x1 = (std::max)({a->x, b->x, c->x});
+        const double y1 = (std::max)({a->y, b->y, c->y});
+
+        // Only the points with z-order values within the range of the triangle
+        // bounding box can be inside the triangle
+        const Uint32 MinZ = ZOrder(x0, y0);
+        const Uint32 MaxZ = ZOrder(x1, y1);
+
+        auto IsInside = [&](const Node* p) {
+            return p->x >= x0 && p->x <= x1 && p->y >= y0 && p->y <= y1 && p != a && p != c &&
+                PointInTriangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y) &&
+                Area(p->pPrev, p, p->pNext) >= 0;
+        };
+
+        // Look for points inside the triangle in both directions
+        const Node* p = pEar->pPrevZ;
+        const Node* n = pEar->pNextZ;
+        while (p != nullptr && p->z >= MinZ && n != nullptr && n->z <= MaxZ)
+        {
+            if (IsInside(p))
+                return false;
+            p = p->pPrevZ;
+
+            if (IsInside(n))
+                return false;
+            n = n->pNextZ;
+        }
+
+        for (; p != nullptr && p->z >= MinZ; p = p->pPrevZ)
+        {
+            if (IsInside(p))
+                return false;
+        }
+
+        for (; n != nullptr && n->z <= MaxZ; n = n->pNextZ)
+        {
+            if (IsInside(n))
+                return false;
+        }
+
+        return true;
+    }
+
+    void AddTriangle(const Node* a, const Node* b, const Node* c)
+    {
+        m_Triangles.push_back(a->Idx);
+        m_Triangles.push_back(b->Idx);
+        m_Triangles.push_back(c->Idx);
+    }
+
+    // Main ear clipping loop
+    void EarClipLinked(Node* pEar, int Pass)
+    {
+        if (pEar == nullptr)
+            return;
+
+        if (Pass == 0 && m_InvSize != 0)
+            IndexCurve(pEar);
+
+        Node* pStop = pEar;
+        while (pEar->pPrev != pEar->pNext)
+        {
+            Node* pPrev = pEar->pPrev;
+            Node* pNext = pEar->pNext;
+
+            if (m_InvSize != 0 ? IsEarHashed(pEar) : IsEar(pEar))
+            {
+                AddTriangle(pPrev, pEar, pNext);
+                RemoveNode(pEar);
+
+                // Skipping the next vertex leads to fewer sliver triangles
+                pEar  = pNext->pNext;
+                pStop = pNext->pNext;
+                continue;
+            }
+
+            pEar = pNext;
+
+            // If the whole remaining polygon has been traversed and no more ears can be found
+            if (pEar == pStop)
+            {
+                if (Pass == 0)
+                {
+                    // Try filtering points and clipping again
+                    EarClipLinked(FilterPoints(pEar), 1);
+                }
+                else if (Pass == 1)
+                {
+                    // Try curing small self-intersections
+                    pEar = CureLocalIntersections(FilterPoints(pEar));
+                    EarClipLinked(pEar, 2);
+                }
+                else if (Pass == 2)
+                {
+                    // As a last resort, try splitting the remaining polygon into two
+                    SplitEarClip(pEar);
+                }
+                break;
+            }
+        }
+    }
+
+    static int Sign(double Val)
+    {
+        return Val > 0 ? 1 : (Val < 0 ? -1 : 0);
+    }
+
+    // For collinear points p, q, r, checks if q lies on the segment pr
+    static bool OnSegment(const Node* p, const Node* q, const Node* r)
+    {
+        return q->x <= (std::max)(p->x, r->x) && q->x >= (std::min)(p->x, r->x) &&
+            q->y <= (std::max)(p->y, r->y) && q->y >= (std::min)(p->y, r->y);
+    }
+
+    static bool Intersects(const Node* p1, const Node* q1, const Node* p2, const Node* q2)
+    {
+        const int o1 = Sign(Area(p1, q1, p2));
+        const int o2 = Sign(Area(p1, q1, q2));
+        const int o3 = Sign(Area(p2, q2, p1));
+        const int o4 = Sign(Area(p2, q2, q1));
+
+        if (o1 != o2 && o3 != o4)
+            return true;
+
+        return (o1 == 0 && OnSegment(p1, p2, q1)) ||
+            (o2 == 0 && OnSegment(p1, q2, q1)) ||
+            (o3 == 0 && OnSegment(p2, p1, q2)) ||
+            (o4 == 0 && OnSegment(p2, q1, q2));
+    }
+
+    // Checks if the diagonal ab intersects any polygon edge
+    static bool IntersectsPolygon(const Node* a, const Node* b)
+    {
+        const Node* p = a;
+        do
+        {
+            if (p->Idx != a->Idx && p->pNext->Idx != a->Idx && p->Idx != b->Idx && p->pNext->Idx != b->Idx &&
+                Intersects(p, p->pNext, a, b))
+                return true;
+            p = p->pNext;
+        } while (p != a);
+        return false;
+    }
+
+    // Checks if the diagonal ab is locally inside the polygon
+    static bool LocallyInside(const Node* a, const Node* b)
+    {
+        return Area(a->pPrev, a, a->pNext) < 0 ?
+            Area(a, b, a->pNext) >= 0 && Area(a, a->pPrev, b) >= 0 :
+            Area(a, b, a->pPrev) < 0 || Area(a, a->pNext, b) < 0;
+    }
+
+    // Checks if the middle point of the diagonal ab is inside the polygon
+    static bool MiddleInside(const Node* a, const Node* b)
+    {
+        const double px     = (a->x + b->x) / 2;
+        const double py     = (a->y + b->y) / 2;
+        bool         Inside = false;
+
+        const Node* p = a;
+        do
+        {
+            if ((p->y > py) != (p->pNext->y > py) && p->pNext->y != p->y &&
+                px < (p->pNext->x - p->x) * (py - p->y) / (p->pNext->y - p->y) + p->x)
+                Inside = !Inside;
+            p = p->pNext;
+        } while (p != a);
+
+        return Inside;
+    }
+
+    static bool IsValidDiagonal(const Node* a, const Node* b)
+    {
+        return a->pNext->Idx != b->Idx && a->pPrev->Idx != b->Idx && !IntersectsPolygon(a, b) &&
+            // Locally visible and does not create opposite-facing sectors
+            ((LocallyInside(a, b) && LocallyInside(b, a) && MiddleInside(a, b) &&
+              (Area(a->pPrev, a, b->pPrev) != 0 || Area(a, b->pPrev, b) != 0)) ||
+             // Special zero-length case
+             (Equals(a, b) && Area(a->pPrev, a, a->pNext) > 0 && Area(b->pPrev, b, b->pNext) > 0));
+    }
+
+    // Links two vertices with a bridge. If the vertices belong to the same ring, this splits the polygon
+    // into two. If one vertex belongs to the outer ring and another to a hole, this merges them into a single ring.
+    Node* SplitPolygon(Node* a, Node* b)
+    {
+        m_Nodes.emplace_back(Node{a->Idx, a->x, a->y});
+        Node* a2 = &m_Nodes.back();
+        m_Nodes.emplace_back(Node{b->Idx, b->x, b->y});
+        Node* b2 = &m_Nodes.back();
+
+        Node* an = a->pNext;
+        Node* bp = b->pPrev;
+
+        a->pNext  = b;
+        b->pPrev  = a;
+        a2->pNext = an;
+        an->pPrev = a2;
+        b2->pNext = a2;
+        a2->pPrev = b2;
+        bp->pNext = b2;
+        b2->pPrev = bp;
+
+        return b2;
+    }
+
+    Node* CureLocalIntersections(Node* pStart)
+    {
+        Node* p = pStart;
+        do
+        {
+            Node* a = p->pPrev;
+            Node* b = p->pNext->pNext;
+            if (!Equals(a, b) && Intersects(a, p, p->pNext, b) && LocallyInside(a, b) && LocallyInside(b, a))
+            {
+                AddTriangle(a, p, b);
+
+                // Remove the two nodes involved
+                RemoveNode(p);
+                RemoveNode(p->pNext);
+
+                p = pStart = b;
+            }
+            p = p->pNext;
+        } while (p != pStart);
+
+        return FilterPoints(p);
+    }
+
+    void SplitEarClip(Node* pStart)
+    {
+        // Look for a valid diagonal that divides the polygon into two
+        Node* a = pStart;
+        do
+        {
+            for (Node* b = a->pNext->pNext; b != a->pPrev; b = b->pNext)
+            {
+                if (a->Idx != b->Idx && IsValidDiagonal(a, b))
+                {
+                    Node* c = SplitPolygon(a, b);
+
+                    // Filter collinear points around the cuts
+                    a = FilterPoints(a, a->pNext);
+                    c = FilterPoints(c, c->pNext);
+
+                    EarClipLinked(a, 0);
+                    EarClipLinked(c, 0);
+                    return;
+                }
+            }
+            a = a->pNext;
+        } while (a != pStart);
+    }
+
+    // Checks if the sector in vertex m contains the sector in vertex p
+    static bool SectorContainsSector(const Node* m, const Node* p)
+    {
+        return Area(m->pPrev, m, p->pPrev) < 0 && Area(p->pNext, m, m->pNext) < 0;
+    }
+
+    // Finds a bridge between the hole and the outer polygon using David Eberly's algorithm
+    static Node* FindHoleBridge(const Node* pHole, Node* pOuter)
+    {
+        const double hx = pHole->x;
+        const double hy = pHole->y;
+
+        // Find a segment intersected by a ray from the leftmost point of the hole to the left.
+        // The segment end point with the lesser x will be the potential connection point.
+        double qx = -(std::numeric_limits<double>::max)();
+        Node*  m  = nullptr;
+        Node*  p  = pOuter;
+        do
+        {
+            if (hy <= p->y && hy >= p->pNext->y && p->pNext->y != p->y)
+            {
+                const double x = p->x + (hy - p->y) * (p->pNext->x - p->x) / (p->pNext->y - p->y);
+                if (x <= hx && x > qx)
+                {
+                    qx = x;
+                    m  = p->x < p->pNext->x ? p : p->pNext;
+                    if (x == hx)
+                    {
+                        // The hole touches the outer segment
+                        return m;
+                    }
+                }
+            }
+            p = p->pNext;
+        } while (p != pOuter);
+
+        if (m == nullptr)
+            return nullptr;
+
+        // Look for points inside the triangle formed by the hole point, the segment intersection and
+        // the end point. If there are no points, the connection is valid. Otherwise, choose the point
+        // with the minimum angle with the ray as the connection point.
+        const Node*  pStop  = m;
+        const double mx     = m->x;
+        const double my     = m->y;
+        double       TanMin = (std::numeric_limits<double>::max)();
+
+        p = m;
+        do
+        {
+            if (hx >= p->x && p->x >= mx && hx != p->x &&
+                PointInTriangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y))
+            {
+                const double Tan = std::abs(hy - p->y) / (hx - p->x);
+                if (LocallyInside(p, pHole) &&
+                    (Tan < TanMin || (Tan == TanMin && (p->x > m->x || (p->x == m->x && SectorContainsSector(m, p))))))
+                {
+                    m      = p;
+                    TanMin = Tan;
+                }
+            }
+            p = p->pNext;
+        } while (p != pStop);
+
+        return m;
+    }
+
+    // Links every hole into the outer ring, producing a single-ring polygon without holes
+    void EliminateHoles()
+    {
+        // Process holes from left to right
+        std::stable_sort(m_Holes.begin(), m_Holes.end(), [](const Node* h0, const Node* h1) { return h0->x < h1->x; });
+        for (Node* pHole : m_Holes)
+        {
+            Node* pBridge = FindHoleBridge(pHole, m_pOuter);
+            if (pBridge == nullptr)
+                continue;
+
+            Node* pBridgeReverse = SplitPolygon(pBridge, pHole);
+
+            // Filter collinear points around the cuts
+            FilterPoints(pBridgeReverse, pBridgeReverse->pNext);
+            m_pOuter = FilterPoints(pBridge, pBridge->pNext);
+        }
+    }
+
+private:
+    // Deque keeps the node addresses stable when new nodes are added
+    std::deque<Node>   m_Nodes;
+    std::vector<Node*> m_Holes;
+    std::vector<Node*> m_SortedNodes;
+
+    Node*  m_pOuter     = nullptr;
+    bool   m_IsOuterCCW = true;
+    Uint32 m_VertCount  = 0;
+
+    double m_MinX    = 0;
+    double m_MinY    = 0;
+    double m_InvSize = 0;
+
+    std::vector<Uint32> m_Triangles;
+};
+
+} // namespace PolygonTriangulationInternal
+
+/// Triangulates a polygon with holes using the ear-clipping algorithm accelerated
+/// with the z-order curve hash.
+
+/// \tparam [in] IndexType     - Index type (e.g. Uint32 or Uint16).
+/// \tparam [in] ComponentType - Vertex component type (e.g. float, double or int).
+///
+/// \param [in]  Polygon - A list of polygon vertices. The last vertex is
+///                        assumed to be connected to the first one.
+/// \param [in]  Holes   - A list of holes. Each hole is a list of vertices in any winding order.
+///                        The holes must be inside the polygon and must not overlap each other.
+///
+/// \return     The triangle list. The vertex indices refer to the concatenation of the polygon
+///             vertices and the vertices of all holes in the order they are given.
+///
+/// \remarks    The winding order of each triangle is the same as the winding
+///             order of the polygon.
+///
+///             Unlike TriangulatePolygon(), which tests every remaining vertex when it clips an ear,
+///             this function only tests the vertices whose z-order values are within the range of
+///             the ear bounding box. This makes it significantly faster for polygons with thousands
+///             of vertices. Polygons with 80 vertices or fewer do not use the hash.
+///
+///             The function tolerates degenerate input, such as duplicate vertices and small
+///             self-intersections, but in this case the triangulation may not cover the whole polygon.
+///             Duplicate and collinear vertices may not be referenced by the triangle list.
+template <typename IndexType, typename ComponentType>
+std::vector<IndexType> TriangulatePolygonWithHoles(const std::vector<Vector2<ComponentType>>&              Polygon,
+                                                   const std::vector<std::vector<Vector2<ComponentType>>>& Holes = {})
+{
+    if (Polygon.size() <= 2)
+    {
+        DEV_ERROR("At least three vertices are required.");
+        return {};
+    }
+
+    PolygonTriangulationInternal::ZOrderEarClipper EarClipper;
+    EarClipper.AddRing(Polygon, /*IsOuter = */ true);
+    for (const auto& Hole : Holes)
+        EarClipper.AddRing(Hole, /*IsOuter = */ false);
+
+    return EarClipper.Triangulate<IndexType>();
+}
+
+
+/// Triangulates a polygon with holes in 3D.
+
+/// \remarks This function projects the polygon and the holes onto the plane of the polygon and then
+///          triangulates the resulting 2D polygon using TriangulatePolygonWithHoles().
+///
+///          If vertices are not coplanar, the result is undefined.
+template <typename IndexType, typename ComponentType>
+typename std::enable_if<std::is_floating_point<ComponentType>::value, std::vector<IndexType>>::type
+TriangulatePolygon3DWithHoles(const std::vector<Vector3<ComponentType>>&              Polygon,
+                              const std::vector<std::vector<Vector3<ComponentType>>>& Holes = {})
+{
+    Vector3<ComponentType> Tangent, Bitangent;
+    if (!GetPolygonProjectionAxes(Polygon, Tangent, Bitangent))
+    {
+        UNEXPECTED("Failed to find a plane for the polygon, which means that all vertices are collinear.");
+        return {};
+    }
+
+    std::vector<std::vector<Vector2<ComponentType>>> HolesProj;
+    HolesProj.reserve(Holes.size());
+    for (const auto& Hole : Holes)
+        HolesProj.emplace_back(ProjectPolygon(Hole, Tangent, Bitangent));
 
-    return TriangulatePolygon<IndexType>(PolygonProj, VerifyEarAndConvexVerts);
+    return TriangulatePolygonWithHoles<IndexType>(ProjectPolygon(Polygon, Tangent, Bitangent), HolesProj);
 }
 
 } // namespace Diligent
@@ -29,11 +29,15 @@
 /// \file
 /// 2D array processing utilities.
 
+#include <vector>
+
 #include "../../Primitives/interface/BasicTypes.h"
 
 namespace Diligent
 {
 
+class IThreadPool;
+
 /// Computes the minimum and the maximum value in a 2D floating-point array
 
 /// \param[in]  pData		   - A pointer to the array data.
@@ -49,4 +53,115 @@ void GetArray2DMinMaxValue(const float* pData,
                            float&       MinValue,
                            float&       MaxValue);
 
+/// Computes the minimum and the maximum value in a 2D floating-point array using the thread pool.
+
+/// \param[in]  pThreadPool    - Thread pool to run the tasks. If it is null, the array is
+///                              processed by the calling thread.
+/// \param[in]  NumTasks       - The maximum number of tasks to split the work into, including
+///                              the part that is processed by the calling thread.
+/// \param[in]  pData          - A pointer to the array data.
+/// \param[in]  StrideInFloats - Row stride in 32-bit floats.
+/// \param[in]  Width          - 2D array width.
+/// \param[in]  Height         - 2D array height.
+/// \param[out] MinValue       - Minimum value.
+/// \param[out] MaxValue       - Maximum value.
+///
+/// \remarks    The function blocks until the whole array is processed, and must not be called
+///             from a worker thread of the same thread pool.
+void GetArray2DMinMaxValueParallel(IThreadPool* pThreadPool,
+                                   Uint32       NumTasks,
+                                   const float* pData,
+                                   size_t       StrideInFloats,
+                                   Uint32       Width,
+                                   Uint32       Height,
+                                   float&       MinValue,
+                                   float&       MaxValue);
+
+
+/// Min/max pyramid of a 2D floating-point array.
+
+/// Every level of the pyramid halves the resolution of the previous one, rounding up,
+/// and every element stores the minimum and the maximum value of the corresponding block
+/// of the array. The pyramid is used to find the minimum and the maximum value in a
+/// rectangle of the array without visiting every element: a query only visits the
+/// elements along the rectangle border at every level, which is O(width + height)
+/// instead of O(width * height).
+///
+/// The pyramid references the array data and does not copy it. The data must stay alive
+/// while the pyramid is used, and the application must call Update() for every region
+/// of the array it modifies.
+class Array2DMinMaxPyramid
+{
+public:
+    Array2DMinMaxPyramid() noexcept {}
+
+    Array2DMinMaxPyramid(const float* pData,
+                         size_t       StrideInFloats,
+                         Uint32       Width,
+                         Uint32       Height);
+
+    /// Rebuilds the pyramid for the new array.
+    void Reset(const float* pData,
+               size_t       StrideInFloats,
+               Uint32       Width,
+               Uint32       Height);
+
+    /// Updates the pyramid after the values in the given region of the array have changed.
+
+    /// \param[in] X            - Region left column.
+    /// \param[in] Y            - Region top row.
+    /// \param[in] RegionWidth  - Region width.
+    /// \param[in] RegionHeight - Region height.
+    ///
+    /// \remarks   The region is clipped against the array bounds.
+    void Update(Uint32 X,
+                Uint32 Y,
+                Uint32 RegionWidth,
+                Uint32 RegionHeight);
+
+    /// Computes the minimum and the maximum value in the rectangle of the array.
+
+    /// \param[in]  X          - Rectangle left column.
+    /// \param[in]  Y          - Rectangle top row.
+    /// \param[in]  RectWidth  - Rectangle width.
+    /// \param[in]  RectHeight - Rectangle height.
+    /// \param[out] MinValue   - Minimum value.
+    /// \param[out] MaxValue   - Maximum value.
+    ///
+    /// \return    false if the rectangle clipped against the array bounds is empty,
+    ///            in which case MinValue and MaxValue are not modified, and true otherwise.
+    bool GetMinMax(Uint32 X,
+                   Uint32 Y,
+                   Uint32 RectWidth,
+                   Uint32 RectHeight,
+                   float& MinValue,
+                   float& MaxValue) const;
+
+    Uint32 GetWidth() const { return m_Width; }
+    Uint32 GetHeight() const { return m_Height; }
+
+    /// Returns the number of pyramid levels, including the array itself.
+    Uint32 GetLevelCount() const { return m_pData != nullptr ? static_cast<Uint32>(m_Levels.size() + 1) : 0; }
+
+private:
+    void UpdateLevel(size_t Level, Uint32 X0, Uint32 Y0, Uint32 X1, Uint32 Y1);
+
+    struct LevelData
+    {
+        Uint32 Width  = 0;
+        Uint32 Height = 0;
+
+        std::vector<float> Min;
+        std::vector<float> Max;
+    };
+
+    const float* m_pData          = nullptr;
+    size_t       m_StrideInFloats = 0;
+    Uint32       m_Width          = 0;
+    Uint32       m_Height         = 0;
+
+    // Levels 1 .. N. Level 0 is the array itself.
+    std::vector<LevelData> m_Levels;
+};
+
 } // namespace Diligent
@@ -53,6 +53,7 @@
 #include <iostream>
 
 #include "HashUtils.hpp"
+#include "BasicMathSIMD.hpp"
 
 #ifdef _MSC_VER
 #    pragma warning(push)
@@ -621,6 +622,10 @@ template <class T> struct Vector4
     constexpr Vector4 operator*(const Matrix4x4<T>& m) const
     {
         Vector4 out;
+#if DILIGENT_MATH_SIMD_ENABLED
+        if (MathSIMD::TryMulVector4Matrix4x4(Data(), m.Data(), out.Data()))
+            return out;
+#endif
         out[0] = x * m[0][0] + y * m[1][0] + z * m[2][0] + w * m[3][0];
         out[1] = x * m[0][1] + y * m[1][1] + z * m[2][1] + w * m[3][1];
         out[2] = x * m[0][2] + y * m[1][2] + z * m[2][2] + w * m[3][2];
@@ -1556,6 +1561,13 @@ template <class T> struct Matrix4x4
 
     constexpr Matrix4x4 Transpose() const
     {
+#if DILIGENT_MATH_SIMD_ENABLED
+        {
+            Matrix4x4 mOut;
+            if (MathSIMD::TryTransposeMatrix4x4(Data(), mOut.Data()))
+                return mOut;
+        }
+#endif
         return Matrix4x4 //
             {
                 _11, _21, _31, _41,
@@ -1800,6 +1812,10 @@ template <class T> struct Matrix4x4
     static Matrix4x4 Mul(const Matrix4x4& m1, const Matrix4x4& m2)
     {
         Matrix4x4 mOut;
+#if DILIGENT_MATH_SIMD_ENABLED
+        if (MathSIMD::TryMulMatrix4x4(m1.Data(), m2.Data(), mOut.Data()))
+            return mOut;
+#endif
         for (int i = 0; i < 4; i++)
         {
             for (int j = 0; j < 4; j++)
@@ -1848,6 +1864,10 @@ template <class T> struct Matrix4x4
     constexpr Matrix4x4 Inverse() const
     {
         Matrix4x4 inv;
+#if DILIGENT_MATH_SIMD_ENABLED
+        if (MathSIMD::TryInverseMatrix4x4(Data(), inv.Data()))
+            return inv;
+#endif
 
         // row 1
         inv._11 =
@@ -2288,6 +2308,55 @@ using int4x4 = Matrix4x4<Int32>;
 using int3x3 = Matrix3x3<Int32>;
 using int2x2 = Matrix2x2<Int32>;
 
+
+/// Transforms an array of points by the matrix.
+
+/// The result is the same as computing pSrc[i] * m for every point, i.e. the points are
+/// extended with w = 1 and the result is divided by w.
+/// The function uses the SIMD implementation when it is supported by the target,
+/// even if DILIGENT_MATH_SIMD is not enabled.
+///
+/// \param [in]  pSrc  - Source points.
+/// \param [out] pDst  - Destination points. May be equal to pSrc.
+/// \param [in]  Count - The number of points.
+/// \param [in]  m     - Transform matrix.
+inline void TransformPoints(const float3* pSrc, float3* pDst, size_t Count, const float4x4& m)
+{
+    size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    i = MathSIMD::TransformFloat3Array(reinterpret_cast<const float*>(pSrc), reinterpret_cast<float*>(pDst), Count, m.Data(), /*IsPoint = */ true, /*DivideByW = */ true);
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = pSrc[i] * m;
+}
+
+/// Transforms an array of normals or directions by the matrix.
+
+/// The vectors are extended with w = 0, so that the translation is not applied,
+/// and the result is not normalized. Note that to correctly transform normals when the
+/// matrix contains non-uniform scaling, the inverse transpose of the matrix should be used.
+///
+/// \param [in]  pSrc  - Source vectors.
+/// \param [out] pDst  - Destination vectors. May be equal to pSrc.
+/// \param [in]  Count - The number of vectors.
+/// \param [in]  m     - Transform matrix.
+inline void TransformNormals(const float3* pSrc, float3* pDst, size_t Count, const float4x4& m)
+{
+    size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    i = MathSIMD::TransformFloat3Array(reinterpret_cast<const float*>(pSrc), reinterpret_cast<float*>(pDst), Count, m.Data(), /*IsPoint = */ false, /*DivideByW = */ false);
+#endif
+    for (; i < Count; ++i)
+    {
+        const float3& n = pSrc[i];
+        pDst[i]         = float3{
+            n.x * m._11 + n.y * m._21 + n.z * m._31,
+            n.x * m._12 + n.y * m._22 + n.z * m._32,
+            n.x * m._13 + n.y * m._23 + n.z * m._33,
+        };
+    }
+}
+
 template <typename T = float>
 struct Quaternion
 {
@@ -0,0 +1,338 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// SIMD implementation of the BasicMath float matrix and vector operations.
+///
+/// The functions in this file operate on row-major 4x4 float matrices and use the same
+/// row-vector convention as BasicMath (v' = v * M). They follow the order of operations
+/// of the scalar implementation, so that the results are identical or differ by a few ULPs.
+///
+/// The SIMD implementation is always available to the batch functions (see TransformPoints()
+/// and TransformNormals() in BasicMath.hpp) when the target supports it. The float4x4 and
+/// float4 operators only use it when DILIGENT_MATH_SIMD is defined as 1 (see DILIGENT_MATH_SIMD
+/// CMake option). Note that in this case the float specializations of Matrix4x4::Transpose()
+/// can't be evaluated at compile time.
+
+#include <cstddef>
+
+#include "../../Platforms/interface/Intrinsics.hpp"
+
+#if DILIGENT_AVX2_SUPPORTED && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#    define DILIGENT_MATH_SIMD_SUPPORTED 1
+#else
+#    define DILIGENT_MATH_SIMD_SUPPORTED 0
+#endif
+
+#if DILIGENT_MATH_SIMD_SUPPORTED && defined(DILIGENT_MATH_SIMD) && DILIGENT_MATH_SIMD
+#    define DILIGENT_MATH_SIMD_ENABLED 1
+#else
+#    define DILIGENT_MATH_SIMD_ENABLED 0
+#endif
+
+namespace Diligent
+{
+
+namespace MathSIMD
+{
+
+#if DILIGENT_MATH_SIMD_SUPPORTED
+
+#    define DILIGENT_SHUFFLE_MASK(x, y, z, w) ((x) | ((y) << 2) | ((z) << 4) | ((w) << 6))
+// Returns (v1[x], v1[y], v2[z], v2[w])
+#    define DILIGENT_SHUFFLE(v1, v2, x, y, z, w) _mm_shuffle_ps(v1, v2, DILIGENT_SHUFFLE_MASK(x, y, z, w))
+// Returns (v[x], v[y], v[z], v[w])
+#    define DILIGENT_SWIZZLE(v, x, y, z, w) _mm_shuffle_ps(v, v, DILIGENT_SHUFFLE_MASK(x, y, z, w))
+
+/// Computes Out = M1 * M2
+inline void MulMatrix4x4(const float* pM1, const float* pM2, float* pOut) noexcept
+{
+    const __m128 Row0 = _mm_loadu_ps(pM2 + 0);
+    const __m128 Row1 = _mm_loadu_ps(pM2 + 4);
+    const __m128 Row2 = _mm_loadu_ps(pM2 + 8);
+    const __m128 Row3 = _mm_loadu_ps(pM2 + 12);
+    for (int i = 0; i < 4; ++i)
+    {
+        const float* pRow = pM1 + i * 4;
+
+        __m128 Res = _mm_mul_ps(_mm_set1_ps(pRow[0]), Row0);
+        Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(pRow[1]), Row1));
+        Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(pRow[2]), Row2));
+        Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(pRow[3]), Row3));
+        _mm_storeu_ps(pOut + i * 4, Res);
+    }
+}
+
+/// Computes Out = V * M
+inline void MulVector4Matrix4x4(const float* pV, const float* pM, float* pOut) noexcept
+{
+    __m128 Res = _mm_mul_ps(_mm_set1_ps(pV[0]), _mm_loadu_ps(pM + 0));
+    Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(pV[1]), _mm_loadu_ps(pM + 4)));
+    Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(pV[2]), _mm_loadu_ps(pM + 8)));
+    Res        = _mm_add_ps(Res, _mm_mul_ps(_mm_set1_ps(pV[3]), _mm_loadu_ps(pM + 12)));
+    _mm_storeu_ps(pOut, Res);
+}
+
+/// Computes Out = transpose(M)
+inline void TransposeMatrix4x4(const float* pM, float* pOut) noexcept
+{
+    __m128 Row0 = _mm_loadu_ps(pM + 0);
+    __m128 Row1 = _mm_loadu_ps(pM + 4);
+    __m128 Row2 = _mm_loadu_ps(pM + 8);
+    __m128 Row3 = _mm_loadu_ps(pM + 12);
+    _MM_TRANSPOSE4_PS(Row0, Row1, Row2, Row3);
+    _mm_storeu_ps(pOut + 0, Row0);
+    _mm_storeu_ps(pOut + 4, Row1);
+    _mm_storeu_ps(pOut + 8, Row2);
+    _mm_storeu_ps(pOut + 12, Row3);
+}
+
+// 2x2 row-major matrix operations on (m00, m01, m10, m11) vectors
+
+// Returns A * B
+inline __m128 Mat2Mul(__m128 A, __m128 B) noexcept
+{
+    return _mm_add_ps(_mm_mul_ps(A, DILIGENT_SWIZZLE(B, 0, 3, 0, 3)),
+                      _mm_mul_ps(DILIGENT_SWIZZLE(A, 1, 0, 3, 2), DILIGENT_SWIZZLE(B, 2, 1, 2, 1)));
+}
+
+// Returns adj(A) * B
+inline __m128 Mat2AdjMul(__m128 A, __m128 B) noexcept
+{
+    return _mm_sub_ps(_mm_mul_ps(DILIGENT_SWIZZLE(A, 3, 3, 0, 0), B),
+                      _mm_mul_ps(DILIGENT_SWIZZLE(A, 1, 1, 2, 2), DILIGENT_SWIZZLE(B, 2, 3, 0, 1)));
+}
+
+// Returns A * adj(B)
+inline __m128 Mat2MulAdj(__m128 A, __m128 B) noexcept
+{
+    return _mm_sub_ps(_mm_mul_ps(A, DILIGENT_SWIZZLE(B, 3, 0, 3, 0)),
+                      _mm_mul_ps(DILIGENT_SWIZZLE(A, 1, 0, 3, 2), DILIGENT_SWIZZLE(B, 2, 1, 2, 1)));
+}
+
+/// Computes Out = inverse(M) using the block-wise inversion with 2x2 sub-matrices.
+///
+/// \note   Similar to the scalar implementation, the function does not check if the matrix
+///         is invertible, and the result contains infinities or NaNs if it is not.
+inline void InverseMatrix4x4(const float* pM, float* pOut) noexcept
+{
+    const __m128 Row0 = _mm_loadu_ps(pM + 0);
+    const __m128 Row1 = _mm_loadu_ps(pM + 4);
+    const __m128 Row2 = _mm_loadu_ps(pM + 8);
+    const __m128 Row3 = _mm_loadu_ps(pM + 12);
+
+    // M = | A B |
+    //     | C D |
+    const __m128 A = _mm_movelh_ps(Row0, Row1);
+    const __m128 B = _mm_movehl_ps(Row1, Row0);
+    const __m128 C = _mm_movelh_ps(Row2, Row3);
+    const __m128 D = _mm_movehl_ps(Row3, Row2);
+
+    // (|A|, |B|, |C|, |D|)
+    const __m128 DetSub = _mm_sub_ps(_mm_mul_ps(DILIGENT_SHUFFLE(Row0, Row2, 0, 2, 0, 2), DILIGENT_SHUFFLE(Row1, Row3, 1, 3, 1, 3)),
+                                     _mm_mul_ps(DILIGENT_SHUFFLE(Row0, Row2, 1, 3, 1, 3), DILIGENT_SHUFFLE(Row1, Row3, 0, 2, 0, 2)));
+
+    const __m128 DetA = DILIGENT_SWIZZLE(DetSub, 0, 0, 0, 0);
+    const __m128 DetB = DILIGENT_SWIZZLE(DetSub, 1, 1, 1, 1);
+    const __m128 DetC = DILIGENT_SWIZZLE(DetSub, 2, 2, 2, 2);
+    const __m128 DetD = DILIGENT_SWIZZLE(DetSub, 3, 3, 3, 3);
+
+    const __m128 D_C = Mat2AdjMul(D, C);
+    const __m128 A_B = Mat2AdjMul(A, B);
+
+    // X# = |D|A - B(D#C)
+    __m128 X = _mm_sub_ps(_mm_mul_ps(DetD, A), Mat2Mul(B, D_C));
+    // W# = |A|D - C(A#B)
+    __m128 W = _mm_sub_ps(_mm_mul_ps(DetA, D), Mat2Mul(C, A_B));
+    // Y# = |B|C - D(A#B)#
+    __m128 Y = _mm_sub_ps(_mm_mul_ps(DetB, C), Mat2MulAdj(D, A_B));
+    // Z# = |C|B - A(D#C)#
+    __m128 Z = _mm_sub_ps(_mm_mul_ps(DetC, B), Mat2MulAdj(A, D_C));
+
+    // |M| = |A|*|D| + |B|*|C| - tr((A#B)(D#C))
+    __m128 Tr = _mm_mul_ps(A_B, DILIGENT_SWIZZLE(D_C, 0, 2, 1, 3));
+    Tr        = _mm_add_ps(Tr, DILIGENT_SWIZZLE(Tr, 2, 3, 0, 1));
+    Tr        = _mm_add_ps(Tr, DILIGENT_SWIZZLE(Tr, 1, 0, 3, 2));
+
+    const __m128 DetM = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(DetA, DetD), _mm_mul_ps(DetB, DetC)), Tr);
+
+    // (1/|M|, -1/|M|, -1/|M|, 1/|M|)
+    const __m128 RcpDetM = _mm_div_ps(_mm_setr_ps(1.f, -1.f, -1.f, 1.f), DetM);
+
+    X = _mm_mul_ps(X, RcpDetM);
+    Y = _mm_mul_ps(Y, RcpDetM);
+    Z = _mm_mul_ps(Z, RcpDetM);
+    W = _mm_mul_ps(W, RcpDetM);
+
+    // Apply the adjugate and store the result
+    _mm_storeu_ps(pOut + 0, DILIGENT_SHUFFLE(X, Y, 3, 1, 3, 1));
+    _mm_storeu_ps(pOut + 4, DILIGENT_SHUFFLE(X, Y, 2, 0, 2, 0));
+    _mm_storeu_ps(pOut + 8, DILIGENT_SHUFFLE(Z, W, 3, 1, 3, 1));
+    _mm_storeu_ps(pOut + 12, DILIGENT_SHUFFLE(Z, W, 2, 0, 2, 0));
+}
+
+/// Transforms an array of 3-component points or vectors by the matrix.
+///
+/// \param [in]  pSrc        - Source vectors, 3 floats per vector.
+/// \param [out] pDst        - Destination vectors, 3 floats per vector. May be equal to pSrc.
+/// \param [in]  Count       - Number of vectors.
+/// \param [in]  pM          - Row-major 4x4 matrix.
+/// \param [in]  IsPoint     - Whether the vectors are points (w = 1) or directions (w = 0).
+/// \param [in]  DivideByW   - Whether to divide the result by w.
+///
+/// \return     The number of processed vectors, which is a multiple of 4.
+///             The remaining vectors must be processed by the caller.
+inline size_t TransformFloat3Array(const float* pSrc, float* pDst, size_t Count, const float* pM, bool IsPoint, bool DivideByW) noexcept
+{
+    const __m128 m00 = _mm_set1_ps(pM[0]);
+    const __m128 m01 = _mm_set1_ps(pM[1]);
+    const __m128 m02 = _mm_set1_ps(pM[2]);
+    const __m128 m03 = _mm_set1_ps(pM[3]);
+    const __m128 m10 = _mm_set1_ps(pM[4]);
+    const __m128 m11 = _mm_set1_ps(pM[5]);
+    const __m128 m12 = _mm_set1_ps(pM[6]);
+    const __m128 m13 = _mm_set1_ps(pM[7]);
+    const __m128 m20 = _mm_set1_ps(pM[8]);
+    const __m128 m21 = _mm_set1_ps(pM[9]);
+    const __m128 m22 = _mm_set1_ps(pM[10]);
+    const __m128 m23 = _mm_set1_ps(pM[11]);
+    const __m128 m30 = _mm_set1_ps(pM[12]);
+    const __m128 m31 = _mm_set1_ps(pM[13]);
+    const __m128 m32 = _mm_set1_ps(pM[14]);
+    const __m128 m33 = _mm_set1_ps(pM[15]);
+
+    const size_t NumProcessed = Count & ~size_t{3};
+    for (size_t i = 0; i < NumProcessed; i += 4, pSrc += 12, pDst += 12)
+    {
+        // Load four vectors:
+        //   V0 = (x0, y0, z0, x1)
+        //   V1 = (y1, z1, x2, y2)
+        //   V2 = (z2, x3, y3, z3)
+        const __m128 V0 = _mm_loadu_ps(pSrc + 0);
+        const __m128 V1 = _mm_loadu_ps(pSrc + 4);
+        const __m128 V2 = _mm_loadu_ps(pSrc + 8);
+
+        // Convert to SoA
+        const __m128 X = DILIGENT_SHUFFLE(V0, DILIGENT_SHUFFLE(V1, V2, 2, 2, 1, 1), 0, 3, 0, 2);
+        const __m128 Y = DILIGENT_SHUFFLE(DILIGENT_SHUFFLE(V0, V1, 1, 1, 0, 0), DILIGENT_SHUFFLE(V1, V2, 3, 3, 2, 2), 0, 2, 0, 2);
+        const __m128 Z = DILIGENT_SHUFFLE(DILIGENT_SHUFFLE(V0, V1, 2, 2, 1, 1), DILIGENT_SHUFFLE(V2, V2, 0, 0, 3, 3), 0, 2, 0, 2);
+
+        // Use the same order of operations as the scalar implementation
+        __m128 OutX = _mm_add_ps(_mm_add_ps(_mm_mul_ps(X, m00), _mm_mul_ps(Y, m10)), _mm_mul_ps(Z, m20));
+        __m128 OutY = _mm_add_ps(_mm_add_ps(_mm_mul_ps(X, m01), _mm_mul_ps(Y, m11)), _mm_mul_ps(Z, m21));
+        __m128 OutZ = _mm_add_ps(_mm_add_ps(_mm_mul_ps(X, m02), _mm_mul_ps(Y, m12)), _mm_mul_ps(Z, m22));
+        if (IsPoint)
+        {
+            OutX = _mm_add_ps(OutX, m30);
+            OutY = _mm_add_ps(OutY, m31);
+            OutZ = _mm_add_ps(OutZ, m32);
+        }
+        if (DivideByW)
+        {
+            __m128 OutW = _mm_add_ps(_mm_add_ps(_mm_mul_ps(X, m03), _mm_mul_ps(Y, m13)), _mm_mul_ps(Z, m23));
+            if (IsPoint)
+                OutW = _mm_add_ps(OutW, m33);
+            OutX = _mm_div_ps(OutX, OutW);
+            OutY = _mm_div_ps(OutY, OutW);
+            OutZ = _mm_div_ps(OutZ, OutW);
+        }
+
+        // Convert back to AoS
+        _mm_storeu_ps(pDst + 0, DILIGENT_SHUFFLE(DILIGENT_SHUFFLE(OutX, OutY, 0, 0, 0, 0), DILIGENT_SHUFFLE(OutZ, OutX, 0, 0, 1, 1), 0, 2, 0, 2));
+        _mm_storeu_ps(pDst + 4, DILIGENT_SHUFFLE(DILIGENT_SHUFFLE(OutY, OutZ, 1, 1, 1, 1), DILIGENT_SHUFFLE(OutX, OutY, 2, 2, 2, 2), 0, 2, 0, 2));
+        _mm_storeu_ps(pDst + 8, DILIGENT_SHUFFLE(DILIGENT_SHUFFLE(OutZ, OutX, 2, 2, 3, 3), DILIGENT_SHUFFLE(OutY, OutZ, 3, 3, 3, 3), 0, 2, 0, 2));
+    }
+
+    return NumProcessed;
+}
+
+#    undef DILIGENT_SWIZZLE
+#    undef DILIGENT_SHUFFLE
+#    undef DILIGENT_SHUFFLE_MASK
+
+#endif // DILIGENT_MATH_SIMD_SUPPORTED
+
+
+// Dispatch functions used by the BasicMath types. The generic versions make the code compile
+// for non-float types and are never called when SIMD is enabled.
+
+template <typename T>
+bool TryMulMatrix4x4(const T*, const T*, T*) noexcept
+{
+    return false;
+}
+
+template <typename T>
+bool TryMulVector4Matrix4x4(const T*, const T*, T*) noexcept
+{
+    return false;
+}
+
+template <typename T>
+bool TryTransposeMatrix4x4(const T*, T*) noexcept
+{
+    return false;
+}
+
+template <typename T>
+bool TryInverseMatrix4x4(const T*, T*) noexcept
+{
+    return false;
+}
+
+#if DILIGENT_MATH_SIMD_ENABLED
+
+inline bool TryMulMatrix4x4(const float* pM1, const float* pM2, float* pOut) noexcept
+{
+    MulMatrix4x4(pM1, pM2, pOut);
+    return true;
+}
+
+inline bool TryMulVector4Matrix4x4(const float* pV, const float* pM, float* pOut) noexcept
+{
+    MulVector4Matrix4x4(pV, pM, pOut);
+    return true;
+}
+
+inline bool TryTransposeMatrix4x4(const float* pM, float* pOut) noexcept
+{
+    TransposeMatrix4x4(pM, pOut);
+    return true;
+}
+
+inline bool TryInverseMatrix4x4(const float* pM, float* pOut) noexcept
+{
+    InverseMatrix4x4(pM, pOut);
+    return true;
+}
+
+#endif // DILIGENT_MATH_SIMD_ENABLED
+
+} // namespace MathSIMD
+
+} // namespace Diligent
@@ -0,0 +1,79 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Lossless compression of independent memory blocks.
+///
+/// Blocks are encoded with a fast LZ77 compressor that produces the LZ4 block format
+/// (sequences of literals followed by a back-reference within the 64 KB window).
+/// Every block is self-contained, so blocks can be decompressed independently and
+/// in any order. The block format does not store the size of the uncompressed data,
+/// which must be kept by the caller.
+
+#include <cstddef>
+
+namespace Diligent
+{
+
+/// Returns the maximum size of the compressed data for the source block of the given size.
+
+/// \remarks    The compressed data is never larger than the returned value,
+///             even if the source data is not compressible.
+size_t GetCompressedBlockBound(size_t SrcSize);
+
+/// Compresses a memory block.
+
+/// \param[in]  pSrc    - A pointer to the source data.
+/// \param[in]  SrcSize - Source data size, in bytes.
+/// \param[out] pDst    - A pointer to the memory where the compressed data will be written.
+/// \param[in]  DstSize - Size of the destination memory, in bytes.
+///
+/// \return     The size of the compressed data, or zero if the compressed data
+///             does not fit into the destination memory.
+///
+/// \remarks    The destination memory that is at least GetCompressedBlockBound(SrcSize)
+///             bytes large is always sufficient. Passing a smaller size allows
+///             aborting the compression early when the data is not compressible enough.
+size_t CompressBlock(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize);
+
+/// Decompresses a memory block that was compressed by CompressBlock().
+
+/// \param[in]  pSrc    - A pointer to the compressed data.
+/// \param[in]  SrcSize - Compressed data size, in bytes.
+/// \param[out] pDst    - A pointer to the memory where the decompressed data will be written.
+/// \param[in]  DstSize - The size of the decompressed data, in bytes.
+///
+/// \return     true if the block was successfully decompressed and the size
+///             of the decompressed data is exactly DstSize, and false otherwise.
+///
+/// \remarks    The function validates the compressed data and never reads or writes
+///             outside of the source and destination memory, so it is safe to use
+///             with untrusted data.
+bool DecompressBlock(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize);
+
+} // namespace Diligent
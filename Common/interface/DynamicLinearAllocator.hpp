@@ -84,6 +84,23 @@ public:
         }
     }
 
+    /// Releases the most recently created blocks until the total size of the
+    /// remaining blocks does not exceed MaxSize. The released blocks must not
+    /// contain any live allocations, so this is typically called after Discard().
+    void Trim(size_t MaxSize)
+    {
+        size_t TotalSize = 0;
+        for (const auto& block : m_Blocks)
+            TotalSize += block.Size;
+
+        while (!m_Blocks.empty() && TotalSize > MaxSize)
+        {
+            TotalSize -= m_Blocks.back().Size;
+            m_pAllocator->Free(m_Blocks.back().Data);
+            m_Blocks.pop_back();
+        }
+    }
+
     NODISCARD void* Allocate(size_t size, size_t align)
     {
         if (size == 0)
@@ -27,6 +27,9 @@
 
 #pragma once
 
+#include <vector>
+#include <type_traits>
+
 #include "../../Platforms/interface/PlatformDefinitions.h"
 
 #include "BasicMath.hpp"
@@ -245,4 +248,377 @@ DstType FilterTexture2DBilinearClampUC(Uint32         Width,
     return FilterTexture2DBilinear<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP, false>(Width, Height, pData, Stride, u, v);
 }
 
+
+#if DILIGENT_MATH_SIMD_SUPPORTED
+// Remaps integer texel coordinates stored as floats according to the address mode.
+// All values must be in (-2^23, 2^23), so that all operations are exact.
+template <TEXTURE_ADDRESS_MODE AddressMode>
+__m128 _WrapTexCoordsSIMD(__m128 i, Uint32 Width)
+{
+    const __m128 w = _mm_set1_ps(static_cast<float>(Width));
+
+    auto WrapCoords = [](__m128 i, __m128 w) //
+    {
+        // r = i - floor(i / w) * w
+        const __m128 q  = _mm_div_ps(i, w);
+        __m128       fq = _mm_cvtepi32_ps(_mm_cvttps_epi32(q));
+        fq              = _mm_sub_ps(fq, _mm_and_ps(_mm_cmpgt_ps(fq, q), _mm_set1_ps(1.f)));
+        __m128 r        = _mm_sub_ps(i, _mm_mul_ps(fq, w));
+        // The division may be rounded up or down, so fix the result if it is off by one period
+        r = _mm_add_ps(r, _mm_and_ps(_mm_cmplt_ps(r, _mm_setzero_ps()), w));
+        r = _mm_sub_ps(r, _mm_and_ps(_mm_cmpge_ps(r, w), w));
+        return r;
+    };
+
+    switch (AddressMode)
+    {
+        case TEXTURE_ADDRESS_WRAP:
+            return WrapCoords(i, w);
+
+        case TEXTURE_ADDRESS_MIRROR:
+        {
+            const __m128 w2 = _mm_add_ps(w, w);
+            const __m128 r  = WrapCoords(i, w2);
+            // r >= w ? (w * 2 - 1) - r : r
+            const __m128 m = _mm_sub_ps(_mm_sub_ps(w2, _mm_set1_ps(1.f)), r);
+            const __m128 c = _mm_cmpge_ps(r, w);
+            return _mm_or_ps(_mm_and_ps(c, m), _mm_andnot_ps(c, r));
+        }
+
+        case TEXTURE_ADDRESS_CLAMP:
+            return _mm_min_ps(_mm_max_ps(i, _mm_setzero_ps()), _mm_sub_ps(w, _mm_set1_ps(1.f)));
+
+        default:
+            return i;
+    }
+}
+
+// Returns Left * (1 - w) + Right * w, which matches the scalar lerp().
+inline __m128 _LerpSIMD(__m128 Left, __m128 Right, __m128 w)
+{
+    return _mm_add_ps(_mm_mul_ps(Left, _mm_sub_ps(_mm_set1_ps(1.f), w)), _mm_mul_ps(Right, w));
+}
+
+template <typename SrcType>
+__m128 _GatherFloat4(const SrcType* pData, size_t Offset0, size_t Offset1, size_t Offset2, size_t Offset3)
+{
+    return _mm_set_ps(static_cast<float>(pData[Offset3]),
+                      static_cast<float>(pData[Offset2]),
+                      static_cast<float>(pData[Offset1]),
+                      static_cast<float>(pData[Offset0]));
+}
+#endif
+
+/// Computes linear texture filter sample infos for an array of coordinates,
+/// see Diligent::GetLinearTexFilterSampleInfo.
+///
+/// \tparam AddressMode       - Texture addressing mode, see Diligent::TEXTURE_ADDRESS_MODE.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width        - Texture width.
+/// \param [in]  pCoords      - Pointer to the array of NumCoords texture sample coordinates.
+/// \param [in]  NumCoords    - The number of coordinates.
+/// \param [out] pI0          - Pointer to the array that receives the first sample indices.
+/// \param [out] pI1          - Pointer to the array that receives the second sample indices.
+/// \param [out] pW           - Pointer to the array that receives the blend weights.
+///
+/// \remarks    The results are structure-of-arrays and are identical to the results of
+///             GetLinearTexFilterSampleInfo for every coordinate. Groups of four coordinates
+///             are processed with SIMD instructions when they are supported by the target.
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void GetLinearTexFilterSampleInfos(Uint32       Width,
+                                   const float* pCoords,
+                                   size_t       NumCoords,
+                                   Int32*       pI0,
+                                   Int32*       pI1,
+                                   float*       pW)
+{
+    auto GetSampleInfo = [&](size_t i) //
+    {
+        const auto SampleInfo = GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, pCoords[i]);
+
+        pI0[i] = SampleInfo.i0;
+        pI1[i] = SampleInfo.i1;
+        pW[i]  = SampleInfo.w;
+    };
+
+    size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    if (AddressMode == TEXTURE_ADDRESS_UNKNOWN ||
+        AddressMode == TEXTURE_ADDRESS_WRAP ||
+        AddressMode == TEXTURE_ADDRESS_MIRROR ||
+        AddressMode == TEXTURE_ADDRESS_CLAMP)
+    {
+        const __m128 Scale   = _mm_set1_ps(static_cast<float>(Width));
+        const __m128 Half    = _mm_set1_ps(0.5f);
+        const __m128 One     = _mm_set1_ps(1.f);
+        const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        // Floats at or above 2^23 have no fractional part
+        const __m128 NoFracThreshold = _mm_set1_ps(8388608.f);
+        for (; i + 4 <= NumCoords; i += 4)
+        {
+            __m128 x = _mm_loadu_ps(pCoords + i);
+            if (IsNormalizedCoord)
+                x = _mm_mul_ps(x, Scale);
+            const __m128 t = _mm_sub_ps(x, Half);
+
+            // Use the scalar path for huge and invalid coordinates
+            if (_mm_movemask_ps(_mm_cmplt_ps(_mm_and_ps(t, AbsMask), NoFracThreshold)) != 0xF)
+            {
+                for (size_t j = i; j < i + 4; ++j)
+                    GetSampleInfo(j);
+                continue;
+            }
+
+            __m128 x0 = _mm_cvtepi32_ps(_mm_cvttps_epi32(t));
+            x0        = _mm_sub_ps(x0, _mm_and_ps(_mm_cmpgt_ps(x0, t), One));
+            _mm_storeu_ps(pW + i, _mm_sub_ps(t, x0));
+
+            const __m128 x1 = _mm_add_ps(x0, One);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pI0 + i), _mm_cvttps_epi32(_WrapTexCoordsSIMD<AddressMode>(x0, Width)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(pI1 + i), _mm_cvttps_epi32(_WrapTexCoordsSIMD<AddressMode>(x1, Width)));
+        }
+    }
+#endif
+
+    for (; i < NumCoords; ++i)
+        GetSampleInfo(i);
+}
+
+/// Samples 2D texture at multiple locations using bilinear filter.
+///
+/// \tparam SrcType           - Source pixel type.
+/// \tparam DstType           - Destination type.
+/// \tparam AddressModeU      - U coordinate address mode.
+/// \tparam AddressModeV      - V coordinate address mode.
+/// \tparam IsNormalizedCoord - Whether sample coordinates are normalized.
+///
+/// \param [in]  Width        - Texture width.
+/// \param [in]  Height       - Texture height.
+/// \param [in]  pData        - Pointer to the texture data.
+/// \param [in]  Stride       - Data stride, in pixels.
+/// \param [in]  pU           - Pointer to the array of NumSamples u coordinates.
+/// \param [in]  pV           - Pointer to the array of NumSamples v coordinates.
+/// \param [in]  NumSamples   - The number of samples.
+/// \param [out] pDst         - Pointer to the array that receives NumSamples filtered texture samples.
+///
+/// \remarks    The results are identical to the results of the single-sample version of
+///             FilterTexture2DBilinear. Sample infos are computed for a batch of samples at a time,
+///             and when DstType is float, four samples are interpolated at once using SIMD instructions.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV,
+          bool                 IsNormalizedCoord>
+void FilterTexture2DBilinear(Uint32         Width,
+                             Uint32         Height,
+                             const SrcType* pData,
+                             size_t         Stride,
+                             const float*   pU,
+                             const float*   pV,
+                             size_t         NumSamples,
+                             DstType*       pDst)
+{
+    constexpr size_t BatchSize = 64;
+
+    Int32 UI0[BatchSize], UI1[BatchSize];
+    Int32 VI0[BatchSize], VI1[BatchSize];
+    float UW[BatchSize], VW[BatchSize];
+    for (size_t BatchStart = 0; BatchStart < NumSamples; BatchStart += BatchSize)
+    {
+        const size_t Count = std::min(BatchSize, NumSamples - BatchStart);
+        GetLinearTexFilterSampleInfos<AddressModeU, IsNormalizedCoord>(Width, pU + BatchStart, Count, UI0, UI1, UW);
+        GetLinearTexFilterSampleInfos<AddressModeV, IsNormalizedCoord>(Height, pV + BatchStart, Count, VI0, VI1, VW);
+
+#ifdef DILIGENT_DEBUG
+        for (size_t i = 0; i < Count; ++i)
+        {
+            _DbgVerifyFilterInfo<AddressModeU>(LinearTexFilterSampleInfo{UI0[i], UI1[i], UW[i]}, Width, "horizontal", pU[BatchStart + i]);
+            _DbgVerifyFilterInfo<AddressModeV>(LinearTexFilterSampleInfo{VI0[i], VI1[i], VW[i]}, Height, "vertical", pV[BatchStart + i]);
+        }
+#endif
+
+        DstType* pBatchDst = pDst + BatchStart;
+
+        size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+        if (std::is_same<DstType, float>::value)
+        {
+            for (; i + 4 <= Count; i += 4)
+            {
+                size_t Row0[4], Row1[4];
+                for (size_t j = 0; j < 4; ++j)
+                {
+                    Row0[j] = VI0[i + j] * Stride;
+                    Row1[j] = VI1[i + j] * Stride;
+                }
+
+                const __m128 S00 = _GatherFloat4(pData, UI0[i + 0] + Row0[0], UI0[i + 1] + Row0[1], UI0[i + 2] + Row0[2], UI0[i + 3] + Row0[3]);
+                const __m128 S10 = _GatherFloat4(pData, UI1[i + 0] + Row0[0], UI1[i + 1] + Row0[1], UI1[i + 2] + Row0[2], UI1[i + 3] + Row0[3]);
+                const __m128 S01 = _GatherFloat4(pData, UI0[i + 0] + Row1[0], UI0[i + 1] + Row1[1], UI0[i + 2] + Row1[2], UI0[i + 3] + Row1[3]);
+                const __m128 S11 = _GatherFloat4(pData, UI1[i + 0] + Row1[0], UI1[i + 1] + Row1[1], UI1[i + 2] + Row1[2], UI1[i + 3] + Row1[3]);
+
+                const __m128 wu = _mm_loadu_ps(UW + i);
+                const __m128 wv = _mm_loadu_ps(VW + i);
+                _mm_storeu_ps(reinterpret_cast<float*>(pBatchDst + i), _LerpSIMD(_LerpSIMD(S00, S10, wu), _LerpSIMD(S01, S11, wu), wv));
+            }
+        }
+#endif
+
+        for (; i < Count; ++i)
+        {
+            auto S00 = static_cast<DstType>(pData[UI0[i] + VI0[i] * Stride]);
+            auto S10 = static_cast<DstType>(pData[UI1[i] + VI0[i] * Stride]);
+            auto S01 = static_cast<DstType>(pData[UI0[i] + VI1[i] * Stride]);
+            auto S11 = static_cast<DstType>(pData[UI1[i] + VI1[i] * Stride]);
+            pBatchDst[i] = lerp(lerp(S00, S10, UW[i]), lerp(S01, S11, UW[i]), VW[i]);
+        }
+    }
+}
+
+/// Resamples a region of 2D texture to a new resolution using bilinear filter.
+///
+/// \tparam SrcType           - Source pixel type.
+/// \tparam DstType           - Destination pixel type.
+/// \tparam AddressModeU      - U coordinate address mode.
+/// \tparam AddressModeV      - V coordinate address mode.
+///
+/// \param [in]  SrcWidth     - Source texture width.
+/// \param [in]  SrcHeight    - Source texture height.
+/// \param [in]  pSrcData     - Pointer to the source texture data.
+/// \param [in]  SrcStride    - Source data stride, in pixels.
+/// \param [in]  DstWidth     - Destination width.
+/// \param [in]  DstHeight    - Destination height.
+/// \param [out] pDstData     - Pointer to the destination data.
+/// \param [in]  DstStride    - Destination data stride, in pixels.
+/// \param [in]  UVMin        - Normalized texture coordinates of the top-left corner of the source region.
+/// \param [in]  UVMax        - Normalized texture coordinates of the bottom-right corner of the source region.
+///
+/// \remarks    Destination pixel (x, y) is sampled at
+///
+///                 u = UVMin.x + (UVMax.x - UVMin.x) * ((x + 0.5) / DstWidth)
+///                 v = UVMin.y + (UVMax.y - UVMin.y) * ((y + 0.5) / DstHeight)
+///
+///             and the result is identical to the result of FilterTexture2DBilinear for these coordinates.
+///
+///             Sample infos are computed once for every destination column and row.
+///             Each source row is filtered horizontally only once and is reused by all destination rows
+///             that reference it, so that every destination row only requires a vertical blend of two
+///             cached rows. When DstType is float, both passes use SIMD instructions.
+template <typename SrcType,
+          typename DstType,
+          TEXTURE_ADDRESS_MODE AddressModeU,
+          TEXTURE_ADDRESS_MODE AddressModeV>
+void ResampleTexture2DBilinear(Uint32         SrcWidth,
+                               Uint32         SrcHeight,
+                               const SrcType* pSrcData,
+                               size_t         SrcStride,
+                               Uint32         DstWidth,
+                               Uint32         DstHeight,
+                               DstType*       pDstData,
+                               size_t         DstStride,
+                               const float2&  UVMin = float2{0, 0},
+                               const float2&  UVMax = float2{1, 1})
+{
+    if (DstWidth == 0 || DstHeight == 0)
+        return;
+
+    std::vector<float> Coords(std::max(DstWidth, DstHeight));
+
+    std::vector<Int32> ColI0(DstWidth), ColI1(DstWidth);
+    std::vector<float> ColW(DstWidth);
+    for (Uint32 x = 0; x < DstWidth; ++x)
+        Coords[x] = UVMin.x + (UVMax.x - UVMin.x) * ((static_cast<float>(x) + 0.5f) / static_cast<float>(DstWidth));
+    GetLinearTexFilterSampleInfos<AddressModeU, true>(SrcWidth, Coords.data(), DstWidth, ColI0.data(), ColI1.data(), ColW.data());
+#ifdef DILIGENT_DEBUG
+    for (Uint32 x = 0; x < DstWidth; ++x)
+        _DbgVerifyFilterInfo<AddressModeU>(LinearTexFilterSampleInfo{ColI0[x], ColI1[x], ColW[x]}, SrcWidth, "horizontal", Coords[x]);
+#endif
+
+    std::vector<Int32> RowI0(DstHeight), RowI1(DstHeight);
+    std::vector<float> RowW(DstHeight);
+    for (Uint32 y = 0; y < DstHeight; ++y)
+        Coords[y] = UVMin.y + (UVMax.y - UVMin.y) * ((static_cast<float>(y) + 0.5f) / static_cast<float>(DstHeight));
+    GetLinearTexFilterSampleInfos<AddressModeV, true>(SrcHeight, Coords.data(), DstHeight, RowI0.data(), RowI1.data(), RowW.data());
+#ifdef DILIGENT_DEBUG
+    for (Uint32 y = 0; y < DstHeight; ++y)
+        _DbgVerifyFilterInfo<AddressModeV>(LinearTexFilterSampleInfo{RowI0[y], RowI1[y], RowW[y]}, SrcHeight, "vertical", Coords[y]);
+#endif
+
+    // Horizontally filtered source rows
+    std::vector<DstType> FilteredRows[2] = {std::vector<DstType>(DstWidth), std::vector<DstType>(DstWidth)};
+    Int32                CachedRows[2]   = {-1, -1};
+
+    auto FilterRow = [&](Int32 Row, Int32 RowToKeep) -> const DstType* //
+    {
+        for (size_t s = 0; s < 2; ++s)
+        {
+            if (CachedRows[s] == Row)
+                return FilteredRows[s].data();
+        }
+
+        const size_t   Slot = CachedRows[0] == RowToKeep ? 1 : 0;
+        const SrcType* pSrc = pSrcData + Row * SrcStride;
+        DstType*       pDst = FilteredRows[Slot].data();
+
+        Uint32 x = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+        if (std::is_same<DstType, float>::value)
+        {
+            for (; x + 4 <= DstWidth; x += 4)
+            {
+                const __m128 S0 = _GatherFloat4(pSrc, ColI0[x + 0], ColI0[x + 1], ColI0[x + 2], ColI0[x + 3]);
+                const __m128 S1 = _GatherFloat4(pSrc, ColI1[x + 0], ColI1[x + 1], ColI1[x + 2], ColI1[x + 3]);
+                _mm_storeu_ps(reinterpret_cast<float*>(pDst + x), _LerpSIMD(S0, S1, _mm_loadu_ps(&ColW[x])));
+            }
+        }
+#endif
+        for (; x < DstWidth; ++x)
+            pDst[x] = lerp(static_cast<DstType>(pSrc[ColI0[x]]), static_cast<DstType>(pSrc[ColI1[x]]), ColW[x]);
+
+        CachedRows[Slot] = Row;
+        return pDst;
+    };
+
+    for (Uint32 y = 0; y < DstHeight; ++y)
+    {
+        const DstType* pRow0 = FilterRow(RowI0[y], RowI1[y]);
+        const DstType* pRow1 = FilterRow(RowI1[y], RowI0[y]);
+        DstType*       pDst  = pDstData + y * DstStride;
+
+        Uint32 x = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+        if (std::is_same<DstType, float>::value)
+        {
+            const __m128 wv = _mm_set1_ps(RowW[y]);
+            for (; x + 4 <= DstWidth; x += 4)
+            {
+                const __m128 S0 = _mm_loadu_ps(reinterpret_cast<const float*>(pRow0 + x));
+                const __m128 S1 = _mm_loadu_ps(reinterpret_cast<const float*>(pRow1 + x));
+                _mm_storeu_ps(reinterpret_cast<float*>(pDst + x), _LerpSIMD(S0, S1, wv));
+            }
+        }
+#endif
+        for (; x < DstWidth; ++x)
+            pDst[x] = lerp(pRow0[x], pRow1[x], RowW[y]);
+    }
+}
+
+/// Specialization of ResampleTexture2DBilinear function that uses CLAMP texture address mode.
+template <typename SrcType, typename DstType>
+void ResampleTexture2DBilinearClamp(Uint32         SrcWidth,
+                                    Uint32         SrcHeight,
+                                    const SrcType* pSrcData,
+                                    size_t         SrcStride,
+                                    Uint32         DstWidth,
+                                    Uint32         DstHeight,
+                                    DstType*       pDstData,
+                                    size_t         DstStride,
+                                    const float2&  UVMin = float2{0, 0},
+                                    const float2&  UVMax = float2{1, 1})
+{
+    ResampleTexture2DBilinear<SrcType, DstType, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP>(
+        SrcWidth, SrcHeight, pSrcData, SrcStride, DstWidth, DstHeight, pDstData, DstStride, UVMin, UVMax);
+}
+
 } // namespace Diligent
@@ -44,10 +44,21 @@ namespace Diligent
 {
 
 /// Memory allocator that allocates memory in a fixed-size chunks
+
+/// \remarks   When thread cache is enabled, every thread allocates blocks from and releases
+///            blocks to its own small cache (magazine) without taking any locks.
+///            Blocks are moved between thread caches and shared memory pages in batches.
+///            A block may be released by any thread, not necessarily the one that allocated it.
+///            When a thread exits, its cache is handed over to the next thread that starts
+///            using the allocator. Threads that exceed the maximum number of thread caches
+///            use the shared pages directly.
 class FixedBlockMemoryAllocator final : public IMemoryAllocator
 {
 public:
-    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator, size_t BlockSize, Uint32 NumBlocksInPage);
+    FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
+                              size_t            BlockSize,
+                              Uint32            NumBlocksInPage,
+                              bool              EnableThreadCache = false);
     ~FixedBlockMemoryAllocator();
 
     /// Allocates block of memory
@@ -66,6 +77,29 @@ private:
 
     void CreateNewPage();
 
+    // Allocates a block from the memory pages. m_Mutex must be locked.
+    void* AllocateFromPages();
+    // Returns the block to its memory page. m_Mutex must be locked.
+    void FreeToPages(void* Ptr);
+
+    // The maximum number of simultaneously running threads that have their own caches.
+    static constexpr Uint32 MaxThreadCaches = 64;
+    // The number of blocks moved between the thread cache and memory pages at once
+    static constexpr Uint32 ThreadCacheBatchSize = 16;
+
+    // Every cache is only accessed by the thread that owns the cache slot, so it needs no lock.
+    struct ThreadCache
+    {
+        void* pRawMem = nullptr;
+
+        Uint32 NumBlocks = 0;
+        void*  Blocks[ThreadCacheBatchSize * 2];
+    };
+    // Returns the cache slot of the calling thread, or ~0u if all slots are taken.
+    static Uint32 GetThreadSlot();
+    // Returns the cache of the calling thread, or null if the thread has no cache slot.
+    ThreadCache* GetThreadCache();
+
     // Memory page class is based on the fixed-size memory pool described in "Fast Efficient Fixed-Size Memory Pool"
     // by Ben Kenwright
     class MemoryPage
@@ -116,6 +150,9 @@ private:
     IMemoryAllocator& m_RawMemoryAllocator;
     const size_t      m_BlockSize;
     const Uint32      m_NumBlocksInPage;
+
+    // Caches indexed by the thread slot, created when the slot is used for the first time
+    ThreadCache** m_ThreadCaches = nullptr;
 };
 
 IMemoryAllocator& GetRawAllocator();
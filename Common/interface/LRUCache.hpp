@@ -24,7 +24,10 @@
 #include <algorithm>
 #include <atomic>
 #include <vector>
+#include <list>
+#include <shared_mutex>
 
+#include "../../../DiligentCore/Primitives/interface/BasicTypes.h"
 #include "../../../DiligentCore/Platforms/Basic/interface/DebugUtilities.hpp"
 
 namespace Diligent
@@ -349,4 +352,420 @@ private:
     std::atomic<size_t> m_MaxSize{0};
 };
 
+
+/// Eviction policy used by ShardedLRUCache.
+enum class LRUCacheEvictionPolicy
+{
+    /// Exact LRU: every hit moves the entry to the front of its shard's LRU list.
+    /// This requires an exclusive shard lock on every access.
+    Exact,
+
+    /// Approximate LRU (CLOCK): a hit only sets the entry's reference bit, so that
+    /// it only needs to take a shared shard lock. When the shard exceeds its budget,
+    /// the clock hand sweeps the entries, clearing the reference bits and evicting
+    /// the first entry whose bit is not set.
+    Clock
+};
+
+/// A thread-safe and exception-safe sharded LRU cache.
+///
+/// The cache has the same semantics as LRUCache, but the keys are distributed between
+/// a number of shards, each having its own lock, LRU list and a share of the total size budget.
+/// Accesses to keys in different shards never contend with each other.
+/// In LRUCacheEvictionPolicy::Clock mode, hits only take a shared lock,
+/// so that concurrent readers of the same shard do not serialize either.
+///
+/// Usage example:
+///
+///     ShardedLRUCache<std::string, CacheData> Cache{32768, 16, LRUCacheEvictionPolicy::Clock};
+///     auto Data = Cache.Get("DataKey",
+///                           [](CacheData& Data, size_t& Size) //
+///                           {
+///                               Data.pData = pData;
+///                               Size       = pData->GetSize();
+///                           });
+///
+/// \note   The size budget is split evenly between the shards, so the cache may start
+///         evicting entries before the total size reaches the maximum if the keys are
+///         not distributed evenly.
+template <typename KeyType, typename DataType, typename KeyHasher = std::hash<KeyType>>
+class ShardedLRUCache
+{
+public:
+    explicit ShardedLRUCache(size_t                 MaxSize   = 0,
+                             Uint32                 NumShards = 16,
+                             LRUCacheEvictionPolicy Policy    = LRUCacheEvictionPolicy::Exact) :
+        m_Policy{Policy}
+    {
+        VERIFY(NumShards > 0, "The number of shards must not be zero");
+        m_Shards.resize(std::max(NumShards, 1u));
+        for (auto& pShard : m_Shards)
+            pShard.reset(new Shard{});
+        SetMaxSize(MaxSize);
+    }
+
+    // clang-format off
+    ShardedLRUCache           (const ShardedLRUCache&)  = delete;
+    ShardedLRUCache           (      ShardedLRUCache&&) = delete;
+    ShardedLRUCache& operator=(const ShardedLRUCache&)  = delete;
+    ShardedLRUCache& operator=(      ShardedLRUCache&&) = delete;
+    // clang-format on
+
+    /// Finds the data in the cache and returns it. If the data is not found, it is atomically created
+    /// using the provided initializer.
+    ///
+    /// \param [in] Key      - The data key.
+    /// \param [in] InitData - Initializer function that is called if the data is not found in the cache.
+    ///
+    /// \return     Data with the specified key, either retrieved from the cache or initialized with
+    ///             the InitData function.
+    ///
+    /// \remarks    InitData function may throw in case of an error.
+    template <typename InitDataType>
+    DataType Get(const KeyType& Key,
+                 InitDataType&& InitData // May throw
+                 ) noexcept(false)
+    {
+        const auto Hash   = KeyHasher{}(Key);
+        auto&      Shard_ = GetShard(Hash);
+
+        if (Shard_.MaxSize.load() == 0 && Shard_.CurrSize.load() == 0)
+        {
+            DataType Data;
+            size_t   DataSize = 0;
+            InitData(Data, DataSize); // May throw
+            return Data;
+        }
+
+        {
+            DataType Data;
+            if (m_Policy == LRUCacheEvictionPolicy::Clock ?
+                    FindClock(Shard_, Key, Data) :
+                    FindExact(Shard_, Key, Data))
+                return Data;
+        }
+
+        // The data was not found or has not been initialized yet. Get the entry, which will be
+        // created if necessary. Since this is a shared pointer, the entry will not be destroyed
+        // while we keep it, even if it is evicted from the cache by another thread.
+        std::shared_ptr<Entry> pEntry = GetEntry(Shard_, Key);
+
+        // The entry is initialized while the shard lock is not held.
+        // InitData may throw, which will leave the entry in the 'InitFailure' state.
+        // It will be removed from the cache later when the shard runs out of its budget.
+        bool IsNewObject = false;
+        auto Data        = pEntry->GetData(std::forward<InitDataType>(InitData), IsNewObject);
+
+        if (IsNewObject)
+        {
+            std::vector<std::shared_ptr<Entry>> DeleteList;
+            {
+                std::unique_lock<std::shared_timed_mutex> Lock{Shard_.Mtx};
+
+                // The entry may have been evicted by another thread while we were initializing it.
+                // In this case it is dangling and will be released when the function exits.
+                auto it = Shard_.Map.find(Key);
+                if (it != Shard_.Map.end() && it->second == pEntry)
+                {
+                    VERIFY_EXPR(pEntry->AccountedSize == 0);
+                    pEntry->AccountedSize = pEntry->GetDataSize();
+                    Shard_.CurrSize.store(Shard_.CurrSize.load() + pEntry->AccountedSize);
+                }
+
+                Evict(Shard_, DeleteList);
+            }
+            // Delete objects after releasing the shard lock
+            DeleteList.clear();
+        }
+
+        return Data;
+    }
+
+    /// Sets the maximum cache size. The size is split evenly between the shards.
+    ///
+    /// \note   The new size takes effect when new entries are added to the cache.
+    void SetMaxSize(size_t MaxSize)
+    {
+        const size_t NumShards = m_Shards.size();
+        // Round up so that the total budget is never less than MaxSize
+        const size_t ShardSize = (MaxSize + NumShards - 1) / NumShards;
+        for (auto& pShard : m_Shards)
+            pShard->MaxSize.store(ShardSize);
+    }
+
+    /// Returns the current cache size.
+    size_t GetCurrSize() const
+    {
+        size_t CurrSize = 0;
+        for (const auto& pShard : m_Shards)
+            CurrSize += pShard->CurrSize.load();
+        return CurrSize;
+    }
+
+    /// Returns the number of shards.
+    Uint32 GetNumShards() const
+    {
+        return static_cast<Uint32>(m_Shards.size());
+    }
+
+    /// Returns the eviction policy.
+    LRUCacheEvictionPolicy GetEvictionPolicy() const
+    {
+        return m_Policy;
+    }
+
+    ~ShardedLRUCache()
+    {
+#ifdef DILIGENT_DEBUG
+        for (const auto& pShard : m_Shards)
+        {
+            VERIFY_EXPR(pShard->Map.size() == pShard->List.size());
+            size_t DbgSize = 0;
+            for (const auto* pNode : pShard->List)
+                DbgSize += pNode->second->AccountedSize;
+            VERIFY_EXPR(DbgSize == pShard->CurrSize);
+        }
+#endif
+    }
+
+private:
+    class Entry;
+
+    using MapType = std::unordered_map<KeyType, std::shared_ptr<Entry>, KeyHasher>;
+    // Map nodes are never relocated, so pointers to them remain valid until the element is erased.
+    using NodeType = typename MapType::value_type;
+    using ListType = std::list<NodeType*>;
+
+    class Entry
+    {
+    public:
+        enum class DataState
+        {
+            InitFailure = -1,
+            Default,
+            Initialized
+        };
+
+        template <typename InitDataType>
+        const DataType& GetData(InitDataType&& InitData, bool& IsNewObject) noexcept(false)
+        {
+            std::lock_guard<std::mutex> Lock{m_InitDataMtx};
+            if (m_State.load() != DataState::Initialized)
+            {
+                m_State.store(DataState::Default);
+                try
+                {
+                    size_t DataSize = 0;
+                    InitData(m_Data, DataSize); // May throw
+                    VERIFY_EXPR(DataSize > 0);
+                    m_DataSize = (std::max)(DataSize, size_t{1});
+                    m_State.store(DataState::Initialized);
+                    IsNewObject = true;
+                }
+                catch (...)
+                {
+                    m_Data = {};
+                    m_State.store(DataState::InitFailure);
+                    throw;
+                }
+            }
+            return m_Data;
+        }
+
+        // Returns the data if it has been initialized. The data is never modified after the
+        // initialization, so it can be read without locking the initialization mutex.
+        const DataType* GetInitializedData() const
+        {
+            return m_State.load() == DataState::Initialized ? &m_Data : nullptr;
+        }
+
+        DataState GetState() const { return m_State; }
+
+        size_t GetDataSize() const
+        {
+            VERIFY_EXPR(m_State == DataState::Initialized);
+            return m_DataSize;
+        }
+
+        // The size that was accounted in the shard. Protected by the shard lock.
+        size_t AccountedSize = 0;
+
+        // Position of the entry in the shard's list. Protected by the shard lock.
+        typename ListType::iterator ListIt;
+
+        // Reference bit used by the CLOCK policy.
+        std::atomic<bool> Referenced{false};
+
+    private:
+        std::mutex m_InitDataMtx;
+        DataType   m_Data;
+        size_t     m_DataSize = 0;
+
+        std::atomic<DataState> m_State{DataState::Default};
+    };
+
+    struct Shard
+    {
+        std::shared_timed_mutex Mtx;
+
+        MapType Map;
+
+        // Exact policy: entries ordered from the most to the least recently used.
+        // Clock policy: circular list of entries swept by ClockHand.
+        ListType List;
+
+        typename ListType::iterator ClockHand = List.end();
+
+        std::atomic<size_t> CurrSize{0};
+        std::atomic<size_t> MaxSize{0};
+    };
+
+    Shard& GetShard(size_t Hash)
+    {
+        // Mix the hash so that shards are well-balanced even if the hasher
+        // returns the value itself (as std::hash does for integers).
+        Hash ^= Hash >> 17;
+        Hash *= static_cast<size_t>(0x9E3779B97F4A7C15ull);
+        Hash ^= Hash >> 31;
+        return *m_Shards[Hash % m_Shards.size()];
+    }
+
+    static bool FindExact(Shard& Shard_, const KeyType& Key, DataType& Data)
+    {
+        std::unique_lock<std::shared_timed_mutex> Lock{Shard_.Mtx};
+
+        auto it = Shard_.Map.find(Key);
+        if (it == Shard_.Map.end())
+            return false;
+
+        const auto* pData = it->second->GetInitializedData();
+        if (pData == nullptr)
+            return false;
+
+        // Move the entry to the front of the list
+        Shard_.List.splice(Shard_.List.begin(), Shard_.List, it->second->ListIt);
+
+        Data = *pData;
+        return true;
+    }
+
+    static bool FindClock(Shard& Shard_, const KeyType& Key, DataType& Data)
+    {
+        std::shared_lock<std::shared_timed_mutex> Lock{Shard_.Mtx};
+
+        auto it = Shard_.Map.find(Key);
+        if (it == Shard_.Map.end())
+            return false;
+
+        const auto& pEntry = it->second;
+        const auto* pData  = pEntry->GetInitializedData();
+        if (pData == nullptr)
+            return false;
+
+        // Avoid writing to the cache line shared by all readers if the bit is already set
+        if (!pEntry->Referenced.load(std::memory_order_relaxed))
+            pEntry->Referenced.store(true, std::memory_order_relaxed);
+
+        Data = *pData;
+        return true;
+    }
+
+    std::shared_ptr<Entry> GetEntry(Shard& Shard_, const KeyType& Key)
+    {
+        std::unique_lock<std::shared_timed_mutex> Lock{Shard_.Mtx};
+
+        auto it = Shard_.Map.find(Key);
+        if (it != Shard_.Map.end())
+            return it->second;
+
+        it = Shard_.Map.emplace(Key, std::make_shared<Entry>()).first;
+
+        NodeType* pNode = &*it;
+        // Exact policy: new entries go to the front of the list.
+        // Clock policy: new entries are inserted right behind the clock hand, so that they
+        // are visited last.
+        it->second->ListIt = m_Policy == LRUCacheEvictionPolicy::Clock ?
+            Shard_.List.insert(Shard_.ClockHand, pNode) :
+            Shard_.List.insert(Shard_.List.begin(), pNode);
+        VERIFY_EXPR(Shard_.Map.size() == Shard_.List.size());
+
+        return it->second;
+    }
+
+    static bool IsEvictable(const Entry& Entry_)
+    {
+        // Entries that are being initialized by another thread or have been initialized,
+        // but not accounted yet, must be skipped.
+        // An entry whose initialization failed may be evicted. If another thread is retrying
+        // the initialization at the same time, it will find that the entry is no longer in the
+        // cache and will discard it.
+        return Entry_.AccountedSize != 0 || Entry_.GetState() == Entry::DataState::InitFailure;
+    }
+
+    // Removes the node from the shard. Must be called with the shard lock held exclusively.
+    static typename ListType::iterator Erase(Shard& Shard_, typename ListType::iterator list_it, std::vector<std::shared_ptr<Entry>>& DeleteList)
+    {
+        NodeType* pNode = *list_it;
+
+        const auto AccountedSize = pNode->second->AccountedSize;
+        VERIFY_EXPR(Shard_.CurrSize >= AccountedSize);
+        Shard_.CurrSize.store(Shard_.CurrSize.load() - AccountedSize);
+
+        auto map_it = Shard_.Map.find(pNode->first);
+        VERIFY_EXPR(map_it != Shard_.Map.end() && &*map_it == pNode);
+        DeleteList.emplace_back(std::move(map_it->second));
+        Shard_.Map.erase(map_it);
+        return Shard_.List.erase(list_it);
+    }
+
+    // Evicts entries until the shard fits into its budget.
+    // Must be called with the shard lock held exclusively.
+    void Evict(Shard& Shard_, std::vector<std::shared_ptr<Entry>>& DeleteList)
+    {
+        if (m_Policy == LRUCacheEvictionPolicy::Clock)
+        {
+            // Every entry is visited at most twice: the first time its reference bit is cleared,
+            // and the second time it is evicted.
+            for (size_t Steps = Shard_.List.size() * 2; Steps > 0 && Shard_.CurrSize > Shard_.MaxSize; --Steps)
+            {
+                if (Shard_.ClockHand == Shard_.List.end())
+                    Shard_.ClockHand = Shard_.List.begin();
+                if (Shard_.ClockHand == Shard_.List.end())
+                    break;
+
+                Entry& Entry_ = *(*Shard_.ClockHand)->second;
+                if (!IsEvictable(Entry_))
+                {
+                    ++Shard_.ClockHand;
+                }
+                else if (Entry_.Referenced.load(std::memory_order_relaxed))
+                {
+                    Entry_.Referenced.store(false, std::memory_order_relaxed);
+                    ++Shard_.ClockHand;
+                }
+                else
+                {
+                    Shard_.ClockHand = Erase(Shard_, Shard_.ClockHand, DeleteList);
+                }
+            }
+        }
+        else
+        {
+            auto list_it = Shard_.List.end();
+            while (list_it != Shard_.List.begin() && Shard_.CurrSize > Shard_.MaxSize)
+            {
+                --list_it;
+                if (IsEvictable(*(*list_it)->second))
+                    list_it = Erase(Shard_, list_it, DeleteList);
+            }
+        }
+        VERIFY_EXPR(Shard_.Map.size() == Shard_.List.size());
+    }
+
+    const LRUCacheEvictionPolicy m_Policy;
+
+    // Shards are allocated individually to keep their locks in separate cache lines.
+    std::vector<std::unique_ptr<Shard>> m_Shards;
+};
+
 } // namespace Diligent
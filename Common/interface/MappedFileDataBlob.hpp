@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the IDataBlob interface backed by a memory-mapped file
+
+#include <memory>
+
+#include "../../Primitives/interface/BasicTypes.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "../../Platforms/Basic/interface/BasicFileSystem.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "ObjectBase.hpp"
+
+namespace Diligent
+{
+
+/// Data blob that exposes the contents of a file.
+
+/// On platforms that support memory mapping (Linux, Android, MacOS, iOS, tvOS), the file
+/// is mapped into memory, and its pages are loaded on demand when the data is accessed
+/// for the first time. On other platforms, the entire file is read into memory.
+/// The blob can't be resized.
+class MappedFileDataBlob final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase = ObjectBase<IDataBlob>;
+
+    /// Returns null if the file can't be opened.
+    /// Pattern is a hint that tells the system how the data is going to be accessed.
+    static RefCntAutoPtr<MappedFileDataBlob> Create(const Char* Path, EFileAccessPattern Pattern = EFileAccessPattern::Normal);
+
+    ~MappedFileDataBlob() override;
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    /// Mapped data can't be resized - the method only verifies that the size does not change.
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override;
+
+    /// Returns the size of the file
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override;
+
+    /// Returns the pointer to the file data
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override;
+
+    /// Returns const pointer to the file data
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override;
+
+private:
+    template <typename AllocatorType, typename ObjectType>
+    friend class MakeNewRCObj;
+
+    MappedFileDataBlob(IReferenceCounters* pRefCounters, const Char* Path, EFileAccessPattern Pattern) noexcept(false);
+
+private:
+    std::unique_ptr<class FileDataStorage> m_Storage;
+};
+
+} // namespace Diligent
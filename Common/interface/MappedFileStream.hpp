@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of the MappedFileStream class
+
+#include "../../Primitives/interface/FileStream.h"
+#include "../../Primitives/interface/DataBlob.h"
+#include "ObjectBase.hpp"
+#include "RefCntAutoPtr.hpp"
+#include "MappedFileDataBlob.hpp"
+
+namespace Diligent
+{
+
+/// Read-only file stream that accesses the file through a memory mapping (see MappedFileDataBlob).
+///
+/// Unlike BasicFileStream, the stream does not use stdio buffers, and ReadBlob()
+/// returns the data blob that references the mapped data without copying it.
+class MappedFileStream final : public ObjectBase<IFileStream>
+{
+public:
+    typedef ObjectBase<IFileStream> TBase;
+
+    // {9E6C7A2E-6C1B-4B57-8C0A-2F0E1D7B5C43}
+    static constexpr INTERFACE_ID IID_InternalImpl =
+        {0x9e6c7a2e, 0x6c1b, 0x4b57, {0x8c, 0xa, 0x2f, 0xe, 0x1d, 0x7b, 0x5c, 0x43}};
+
+    MappedFileStream(IReferenceCounters* pRefCounters,
+                     MappedFileDataBlob* pData);
+
+    virtual void DILIGENT_CALL_TYPE QueryInterface(const INTERFACE_ID& IID, IObject** ppInterface) override final;
+
+    /// Reads the remaining data from the stream into pData.
+    /// The data is copied - use ReadBlob() to avoid the copy.
+    virtual void DILIGENT_CALL_TYPE ReadBlob(IDataBlob* pData) override final;
+
+    /// Reads data from the stream
+    virtual bool DILIGENT_CALL_TYPE Read(void* Data, size_t Size) override final;
+
+    /// The stream is read-only - the method always fails.
+    virtual bool DILIGENT_CALL_TYPE Write(const void* Data, size_t Size) override final;
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() override final;
+
+    virtual bool DILIGENT_CALL_TYPE IsValid() override final;
+
+    /// Returns the data blob that references the remaining data in the stream without copying it,
+    /// and moves the current position to the end of the stream.
+    RefCntAutoPtr<IDataBlob> ReadBlob();
+
+    /// Maps the file and creates the stream. Returns null if the file can't be opened.
+    /// Pattern is a hint that tells the system how the data is going to be accessed.
+    static RefCntAutoPtr<MappedFileStream> Create(const Char* Path, EFileAccessPattern Pattern = EFileAccessPattern::Sequential);
+
+private:
+    RefCntAutoPtr<MappedFileDataBlob> m_pData;
+    size_t                            m_CurrentOffset = 0;
+};
+
+/// Reads the remaining data from the stream into a data blob.
+
+/// If the stream is a MappedFileStream, the returned blob references the mapped
+/// file data. Otherwise, the data is copied into a new blob.
+RefCntAutoPtr<IDataBlob> ReadFileStreamData(IFileStream* pStream);
+
+} // namespace Diligent
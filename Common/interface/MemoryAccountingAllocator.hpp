@@ -0,0 +1,155 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#pragma once
+
+/// \file
+/// Defines Diligent::MemoryAccountingAllocator class
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "../../Primitives/interface/MemoryAccounting.h"
+#include "HashUtils.hpp"
+
+namespace Diligent
+{
+
+/// Memory allocator wrapper that keeps the statistics of the allocations.
+
+/// The allocator forwards all requests to the backing allocator and accounts every
+/// allocation to its tag (the allocation description) and its subsystem (the source file
+/// that requested the allocation). The statistics can be queried at any time through
+/// the IMemoryAccounting interface.
+///
+/// Every allocation is prefixed by a small header that stores its size and group, so
+/// that the statistics can be updated when the memory is released. All methods are thread-safe.
+/// The counters are atomic, and the groups of an allocation site are found without locking
+/// once the site has been seen, so that allocations do not serialize on a mutex.
+///
+/// Allocation sites are cached by the description and file name pointers. Descriptions with the
+/// same text at different addresses are accounted to the same tag, but a buffer that is reused
+/// for a different description may keep being accounted to the tag of its first text.
+///
+/// To account all engine allocations, pass the allocator as the raw memory allocator
+/// to the engine factory (EngineCreateInfo::pRawMemAllocator). In release builds, STL containers
+/// and reference-counted objects only provide allocation descriptions when the engine is built
+/// with the DILIGENT_MEMORY_ACCOUNTING CMake option; otherwise their allocations are reported
+/// under a single placeholder tag.
+/// The allocator must outlive all allocations made through it.
+class MemoryAccountingAllocator final : public IMemoryAllocator, public IMemoryAccounting
+{
+public:
+    explicit MemoryAccountingAllocator(IMemoryAllocator& Allocator) noexcept;
+
+    // clang-format off
+    MemoryAccountingAllocator           (const MemoryAccountingAllocator&) = delete;
+    MemoryAccountingAllocator           (MemoryAccountingAllocator&&)      = delete;
+    MemoryAccountingAllocator& operator=(const MemoryAccountingAllocator&) = delete;
+    MemoryAccountingAllocator& operator=(MemoryAccountingAllocator&&)      = delete;
+    // clang-format on
+
+    ~MemoryAccountingAllocator();
+
+    /// Allocates block of memory
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final;
+
+    /// Releases memory
+    virtual void Free(void* Ptr) override final;
+
+    /// Implementation of IMemoryAccounting::GetTotalStats().
+    virtual MemoryAllocationStats GetTotalStats() override final;
+
+    /// Implementation of IMemoryAccounting::GetGroupStats().
+    virtual Uint32 GetGroupStats(MEMORY_ACCOUNTING_GROUP Group, MemoryAllocationStats* pStats, Uint32 MaxStats) override final;
+
+    /// Implementation of IMemoryAccounting::ResetPeakStats().
+    virtual void ResetPeakStats() override final;
+
+private:
+    struct Counters
+    {
+        std::atomic<Uint64> LiveBytes{0};
+        std::atomic<Uint64> PeakBytes{0};
+        std::atomic<Uint64> LiveAllocations{0};
+        std::atomic<Uint64> TotalAllocations{0};
+        std::atomic<Uint64> TotalBytes{0};
+
+        void OnAllocate(size_t Size);
+        void OnFree(size_t Size);
+
+        MemoryAllocationStats GetStats(const Char* Name) const;
+    };
+
+    // Allocation site identified by the description and the file name.
+    struct AllocationSource
+    {
+        String Description;
+        String FileName;
+
+        Counters* pGroups[MEMORY_ACCOUNTING_GROUP_COUNT] = {};
+    };
+
+    // Entry of the lock-free site cache. Descriptions and file names are normally string literals,
+    // so the pointers identify the site and the strings are not compared on a cache hit.
+    struct SourceCacheEntry
+    {
+        const Char*             Description;
+        const char*             FileName;
+        const AllocationSource* pSource;
+
+        bool Matches(const Char* dbgDescription, const char* dbgFileName) const
+        {
+            return Description == dbgDescription && FileName == dbgFileName;
+        }
+    };
+
+    const AllocationSource& GetSource(const Char* dbgDescription, const char* dbgFileName);
+    const AllocationSource* FindCachedSource(size_t Hash, const Char* dbgDescription, const char* dbgFileName) const;
+
+    IMemoryAllocator& m_Allocator;
+
+    // The maximum number of cached sites is half of the cache size. The sites that
+    // do not fit into the cache are looked up under the mutex.
+    static constexpr size_t SourceCacheSize = 1024;
+
+    std::atomic<const SourceCacheEntry*> m_SourceCache[SourceCacheSize];
+
+    // Protects the maps and the cache entries below, but not the counters
+    std::mutex m_Mtx;
+
+    std::vector<std::unique_ptr<SourceCacheEntry>>                m_SourceCacheEntries;
+    std::unordered_map<String, std::unique_ptr<AllocationSource>> m_Sources; // Keyed by the description and file name
+    std::unordered_map<String, Counters>                          m_Groups[MEMORY_ACCOUNTING_GROUP_COUNT];
+
+    Counters m_Total;
+};
+
+} // namespace Diligent
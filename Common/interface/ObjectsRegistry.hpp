@@ -22,9 +22,11 @@
 #include <memory>
 #include <algorithm>
 #include <atomic>
+#include <thread>
 
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "RefCntAutoPtr.hpp"
+#include "SpinLock.hpp"
 
 namespace Diligent
 {
@@ -107,6 +109,12 @@ auto _IsWeakPtrExpired(std::weak_ptr<T>& pWeakPtr)
 ///
 ///         It is guaranteed, that the Object will only be initialized once, even if multiple threads call Get() simultaneously.
 ///
+///         In read-mostly mode, the registry additionally maintains an immutable snapshot of the live objects that is
+///         published RCU-style. Lookups of the objects in the snapshot do not take any locks, while inserts and purges
+///         rebuild the snapshot under the registry mutex and wait until no reader uses the previous one.
+///         The snapshot is rebuilt lazily, so that the cost of the rebuild is amortized over a number of
+///         lookups that missed it.
+///
 template <typename KeyType,
           typename StrongPtrType,
           typename KeyHasher = std::hash<KeyType>,
@@ -116,10 +124,23 @@ class ObjectsRegistry
 public:
     using WeakPtrType = typename _StrongPtrHelper<StrongPtrType>::WeakPtrType;
 
-    explicit ObjectsRegistry(Uint32 NumRequestsToPurge = 1024) noexcept :
-        m_NumRequestsToPurge{NumRequestsToPurge}
+    explicit ObjectsRegistry(Uint32 NumRequestsToPurge = 1024, bool ReadMostly = false) noexcept :
+        m_NumRequestsToPurge{NumRequestsToPurge},
+        m_ReadMostly{ReadMostly}
     {}
 
+    // clang-format off
+    ObjectsRegistry           (const ObjectsRegistry&)  = delete;
+    ObjectsRegistry           (      ObjectsRegistry&&) = delete;
+    ObjectsRegistry& operator=(const ObjectsRegistry&)  = delete;
+    ObjectsRegistry& operator=(      ObjectsRegistry&&) = delete;
+    // clang-format on
+
+    ~ObjectsRegistry()
+    {
+        delete m_pSnapshot.load();
+    }
+
     /// Finds the object in the registry and returns strong pointer to it (std::shared_ptr or RefCntAutoPtr).
     /// If the object is not found, it is atomically created using the provided initializer.
     ///
@@ -140,6 +161,12 @@ public:
                       CreateObjectType&& CreateObject // May throw
                       ) noexcept(false)
     {
+        if (m_ReadMostly)
+        {
+            if (auto pObject = FindInSnapshot(Key))
+                return pObject;
+        }
+
         // Get the Object wrapper. Since this is a shared pointer, it may not be destroyed
         // while we keep one, even if it is popped from the registry by another thread.
         std::shared_ptr<ObjectWrapper> pObjectWrpr;
@@ -181,6 +208,7 @@ public:
             throw;
         }
 
+        std::unique_ptr<SnapshotType> pOldSnapshot;
         {
             std::lock_guard<std::mutex> Guard{m_CacheMtx};
 
@@ -206,8 +234,12 @@ public:
             }
 
             if (m_NumRequestsSinceLastPurge.fetch_add(1) + 1 >= m_NumRequestsToPurge)
-                PurgeUnguarded();
+                PurgeUnguarded(pOldSnapshot);
+
+            if (pObject)
+                OnSnapshotMissUnguarded(pOldSnapshot);
         }
+        ReclaimSnapshot(std::move(pOldSnapshot));
 
         return pObject;
     }
@@ -221,33 +253,56 @@ public:
     ///             or empty pointer otherwise.
     StrongPtrType Get(const KeyType& Key)
     {
-        std::lock_guard<std::mutex> Guard{m_CacheMtx};
-
-        if (m_NumRequestsSinceLastPurge.fetch_add(1) + 1 >= m_NumRequestsToPurge)
-            PurgeUnguarded();
+        if (m_ReadMostly)
+        {
+            if (auto pObject = FindInSnapshot(Key))
+                return pObject;
+        }
 
-        auto it = m_Cache.find(Key);
-        if (it != m_Cache.end())
+        StrongPtrType                 pObject;
+        std::unique_ptr<SnapshotType> pOldSnapshot;
         {
-            auto pObject = it->second->Lock();
-            if (!pObject)
+            std::lock_guard<std::mutex> Guard{m_CacheMtx};
+
+            if (m_NumRequestsSinceLastPurge.fetch_add(1) + 1 >= m_NumRequestsToPurge)
+                PurgeUnguarded(pOldSnapshot);
+
+            auto it = m_Cache.find(Key);
+            if (it != m_Cache.end())
             {
-                // Note that we may remove the entry from the cache while another thread is creating the object.
-                // This is OK as it will be added back to the cache.
-                m_Cache.erase(it);
+                pObject = it->second->Lock();
+                if (!pObject)
+                {
+                    // Note that we may remove the entry from the cache while another thread is creating the object.
+                    // This is OK as it will be added back to the cache.
+                    m_Cache.erase(it);
+                }
+                else
+                {
+                    OnSnapshotMissUnguarded(pOldSnapshot);
+                }
             }
-
-            return pObject;
         }
+        ReclaimSnapshot(std::move(pOldSnapshot));
 
-        return {};
+        return pObject;
     }
 
     /// Removes all expired pointers from the cache
     void Purge()
     {
-        std::lock_guard<std::mutex> Guard{m_CacheMtx};
-        PurgeUnguarded();
+        std::unique_ptr<SnapshotType> pOldSnapshot;
+        {
+            std::lock_guard<std::mutex> Guard{m_CacheMtx};
+            PurgeUnguarded(pOldSnapshot);
+        }
+        ReclaimSnapshot(std::move(pOldSnapshot));
+    }
+
+    /// Returns true if the registry is in read-mostly mode.
+    bool IsReadMostly() const
+    {
+        return m_ReadMostly;
     }
 
     /// Processes each element in the cache with the specified handler.
@@ -265,6 +320,9 @@ public:
     }
 
 private:
+    // Immutable snapshot used by lock-free lookups in read-mostly mode.
+    using SnapshotType = std::unordered_map<KeyType, WeakPtrType, KeyHasher, KeyEqual>;
+
     class ObjectWrapper
     {
     public:
@@ -274,11 +332,13 @@ private:
             StrongPtrType pObject;
 
             std::lock_guard<std::mutex> Guard{m_CreateObjectMtx};
-            pObject = _LockWeakPtr(m_wpObject);
+            pObject = Lock();
             if (!pObject)
             {
-                pObject    = CreateObject(); // May throw
-                m_wpObject = pObject;
+                pObject = CreateObject(); // May throw
+
+                Threading::SpinLockGuard WeakPtrGuard{m_WeakPtrLock};
+                m_wpObject = WeakPtrType{pObject};
             }
 
             return pObject;
@@ -286,20 +346,31 @@ private:
 
         StrongPtrType Lock()
         {
+            Threading::SpinLockGuard Guard{m_WeakPtrLock};
             return _LockWeakPtr(m_wpObject);
         }
 
         bool IsExpired()
         {
+            Threading::SpinLockGuard Guard{m_WeakPtrLock};
             return _IsWeakPtrExpired(m_wpObject);
         }
 
+        WeakPtrType GetWeakPtr()
+        {
+            Threading::SpinLockGuard Guard{m_WeakPtrLock};
+            return m_wpObject;
+        }
+
     private:
         std::mutex  m_CreateObjectMtx;
         WeakPtrType m_wpObject;
+
+        // Protects m_wpObject that may be read by Lock() while another thread is creating the object.
+        Threading::SpinLock m_WeakPtrLock;
     };
 
-    void PurgeUnguarded()
+    void PurgeUnguarded(std::unique_ptr<SnapshotType>& pOldSnapshot)
     {
         for (auto it = m_Cache.begin(); it != m_Cache.end();)
         {
@@ -314,17 +385,134 @@ private:
         }
 
         m_NumRequestsSinceLastPurge.store(0);
+
+        if (m_ReadMostly)
+            UpdateSnapshotUnguarded(pOldSnapshot);
+    }
+
+    StrongPtrType FindInSnapshot(const KeyType& Key)
+    {
+        // The snapshot may not be released while the reader count in the slot is not zero.
+        auto&        Slot  = m_ReaderSlots[GetReaderSlotIndex()];
+        const Uint32 Epoch = m_ReaderEpoch.load() & 1u;
+        Slot.NumReaders[Epoch].fetch_add(1);
+
+        StrongPtrType pObject;
+        if (auto* pSnapshot = m_pSnapshot.load())
+        {
+            auto it = pSnapshot->find(Key);
+            if (it != pSnapshot->end())
+            {
+                // Lock a copy since locking an expired weak pointer resets it,
+                // while the snapshot is shared between readers and must not be modified.
+                auto wpObject = it->second;
+                pObject       = _LockWeakPtr(wpObject);
+            }
+        }
+
+        Slot.NumReaders[Epoch].fetch_sub(1);
+
+        return pObject;
+    }
+
+    // Called when an existing object was found in the cache, but not in the snapshot.
+    void OnSnapshotMissUnguarded(std::unique_ptr<SnapshotType>& pOldSnapshot)
+    {
+        if (!m_ReadMostly)
+            return;
+
+        // Rebuild the snapshot when the number of misses reaches a fraction of the cache size
+        // so that the rebuild cost is amortized over the lookups.
+        if (++m_NumSnapshotMisses >= m_Cache.size() / 8 + 1)
+            UpdateSnapshotUnguarded(pOldSnapshot);
+    }
+
+    // Publishes a new snapshot and returns the old one in pOldSnapshot. The old snapshot may still
+    // be used by readers and must be released with ReclaimSnapshot() after m_CacheMtx is unlocked.
+    void UpdateSnapshotUnguarded(std::unique_ptr<SnapshotType>& pOldSnapshot)
+    {
+        if (pOldSnapshot)
+        {
+            // The snapshot has already been rebuilt while the mutex is held, and is up to date.
+            m_NumSnapshotMisses = 0;
+            return;
+        }
+
+        std::unique_ptr<SnapshotType> pNewSnapshot{new SnapshotType{}};
+        pNewSnapshot->reserve(m_Cache.size());
+        for (auto& Entry : m_Cache)
+        {
+            auto wpObject = Entry.second->GetWeakPtr();
+            if (!_IsWeakPtrExpired(wpObject))
+                pNewSnapshot->emplace(Entry.first, std::move(wpObject));
+        }
+
+        pOldSnapshot.reset(m_pSnapshot.exchange(pNewSnapshot.release()));
+        m_NumSnapshotMisses = 0;
+    }
+
+    // Waits until all readers that may have loaded the old snapshot are done and deletes it.
+    // Must not be called while m_CacheMtx is locked so that other threads are not blocked by the wait.
+    void ReclaimSnapshot(std::unique_ptr<SnapshotType> pOldSnapshot)
+    {
+        if (!pOldSnapshot)
+            return;
+
+        // Grace periods of concurrent writers must not interleave their epoch flips.
+        std::lock_guard<std::mutex> Guard{m_ReclaimMtx};
+
+        // Readers that incremented their counter after the epoch flip see the new snapshot.
+        // The epoch is flipped twice since a reader could have read the epoch before the previous
+        // flip, but incremented the counter after it (see the user-space RCU for details).
+        for (Uint32 Flip = 0; Flip < 2; ++Flip)
+        {
+            const Uint32 OldEpoch = m_ReaderEpoch.fetch_xor(1u) & 1u;
+            for (auto& Slot : m_ReaderSlots)
+            {
+                while (Slot.NumReaders[OldEpoch].load() != 0)
+                    std::this_thread::yield();
+            }
+        }
+    }
+
+    static Uint32 GetReaderSlotIndex()
+    {
+        static std::atomic<Uint32> NextSlotIdx{0};
+        thread_local const Uint32  SlotIdx = NextSlotIdx.fetch_add(1) % NumReaderSlots;
+        return SlotIdx;
     }
 
 private:
     using CacheType = std::unordered_map<KeyType, std::shared_ptr<ObjectWrapper>, KeyHasher, KeyEqual>;
 
+    static constexpr Uint32 NumReaderSlots = 16;
+
+    // Reader counters for each epoch parity, padded to avoid false sharing between slots.
+    struct ReaderSlot
+    {
+        std::atomic<Uint32> NumReaders[2] = {};
+
+        Uint8 Padding[64 - sizeof(std::atomic<Uint32>) * 2];
+    };
+
     const Uint32 m_NumRequestsToPurge;
+    const bool   m_ReadMostly;
 
     std::atomic<Uint32> m_NumRequestsSinceLastPurge{0};
 
     std::mutex m_CacheMtx;
     CacheType  m_Cache;
+
+    // Protected by m_CacheMtx
+    size_t m_NumSnapshotMisses = 0;
+
+    std::atomic<SnapshotType*> m_pSnapshot{nullptr};
+    std::atomic<Uint32>        m_ReaderEpoch{0};
+
+    // Serializes the grace periods in ReclaimSnapshot()
+    std::mutex m_ReclaimMtx;
+
+    ReaderSlot m_ReaderSlots[NumReaderSlots];
 };
 
 } // namespace Diligent
@@ -0,0 +1,163 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+/// \file
+/// Multithreaded versions of the batch frustum culling functions from AdvancedMath.hpp.
+
+#include <algorithm>
+#include <vector>
+
+#include "AdvancedMath.hpp"
+#include "ThreadPool.hpp"
+
+namespace Diligent
+{
+
+namespace ParallelCullingInternal
+{
+
+// Splits the boxes into NumTasks ranges, runs Handler(FirstBox, NumBoxes) for every range
+// in the thread pool and waits for all ranges to be processed. The first range is processed
+// by the calling thread. Range boundaries are multiples of 32, so that every range writes
+// its own visibility mask elements.
+template <typename HandlerType>
+void ProcessBoxRanges(IThreadPool* pThreadPool, Uint32 NumTasks, size_t NumBoxes, size_t MinBoxesPerTask, const HandlerType& Handler)
+{
+    MinBoxesPerTask        = (std::max)(MinBoxesPerTask, size_t{1});
+    const size_t MaxTasks  = (NumBoxes + MinBoxesPerTask - 1) / MinBoxesPerTask;
+    const size_t TaskCount = pThreadPool != nullptr ? (std::min)(size_t{(std::max)(NumTasks, 1u)}, MaxTasks) : 1;
+    if (TaskCount <= 1)
+    {
+        Handler(size_t{0}, NumBoxes);
+        return;
+    }
+
+    const size_t BoxesPerTask = ((NumBoxes + TaskCount - 1) / TaskCount + 31) & ~size_t{31};
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(TaskCount - 1);
+    for (size_t FirstBox = BoxesPerTask; FirstBox < NumBoxes; FirstBox += BoxesPerTask)
+    {
+        const size_t RangeSize = (std::min)(BoxesPerTask, NumBoxes - FirstBox);
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&Handler, FirstBox, RangeSize](Uint32) {
+                                                Handler(FirstBox, RangeSize);
+                                            }));
+    }
+
+    Handler(size_t{0}, (std::min)(BoxesPerTask, NumBoxes));
+
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+}
+
+} // namespace ParallelCullingInternal
+
+
+/// Tests multiple bounding boxes against the view frustum using the thread pool.
+
+/// \param [in]  pThreadPool     - Thread pool to run the tasks. If it is null, the boxes are
+///                                processed by the calling thread.
+/// \param [in]  NumTasks        - The maximum number of tasks to split the work into, including
+///                                the part that is processed by the calling thread. Typically,
+///                                this is the number of worker threads plus one.
+/// \param [in]  Frustum         - View frustum, either ViewFrustum or ViewFrustumExt.
+/// \param [in]  Boxes           - Bounding boxes to test, either BoundBoxesSoA or OrientedBoundingBoxesSoA.
+/// \param [out] pVisibilityMask - Visibility mask, see GetBoxesVisibilityMask().
+/// \param [in]  PlaneFlags      - Planes to test the boxes against.
+/// \param [in]  MinBoxesPerTask - The minimum number of boxes processed by one task.
+///                                Small sets are processed by the calling thread only.
+///
+/// \remarks    The function blocks until all boxes are processed, and must not be called
+///             from a worker thread of the same thread pool.
+template <typename FrustumType, typename BoxesType>
+void GetBoxesVisibilityMaskParallel(IThreadPool*        pThreadPool,
+                                    Uint32              NumTasks,
+                                    const FrustumType&  Frustum,
+                                    const BoxesType&    Boxes,
+                                    Uint32*             pVisibilityMask,
+                                    FRUSTUM_PLANE_FLAGS PlaneFlags      = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                                    size_t              MinBoxesPerTask = 16384)
+{
+    ParallelCullingInternal::ProcessBoxRanges(pThreadPool, NumTasks, Boxes.Count, MinBoxesPerTask,
+                                              [&](size_t FirstBox, size_t NumBoxes) {
+                                                  GetBoxesVisibilityMask(Frustum, Boxes.GetRange(FirstBox, NumBoxes), pVisibilityMask + FirstBox / 32, PlaneFlags);
+                                              });
+}
+
+/// Tests multiple bounding boxes against the view frustum using the thread pool and
+/// writes the indices of the boxes that are not invisible.
+
+/// \return     The number of visible boxes.
+///
+/// \remarks    See GetBoxesVisibilityMaskParallel() and GetVisibleBoxIndices().
+///             Every task writes the indices of its range to the corresponding part of
+///             pVisibleIndices, after which the parts are moved together by the calling thread.
+template <typename FrustumType, typename BoxesType>
+size_t GetVisibleBoxIndicesParallel(IThreadPool*        pThreadPool,
+                                    Uint32              NumTasks,
+                                    const FrustumType&  Frustum,
+                                    const BoxesType&    Boxes,
+                                    Uint32*             pVisibleIndices,
+                                    FRUSTUM_PLANE_FLAGS PlaneFlags      = FRUSTUM_PLANE_FLAG_FULL_FRUSTUM,
+                                    size_t              MinBoxesPerTask = 16384)
+{
+    struct RangeInfo
+    {
+        size_t FirstBox   = 0;
+        size_t NumVisible = 0;
+    };
+    // Range boundaries are multiples of 32, so every range has its own element
+    std::vector<RangeInfo> Ranges((Boxes.Count + 31) / 32 + 1);
+
+    ParallelCullingInternal::ProcessBoxRanges(pThreadPool, NumTasks, Boxes.Count, MinBoxesPerTask,
+                                              [&](size_t FirstBox, size_t NumBoxes) {
+                                                  Uint32* pRangeIndices = pVisibleIndices + FirstBox;
+
+                                                  const size_t NumVisible = GetVisibleBoxIndices(Frustum, Boxes.GetRange(FirstBox, NumBoxes), pRangeIndices, PlaneFlags);
+                                                  for (size_t i = 0; i < NumVisible; ++i)
+                                                      pRangeIndices[i] += static_cast<Uint32>(FirstBox);
+
+                                                  Ranges[FirstBox / 32] = {FirstBox, NumVisible};
+                                              });
+
+    size_t NumVisible = 0;
+    for (const auto& Range : Ranges)
+    {
+        if (Range.NumVisible == 0)
+            continue;
+        if (Range.FirstBox != NumVisible)
+            std::copy(pVisibleIndices + Range.FirstBox, pVisibleIndices + Range.FirstBox + Range.NumVisible, pVisibleIndices + NumVisible);
+        NumVisible += Range.NumVisible;
+    }
+
+    return NumVisible;
+}
+
+} // namespace Diligent
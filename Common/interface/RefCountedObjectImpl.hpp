@@ -615,12 +615,14 @@ public:
         // clang-format off
         m_pAllocator{&Allocator},
         m_pOwner{pOwner}
-#ifdef DILIGENT_DEVELOPMENT
+#if defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_MEMORY_ACCOUNTING)
       , m_dvpDescription{Description}
       , m_dvpFileName   {FileName   }
+#endif
+#ifdef DILIGENT_DEVELOPMENT
       , m_dvpLineNumber {LineNumber }
-    // clang-format on
 #endif
+    // clang-format on
     {
     }
 
@@ -628,9 +630,11 @@ public:
         // clang-format off
         m_pAllocator    {nullptr},
         m_pOwner        {pOwner }
-#ifdef DILIGENT_DEVELOPMENT
+#if defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_MEMORY_ACCOUNTING)
       , m_dvpDescription{nullptr}
       , m_dvpFileName   {nullptr}
+#endif
+#ifdef DILIGENT_DEVELOPMENT
       , m_dvpLineNumber {0      }
 #endif
     // clang-format on
@@ -660,10 +664,12 @@ public:
         ObjectType* pObj = nullptr;
         try
         {
-#ifndef DILIGENT_DEVELOPMENT
+#if !defined(DILIGENT_DEVELOPMENT) && !defined(DILIGENT_MEMORY_ACCOUNTING)
             static constexpr const char* m_dvpDescription = "<Unavailable in release build>";
             static constexpr const char* m_dvpFileName    = "<Unavailable in release build>";
-            static constexpr Int32       m_dvpLineNumber  = -1;
+#endif
+#ifndef DILIGENT_DEVELOPMENT
+            static constexpr Int32 m_dvpLineNumber = -1;
 #endif
             // Operators new and delete of RefCountedObject are private and only accessible
             // by methods of MakeNewRCObj
@@ -687,10 +693,14 @@ private:
     AllocatorType* const m_pAllocator;
     IObject* const       m_pOwner;
 
-#ifdef DILIGENT_DEVELOPMENT
+    // With DILIGENT_MEMORY_ACCOUNTING, release builds pass the object description to the
+    // allocator too, so that objects are not all reported under one placeholder tag.
+#if defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_MEMORY_ACCOUNTING)
     const Char* const m_dvpDescription;
     const char* const m_dvpFileName;
-    Int32 const       m_dvpLineNumber;
+#endif
+#ifdef DILIGENT_DEVELOPMENT
+    Int32 const m_dvpLineNumber;
 #endif
 };
 
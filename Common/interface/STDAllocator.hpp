@@ -63,9 +63,11 @@ struct STDAllocator
     STDAllocator(AllocatorType& Allocator, const Char* Description, const Char* FileName, const Int32 LineNumber) noexcept :
         // clang-format off
         m_Allocator     {Allocator}
-#ifdef DILIGENT_DEVELOPMENT
+#if defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_MEMORY_ACCOUNTING)
       , m_dvpDescription{Description}
       , m_dvpFileName   {FileName   }
+#endif
+#ifdef DILIGENT_DEVELOPMENT
       , m_dvpLineNumber {LineNumber }
 #endif
     // clang-format on
@@ -76,9 +78,11 @@ struct STDAllocator
     STDAllocator(const STDAllocator<U, AllocatorType>& other) noexcept :
         // clang-format off
         m_Allocator     {other.m_Allocator}
-#ifdef DILIGENT_DEVELOPMENT
+#if defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_MEMORY_ACCOUNTING)
       , m_dvpDescription{other.m_dvpDescription}
       , m_dvpFileName   {other.m_dvpFileName   }
+#endif
+#ifdef DILIGENT_DEVELOPMENT
       , m_dvpLineNumber {other.m_dvpLineNumber }
 #endif
     // clang-format on
@@ -89,9 +93,11 @@ struct STDAllocator
     STDAllocator(STDAllocator<U, AllocatorType>&& other) noexcept :
         // clang-format off
         m_Allocator     {other.m_Allocator}
-#ifdef DILIGENT_DEVELOPMENT
+#if defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_MEMORY_ACCOUNTING)
       , m_dvpDescription{other.m_dvpDescription}
       , m_dvpFileName   {other.m_dvpFileName   }
+#endif
+#ifdef DILIGENT_DEVELOPMENT
       , m_dvpLineNumber {other.m_dvpLineNumber }
 #endif
     // clang-format on
@@ -120,10 +126,12 @@ struct STDAllocator
 
     T* allocate(std::size_t count)
     {
-#ifndef DILIGENT_DEVELOPMENT
+#if !defined(DILIGENT_DEVELOPMENT) && !defined(DILIGENT_MEMORY_ACCOUNTING)
         static constexpr const char* m_dvpDescription = "<Unavailable in release build>";
         static constexpr const char* m_dvpFileName    = "<Unavailable in release build>";
-        static constexpr Int32       m_dvpLineNumber  = -1;
+#endif
+#ifndef DILIGENT_DEVELOPMENT
+        static constexpr Int32 m_dvpLineNumber = -1;
 #endif
         return reinterpret_cast<T*>(m_Allocator.Allocate(count * sizeof(T), m_dvpDescription, m_dvpFileName, m_dvpLineNumber));
     }
@@ -154,10 +162,14 @@ struct STDAllocator
     }
 
     AllocatorType& m_Allocator;
-#ifdef DILIGENT_DEVELOPMENT
+    // Containers copy their allocator, so the pointers are only kept in release builds when
+    // DILIGENT_MEMORY_ACCOUNTING is defined. Otherwise they would add 16 bytes to every container.
+#if defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_MEMORY_ACCOUNTING)
     const Char* const m_dvpDescription;
     const Char* const m_dvpFileName;
-    Int32 const       m_dvpLineNumber;
+#endif
+#ifdef DILIGENT_DEVELOPMENT
+    Int32 const m_dvpLineNumber;
 #endif
 };
 
@@ -0,0 +1,164 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::ScratchArena class
+
+#include <cstddef>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "../../Primitives/interface/MemoryAllocator.h"
+#include "DynamicLinearAllocator.hpp"
+#include "STDAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Linear memory arena for temporary allocations.
+
+/// The arena hands out memory from pages that are requested from the backing allocator
+/// and are retained between uses. Memory is never released individually: all allocations
+/// are discarded at once when the outermost ScratchArena::Scope ends. Once the pages are large
+/// enough to hold the peak working set, the arena makes no allocations from the backing
+/// allocator.
+///
+/// To prevent a single unusually large request from pinning its memory for the lifetime
+/// of the arena, pages that exceed MaxRetainedSize are returned to the backing allocator
+/// when the outermost scope ends.
+///
+/// The arena is not thread-safe. Typically, every thread uses its own arena.
+class ScratchArena final : public IMemoryAllocator
+{
+public:
+    explicit ScratchArena(IMemoryAllocator& Allocator, Uint32 PageSize = 16 << 10, size_t MaxRetainedSize = 1 << 20) :
+        m_LinearAllocator{Allocator, PageSize},
+        m_MaxRetainedSize{MaxRetainedSize}
+    {}
+
+    // clang-format off
+    ScratchArena           (const ScratchArena&) = delete;
+    ScratchArena           (ScratchArena&&)      = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+    ScratchArena& operator=(ScratchArena&&)      = delete;
+    // clang-format on
+
+    ~ScratchArena()
+    {
+        VERIFY(m_ScopeDepth == 0, "Scratch arena is destroyed while ", m_ScopeDepth, " scope(s) are still active");
+    }
+
+    /// Allocates memory from the arena. The memory is valid until the outermost scope ends.
+    virtual void* Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber) override final
+    {
+        VERIFY(m_ScopeDepth > 0, "Scratch arena memory must only be allocated within a scope");
+        return m_LinearAllocator.Allocate(Size, alignof(std::max_align_t));
+    }
+
+    /// Does nothing: the memory is released when the outermost scope ends.
+    virtual void Free(void* Ptr) override final
+    {
+    }
+
+    /// Returns the number of pages allocated from the backing allocator.
+    size_t GetPageCount() const
+    {
+        return m_LinearAllocator.GetBlockCount();
+    }
+
+    /// Defines the lifetime of the arena allocations.
+
+    /// Scopes may be nested, e.g. when an object is created while another one is being
+    /// created. The arena memory is reset when the outermost scope ends, so all containers
+    /// that use the arena must be destroyed before that.
+    class Scope
+    {
+    public:
+        explicit Scope(ScratchArena& Arena) noexcept :
+            m_Arena{Arena}
+        {
+            ++m_Arena.m_ScopeDepth;
+        }
+
+        // clang-format off
+        Scope           (const Scope&) = delete;
+        Scope           (Scope&&)      = delete;
+        Scope& operator=(const Scope&) = delete;
+        Scope& operator=(Scope&&)      = delete;
+        // clang-format on
+
+        ~Scope()
+        {
+            VERIFY_EXPR(m_Arena.m_ScopeDepth > 0);
+            if (--m_Arena.m_ScopeDepth == 0)
+            {
+                m_Arena.m_LinearAllocator.Discard();
+                m_Arena.m_LinearAllocator.Trim(m_Arena.m_MaxRetainedSize);
+            }
+        }
+
+        ScratchArena& GetArena() const
+        {
+            return m_Arena;
+        }
+
+        /// Returns an STL allocator that allocates memory from the arena.
+
+        /// \remarks The allocator is implicitly converted to the allocator of any type, e.g.:
+        ///
+        ///     ScratchArena::Scope        Scratch{GetThreadScratchArena()};
+        ///     ScratchVector<const char*> Names{Scratch.GetSTDAllocator()};
+        STDAllocatorRawMem<Uint8> GetSTDAllocator() const
+        {
+            return STD_ALLOCATOR_RAW_MEM(Uint8, m_Arena, "Scratch arena allocation");
+        }
+
+    private:
+        ScratchArena& m_Arena;
+    };
+
+private:
+    DynamicLinearAllocator m_LinearAllocator;
+
+    const size_t m_MaxRetainedSize;
+
+    Uint32 m_ScopeDepth = 0;
+};
+
+/// STL containers that allocate memory from the scratch arena.
+template <typename T>
+using ScratchVector = std::vector<T, STDAllocatorRawMem<T>>;
+
+template <typename KeyType, typename ValueType, typename Hasher = std::hash<KeyType>>
+using ScratchUnorderedMultimap = std::unordered_multimap<KeyType, ValueType, Hasher, std::equal_to<KeyType>, STDAllocatorRawMem<std::pair<const KeyType, ValueType>>>;
+
+template <typename KeyType, typename Hasher = std::hash<KeyType>>
+using ScratchUnorderedSet = std::unordered_set<KeyType, Hasher, std::equal_to<KeyType>, STDAllocatorRawMem<KeyType>>;
+
+} // namespace Diligent
@@ -231,10 +231,33 @@ public:
                         CountType&              Count,
                         ArrayElemSerializerType ElemSerializer);
 
+    /// Serializes an array of elements without a custom element serializer.
+    ///
+    /// Arrays of trivially serializable elements are serialized as a single block of bytes
+    /// that is aligned by the element alignment:
+    ///
+    ///  * Measure/Write
+    ///      Writes Count
+    ///      Aligns up current offset to the element alignment
+    ///      Writes Count elements
+    ///
+    ///  * Read
+    ///      Reads Count
+    ///      Aligns up current offset to the element alignment
+    ///      If the element pointer is const-qualified and the source data is properly aligned,
+    ///      sets Elements to m_Ptr, so that the elements are referenced in place without copying.
+    ///      Otherwise, allocates the array with Allocator and copies the elements.
+    ///      Moves m_Ptr by Count elements
+    ///
+    /// Other arrays are serialized element by element, see SerializeArray().
     template <typename ElemPtrType, typename CountType>
     bool SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                            ElemPtrType&            Elements,
-                           CountType&              Count);
+                           CountType&              Count)
+    {
+        using ElemType = RawType<decltype(Elements[0])>;
+        return SerializeArrayRaw(Allocator, Elements, Count, std::integral_constant<bool, IsTriviallySerializable<ElemType>::value>{});
+    }
 
     template <typename T>
     TReadOnly<T> Cast()
@@ -296,6 +319,32 @@ private:
     template <typename T>
     bool Copy(T* pData, size_t Size);
 
+    template <typename ElemPtrType, typename CountType>
+    bool SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                           ElemPtrType&            Elements,
+                           CountType&              Count,
+                           std::false_type /*IsTriviallySerializable*/);
+
+    template <typename ElemPtrType, typename CountType>
+    bool SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                           ElemPtrType&            Elements,
+                           CountType&              Count,
+                           std::true_type /*IsTriviallySerializable*/);
+
+    // Only arrays referenced through const pointers may point to the source data
+    template <typename ElemType>
+    static bool ReferenceArrayData(const ElemType*& Elements, const Uint8* pData)
+    {
+        Elements = reinterpret_cast<const ElemType*>(pData);
+        return true;
+    }
+
+    template <typename ElemType>
+    static bool ReferenceArrayData(ElemType*& /*Elements*/, const Uint8* /*pData*/)
+    {
+        return false;
+    }
+
     void AlignOffset(size_t Alignment)
     {
         const auto Size       = GetSize();
@@ -486,7 +535,8 @@ template <SerializerMode Mode>
 template <typename ElemPtrType, typename CountType>
 bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                                          ElemPtrType&            Elements,
-                                         CountType&              Count)
+                                         CountType&              Count,
+                                         std::false_type /*IsTriviallySerializable*/)
 {
     return SerializeArray(Allocator, Elements, Count,
                           [](Serializer<Mode>& Ser, auto& Elem) //
@@ -495,6 +545,58 @@ bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
                           });
 }
 
+
+template <SerializerMode Mode> // Write or Measure
+template <typename ElemPtrType, typename CountType>
+bool Serializer<Mode>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                                         ElemPtrType&            Elements,
+                                         CountType&              Count,
+                                         std::true_type /*IsTriviallySerializable*/)
+{
+    static_assert(Mode == SerializerMode::Write || Mode == SerializerMode::Measure, "Unexpected mode");
+    VERIFY_EXPR((Elements != nullptr) == (Count != 0));
+
+    if (!(*this)(Count))
+        return false;
+
+    using ElemType = RawType<decltype(Elements[0])>;
+    AlignOffset(alignof(ElemType));
+    return Copy(Elements, sizeof(ElemType) * static_cast<size_t>(Count));
+}
+
+
+template <>
+template <typename ElemPtrType, typename CountType>
+bool Serializer<SerializerMode::Read>::SerializeArrayRaw(DynamicLinearAllocator* Allocator,
+                                                         ElemPtrType&            DstArray,
+                                                         CountType&              Count,
+                                                         std::true_type /*IsTriviallySerializable*/)
+{
+    VERIFY_EXPR(DstArray == nullptr);
+
+    if (!(*this)(Count))
+        return false;
+
+    using ElemType = RawType<decltype(DstArray[0])>;
+    AlignOffset(alignof(ElemType));
+
+    const size_t Size = sizeof(ElemType) * static_cast<size_t>(Count);
+    CHECK_REMAINING_SIZE(Size, "Note enough data to read ", Count, " array elements.");
+    if (Size == 0)
+        return true;
+
+    if (reinterpret_cast<size_t>(m_Ptr) % alignof(ElemType) != 0 || !ReferenceArrayData(DstArray, m_Ptr))
+    {
+        VERIFY_EXPR(Allocator != nullptr);
+        auto* pDstElements = Allocator->Allocate<ElemType>(static_cast<size_t>(Count));
+        std::memcpy(pDstElements, m_Ptr, Size);
+        DstArray = pDstElements;
+    }
+    m_Ptr += Size;
+
+    return true;
+}
+
 #undef CHECK_REMAINING_SIZE
 
 } // namespace Diligent
@@ -27,8 +27,12 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <thread>
+#include <vector>
 
 #include "../../Primitives/interface/Object.h"
 #include "../../Platforms/Basic/interface/DebugUtilities.hpp"
@@ -107,6 +111,13 @@ public:
     ///         running the task or a deadlock will occur.
     virtual void WaitForCompletion() const = 0;
 
+    /// Waits until the task is complete or the timeout expires.
+
+    /// \param [in] TimeoutMs - The maximum time to wait, in milliseconds.
+    ///
+    /// \return     true if the task is finished, and false if the timeout has expired.
+    virtual bool WaitForCompletion(Uint32 TimeoutMs) const = 0;
+
     /// Waits until the tasks is running.
     ///
     /// \warning  An application is responsible to make sure that
@@ -115,6 +126,42 @@ public:
     ///
     ///           This method must not be called from the worker thread.
     virtual void WaitUntilRunning() const = 0;
+
+    /// Waits until the tasks is running or the timeout expires.
+
+    /// \param [in] TimeoutMs - The maximum time to wait, in milliseconds.
+    ///
+    /// \return     true if the task has been started, and false if the timeout has expired.
+    virtual bool WaitUntilRunning(Uint32 TimeoutMs) const = 0;
+
+    /// Returns the number of prerequisite tasks.
+
+    /// \remarks   The task releases its prerequisites when it starts running or
+    ///            is cancelled. After that, the method returns zero.
+    virtual Uint32 GetPrerequisiteCount() const = 0;
+
+    /// Returns the prerequisite task with the given index.
+
+    /// \param [in] Index - Prerequisite index, must be less than GetPrerequisiteCount().
+    ///
+    /// \remarks    The thread pool does not start the task until all its
+    ///             prerequisites are finished.
+    virtual IAsyncTask* GetPrerequisite(Uint32 Index) const = 0;
+
+    /// Adds a function that will be called when the task is finished.
+
+    /// \param [in] Continuation - The function to call. The function takes the pointer
+    ///                            to this task as the argument.
+    ///
+    /// \remarks    The continuation is called from the thread that sets the task status
+    ///             to ASYNC_TASK_STATUS_COMPLETE or ASYNC_TASK_STATUS_CANCELLED.
+    ///             If the task is already finished, the continuation is called immediately
+    ///             from the calling thread.
+    ///
+    ///             The thread pool uses continuations to start the task's dependents.
+    ///             An application may use them as completion callbacks instead of
+    ///             blocking a thread in WaitForCompletion().
+    virtual void AddContinuation(std::function<void(IAsyncTask*)> Continuation) = 0;
 };
 
 
@@ -132,6 +179,16 @@ public:
     ///
     /// \remarks   Thread pool will keep a strong reference to the task,
     ///            so an application is free to release it after enqueuing.
+    ///
+    ///            If the task has prerequisites (see IAsyncTask::GetPrerequisite),
+    ///            it is added to the queue only after the last prerequisite
+    ///            is finished. Until then, the task does not occupy a worker thread.
+    ///            If any of the prerequisites is cancelled, the task is cancelled
+    ///            without being run, which in turn cancels its own dependents.
+    ///
+    ///            An application is responsible to make sure that all prerequisites
+    ///            will be finished eventually, for example, by enqueuing them
+    ///            into this or another thread pool.
     virtual void EnqueueTask(IAsyncTask* pTask) = 0;
 
 
@@ -169,14 +226,20 @@ public:
 
     /// \remarks    The method blocks the calling thread until all
     ///             tasks in the quque are finished and the queue is empty.
+    ///             Tasks waiting for their prerequisites are also waited for.
     ///             An application is responsible to make sure that all tasks
     ///             will finish eventually.
     virtual void WaitForAllTasks() = 0;
 
 
     /// Returns the current queue size.
+
+    /// \remarks    Tasks waiting for their prerequisites are not counted.
     virtual Uint32 GetQueueSize() = 0;
 
+    /// Returns the number of tasks waiting for their prerequisites to finish.
+    virtual Uint32 GetWaitingTaskCount() const = 0;
+
     /// Returns the number of currently running tasks
     virtual Uint32 GetRunningTaskCount() const = 0;
 
@@ -261,6 +324,27 @@ struct ThreadPoolCreateInfo
     /// An optional function that will be called by the thread pool from
     /// the worker thread before the worker thread exits.
     std::function<void(Uint32)> OnThreadExiting = nullptr;
+
+    /// Whether to use the work-stealing scheduler.
+
+    /// \remarks    By default, all tasks are kept in a single priority queue that
+    ///             all worker threads contend on. When work stealing is enabled,
+    ///             every worker thread owns a local task queue:
+    ///             - Tasks enqueued from a worker thread of this pool (e.g. by another task)
+    ///               are added to the local queue of that thread and are processed
+    ///               in LIFO order.
+    ///             - Tasks enqueued from any other thread are added to the shared
+    ///               priority queue.
+    ///             - An idle worker first drains its local queue, then the shared queue,
+    ///               and then steals the oldest tasks from other workers.
+    ///
+    ///             Task priorities are only respected within the shared queue.
+    ///             When a task in a local queue is reprioritized, it is moved to the shared queue.
+    ///
+    ///             Threads that call IThreadPool::ProcessTask() manually with ThreadId
+    ///             greater than or equal to NumThreads do not have local queues, but
+    ///             can still process tasks from the shared queue and steal from other threads.
+    bool EnableWorkStealing = false;
 };
 
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI);
@@ -322,7 +406,39 @@ public:
             }
         }
 #endif
+        // Once the task has left the NOT_STARTED state, its prerequisites are finished
+        // and are no longer needed. Holding them would keep every ancestor in a long
+        // chain of continuations alive.
+        if (Status != ASYNC_TASK_STATUS_NOT_STARTED)
+            m_Prerequisites.clear();
+
         m_TaskStatus.store(Status);
+
+        // NB: the status must be stored before the number of waiting threads is checked.
+        //     WaitForStatus() increments the number of waiting threads first and then checks
+        //     the status, so at least one of the two threads is guaranteed to see the
+        //     modification made by the other one.
+        if (m_NumWaitingThreads.load() > 0)
+        {
+            {
+                // Acquiring the mutex guarantees that the waiting thread that has
+                // incremented m_NumWaitingThreads is now waiting on the condition variable.
+                std::lock_guard<std::mutex> Guard{m_StatusMtx};
+            }
+            m_StatusCond.notify_all();
+        }
+
+        if (Status == ASYNC_TASK_STATUS_COMPLETE || Status == ASYNC_TASK_STATUS_CANCELLED)
+        {
+            std::vector<std::function<void(IAsyncTask*)>> Continuations;
+            {
+                std::lock_guard<std::mutex> Guard{m_StatusMtx};
+                m_ContinuationsCalled = true;
+                Continuations.swap(m_Continuations);
+            }
+            for (auto& Continuation : Continuations)
+                Continuation(this);
+        }
     }
 
     ASYNC_TASK_STATUS GetStatus() const override final
@@ -349,27 +465,116 @@ public:
 
     virtual void WaitForCompletion() const override final
     {
-        while (!IsFinished())
-            std::this_thread::yield();
+        WaitForStatus(ASYNC_TASK_STATUS_CANCELLED, nullptr);
+    }
+
+    virtual bool WaitForCompletion(Uint32 TimeoutMs) const override final
+    {
+        const auto Timeout = std::chrono::milliseconds{TimeoutMs};
+        return WaitForStatus(ASYNC_TASK_STATUS_CANCELLED, &Timeout);
     }
 
     virtual void WaitUntilRunning() const override final
     {
-        while (GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED)
-            std::this_thread::yield();
+        WaitForStatus(ASYNC_TASK_STATUS_RUNNING, nullptr);
+    }
+
+    virtual bool WaitUntilRunning(Uint32 TimeoutMs) const override final
+    {
+        const auto Timeout = std::chrono::milliseconds{TimeoutMs};
+        return WaitForStatus(ASYNC_TASK_STATUS_RUNNING, &Timeout);
+    }
+
+    virtual Uint32 GetPrerequisiteCount() const override final
+    {
+        return static_cast<Uint32>(m_Prerequisites.size());
+    }
+
+    virtual IAsyncTask* GetPrerequisite(Uint32 Index) const override final
+    {
+        VERIFY_EXPR(Index < m_Prerequisites.size());
+        return m_Prerequisites[Index];
+    }
+
+    virtual void AddContinuation(std::function<void(IAsyncTask*)> Continuation) override final
+    {
+        VERIFY_EXPR(Continuation);
+        {
+            std::lock_guard<std::mutex> Guard{m_StatusMtx};
+            if (!m_ContinuationsCalled)
+            {
+                m_Continuations.emplace_back(std::move(Continuation));
+                return;
+            }
+        }
+        // The task is already finished
+        Continuation(this);
+    }
+
+    /// Adds a prerequisite task.
+
+    /// \remarks    Prerequisites must be added before the task is enqueued into the thread pool.
+    void AddPrerequisite(IAsyncTask* pPrerequisite)
+    {
+        DEV_CHECK_ERR(pPrerequisite != nullptr, "Prerequisite must not be null");
+        DEV_CHECK_ERR(pPrerequisite != this, "A task can't be a prerequisite of itself");
+        DEV_CHECK_ERR(GetStatus() == ASYNC_TASK_STATUS_NOT_STARTED, "Prerequisites must be added before the task is started");
+        m_Prerequisites.emplace_back(pPrerequisite);
     }
 
 protected:
     std::atomic<bool> m_bSafelyCancel{false};
 
+private:
+    // Waits until the task status is greater than or equal to MinStatus.
+    // The thread spins for a short time and then parks on the condition variable.
+    // Returns false if the timeout has expired.
+    bool WaitForStatus(ASYNC_TASK_STATUS MinStatus, const std::chrono::milliseconds* pTimeout) const;
+
 private:
     std::atomic<float>             m_fPriority{0};
     std::atomic<ASYNC_TASK_STATUS> m_TaskStatus{ASYNC_TASK_STATUS_NOT_STARTED};
+
+    // Only accessed while the task is NOT_STARTED and cleared by SetStatus()
+    std::vector<RefCntAutoPtr<IAsyncTask>> m_Prerequisites;
+
+    // Protects continuations and is used to park waiting threads
+    mutable std::mutex                            m_StatusMtx;
+    mutable std::condition_variable               m_StatusCond;
+    mutable std::atomic<int>                      m_NumWaitingThreads{0};
+    std::vector<std::function<void(IAsyncTask*)>> m_Continuations;
+    bool                                          m_ContinuationsCalled = false;
 };
 
 
+/// Enqueues the handler function as an asynchronous task that will run
+/// after all prerequisite tasks are finished.
+
+/// \param [in] pThreadPool      - Thread pool to run the task.
+/// \param [in] ppPrerequisites  - An array of prerequisite tasks.
+/// \param [in] NumPrerequisites - The number of elements in ppPrerequisites array.
+/// \param [in] Handler          - Handler function to run. It takes the thread id as the argument.
+/// \param [in] fPriority        - Task priority.
+///
+/// \return     The asynchronous task that can be used as a prerequisite of other tasks.
+///
+/// \remarks    If any of the prerequisites is cancelled, the task will also be cancelled.
+///
+///             Example of a pipeline that does not block worker threads:
+///
+///                 auto pCompile = EnqueueAsyncWork(pThreadPool, CompileShader);
+///
+///                 IAsyncTask* ReflectPrereqs[] = {pCompile};
+///                 auto pReflect = EnqueueAsyncWork(pThreadPool, ReflectPrereqs, 1, ReflectShader);
+///
+///                 IAsyncTask* PSOPrereqs[] = {pReflect, pLoadRenderStates};
+///                 auto pCreatePSO = EnqueueAsyncWork(pThreadPool, PSOPrereqs, 2, CreatePSO);
 template <typename HanlderType>
-RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType Handler, float fPriority = 0)
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool*       pThreadPool,
+                                           IAsyncTask* const* ppPrerequisites,
+                                           Uint32             NumPrerequisites,
+                                           HanlderType        Handler,
+                                           float              fPriority = 0)
 {
     class TaskImpl final : public AsyncTaskBase
     {
@@ -392,9 +597,17 @@ RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType
     };
 
     RefCntAutoPtr<TaskImpl> pTask{MakeNewRCObj<TaskImpl>()(fPriority, std::move(Handler))};
+    for (Uint32 i = 0; i < NumPrerequisites; ++i)
+        pTask->AddPrerequisite(ppPrerequisites[i]);
     pThreadPool->EnqueueTask(pTask);
 
     return pTask;
 }
 
+template <typename HanlderType>
+RefCntAutoPtr<IAsyncTask> EnqueueAsyncWork(IThreadPool* pThreadPool, HanlderType Handler, float fPriority = 0)
+{
+    return EnqueueAsyncWork(pThreadPool, nullptr, 0, std::move(Handler), fPriority);
+}
+
 } // namespace Diligent
@@ -29,8 +29,10 @@
 #include <algorithm>
 
 #include "Intrinsics.hpp"
+#include "BasicMathSIMD.hpp"
 #include "DebugUtilities.hpp"
 #include "Align.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -38,23 +40,58 @@ namespace Diligent
 namespace
 {
 
-void GetArray2DMinMaxValueGeneric(const float* pData,
+// Updates MinValue with the minimum value of pMinData and MaxValue with the maximum value of pMaxData.
+// Both pointers are the same for the source array, and differ for the levels of the min/max pyramid.
+void AccumulateArray2DMinMaxValue(const float* pMinData,
+                                  const float* pMaxData,
                                   size_t       StrideInFloats,
                                   Uint32       Width,
                                   Uint32       Height,
                                   float&       MinValue,
                                   float&       MaxValue)
 {
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    // Note that _mm_min_ps/_mm_max_ps return the second operand if either operand is NaN,
+    // so keeping the accumulator second ignores NaNs the same way as std::min/std::max do.
+    __m128 mMin0 = _mm_set1_ps(MinValue);
+    __m128 mMax0 = _mm_set1_ps(MaxValue);
+    __m128 mMin1 = mMin0;
+    __m128 mMax1 = mMax0;
+#endif
     for (size_t row = 0; row < Height; ++row)
     {
-        const auto* pRowStart = pData + row * StrideInFloats;
-        const auto* pRowEnd   = pRowStart + Width;
-        for (const auto* ptr = pRowStart; ptr < pRowEnd; ++ptr)
+        const float* pMinRow = pMinData + row * StrideInFloats;
+        const float* pMaxRow = pMaxData + row * StrideInFloats;
+
+        Uint32 col = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+        for (; col + 8 <= Width; col += 8)
         {
-            MinValue = std::min(MinValue, *ptr);
-            MaxValue = std::max(MaxValue, *ptr);
+            mMin0 = _mm_min_ps(_mm_loadu_ps(pMinRow + col), mMin0);
+            mMin1 = _mm_min_ps(_mm_loadu_ps(pMinRow + col + 4), mMin1);
+            mMax0 = _mm_max_ps(_mm_loadu_ps(pMaxRow + col), mMax0);
+            mMax1 = _mm_max_ps(_mm_loadu_ps(pMaxRow + col + 4), mMax1);
+        }
+#endif
+        for (; col < Width; ++col)
+        {
+            MinValue = std::min(MinValue, pMinRow[col]);
+            MaxValue = std::max(MaxValue, pMaxRow[col]);
         }
     }
+
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    mMin0 = _mm_min_ps(mMin0, mMin1);
+    mMax0 = _mm_max_ps(mMax0, mMax1);
+    // | A | B | C | D |  =>  | B | A | D | C |
+    mMin0 = _mm_min_ps(mMin0, _mm_shuffle_ps(mMin0, mMin0, _MM_SHUFFLE(2, 3, 0, 1)));
+    mMax0 = _mm_max_ps(mMax0, _mm_shuffle_ps(mMax0, mMax0, _MM_SHUFFLE(2, 3, 0, 1)));
+    // | AB | AB | CD | CD |  =>  | CD | CD | AB | AB |
+    mMin0 = _mm_min_ps(mMin0, _mm_shuffle_ps(mMin0, mMin0, _MM_SHUFFLE(1, 0, 3, 2)));
+    mMax0 = _mm_max_ps(mMax0, _mm_shuffle_ps(mMax0, mMax0, _MM_SHUFFLE(1, 0, 3, 2)));
+    MinValue = std::min(_mm_cvtss_f32(mMin0), MinValue);
+    MaxValue = std::max(_mm_cvtss_f32(mMax0), MaxValue);
+#endif
 }
 
 #if DILIGENT_AVX2_ENABLED
@@ -149,7 +186,297 @@ void GetArray2DMinMaxValue(const float* pData,
         return;
 #endif
 
-    GetArray2DMinMaxValueGeneric(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+    AccumulateArray2DMinMaxValue(pData, pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+}
+
+void GetArray2DMinMaxValueParallel(IThreadPool* pThreadPool,
+                                   Uint32       NumTasks,
+                                   const float* pData,
+                                   size_t       StrideInFloats,
+                                   Uint32       Width,
+                                   Uint32       Height,
+                                   float&       MinValue,
+                                   float&       MaxValue)
+{
+    if (Width == 0 || Height == 0)
+        return;
+
+    // The minimum number of elements processed by one task
+    constexpr Uint32 MinElementsPerTask = 65536;
+
+    const Uint32 MaxTasks  = static_cast<Uint32>(std::min(std::max(size_t{Width} * Height / MinElementsPerTask, size_t{1}), size_t{Height}));
+    const Uint32 TaskCount = pThreadPool != nullptr ? std::min(std::max(NumTasks, 1u), MaxTasks) : 1;
+    if (TaskCount <= 1)
+    {
+        GetArray2DMinMaxValue(pData, StrideInFloats, Width, Height, MinValue, MaxValue);
+        return;
+    }
+
+    struct RangeMinMax
+    {
+        float Min;
+        float Max;
+    };
+    std::vector<RangeMinMax> Results(TaskCount);
+
+    const Uint32 RowsPerTask = (Height + TaskCount - 1) / TaskCount;
+
+    const auto ProcessRange = [&](Uint32 Task) {
+        const Uint32 FirstRow = Task * RowsPerTask;
+        const Uint32 NumRows  = std::min(RowsPerTask, Height - FirstRow);
+        // Reduce into locals and write the result once, so that the tasks
+        // do not share the cache line of the results while they run.
+        float RangeMin = 0;
+        float RangeMax = 0;
+        GetArray2DMinMaxValue(pData + FirstRow * StrideInFloats, StrideInFloats, Width, NumRows, RangeMin, RangeMax);
+        Results[Task] = {RangeMin, RangeMax};
+    };
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(TaskCount - 1);
+    for (Uint32 Task = 1; Task < TaskCount && Task * RowsPerTask < Height; ++Task)
+    {
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&ProcessRange, Task](Uint32) {
+                                                ProcessRange(Task);
+                                            }));
+    }
+
+    ProcessRange(0);
+
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+
+    MinValue = Results[0].Min;
+    MaxValue = Results[0].Max;
+    for (size_t i = 1; i <= Tasks.size(); ++i)
+    {
+        MinValue = std::min(MinValue, Results[i].Min);
+        MaxValue = std::max(MaxValue, Results[i].Max);
+    }
+}
+
+
+namespace
+{
+
+// Computes elements [X0, X1) of a coarse pyramid row from two rows of the finer level.
+template <bool IsMax>
+void ReduceRowPair(const float* pRow0,
+                   const float* pRow1,
+                   Uint32       FineWidth,
+                   float*       pDst,
+                   Uint32       X0,
+                   Uint32       X1)
+{
+    Uint32 x = X0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    const auto Op = [](__m128 a, __m128 b) {
+        return IsMax ? _mm_max_ps(a, b) : _mm_min_ps(a, b);
+    };
+    for (; x + 4 <= X1 && (x + 4) * 2 <= FineWidth; x += 4)
+    {
+        const __m128 v0 = Op(_mm_loadu_ps(pRow0 + x * 2), _mm_loadu_ps(pRow1 + x * 2));
+        const __m128 v1 = Op(_mm_loadu_ps(pRow0 + x * 2 + 4), _mm_loadu_ps(pRow1 + x * 2 + 4));
+
+        const __m128 Even = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(2, 0, 2, 0));
+        const __m128 Odd  = _mm_shuffle_ps(v0, v1, _MM_SHUFFLE(3, 1, 3, 1));
+        _mm_storeu_ps(pDst + x, Op(Even, Odd));
+    }
+#endif
+    for (; x < X1; ++x)
+    {
+        const Uint32 c0 = x * 2;
+        const Uint32 c1 = std::min(x * 2 + 1, FineWidth - 1);
+        if (IsMax)
+            pDst[x] = std::max(std::max(pRow0[c0], pRow0[c1]), std::max(pRow1[c0], pRow1[c1]));
+        else
+            pDst[x] = std::min(std::min(pRow0[c0], pRow0[c1]), std::min(pRow1[c0], pRow1[c1]));
+    }
+}
+
+} // namespace
+
+Array2DMinMaxPyramid::Array2DMinMaxPyramid(const float* pData,
+                                           size_t       StrideInFloats,
+                                           Uint32       Width,
+                                           Uint32       Height)
+{
+    Reset(pData, StrideInFloats, Width, Height);
+}
+
+void Array2DMinMaxPyramid::Reset(const float* pData,
+                                 size_t       StrideInFloats,
+                                 Uint32       Width,
+                                 Uint32       Height)
+{
+    DEV_CHECK_ERR(pData != nullptr || Width == 0 || Height == 0, "Data pointer must not be null");
+    DEV_CHECK_ERR(Height <= 1 || StrideInFloats >= Width, "Row stride (", StrideInFloats, ") must be at least ", Width);
+
+    m_Levels.clear();
+    if (pData == nullptr || Width == 0 || Height == 0)
+    {
+        m_pData          = nullptr;
+        m_StrideInFloats = 0;
+        m_Width          = 0;
+        m_Height         = 0;
+        return;
+    }
+
+    m_pData          = pData;
+    m_StrideInFloats = StrideInFloats;
+    m_Width          = Width;
+    m_Height         = Height;
+
+    while (Width > 1 || Height > 1)
+    {
+        Width  = (Width + 1) / 2;
+        Height = (Height + 1) / 2;
+
+        LevelData Level;
+        Level.Width  = Width;
+        Level.Height = Height;
+        Level.Min.resize(size_t{Width} * Height);
+        Level.Max.resize(size_t{Width} * Height);
+        m_Levels.emplace_back(std::move(Level));
+
+        UpdateLevel(m_Levels.size(), 0, 0, Width, Height);
+    }
+}
+
+void Array2DMinMaxPyramid::UpdateLevel(size_t Level, Uint32 X0, Uint32 Y0, Uint32 X1, Uint32 Y1)
+{
+    VERIFY_EXPR(Level >= 1 && Level <= m_Levels.size());
+    auto& Dst = m_Levels[Level - 1];
+
+    const float* pFineMin   = m_pData;
+    const float* pFineMax   = m_pData;
+    size_t       FineStride = m_StrideInFloats;
+    Uint32       FineWidth  = m_Width;
+    Uint32       FineHeight = m_Height;
+    if (Level > 1)
+    {
+        const auto& Fine = m_Levels[Level - 2];
+
+        pFineMin   = Fine.Min.data();
+        pFineMax   = Fine.Max.data();
+        FineStride = Fine.Width;
+        FineWidth  = Fine.Width;
+        FineHeight = Fine.Height;
+    }
+
+    for (Uint32 y = Y0; y < Y1; ++y)
+    {
+        const size_t Row0 = size_t{y} * 2 * FineStride;
+        const size_t Row1 = size_t{std::min(y * 2 + 1, FineHeight - 1)} * FineStride;
+
+        ReduceRowPair<false>(pFineMin + Row0, pFineMin + Row1, FineWidth, &Dst.Min[size_t{y} * Dst.Width], X0, X1);
+        ReduceRowPair<true>(pFineMax + Row0, pFineMax + Row1, FineWidth, &Dst.Max[size_t{y} * Dst.Width], X0, X1);
+    }
+}
+
+void Array2DMinMaxPyramid::Update(Uint32 X,
+                                  Uint32 Y,
+                                  Uint32 RegionWidth,
+                                  Uint32 RegionHeight)
+{
+    Uint32 X0 = std::min(X, m_Width);
+    Uint32 Y0 = std::min(Y, m_Height);
+    Uint32 X1 = X0 + std::min(RegionWidth, m_Width - X0);
+    Uint32 Y1 = Y0 + std::min(RegionHeight, m_Height - Y0);
+    if (X0 >= X1 || Y0 >= Y1)
+        return;
+
+    for (size_t Level = 1; Level <= m_Levels.size(); ++Level)
+    {
+        X0 /= 2;
+        Y0 /= 2;
+        X1 = (X1 + 1) / 2;
+        Y1 = (Y1 + 1) / 2;
+        UpdateLevel(Level, X0, Y0, X1, Y1);
+    }
+}
+
+bool Array2DMinMaxPyramid::GetMinMax(Uint32 X,
+                                     Uint32 Y,
+                                     Uint32 RectWidth,
+                                     Uint32 RectHeight,
+                                     float& MinValue,
+                                     float& MaxValue) const
+{
+    Uint32 X0 = std::min(X, m_Width);
+    Uint32 Y0 = std::min(Y, m_Height);
+    Uint32 X1 = X0 + std::min(RectWidth, m_Width - X0);
+    Uint32 Y1 = Y0 + std::min(RectHeight, m_Height - Y0);
+    if (X0 >= X1 || Y0 >= Y1)
+        return false;
+
+    float Min = m_pData[Y0 * m_StrideInFloats + X0];
+    float Max = Min;
+
+    // Accumulates the rectangle [x0, x1) x [y0, y1) of the given level
+    const auto AccumulateRect = [&](size_t Level, Uint32 x0, Uint32 y0, Uint32 x1, Uint32 y1) {
+        if (Level == 0)
+        {
+            const float* pData = m_pData + y0 * m_StrideInFloats + x0;
+            AccumulateArray2DMinMaxValue(pData, pData, m_StrideInFloats, x1 - x0, y1 - y0, Min, Max);
+        }
+        else
+        {
+            const auto&  Data   = m_Levels[Level - 1];
+            const size_t Offset = size_t{y0} * Data.Width + x0;
+            AccumulateArray2DMinMaxValue(&Data.Min[Offset], &Data.Max[Offset], Data.Width, x1 - x0, y1 - y0, Min, Max);
+        }
+    };
+
+    // Starting from the array itself, process the rows and columns along the rectangle border that
+    // are not covered by whole elements of the next level, and move to the next level.
+    for (size_t Level = 0;; ++Level)
+    {
+        const Uint32 LevelWidth  = Level == 0 ? m_Width : m_Levels[Level - 1].Width;
+        const Uint32 LevelHeight = Level == 0 ? m_Height : m_Levels[Level - 1].Height;
+        if (Level == m_Levels.size())
+        {
+            AccumulateRect(Level, X0, Y0, X1, Y1);
+            break;
+        }
+
+        // Note that the last element of the odd-sized level is covered by the last element of the next level
+        if ((X0 & 1) != 0)
+        {
+            AccumulateRect(Level, X0, Y0, X0 + 1, Y1);
+            ++X0;
+        }
+        if ((X1 & 1) != 0 && X1 != LevelWidth && X0 < X1)
+        {
+            AccumulateRect(Level, X1 - 1, Y0, X1, Y1);
+            --X1;
+        }
+        if (X0 >= X1)
+            break;
+
+        if ((Y0 & 1) != 0)
+        {
+            AccumulateRect(Level, X0, Y0, X1, Y0 + 1);
+            ++Y0;
+        }
+        if ((Y1 & 1) != 0 && Y1 != LevelHeight && Y0 < Y1)
+        {
+            AccumulateRect(Level, X0, Y1 - 1, X1, Y1);
+            --Y1;
+        }
+        if (Y0 >= Y1)
+            break;
+
+        X0 /= 2;
+        Y0 /= 2;
+        X1 = (X1 + 1) / 2;
+        Y1 = (Y1 + 1) / 2;
+    }
+
+    MinValue = Min;
+    MaxValue = Max;
+    return true;
 }
 
 } // namespace Diligent
@@ -0,0 +1,268 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BlockCompression.hpp"
+
+#include <cstring>
+#include <algorithm>
+
+#include "../../Primitives/interface/BasicTypes.h"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// Block format:
+//
+//  | Sequence 0 | Sequence 1 | ... | Last sequence |
+//
+//      | Sequence | = | Token | Literal length* | Literals | Offset | Match length* |
+//
+//          Token          - the high 4 bits contain the literal length, the low 4 bits contain the match length minus MinMatch.
+//                           The value of 15 in either field indicates that the length continues in the following bytes.
+//          Literal length - optional extra bytes of the literal length: each byte is added to the length,
+//                           and the byte value of 255 indicates that another byte follows.
+//          Offset         - 16-bit little-endian distance from the current position to the start of the match.
+//          Match length   - optional extra bytes of the match length, encoded the same way as the literal length.
+//
+//      | Last sequence | = | Token | Literal length* | Literals |
+//
+// The encoder follows the LZ4 end-of-block rules: the last 5 bytes are always literals and the
+// last match starts at least 12 bytes before the end of the block.
+
+constexpr size_t MinMatch     = 4;
+constexpr size_t LastLiterals = 5;
+constexpr size_t MFLimit      = 12;
+constexpr size_t MaxOffset    = 65535;
+
+constexpr Uint32 HashLog       = 12;
+constexpr size_t HashTableSize = size_t{1} << HashLog;
+
+inline Uint32 Read32(const Uint8* p)
+{
+    Uint32 Val;
+    memcpy(&Val, p, sizeof(Val));
+    return Val;
+}
+
+inline Uint32 HashSequence(Uint32 Seq)
+{
+    return (Seq * 2654435761u) >> (32 - HashLog);
+}
+
+inline size_t GetLengthSize(size_t Length)
+{
+    return Length >= 15 ? (Length - 15) / 255 + 1 : 0;
+}
+
+inline Uint8* WriteLength(Uint8* pDst, size_t Length)
+{
+    for (Length -= 15; Length >= 255; Length -= 255)
+        *(pDst++) = 255;
+    *(pDst++) = static_cast<Uint8>(Length);
+    return pDst;
+}
+
+inline bool ReadLength(const Uint8*& pSrc, const Uint8* pSrcEnd, size_t& Length)
+{
+    Uint8 Byte = 0;
+    do
+    {
+        if (pSrc >= pSrcEnd)
+            return false;
+        Byte = *(pSrc++);
+        Length += Byte;
+    } while (Byte == 255);
+    return true;
+}
+
+} // namespace
+
+size_t GetCompressedBlockBound(size_t SrcSize)
+{
+    return SrcSize + SrcSize / 255 + 16;
+}
+
+size_t CompressBlock(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize)
+{
+    const auto* const pSrcData = static_cast<const Uint8*>(pSrc);
+    auto* const       pDstData = static_cast<Uint8*>(pDst);
+    auto*             pOut     = pDstData;
+    auto* const       pOutEnd  = pDstData + DstSize;
+
+    size_t Anchor = 0;
+
+    auto WriteSequence = [&](size_t LiteralsEnd, size_t Offset, size_t MatchLength) {
+        const auto   LiteralLength = LiteralsEnd - Anchor;
+        const size_t SeqSize =
+            1 + GetLengthSize(LiteralLength) + LiteralLength +
+            (MatchLength != 0 ? 2 + GetLengthSize(MatchLength - MinMatch) : 0);
+        if (SeqSize > static_cast<size_t>(pOutEnd - pOut))
+            return false;
+
+        auto* pToken = pOut++;
+        *pToken      = static_cast<Uint8>(std::min(LiteralLength, size_t{15}) << 4);
+        if (LiteralLength >= 15)
+            pOut = WriteLength(pOut, LiteralLength);
+
+        if (LiteralLength > 0)
+            memcpy(pOut, pSrcData + Anchor, LiteralLength);
+        pOut += LiteralLength;
+
+        if (MatchLength != 0)
+        {
+            *(pOut++) = static_cast<Uint8>(Offset & 0xFF);
+            *(pOut++) = static_cast<Uint8>(Offset >> 8);
+
+            const auto Length = MatchLength - MinMatch;
+            *pToken |= static_cast<Uint8>(std::min(Length, size_t{15}));
+            if (Length >= 15)
+                pOut = WriteLength(pOut, Length);
+        }
+
+        return true;
+    };
+
+    if (SrcSize > MFLimit)
+    {
+        // Positions of the most recent 4-byte sequences with the given hash.
+        // Initial zeros are harmless since every candidate is verified.
+        Uint32 HashTable[HashTableSize] = {};
+
+        const auto MatchStartLimit = SrcSize - MFLimit;
+        const auto MatchEndLimit   = SrcSize - LastLiterals;
+
+        size_t Pos = 1;
+        while (Pos <= MatchStartLimit)
+        {
+            const auto Seq  = Read32(pSrcData + Pos);
+            auto&      Slot = HashTable[HashSequence(Seq)];
+            size_t     Ref  = Slot;
+            Slot            = static_cast<Uint32>(Pos);
+
+            if (Ref >= Pos || Pos - Ref > MaxOffset || Read32(pSrcData + Ref) != Seq)
+            {
+                // Skip faster through the data that does not compress
+                Pos += 1 + ((Pos - Anchor) >> 6);
+                continue;
+            }
+
+            // Extend the match backwards into the pending literals
+            while (Pos > Anchor && Ref > 0 && pSrcData[Pos - 1] == pSrcData[Ref - 1])
+            {
+                --Pos;
+                --Ref;
+            }
+
+            size_t MatchLength = MinMatch;
+            while (Pos + MatchLength < MatchEndLimit && pSrcData[Pos + MatchLength] == pSrcData[Ref + MatchLength])
+                ++MatchLength;
+
+            if (!WriteSequence(Pos, Pos - Ref, MatchLength))
+                return 0;
+
+            Pos += MatchLength;
+            Anchor = Pos;
+
+            // Index a position inside the match to improve the chances of finding the next one
+            if (Pos <= MatchStartLimit)
+                HashTable[HashSequence(Read32(pSrcData + Pos - 2))] = static_cast<Uint32>(Pos - 2);
+        }
+    }
+
+    if (!WriteSequence(SrcSize, 0, 0))
+        return 0;
+
+    return static_cast<size_t>(pOut - pDstData);
+}
+
+bool DecompressBlock(const void* pSrc, size_t SrcSize, void* pDst, size_t DstSize)
+{
+    const auto*       pIn      = static_cast<const Uint8*>(pSrc);
+    const auto* const pInEnd   = pIn + SrcSize;
+    auto* const       pDstData = static_cast<Uint8*>(pDst);
+    auto*             pOut     = pDstData;
+    auto* const       pOutEnd  = pDstData + DstSize;
+
+    while (pIn < pInEnd)
+    {
+        const auto Token = *(pIn++);
+
+        size_t LiteralLength = Token >> 4;
+        if (LiteralLength == 15 && !ReadLength(pIn, pInEnd, LiteralLength))
+            return false;
+
+        if (LiteralLength > static_cast<size_t>(pInEnd - pIn) || LiteralLength > static_cast<size_t>(pOutEnd - pOut))
+            return false;
+
+        if (LiteralLength > 0)
+            memcpy(pOut, pIn, LiteralLength);
+        pIn += LiteralLength;
+        pOut += LiteralLength;
+
+        if (pIn == pInEnd)
+        {
+            // The last sequence contains only literals
+            return pOut == pOutEnd;
+        }
+
+        if (pInEnd - pIn < 2)
+            return false;
+
+        const size_t Offset = size_t{pIn[0]} | (size_t{pIn[1]} << 8);
+        pIn += 2;
+        if (Offset == 0 || Offset > static_cast<size_t>(pOut - pDstData))
+            return false;
+
+        size_t MatchLength = Token & 0x0F;
+        if (MatchLength == 15 && !ReadLength(pIn, pInEnd, MatchLength))
+            return false;
+        MatchLength += MinMatch;
+
+        if (MatchLength > static_cast<size_t>(pOutEnd - pOut))
+            return false;
+
+        const auto* pMatch = pOut - Offset;
+        if (Offset >= MatchLength)
+        {
+            memcpy(pOut, pMatch, MatchLength);
+            pOut += MatchLength;
+        }
+        else
+        {
+            // Overlapping match repeats the last Offset bytes
+            for (const auto* pMatchEnd = pOut + MatchLength; pOut != pMatchEnd;)
+                *(pOut++) = *(pMatch++);
+        }
+    }
+
+    // Valid block always ends with the literals-only sequence
+    return false;
+}
+
+} // namespace Diligent
@@ -27,6 +27,7 @@
 
 #include "pch.h"
 #include <algorithm>
+#include <atomic>
 #include "FixedBlockMemoryAllocator.hpp"
 #include "Align.hpp"
 
@@ -171,7 +172,8 @@ static size_t AdjustBlockSize(size_t BlockSize)
 
 FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemoryAllocator,
                                                      size_t            BlockSize,
-                                                     Uint32            NumBlocksInPage) :
+                                                     Uint32            NumBlocksInPage,
+                                                     bool              EnableThreadCache) :
     // clang-format off
     m_PagePool          (STD_ALLOCATOR_RAW_MEM(MemoryPage, RawMemoryAllocator, "Allocator for vector<MemoryPage>")),
     m_AvailablePages    (STD_ALLOCATOR_RAW_MEM(size_t, RawMemoryAllocator, "Allocator for unordered_set<size_t>") ),
@@ -185,11 +187,38 @@ FixedBlockMemoryAllocator::FixedBlockMemoryAllocator(IMemoryAllocator& RawMemory
     if (m_BlockSize > 0)
     {
         CreateNewPage();
+
+        if (EnableThreadCache)
+        {
+            m_ThreadCaches = reinterpret_cast<ThreadCache**>(
+                m_RawMemoryAllocator.Allocate(sizeof(ThreadCache*) * MaxThreadCaches, "Memory for FixedBlockMemoryAllocator thread caches", __FILE__, __LINE__));
+            for (Uint32 i = 0; i < MaxThreadCaches; ++i)
+                m_ThreadCaches[i] = nullptr;
+        }
     }
 }
 
 FixedBlockMemoryAllocator::~FixedBlockMemoryAllocator()
 {
+    if (m_ThreadCaches != nullptr)
+    {
+        // Return all cached blocks to the pages
+        for (Uint32 i = 0; i < MaxThreadCaches; ++i)
+        {
+            auto* pCache = m_ThreadCaches[i];
+            if (pCache == nullptr)
+                continue;
+
+            for (Uint32 b = 0; b < pCache->NumBlocks; ++b)
+                FreeToPages(pCache->Blocks[b]);
+            auto* pRawMem = pCache->pRawMem;
+            pCache->~ThreadCache();
+            m_RawMemoryAllocator.Free(pRawMem);
+        }
+        m_RawMemoryAllocator.Free(m_ThreadCaches);
+        m_ThreadCaches = nullptr;
+    }
+
 #ifdef DILIGENT_DEBUG
     for (size_t p = 0; p < m_PagePool.size(); ++p)
     {
@@ -207,15 +236,68 @@ void FixedBlockMemoryAllocator::CreateNewPage()
     m_AddrToPageId.reserve(m_PagePool.size() * m_NumBlocksInPage);
 }
 
-void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+Uint32 FixedBlockMemoryAllocator::GetThreadSlot()
 {
-    VERIFY_EXPR(Size > 0);
+    // Cache slots are shared by all allocators. Every thread acquires a slot when it uses any
+    // allocator with thread cache for the first time and releases it when it exits. A slot is
+    // owned by at most one thread at a time, so the caches need no synchronization. The
+    // acquire/release pair makes the caches of an exited thread visible to the next owner.
+    static std::atomic<bool> SlotUsed[MaxThreadCaches];
 
-    Size = AdjustBlockSize(Size);
-    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+    struct ThreadSlot
+    {
+        Uint32 Idx = ~0u;
 
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+        ThreadSlot()
+        {
+            for (Uint32 i = 0; i < MaxThreadCaches; ++i)
+            {
+                bool Expected = false;
+                if (!SlotUsed[i].load(std::memory_order_relaxed) &&
+                    SlotUsed[i].compare_exchange_strong(Expected, true, std::memory_order_acquire))
+                {
+                    Idx = i;
+                    break;
+                }
+            }
+        }
+
+        ~ThreadSlot()
+        {
+            if (Idx < MaxThreadCaches)
+                SlotUsed[Idx].store(false, std::memory_order_release);
+        }
+    };
+    thread_local ThreadSlot Slot;
+
+    return Slot.Idx;
+}
+
+FixedBlockMemoryAllocator::ThreadCache* FixedBlockMemoryAllocator::GetThreadCache()
+{
+    const auto Slot = GetThreadSlot();
+    if (Slot >= MaxThreadCaches)
+        return nullptr;
+
+    auto*& pCache = m_ThreadCaches[Slot];
+    if (pCache == nullptr)
+    {
+        // The cache is created once per slot, so the mutex is not taken on the fast path.
+        // Caches are padded to the cache line size to avoid false sharing.
+        constexpr size_t CacheLineSize = 64;
+
+        std::lock_guard<std::mutex> LockGuard(m_Mutex);
 
+        void* pRawMem   = m_RawMemoryAllocator.Allocate(AlignUp(sizeof(ThreadCache), CacheLineSize) + CacheLineSize - 1,
+                                                      "FixedBlockMemoryAllocator thread cache", __FILE__, __LINE__);
+        pCache          = new (AlignUp(pRawMem, CacheLineSize)) ThreadCache{};
+        pCache->pRawMem = pRawMem;
+    }
+    return pCache;
+}
+
+void* FixedBlockMemoryAllocator::AllocateFromPages()
+{
     if (m_AvailablePages.empty())
     {
         CreateNewPage();
@@ -233,10 +315,9 @@ void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescriptio
     return Ptr;
 }
 
-void FixedBlockMemoryAllocator::Free(void* Ptr)
+void FixedBlockMemoryAllocator::FreeToPages(void* Ptr)
 {
-    std::lock_guard<std::mutex> LockGuard(m_Mutex);
-    auto                        PageIdIt = m_AddrToPageId.find(Ptr);
+    auto PageIdIt = m_AddrToPageId.find(Ptr);
     if (PageIdIt != m_AddrToPageId.end())
     {
         auto PageId = PageIdIt->second;
@@ -259,4 +340,63 @@ void FixedBlockMemoryAllocator::Free(void* Ptr)
     }
 }
 
+void* FixedBlockMemoryAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    VERIFY_EXPR(Size > 0);
+
+    Size = AdjustBlockSize(Size);
+    VERIFY(m_BlockSize == Size, "Requested size (", Size, ") does not match the block size (", m_BlockSize, ")");
+
+    auto* pCache = m_ThreadCaches != nullptr ? GetThreadCache() : nullptr;
+    if (pCache != nullptr)
+    {
+        auto& Cache = *pCache;
+        if (Cache.NumBlocks == 0)
+        {
+            // Refill the cache from the pages
+            std::lock_guard<std::mutex> LockGuard(m_Mutex);
+            for (Uint32 b = 0; b < ThreadCacheBatchSize; ++b)
+                Cache.Blocks[Cache.NumBlocks++] = AllocateFromPages();
+        }
+
+        auto* Ptr = Cache.Blocks[--Cache.NumBlocks];
+        FillWithDebugPattern(Ptr, MemoryPage::AllocatedBlockMemPattern, m_BlockSize);
+        return Ptr;
+    }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    return AllocateFromPages();
+}
+
+void FixedBlockMemoryAllocator::Free(void* Ptr)
+{
+    auto* pCache = m_ThreadCaches != nullptr ? GetThreadCache() : nullptr;
+    if (pCache != nullptr)
+    {
+        auto& Cache = *pCache;
+#ifdef DILIGENT_DEBUG
+        // Blocks freed twice into different caches are detected when they are returned to the pages
+        for (Uint32 b = 0; b < Cache.NumBlocks; ++b)
+            VERIFY(Cache.Blocks[b] != Ptr, "The block is already in the thread cache - double freeing memory?");
+#endif
+        FillWithDebugPattern(Ptr, MemoryPage::DeallocatedBlockMemPattern, m_BlockSize);
+
+        if (Cache.NumBlocks == _countof(Cache.Blocks))
+        {
+            // Return the older half of the cached blocks to the pages
+            std::lock_guard<std::mutex> LockGuard(m_Mutex);
+            for (Uint32 b = 0; b < ThreadCacheBatchSize; ++b)
+                FreeToPages(Cache.Blocks[b]);
+            for (Uint32 b = ThreadCacheBatchSize; b < Cache.NumBlocks; ++b)
+                Cache.Blocks[b - ThreadCacheBatchSize] = Cache.Blocks[b];
+            Cache.NumBlocks -= ThreadCacheBatchSize;
+        }
+        Cache.Blocks[Cache.NumBlocks++] = Ptr;
+        return;
+    }
+
+    std::lock_guard<std::mutex> LockGuard(m_Mutex);
+    FreeToPages(Ptr);
+}
+
 } // namespace Diligent
@@ -0,0 +1,123 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+#include "MappedFileDataBlob.hpp"
+
+#include <vector>
+
+namespace Diligent
+{
+
+#if PLATFORM_LINUX || PLATFORM_ANDROID || PLATFORM_APPLE
+
+class FileDataStorage
+{
+public:
+    FileDataStorage(const Char* Path, EFileAccessPattern Pattern) noexcept(false) :
+        m_File{Path}
+    {
+        if (Pattern != EFileAccessPattern::Normal)
+            m_File.SetAccessPattern(Pattern);
+    }
+
+    void*  GetData() { return m_File.GetData(); }
+    size_t GetSize() const { return m_File.GetSize(); }
+
+private:
+    LinuxMappedFile m_File;
+};
+
+#else
+
+class FileDataStorage
+{
+public:
+    FileDataStorage(const Char* Path, EFileAccessPattern /*Pattern*/) noexcept(false)
+    {
+        if (!FileWrapper::ReadWholeFile(Path, m_Data))
+            LOG_ERROR_AND_THROW("Failed to read file ", Path);
+    }
+
+    void*  GetData() { return !m_Data.empty() ? m_Data.data() : nullptr; }
+    size_t GetSize() const { return m_Data.size(); }
+
+private:
+    std::vector<Uint8> m_Data;
+};
+
+#endif
+
+MappedFileDataBlob::MappedFileDataBlob(IReferenceCounters* pRefCounters, const Char* Path, EFileAccessPattern Pattern) noexcept(false) :
+    TBase{pRefCounters},
+    m_Storage{std::make_unique<FileDataStorage>(Path, Pattern)}
+{
+}
+
+MappedFileDataBlob::~MappedFileDataBlob()
+{
+}
+
+RefCntAutoPtr<MappedFileDataBlob> MappedFileDataBlob::Create(const Char* Path, EFileAccessPattern Pattern)
+{
+    if (Path == nullptr)
+    {
+        DEV_ERROR("File path must not be null");
+        return {};
+    }
+
+    try
+    {
+        return RefCntAutoPtr<MappedFileDataBlob>{MakeNewRCObj<MappedFileDataBlob>()(Path, Pattern)};
+    }
+    catch (...)
+    {
+        return {};
+    }
+}
+
+void MappedFileDataBlob::Resize(size_t NewSize)
+{
+    DEV_CHECK_ERR(NewSize == m_Storage->GetSize(), "Mapped file data blob can't be resized");
+}
+
+size_t MappedFileDataBlob::GetSize() const
+{
+    return m_Storage->GetSize();
+}
+
+void* MappedFileDataBlob::GetDataPtr()
+{
+    return m_Storage->GetData();
+}
+
+const void* MappedFileDataBlob::GetConstDataPtr() const
+{
+    return m_Storage->GetData();
+}
+
+} // namespace Diligent
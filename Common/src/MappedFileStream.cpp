@@ -0,0 +1,179 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "pch.h"
+
+#include "MappedFileStream.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "DataBlobImpl.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+/// Data blob that references a range of the parent blob's data
+class DataBlobView final : public ObjectBase<IDataBlob>
+{
+public:
+    using TBase = ObjectBase<IDataBlob>;
+
+    DataBlobView(IReferenceCounters* pRefCounters,
+                 IDataBlob*          pParent,
+                 size_t              Offset,
+                 size_t              Size) :
+        TBase{pRefCounters},
+        m_pParent{pParent},
+        m_Offset{Offset},
+        m_Size{Size}
+    {
+        VERIFY_EXPR(m_Offset + m_Size <= m_pParent->GetSize());
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_DataBlob, TBase)
+
+    virtual void DILIGENT_CALL_TYPE Resize(size_t NewSize) override final
+    {
+        DEV_CHECK_ERR(NewSize == m_Size, "Data blob view can't be resized");
+    }
+
+    virtual size_t DILIGENT_CALL_TYPE GetSize() const override final
+    {
+        return m_Size;
+    }
+
+    virtual void* DILIGENT_CALL_TYPE GetDataPtr() override final
+    {
+        return static_cast<Uint8*>(m_pParent->GetDataPtr()) + m_Offset;
+    }
+
+    virtual const void* DILIGENT_CALL_TYPE GetConstDataPtr() const override final
+    {
+        return static_cast<const Uint8*>(m_pParent->GetConstDataPtr()) + m_Offset;
+    }
+
+private:
+    RefCntAutoPtr<IDataBlob> m_pParent;
+
+    const size_t m_Offset;
+    const size_t m_Size;
+};
+
+} // namespace
+
+constexpr INTERFACE_ID MappedFileStream::IID_InternalImpl;
+
+RefCntAutoPtr<MappedFileStream> MappedFileStream::Create(const Char* Path, EFileAccessPattern Pattern)
+{
+    auto pData = MappedFileDataBlob::Create(Path, Pattern);
+    if (!pData)
+        return {};
+
+    return RefCntAutoPtr<MappedFileStream>{MakeNewRCObj<MappedFileStream>()(pData)};
+}
+
+MappedFileStream::MappedFileStream(IReferenceCounters* pRefCounters,
+                                   MappedFileDataBlob* pData) :
+    TBase{pRefCounters},
+    m_pData{pData}
+{
+    VERIFY_EXPR(m_pData != nullptr);
+}
+
+IMPLEMENT_QUERY_INTERFACE2(MappedFileStream, IID_FileStream, IID_InternalImpl, TBase)
+
+bool MappedFileStream::Read(void* Data, size_t Size)
+{
+    VERIFY_EXPR(m_CurrentOffset <= m_pData->GetSize());
+    const auto BytesLeft   = m_pData->GetSize() - m_CurrentOffset;
+    const auto BytesToRead = std::min(BytesLeft, Size);
+    if (BytesToRead > 0)
+    {
+        const auto* pSrcData = static_cast<const Uint8*>(m_pData->GetConstDataPtr()) + m_CurrentOffset;
+        memcpy(Data, pSrcData, BytesToRead);
+        m_CurrentOffset += BytesToRead;
+    }
+    return Size == BytesToRead;
+}
+
+void MappedFileStream::ReadBlob(IDataBlob* pData)
+{
+    const auto BytesLeft = m_pData->GetSize() - m_CurrentOffset;
+    pData->Resize(BytesLeft);
+    auto res = Read(pData->GetDataPtr(), pData->GetSize());
+    VERIFY_EXPR(res);
+    (void)res;
+}
+
+RefCntAutoPtr<IDataBlob> MappedFileStream::ReadBlob()
+{
+    const auto Offset = m_CurrentOffset;
+    const auto Size   = m_pData->GetSize() - Offset;
+
+    m_CurrentOffset = m_pData->GetSize();
+    if (Offset == 0)
+        return RefCntAutoPtr<IDataBlob>{m_pData};
+
+    return RefCntAutoPtr<IDataBlob>{MakeNewRCObj<DataBlobView>()(m_pData, Offset, Size)};
+}
+
+bool MappedFileStream::Write(const void* Data, size_t Size)
+{
+    DEV_ERROR("Mapped file stream is read-only");
+    return false;
+}
+
+size_t MappedFileStream::GetSize()
+{
+    return m_pData->GetSize();
+}
+
+bool MappedFileStream::IsValid()
+{
+    return m_pData != nullptr;
+}
+
+
+RefCntAutoPtr<IDataBlob> ReadFileStreamData(IFileStream* pStream)
+{
+    if (pStream == nullptr)
+        return {};
+
+    RefCntAutoPtr<MappedFileStream> pMappedStream{pStream, MappedFileStream::IID_InternalImpl};
+    if (pMappedStream)
+        return pMappedStream->ReadBlob();
+
+    auto pData = DataBlobImpl::Create();
+    pStream->ReadBlob(pData);
+    return RefCntAutoPtr<IDataBlob>{pData};
+}
+
+} // namespace Diligent
@@ -0,0 +1,260 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#include "pch.h"
+#include "MemoryAccountingAllocator.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "DebugUtilities.hpp"
+
+namespace Diligent
+{
+
+namespace
+{
+
+// The header precedes every allocation and keeps the user memory aligned
+// the same way as the memory returned by the backing allocator.
+struct alignas(alignof(std::max_align_t)) AllocationHeader
+{
+    size_t      Size;
+    const void* pSource;
+};
+
+const char* SafeStr(const char* Str)
+{
+    return Str != nullptr ? Str : "";
+}
+
+const char* GetFileBaseName(const char* FilePath)
+{
+    const char* BaseName = FilePath;
+    for (const char* c = FilePath; *c != '\0'; ++c)
+    {
+        if (*c == '/' || *c == '\\')
+            BaseName = c + 1;
+    }
+    return BaseName;
+}
+
+} // namespace
+
+void MemoryAccountingAllocator::Counters::OnAllocate(size_t Size)
+{
+    const auto LiveBytesAfter = LiveBytes.fetch_add(Size, std::memory_order_relaxed) + Size;
+
+    auto Peak = PeakBytes.load(std::memory_order_relaxed);
+    while (LiveBytesAfter > Peak && !PeakBytes.compare_exchange_weak(Peak, LiveBytesAfter, std::memory_order_relaxed))
+    {
+    }
+
+    LiveAllocations.fetch_add(1, std::memory_order_relaxed);
+    TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+    TotalBytes.fetch_add(Size, std::memory_order_relaxed);
+}
+
+void MemoryAccountingAllocator::Counters::OnFree(size_t Size)
+{
+    const auto LiveBytesBefore       = LiveBytes.fetch_sub(Size, std::memory_order_relaxed);
+    const auto LiveAllocationsBefore = LiveAllocations.fetch_sub(1, std::memory_order_relaxed);
+    VERIFY_EXPR(LiveBytesBefore >= Size && LiveAllocationsBefore > 0);
+    (void)LiveBytesBefore;
+    (void)LiveAllocationsBefore;
+}
+
+MemoryAllocationStats MemoryAccountingAllocator::Counters::GetStats(const Char* Name) const
+{
+    MemoryAllocationStats Stats;
+    Stats.Name             = Name;
+    Stats.LiveBytes        = LiveBytes.load(std::memory_order_relaxed);
+    Stats.PeakBytes        = PeakBytes.load(std::memory_order_relaxed);
+    Stats.LiveAllocations  = LiveAllocations.load(std::memory_order_relaxed);
+    Stats.TotalAllocations = TotalAllocations.load(std::memory_order_relaxed);
+    Stats.TotalBytes       = TotalBytes.load(std::memory_order_relaxed);
+    return Stats;
+}
+
+MemoryAccountingAllocator::MemoryAccountingAllocator(IMemoryAllocator& Allocator) noexcept :
+    m_Allocator{Allocator}
+{
+    for (auto& Entry : m_SourceCache)
+        Entry.store(nullptr, std::memory_order_relaxed);
+}
+
+MemoryAccountingAllocator::~MemoryAccountingAllocator()
+{
+    const auto Total = m_Total.GetStats(nullptr);
+    if (Total.LiveAllocations != 0)
+    {
+        LOG_WARNING_MESSAGE("Memory accounting allocator is destroyed while ", Total.LiveAllocations,
+                            " allocation(s) (", Total.LiveBytes, " bytes) have not been released.");
+    }
+}
+
+const MemoryAccountingAllocator::AllocationSource* MemoryAccountingAllocator::FindCachedSource(size_t Hash, const Char* dbgDescription, const char* dbgFileName) const
+{
+    for (size_t i = 0; i < SourceCacheSize; ++i)
+    {
+        const auto* pEntry = m_SourceCache[(Hash + i) % SourceCacheSize].load(std::memory_order_acquire);
+        if (pEntry == nullptr)
+            return nullptr;
+        if (pEntry->Matches(dbgDescription, dbgFileName))
+            return pEntry->pSource;
+    }
+    return nullptr;
+}
+
+const MemoryAccountingAllocator::AllocationSource& MemoryAccountingAllocator::GetSource(const Char* dbgDescription, const char* dbgFileName)
+{
+    const auto Hash = ComputeHash(dbgDescription, dbgFileName);
+    if (const auto* pSource = FindCachedSource(Hash, dbgDescription, dbgFileName))
+        return *pSource;
+
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    // Another thread may have added the site while we were waiting for the lock
+    if (const auto* pSource = FindCachedSource(Hash, dbgDescription, dbgFileName))
+        return *pSource;
+
+    // Sites are identified by the text, so the description does not need to outlive the allocation.
+    String Key{SafeStr(dbgDescription)};
+    Key.push_back('\0');
+    Key.append(SafeStr(dbgFileName));
+
+    auto& pSource = m_Sources[Key];
+    if (!pSource)
+    {
+        pSource.reset(new AllocationSource);
+        pSource->Description = SafeStr(dbgDescription);
+        pSource->FileName    = SafeStr(dbgFileName);
+
+        pSource->pGroups[MEMORY_ACCOUNTING_GROUP_TAG]       = &m_Groups[MEMORY_ACCOUNTING_GROUP_TAG][pSource->Description];
+        pSource->pGroups[MEMORY_ACCOUNTING_GROUP_SUBSYSTEM] = &m_Groups[MEMORY_ACCOUNTING_GROUP_SUBSYSTEM][GetFileBaseName(pSource->FileName.c_str())];
+    }
+
+    // Descriptions that are built at run time may have a new address every time.
+    // Limit the number of cached sites so that the cache does not fill up.
+    if (m_SourceCacheEntries.size() < SourceCacheSize / 2)
+    {
+        m_SourceCacheEntries.emplace_back(new SourceCacheEntry{dbgDescription, dbgFileName, pSource.get()});
+        for (size_t i = 0; i < SourceCacheSize; ++i)
+        {
+            auto& Slot = m_SourceCache[(Hash + i) % SourceCacheSize];
+            if (Slot.load(std::memory_order_relaxed) == nullptr)
+            {
+                Slot.store(m_SourceCacheEntries.back().get(), std::memory_order_release);
+                break;
+            }
+        }
+    }
+
+    return *pSource;
+}
+
+void* MemoryAccountingAllocator::Allocate(size_t Size, const Char* dbgDescription, const char* dbgFileName, const Int32 dbgLineNumber)
+{
+    auto* pHeader = static_cast<AllocationHeader*>(m_Allocator.Allocate(sizeof(AllocationHeader) + Size, dbgDescription, dbgFileName, dbgLineNumber));
+    if (pHeader == nullptr)
+        return nullptr;
+
+    const auto& Source = GetSource(dbgDescription, dbgFileName);
+    for (auto* pGroup : Source.pGroups)
+        pGroup->OnAllocate(Size);
+    m_Total.OnAllocate(Size);
+
+    pHeader->Size    = Size;
+    pHeader->pSource = &Source;
+
+    return pHeader + 1;
+}
+
+void MemoryAccountingAllocator::Free(void* Ptr)
+{
+    if (Ptr == nullptr)
+        return;
+
+    auto* pHeader = static_cast<AllocationHeader*>(Ptr) - 1;
+
+    const auto& Source = *static_cast<const AllocationSource*>(pHeader->pSource);
+    for (auto* pGroup : Source.pGroups)
+        pGroup->OnFree(pHeader->Size);
+    m_Total.OnFree(pHeader->Size);
+
+    m_Allocator.Free(pHeader);
+}
+
+MemoryAllocationStats MemoryAccountingAllocator::GetTotalStats()
+{
+    return m_Total.GetStats(nullptr);
+}
+
+Uint32 MemoryAccountingAllocator::GetGroupStats(MEMORY_ACCOUNTING_GROUP Group, MemoryAllocationStats* pStats, Uint32 MaxStats)
+{
+    if (Group >= MEMORY_ACCOUNTING_GROUP_COUNT)
+    {
+        UNEXPECTED("Unexpected memory accounting group (", Uint32{Group}, ")");
+        return 0;
+    }
+
+    std::vector<MemoryAllocationStats> AllStats;
+    {
+        std::lock_guard<std::mutex> Lock{m_Mtx};
+
+        const auto& Groups = m_Groups[Group];
+        AllStats.reserve(Groups.size());
+        for (const auto& it : Groups)
+            AllStats.emplace_back(it.second.GetStats(it.first.c_str()));
+    }
+
+    const auto NumStats = std::min(static_cast<size_t>(MaxStats), AllStats.size());
+    if (pStats != nullptr && NumStats > 0)
+    {
+        std::partial_sort(AllStats.begin(), AllStats.begin() + NumStats, AllStats.end(),
+                          [](const MemoryAllocationStats& lhs, const MemoryAllocationStats& rhs) {
+                              return lhs.LiveBytes > rhs.LiveBytes;
+                          });
+        std::copy(AllStats.begin(), AllStats.begin() + NumStats, pStats);
+    }
+
+    return static_cast<Uint32>(AllStats.size());
+}
+
+void MemoryAccountingAllocator::ResetPeakStats()
+{
+    std::lock_guard<std::mutex> Lock{m_Mtx};
+
+    for (auto& Groups : m_Groups)
+    {
+        for (auto& it : Groups)
+            it.second.PeakBytes.store(it.second.LiveBytes.load());
+    }
+    m_Total.PeakBytes.store(m_Total.LiveBytes.load());
+}
+
+} // namespace Diligent
@@ -1,5 +1,5 @@
 /*
- *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2019-2023 Diligent Graphics LLC
  *
  *  Licensed under the Apache License, Version 2.0 (the "License");
  *  you may not use this file except in compliance with the License.
@@ -26,10 +26,14 @@
 
 #include "ThreadPool.hpp"
 
+#include <algorithm>
 #include <mutex>
 #include <thread>
 #include <map>
+#include <deque>
 #include <vector>
+#include <memory>
+#include <limits>
 #include <condition_variable>
 
 namespace Diligent
@@ -39,6 +43,90 @@ AsyncTaskBase::~AsyncTaskBase()
 {
 }
 
+bool AsyncTaskBase::WaitForStatus(ASYNC_TASK_STATUS MinStatus, const std::chrono::milliseconds* pTimeout) const
+{
+    static_assert(ASYNC_TASK_STATUS_COMPLETE > ASYNC_TASK_STATUS_CANCELLED &&
+                      ASYNC_TASK_STATUS_CANCELLED > ASYNC_TASK_STATUS_RUNNING &&
+                      ASYNC_TASK_STATUS_RUNNING > ASYNC_TASK_STATUS_NOT_STARTED,
+                  "Unexpected enum values");
+
+    auto StatusReached = [this, MinStatus]() {
+        return m_TaskStatus.load() >= MinStatus;
+    };
+
+    const auto StartTime = std::chrono::steady_clock::now();
+
+    // Many tasks finish shortly after they are waited upon, so spin for a short time
+    // first to avoid the cost of parking the thread.
+    constexpr Uint32 NumSpinIterations = 64;
+    for (Uint32 i = 0; i < NumSpinIterations; ++i)
+    {
+        if (StatusReached())
+            return true;
+        std::this_thread::yield();
+    }
+
+    std::unique_lock<std::mutex> lock{m_StatusMtx};
+    // NB: the number of waiting threads must be incremented before the status is checked
+    //     by the predicate (see SetStatus()).
+    m_NumWaitingThreads.fetch_add(1);
+    bool Res = true;
+    if (pTimeout != nullptr)
+        Res = m_StatusCond.wait_until(lock, StartTime + *pTimeout, StatusReached);
+    else
+        m_StatusCond.wait(lock, StatusReached);
+    m_NumWaitingThreads.fetch_add(-1);
+
+    return Res;
+}
+
+namespace
+{
+
+// Calls OnReady once all prerequisites of the task are finished.
+// The argument of OnReady indicates whether any of the prerequisites was cancelled.
+void WaitForPrerequisites(IAsyncTask* pTask, std::function<void(bool)> OnReady)
+{
+    struct WaitingTaskInfo
+    {
+        std::atomic<Uint32>       NumPendingPrerequisites{0};
+        std::atomic<bool>         PrerequisiteCancelled{false};
+        std::function<void(bool)> OnReady;
+    };
+
+    const auto NumPrerequisites = pTask->GetPrerequisiteCount();
+
+    auto pInfo = std::make_shared<WaitingTaskInfo>();
+    // One extra count prevents the task from becoming ready while the continuations are being added
+    pInfo->NumPendingPrerequisites.store(NumPrerequisites + 1);
+    pInfo->OnReady = std::move(OnReady);
+
+    auto OnPrerequisiteFinished = [](WaitingTaskInfo& Info) {
+        if (Info.NumPendingPrerequisites.fetch_add(-1) == 1)
+        {
+            Info.OnReady(Info.PrerequisiteCancelled.load());
+            Info.OnReady = nullptr;
+        }
+    };
+
+    for (Uint32 i = 0; i < NumPrerequisites; ++i)
+    {
+        auto* pPrerequisite = pTask->GetPrerequisite(i);
+        DEV_CHECK_ERR(pPrerequisite != nullptr, "Prerequisite ", i, " is null");
+        pPrerequisite->AddContinuation(
+            [pInfo, OnPrerequisiteFinished](IAsyncTask* pPrerequisite) //
+            {
+                if (pPrerequisite->GetStatus() == ASYNC_TASK_STATUS_CANCELLED)
+                    pInfo->PrerequisiteCancelled.store(true);
+                OnPrerequisiteFinished(*pInfo);
+            });
+    }
+
+    OnPrerequisiteFinished(*pInfo);
+}
+
+} // namespace
+
 class ThreadPoolImpl final : public ObjectBase<IThreadPool>
 {
 public:
@@ -118,7 +206,7 @@ public:
                 std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
 
                 const auto NumRunningTasks = m_NumRunningTasks.fetch_add(-1) - 1;
-                if (m_TasksQueue.empty() && NumRunningTasks == 0)
+                if (m_TasksQueue.empty() && NumRunningTasks == 0 && m_NumWaitingTasks.load() == 0)
                 {
                     m_TasksFinishedCond.notify_one();
                 }
@@ -134,6 +222,17 @@ public:
         if (pTask == nullptr)
             return;
 
+        if (pTask->GetPrerequisiteCount() > 0)
+        {
+            m_NumWaitingTasks.fetch_add(1);
+            WaitForPrerequisites(pTask,
+                                 [this, pTask = RefCntAutoPtr<IAsyncTask>{pTask}](bool PrerequisiteCancelled) //
+                                 {
+                                     OnPrerequisitesFinished(pTask, PrerequisiteCancelled);
+                                 });
+            return;
+        }
+
         {
             std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
             DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
@@ -146,12 +245,12 @@ public:
     virtual void WaitForAllTasks() override final
     {
         std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
-        if (!m_TasksQueue.empty() || m_NumRunningTasks.load() > 0)
+        if (!m_TasksQueue.empty() || m_NumRunningTasks.load() > 0 || m_NumWaitingTasks.load() > 0)
         {
             m_TasksFinishedCond.wait(lock,
                                      [this] //
                                      {
-                                         return m_TasksQueue.empty() && m_NumRunningTasks.load() == 0;
+                                         return m_TasksQueue.empty() && m_NumRunningTasks.load() == 0 && m_NumWaitingTasks.load() == 0;
                                      } //
             );
         }
@@ -252,11 +351,45 @@ public:
         return m_NumRunningTasks.load();
     }
 
+    virtual Uint32 GetWaitingTaskCount() const override final
+    {
+        return m_NumWaitingTasks.load();
+    }
+
     ~ThreadPoolImpl()
     {
         StopThreads();
         VERIFY_EXPR(m_TasksQueue.empty());
         VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+        VERIFY(m_NumWaitingTasks.load() == 0, "Destroying the thread pool that has tasks waiting for prerequisites");
+    }
+
+private:
+    void OnPrerequisitesFinished(IAsyncTask* pTask, bool PrerequisiteCancelled)
+    {
+        if (PrerequisiteCancelled)
+        {
+            // This will also cancel the dependents of this task
+            pTask->SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+        }
+
+        {
+            std::unique_lock<std::mutex> lock{m_TasksQueueMtx};
+            if (!PrerequisiteCancelled)
+            {
+                DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+                m_TasksQueue.emplace(pTask->GetPriority(), pTask);
+            }
+
+            const auto NumWaitingTasks = m_NumWaitingTasks.fetch_add(-1) - 1;
+            if (m_TasksQueue.empty() && m_NumRunningTasks.load() == 0 && NumWaitingTasks == 0)
+            {
+                m_TasksFinishedCond.notify_one();
+            }
+        }
+
+        if (!PrerequisiteCancelled)
+            m_NextTaskCond.notify_one();
     }
 
 private:
@@ -273,11 +406,516 @@ private:
     std::atomic<bool>       m_Stop{false};
 
     std::atomic<int> m_NumRunningTasks{0};
+    std::atomic<int> m_NumWaitingTasks{0};
+};
+
+
+// Work-stealing thread pool.
+//
+// Every worker thread owns a local queue protected by its own mutex. Tasks enqueued
+// from a worker thread go to the back of its local queue; the owner pops tasks from
+// the back (LIFO), while other threads steal from the front (FIFO). Tasks enqueued
+// from other threads go to the shared priority queue.
+//
+// The total number of queued tasks is tracked by an atomic counter that is used
+// to put idle threads to sleep and to wake them up without taking any queue lock.
+class WorkStealingThreadPoolImpl final : public ObjectBase<IThreadPool>
+{
+public:
+    using TBase = ObjectBase<IThreadPool>;
+
+    WorkStealingThreadPoolImpl(IReferenceCounters*         pRefCounters,
+                               const ThreadPoolCreateInfo& PoolCI) :
+        TBase{pRefCounters},
+        m_NumLocalQueues{static_cast<Uint32>(PoolCI.NumThreads)},
+        m_LocalQueues{PoolCI.NumThreads > 0 ? new LocalQueue[PoolCI.NumThreads] : nullptr}
+    {
+        m_WorkerThreads.reserve(PoolCI.NumThreads);
+        for (Uint32 i = 0; i < PoolCI.NumThreads; ++i)
+        {
+            m_WorkerThreads.emplace_back(
+                [this, PoolCI, i] //
+                {
+                    if (PoolCI.OnThreadStarted)
+                        PoolCI.OnThreadStarted(i);
+
+                    while (ProcessTask(i, /*WaitForTask =*/true))
+                    {
+                    }
+
+                    if (PoolCI.OnThreadExiting)
+                        PoolCI.OnThreadExiting(i);
+                });
+        }
+    }
+
+    IMPLEMENT_QUERY_INTERFACE_IN_PLACE(IID_ThreadPool, TBase)
+
+    virtual bool ProcessTask(Uint32 ThreadId, bool WaitForTask) override final
+    {
+        RefCntAutoPtr<IAsyncTask> pTask;
+        while (!pTask)
+        {
+            pTask = FindTask(ThreadId);
+            if (pTask)
+                break;
+
+            std::unique_lock<std::mutex> lock{m_SleepMtx};
+            if (WaitForTask)
+            {
+                // NB: the number of sleeping threads must be incremented before the predicate is checked.
+                //     EnqueueTask() increments the number of queued tasks first and then checks the number
+                //     of sleeping threads, so at least one of the two threads is guaranteed to see
+                //     the modification made by the other one.
+                m_NumSleepingThreads.fetch_add(1);
+                m_WakeUpCond.wait(lock,
+                                  [this] //
+                                  {
+                                      return m_Stop.load() || m_NumQueuedTasks.load() > 0;
+                                  } //
+                );
+                m_NumSleepingThreads.fetch_add(-1);
+            }
+
+            // m_Stop must be accessed under the mutex
+            if (m_Stop.load() && m_NumQueuedTasks.load() == 0)
+                return false;
+
+            if (!WaitForTask)
+                return true;
+        }
+
+        {
+            // Make tasks enqueued by this task go to the local queue of this thread
+            const auto PrevContext = t_WorkerContext;
+            t_WorkerContext        = {this, ThreadId};
+
+            pTask->SetStatus(ASYNC_TASK_STATUS_RUNNING);
+            pTask->Run(ThreadId);
+            DEV_CHECK_ERR((pTask->GetStatus() == ASYNC_TASK_STATUS_COMPLETE ||
+                           pTask->GetStatus() == ASYNC_TASK_STATUS_CANCELLED),
+                          "Finished tasks must be in COMPLETE or CANCELLED state");
+
+            t_WorkerContext = PrevContext;
+        }
+
+        const auto NumRunningTasks = m_NumRunningTasks.fetch_add(-1) - 1;
+        if (NumRunningTasks == 0)
+            NotifyIfAllTasksFinished();
+
+        return true;
+    }
+
+    virtual void EnqueueTask(IAsyncTask* pTask) override final
+    {
+        VERIFY_EXPR(pTask != nullptr);
+        if (pTask == nullptr)
+            return;
+
+        if (pTask->GetPrerequisiteCount() > 0)
+        {
+            m_NumWaitingTasks.fetch_add(1);
+            WaitForPrerequisites(pTask,
+                                 [this, pTask = RefCntAutoPtr<IAsyncTask>{pTask}](bool PrerequisiteCancelled) //
+                                 {
+                                     if (PrerequisiteCancelled)
+                                     {
+                                         // This will also cancel the dependents of this task
+                                         pTask->SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+                                     }
+                                     else
+                                     {
+                                         EnqueueReadyTask(pTask);
+                                     }
+
+                                     if (m_NumWaitingTasks.fetch_add(-1) == 1)
+                                         NotifyIfAllTasksFinished();
+                                 });
+            return;
+        }
+
+        EnqueueReadyTask(pTask);
+    }
+
+    virtual void WaitForAllTasks() override final
+    {
+        std::unique_lock<std::mutex> lock{m_SleepMtx};
+        m_TasksFinishedCond.wait(lock,
+                                 [this] //
+                                 {
+                                     return AllTasksFinished();
+                                 } //
+        );
+    }
+
+    virtual void StopThreads() override final
+    {
+        {
+            std::unique_lock<std::mutex> lock{m_SleepMtx};
+            // NB: even if the shared variable is atomic, it must be modified under the mutex
+            //     in order to correctly publish the modification to the waiting thread.
+            m_Stop.store(true);
+        }
+        m_WakeUpCond.notify_all();
+        for (std::thread& worker : m_WorkerThreads)
+            worker.join();
+
+        m_WorkerThreads.clear();
+    }
+
+    virtual bool RemoveTask(IAsyncTask* pTask) override final
+    {
+        RefCntAutoPtr<IAsyncTask> pRemovedTask;
+        {
+            std::lock_guard<std::mutex> lock{m_SharedQueueMtx};
+            for (auto it = m_SharedQueue.begin(); it != m_SharedQueue.end(); ++it)
+            {
+                if (it->second == pTask)
+                {
+                    pRemovedTask = std::move(it->second);
+                    m_SharedQueue.erase(it);
+                    UpdateSharedQueueTopPriority();
+                    break;
+                }
+            }
+        }
+
+        for (Uint32 i = 0; i < m_NumLocalQueues && !pRemovedTask; ++i)
+        {
+            auto& Queue = m_LocalQueues[i];
+
+            std::lock_guard<std::mutex> lock{Queue.Mtx};
+            for (auto it = Queue.Tasks.begin(); it != Queue.Tasks.end(); ++it)
+            {
+                if (it->second == pTask)
+                {
+                    pRemovedTask = std::move(it->second);
+                    Queue.Tasks.erase(it);
+                    Queue.Size.store(Queue.Tasks.size());
+                    break;
+                }
+            }
+        }
+
+        if (!pRemovedTask)
+            return false;
+
+        if (m_NumQueuedTasks.fetch_add(-1) == 1)
+            NotifyIfAllTasksFinished();
+
+        return true;
+    }
+
+    virtual bool ReprioritizeTask(IAsyncTask* pTask) override final
+    {
+        const auto Priority = pTask->GetPriority();
+
+        {
+            std::lock_guard<std::mutex> lock{m_SharedQueueMtx};
+            for (auto it = m_SharedQueue.begin(); it != m_SharedQueue.end(); ++it)
+            {
+                if (it->second == pTask)
+                {
+                    if (it->first != Priority)
+                    {
+                        auto pExistingTask = std::move(it->second);
+                        m_SharedQueue.erase(it);
+                        m_SharedQueue.emplace(Priority, std::move(pExistingTask));
+                        UpdateSharedQueueTopPriority();
+                    }
+                    return true;
+                }
+            }
+        }
+
+        // Local queues are not sorted by priority, so move the task to the shared queue.
+        // FindTask() takes the task from the shared queue before the local one if its priority is higher.
+        for (Uint32 i = 0; i < m_NumLocalQueues; ++i)
+        {
+            auto& Queue = m_LocalQueues[i];
+
+            RefCntAutoPtr<IAsyncTask> pExistingTask;
+            {
+                std::lock_guard<std::mutex> lock{Queue.Mtx};
+                for (auto it = Queue.Tasks.begin(); it != Queue.Tasks.end(); ++it)
+                {
+                    if (it->second == pTask)
+                    {
+                        pExistingTask = std::move(it->second);
+                        Queue.Tasks.erase(it);
+                        Queue.Size.store(Queue.Tasks.size());
+                        break;
+                    }
+                }
+            }
+
+            if (pExistingTask)
+            {
+                // The task remains accounted in m_NumQueuedTasks while it is being moved
+                std::lock_guard<std::mutex> lock{m_SharedQueueMtx};
+                m_SharedQueue.emplace(Priority, std::move(pExistingTask));
+                UpdateSharedQueueTopPriority();
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    virtual void ReprioritizeAllTasks() override final
+    {
+        std::vector<std::pair<float, RefCntAutoPtr<IAsyncTask>>> ReprioritizationList;
+        for (Uint32 i = 0; i < m_NumLocalQueues; ++i)
+        {
+            auto& Queue = m_LocalQueues[i];
+
+            std::lock_guard<std::mutex> lock{Queue.Mtx};
+            for (auto it = Queue.Tasks.begin(); it != Queue.Tasks.end();)
+            {
+                const auto Priority = it->second->GetPriority();
+                if (it->first != Priority)
+                {
+                    ReprioritizationList.emplace_back(Priority, std::move(it->second));
+                    it = Queue.Tasks.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+            Queue.Size.store(Queue.Tasks.size());
+        }
+
+        std::lock_guard<std::mutex> lock{m_SharedQueueMtx};
+        for (auto it = m_SharedQueue.begin(); it != m_SharedQueue.end();)
+        {
+            const auto Priority = it->second->GetPriority();
+            if (it->first != Priority)
+            {
+                ReprioritizationList.emplace_back(Priority, std::move(it->second));
+                it = m_SharedQueue.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        if (!ReprioritizationList.empty())
+        {
+            m_SharedQueue.insert(ReprioritizationList.begin(), ReprioritizationList.end());
+            UpdateSharedQueueTopPriority();
+        }
+    }
+
+    Uint32 GetQueueSize() override final
+    {
+        return static_cast<Uint32>(std::max(m_NumQueuedTasks.load(), 0));
+    }
+
+    virtual Uint32 GetRunningTaskCount() const override final
+    {
+        return m_NumRunningTasks.load();
+    }
+
+    virtual Uint32 GetWaitingTaskCount() const override final
+    {
+        return m_NumWaitingTasks.load();
+    }
+
+    ~WorkStealingThreadPoolImpl()
+    {
+        StopThreads();
+        VERIFY_EXPR(m_NumQueuedTasks.load() == 0);
+        VERIFY_EXPR(m_NumRunningTasks.load() == 0);
+        VERIFY(m_NumWaitingTasks.load() == 0, "Destroying the thread pool that has tasks waiting for prerequisites");
+    }
+
+private:
+    struct WorkerContext
+    {
+        const WorkStealingThreadPoolImpl* pPool    = nullptr;
+        Uint32                            ThreadId = 0;
+    };
+    static thread_local WorkerContext t_WorkerContext;
+
+    // Local queues are padded to avoid false sharing between worker threads.
+    // Padding is used instead of alignas since new[] does not guarantee extended alignment in C++14.
+    struct LocalQueue
+    {
+        std::mutex                                              Mtx;
+        std::deque<std::pair<float, RefCntAutoPtr<IAsyncTask>>> Tasks;
+        std::atomic<size_t>                                     Size{0};
+
+        // Keeps the data of adjacent queues at least a cache line apart
+        Uint8 Padding[64];
+    };
+
+    // Returns the next task to run and marks it as running.
+    RefCntAutoPtr<IAsyncTask> FindTask(Uint32 ThreadId)
+    {
+        if (m_NumQueuedTasks.load() == 0)
+            return {};
+
+        RefCntAutoPtr<IAsyncTask> pTask;
+
+        // Newest task from the local queue, unless the shared queue has a task with higher priority
+        // (e.g. a local task that was moved there by ReprioritizeTask()).
+        if (ThreadId < m_NumLocalQueues)
+            pTask = PopTask(m_LocalQueues[ThreadId], /*Steal = */ false, m_SharedQueueTopPriority.load());
+
+        // Highest-priority task from the shared queue
+        if (!pTask)
+        {
+            std::lock_guard<std::mutex> lock{m_SharedQueueMtx};
+            if (!m_SharedQueue.empty())
+            {
+                auto front = m_SharedQueue.begin();
+                pTask      = std::move(front->second);
+                m_SharedQueue.erase(front);
+                UpdateSharedQueueTopPriority();
+            }
+        }
+
+        // The shared queue may have been emptied by other threads after the priority was checked
+        if (!pTask && ThreadId < m_NumLocalQueues)
+            pTask = PopTask(m_LocalQueues[ThreadId], /*Steal = */ false);
+
+        // Oldest task from other threads' local queues
+        for (Uint32 i = 1; i <= m_NumLocalQueues && !pTask; ++i)
+        {
+            const auto Victim = (ThreadId + i) % m_NumLocalQueues;
+            if (Victim != ThreadId)
+                pTask = PopTask(m_LocalQueues[Victim], /*Steal = */ true);
+        }
+
+        if (pTask)
+        {
+            // NB: we must increment the running task counter before decrementing
+            //     the number of queued tasks, otherwise WaitForAllTasks() may miss the task.
+            m_NumRunningTasks.fetch_add(1);
+            m_NumQueuedTasks.fetch_add(-1);
+        }
+
+        return pTask;
+    }
+
+    // Pops the task from the queue. The newest task is only taken if its priority is not lower than MinPriority.
+    static RefCntAutoPtr<IAsyncTask> PopTask(LocalQueue& Queue, bool Steal, float MinPriority = std::numeric_limits<float>::lowest())
+    {
+        // Do not take the lock if the queue is empty
+        if (Queue.Size.load(std::memory_order_relaxed) == 0)
+            return {};
+
+        std::lock_guard<std::mutex> lock{Queue.Mtx};
+        if (Queue.Tasks.empty())
+            return {};
+
+        RefCntAutoPtr<IAsyncTask> pTask;
+        if (Steal)
+        {
+            pTask = std::move(Queue.Tasks.front().second);
+            Queue.Tasks.pop_front();
+        }
+        else
+        {
+            if (Queue.Tasks.back().first < MinPriority)
+                return {};
+
+            pTask = std::move(Queue.Tasks.back().second);
+            Queue.Tasks.pop_back();
+        }
+        Queue.Size.store(Queue.Tasks.size(), std::memory_order_relaxed);
+
+        return pTask;
+    }
+
+    void EnqueueReadyTask(IAsyncTask* pTask)
+    {
+        DEV_CHECK_ERR(!m_Stop, "Enqueue on a stopped ThreadPool");
+
+        // NB: the counter must be incremented before the task is added to the queue so that
+        //     it never goes negative when the task is immediately picked up by another thread.
+        m_NumQueuedTasks.fetch_add(1);
+
+        const auto Priority = pTask->GetPriority();
+        if (t_WorkerContext.pPool == this && t_WorkerContext.ThreadId < m_NumLocalQueues)
+        {
+            auto& Queue = m_LocalQueues[t_WorkerContext.ThreadId];
+
+            std::lock_guard<std::mutex> lock{Queue.Mtx};
+            Queue.Tasks.emplace_back(Priority, pTask);
+            Queue.Size.store(Queue.Tasks.size());
+        }
+        else
+        {
+            std::lock_guard<std::mutex> lock{m_SharedQueueMtx};
+            m_SharedQueue.emplace(Priority, pTask);
+            UpdateSharedQueueTopPriority();
+        }
+
+        if (m_NumSleepingThreads.load() > 0)
+        {
+            {
+                // Acquiring the mutex guarantees that the thread that has incremented
+                // m_NumSleepingThreads is now waiting on the condition variable.
+                std::lock_guard<std::mutex> lock{m_SleepMtx};
+            }
+            m_WakeUpCond.notify_one();
+        }
+    }
+
+    // Must be called while holding m_SharedQueueMtx
+    void UpdateSharedQueueTopPriority()
+    {
+        m_SharedQueueTopPriority.store(!m_SharedQueue.empty() ? m_SharedQueue.begin()->first : std::numeric_limits<float>::lowest());
+    }
+
+    bool AllTasksFinished() const
+    {
+        return m_NumQueuedTasks.load() == 0 && m_NumRunningTasks.load() == 0 && m_NumWaitingTasks.load() == 0;
+    }
+
+    void NotifyIfAllTasksFinished()
+    {
+        // NB: notify while holding the mutex so that the pool can't be destroyed
+        //     by the thread returning from WaitForAllTasks() before notify_all() is done.
+        std::lock_guard<std::mutex> lock{m_SleepMtx};
+        if (AllTasksFinished())
+            m_TasksFinishedCond.notify_all();
+    }
+
+private:
+    const Uint32                  m_NumLocalQueues;
+    std::unique_ptr<LocalQueue[]> m_LocalQueues;
+
+    std::mutex                                                           m_SharedQueueMtx;
+    std::multimap<float, RefCntAutoPtr<IAsyncTask>, std::greater<float>> m_SharedQueue;
+    // Priority of the first task in the shared queue, lets FindTask() compare it with the local queue without the lock
+    std::atomic<float> m_SharedQueueTopPriority{std::numeric_limits<float>::lowest()};
+
+    std::vector<std::thread> m_WorkerThreads;
+
+    std::mutex              m_SleepMtx;
+    std::condition_variable m_WakeUpCond{};
+    std::condition_variable m_TasksFinishedCond{};
+    std::atomic<bool>       m_Stop{false};
+
+    std::atomic<int> m_NumQueuedTasks{0};
+    std::atomic<int> m_NumRunningTasks{0};
+    std::atomic<int> m_NumWaitingTasks{0};
+    std::atomic<int> m_NumSleepingThreads{0};
 };
 
+thread_local WorkStealingThreadPoolImpl::WorkerContext WorkStealingThreadPoolImpl::t_WorkerContext;
+
+
 RefCntAutoPtr<IThreadPool> CreateThreadPool(const ThreadPoolCreateInfo& ThreadPoolCI)
 {
-    return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
+    if (ThreadPoolCI.EnableWorkStealing)
+        return RefCntAutoPtr<WorkStealingThreadPoolImpl>{MakeNewRCObj<WorkStealingThreadPoolImpl>()(ThreadPoolCI)};
+    else
+        return RefCntAutoPtr<ThreadPoolImpl>{MakeNewRCObj<ThreadPoolImpl>()(ThreadPoolCI)};
 }
 
 } // namespace Diligent
@@ -295,6 +295,23 @@ DILIGENT_BEGIN_INTERFACE(IArchiverFactory, IObject)
                                        IDataBlob**      ppDstArchive) CONST PURE;
 
 
+    /// Compresses or decompresses the archive data and writes a new archive to the blob.
+
+    /// \param [in]  pSrcArchive  - Source archive.
+    /// \param [in]  Compress     - Whether the data of the new archive should be compressed.
+    /// \param [out] ppDstArchive - Memory address where a pointer to the new archive will be written.
+    /// \return     true if the archive was successfully written, and false otherwise.
+    ///
+    /// \remarks   The data of every resource and every shader is compressed independently,
+    ///            so that the dearchiver only decompresses the data of the resources that
+    ///            are unpacked. Compression reduces the archive size, especially when it contains
+    ///            the data for multiple backends, at the cost of decompression on first unpack.
+    VIRTUAL Bool METHOD(CompressArchive)(THIS_
+                                         const IDataBlob* pSrcArchive,
+                                         Bool             Compress,
+                                         IDataBlob**      ppDstArchive) CONST PURE;
+
+
     /// Prints archive content for debugging and validation.
     VIRTUAL Bool METHOD(PrintArchiveContent)(THIS_
                                              const IDataBlob* pArchive) CONST PURE;
@@ -317,6 +334,7 @@ DILIGENT_END_INTERFACE
 #    define IArchiverFactory_RemoveDeviceData(This, ...)                        CALL_IFACE_METHOD(ArchiverFactory, RemoveDeviceData,                       This, __VA_ARGS__)
 #    define IArchiverFactory_AppendDeviceData(This, ...)                        CALL_IFACE_METHOD(ArchiverFactory, AppendDeviceData,                       This, __VA_ARGS__)
 #    define IArchiverFactory_MergeArchives(This, ...)                           CALL_IFACE_METHOD(ArchiverFactory, MergeArchives,                          This, __VA_ARGS__)
+#    define IArchiverFactory_CompressArchive(This, ...)                         CALL_IFACE_METHOD(ArchiverFactory, CompressArchive,                        This, __VA_ARGS__)
 #    define IArchiverFactory_PrintArchiveContent(This, ...)                     CALL_IFACE_METHOD(ArchiverFactory, PrintArchiveContent,                    This, __VA_ARGS__)
 #    define IArchiverFactory_SetMessageCallback(This, ...)                      CALL_IFACE_METHOD(ArchiverFactory, SetMessageCallback,                     This, __VA_ARGS__)
 
@@ -133,6 +133,11 @@ public:
         Uint32           NumSrcArchives,
         IDataBlob**      ppDstArchive) const override final;
 
+    virtual Bool DILIGENT_CALL_TYPE CompressArchive(
+        const IDataBlob* pSrcArchive,
+        Bool             Compress,
+        IDataBlob**      ppDstArchive) const override final;
+
     virtual Bool DILIGENT_CALL_TYPE PrintArchiveContent(const IDataBlob* pArchive) const override final;
 
     virtual void DILIGENT_CALL_TYPE SetMessageCallback(DebugMessageCallbackType MessageCallback) const override final;
@@ -318,6 +323,40 @@ Bool ArchiverFactoryImpl::MergeArchives(
     }
 }
 
+Bool ArchiverFactoryImpl::CompressArchive(const IDataBlob* pSrcArchive,
+                                          Bool             Compress,
+                                          IDataBlob**      ppDstArchive) const
+{
+    if (pSrcArchive == nullptr)
+    {
+        DEV_ERROR("pSrcArchive must not be null");
+        return false;
+    }
+    if (ppDstArchive == nullptr)
+    {
+        DEV_ERROR("ppDstArchive must not be null");
+        return false;
+    }
+    DEV_CHECK_ERR(*ppDstArchive == nullptr, "*ppDstArchive must be null");
+
+    try
+    {
+        DeviceObjectArchive ObjectArchive{DeviceObjectArchive::CreateInfo{pSrcArchive}};
+
+        auto Flags = ObjectArchive.GetFlags() & ~DeviceObjectArchive::ArchiveFlags::CompressedData;
+        if (Compress)
+            Flags |= DeviceObjectArchive::ArchiveFlags::CompressedData;
+        ObjectArchive.SetFlags(Flags);
+
+        ObjectArchive.Serialize(ppDstArchive);
+        return *ppDstArchive != nullptr;
+    }
+    catch (...)
+    {
+        return false;
+    }
+}
+
 Bool ArchiverFactoryImpl::PrintArchiveContent(const IDataBlob* pArchive) const
 {
     try
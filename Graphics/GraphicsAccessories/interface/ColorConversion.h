@@ -98,4 +98,46 @@ inline float4 FastSRGBAToLinear(const float4& SRGBA)
     return float4{FastGammaToLinear(SRGBA.r), FastGammaToLinear(SRGBA.g), FastGammaToLinear(SRGBA.b), SRGBA.a};
 }
 
+
+/// Converts an array of 8-bit sRGB values to linear float values.
+
+/// \param [in]  pSRGB     - Pointer to the array of sRGB values.
+/// \param [out] pLinear   - Pointer to the array of linear values.
+/// \param [in]  NumValues - The number of values to convert.
+///
+/// \remarks    The results are identical to GammaToLinear(Uint8).
+void SRGBToLinear(const Uint8* pSRGB, float* pLinear, size_t NumValues);
+
+/// Converts an array of linear float values to 8-bit sRGB values.
+
+/// \param [in]  pLinear   - Pointer to the array of linear values.
+/// \param [out] pSRGB     - Pointer to the array of sRGB values.
+/// \param [in]  NumValues - The number of values to convert.
+///
+/// \remarks    The values are clamped to [0, 1] range and rounded to the nearest sRGB value,
+///             i.e. the result is round(LinearToGamma(x) * 255) computed with infinite precision.
+///             NaNs are converted to 0.
+void LinearToSRGB(const float* pLinear, Uint8* pSRGB, size_t NumValues);
+
+/// Converts an array of RGBA8 sRGB pixels to linear RGBA16F pixels.
+
+/// \param [in]  pSRGBA    - Pointer to the RGBA8 sRGB pixels.
+/// \param [out] pRGBA16F  - Pointer to the linear RGBA16F pixels.
+/// \param [in]  NumPixels - The number of pixels to convert.
+///
+/// \remarks    Alpha is not gamma-corrected. The results are rounded to the nearest
+///             half-precision value.
+void SRGBA8ToLinearRGBA16F(const Uint8* pSRGBA, Uint16* pRGBA16F, size_t NumPixels);
+
+/// Converts an array of linear RGBA16F pixels to RGBA8 sRGB pixels.
+
+/// \param [in]  pRGBA16F  - Pointer to the linear RGBA16F pixels.
+/// \param [out] pSRGBA    - Pointer to the RGBA8 sRGB pixels.
+/// \param [in]  NumPixels - The number of pixels to convert.
+///
+/// \remarks    Color channels are converted as in LinearToSRGB(const float*, Uint8*, size_t).
+///             Alpha is not gamma-corrected and is clamped to [0, 1] range and rounded to the
+///             nearest 8-bit value.
+void LinearRGBA16FToSRGBA8(const Uint16* pRGBA16F, Uint8* pSRGBA, size_t NumPixels);
+
 DILIGENT_END_NAMESPACE // namespace Diligent
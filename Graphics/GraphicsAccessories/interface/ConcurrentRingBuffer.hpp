@@ -0,0 +1,259 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Implementation of Diligent::ConcurrentRingBuffer class
+
+#include <atomic>
+#include <deque>
+#include <algorithm>
+
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/Align.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+
+/// Implementation of a ring buffer that allows allocating space from multiple threads.
+
+/// The head and the tail of the buffer are monotonically increasing 64-bit positions,
+/// and the offset in the buffer is the position modulo the buffer size. This way the head
+/// never wraps around, and a single atomic value is enough to describe the allocated space.
+///
+/// The head is always aligned by the minimum alignment that is given to the constructor,
+/// so allocations whose alignment does not exceed it are claimed with one atomic fetch-add.
+/// When the claimed range crosses the end of the buffer, it is left unused and the allocation
+/// is retried. Allocations with larger alignment use a compare-exchange loop.
+///
+/// Allocate() may be called from any number of threads simultaneously, and also in parallel with
+/// ReleaseCompletedFrames(). FinishCurrentFrame() and ReleaseCompletedFrames() must be called from
+/// one thread at a time, and all allocations made for the frame must happen before FinishCurrentFrame()
+/// (and the allocations for the next frame - after it).
+class ConcurrentRingBuffer
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr const OffsetType InvalidOffset = static_cast<OffsetType>(-1);
+
+    /// \param[in] MaxSize      - Buffer size. Must be a multiple of MinAlignment.
+    /// \param[in] MinAlignment - Minimum alignment of all allocations. Must be a power of two.
+    /// \param[in] Allocator    - Allocator that is used to allocate the list of frames.
+    ConcurrentRingBuffer(OffsetType MaxSize, OffsetType MinAlignment, IMemoryAllocator& Allocator) noexcept :
+        m_CompletedFrameHeads(STD_ALLOCATOR_RAW_MEM(FrameHeadAttribs, Allocator, "Allocator for deque<FrameHeadAttribs>")),
+        m_MaxSize{MaxSize},
+        m_MinAlignment{MinAlignment}
+    {
+        VERIFY(IsPowerOfTwo(m_MinAlignment), "Min alignment (", m_MinAlignment, ") must be power of 2");
+        VERIFY((m_MaxSize % m_MinAlignment) == 0, "Buffer size (", m_MaxSize, ") must be a multiple of the min alignment (", m_MinAlignment, ")");
+    }
+
+    // clang-format off
+    ConcurrentRingBuffer             (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer             (      ConcurrentRingBuffer&&) = delete;
+    ConcurrentRingBuffer& operator = (const ConcurrentRingBuffer&)  = delete;
+    ConcurrentRingBuffer& operator = (      ConcurrentRingBuffer&&) = delete;
+    // clang-format on
+
+    ~ConcurrentRingBuffer()
+    {
+        VERIFY(IsEmpty(), "All space in the ring buffer must be released");
+    }
+
+    /// Allocates space in the buffer. The method is thread-safe.
+
+    /// \return     Offset of the allocated space, or InvalidOffset if there is not
+    ///             enough free space in the buffer.
+    OffsetType Allocate(OffsetType Size, OffsetType Alignment)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        if (Alignment < m_MinAlignment)
+            Alignment = m_MinAlignment;
+        Size = AlignUp(Size, Alignment);
+
+        if (Size > m_MaxSize)
+            return InvalidOffset;
+
+        return Alignment == m_MinAlignment ?
+            AllocateFetchAdd(Size) :
+            AllocateCompareExchange(Size, Alignment);
+    }
+
+    /// Marks the end of the current frame.
+
+    /// \param[in] FenceValue - The fence value associated with the command lists in which
+    ///                         the allocations of the current frame could have been referenced.
+    ///
+    /// \remarks    See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+    void FinishCurrentFrame(Uint64 FenceValue)
+    {
+#ifdef DILIGENT_DEBUG
+        if (!m_CompletedFrameHeads.empty())
+            VERIFY(FenceValue >= m_CompletedFrameHeads.back().FenceValue, "Current frame fence value (", FenceValue, ") is lower than the fence value of the previous frame (", m_CompletedFrameHeads.back().FenceValue, ")");
+#endif
+        const auto Head = m_Head.load(std::memory_order_acquire);
+        // Ignore zero-size frames
+        if (Head != m_LastFrameHead)
+        {
+            m_CompletedFrameHeads.emplace_back(FenceValue, Head);
+            m_LastFrameHead = Head;
+        }
+    }
+
+    /// Releases the space of all frames whose fence values are less than or equal to CompletedFenceValue.
+
+    /// \remarks    See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+    void ReleaseCompletedFrames(Uint64 CompletedFenceValue)
+    {
+        auto Tail = m_Tail.load(std::memory_order_relaxed);
+        while (!m_CompletedFrameHeads.empty() && m_CompletedFrameHeads.front().FenceValue <= CompletedFenceValue)
+        {
+            VERIFY_EXPR(m_CompletedFrameHeads.front().Head >= Tail);
+            Tail = m_CompletedFrameHeads.front().Head;
+            m_CompletedFrameHeads.pop_front();
+        }
+        // Release semantics make sure that the head that the tail was taken from
+        // is visible to the threads that see the new tail.
+        m_Tail.store(Tail, std::memory_order_release);
+    }
+
+    // clang-format off
+    OffsetType GetMaxSize()  const { return m_MaxSize; }
+    bool       IsFull()      const { return GetUsedSize() == m_MaxSize; }
+    bool       IsEmpty()     const { return GetUsedSize() == 0; }
+    // clang-format on
+
+    /// Returns the size of the space that has not been released yet, including
+    /// the unused space at the end of the buffer left by the wrapped allocations.
+    OffsetType GetUsedSize() const
+    {
+        // The tail must be read first as it never overtakes the head
+        const auto Tail = m_Tail.load(std::memory_order_acquire);
+        const auto Head = m_Head.load(std::memory_order_acquire);
+        VERIFY_EXPR(Head >= Tail);
+        // The head may go beyond the end of the available space when a failed
+        // allocation could not be rolled back.
+        return static_cast<OffsetType>(std::min(Head - Tail, Uint64{m_MaxSize}));
+    }
+
+private:
+    OffsetType AllocateFetchAdd(OffsetType Size)
+    {
+        for (;;)
+        {
+            // Do not claim the space when the buffer is obviously full.
+            {
+                const auto Tail = m_Tail.load(std::memory_order_acquire);
+                const auto Head = m_Head.load(std::memory_order_relaxed);
+                if (Head + Size > Tail + m_MaxSize)
+                    return InvalidOffset;
+            }
+
+            const auto Start = m_Head.fetch_add(Size, std::memory_order_acq_rel);
+            const auto End   = Start + Size;
+            if (End > m_Tail.load(std::memory_order_acquire) + m_MaxSize)
+            {
+                // Another thread has claimed the remaining space. Give the range back if
+                // no other allocation followed it. Otherwise the range is left unused and
+                // is released with the current frame.
+                auto Expected = End;
+                m_Head.compare_exchange_strong(Expected, Start, std::memory_order_acq_rel, std::memory_order_relaxed);
+                return InvalidOffset;
+            }
+
+            const auto Offset = static_cast<OffsetType>(Start % m_MaxSize);
+            if (Offset + Size <= m_MaxSize)
+                return Offset;
+
+            //           End                Tail          Offset        MaxSize
+            //            |                  |             |             |
+            //  [+++++++++                   xxxxxxxxxxxxxx++++++++++++++]
+            //
+            // The range crosses the end of the buffer. Leave it unused and try again:
+            // the next range starts after the end of this one.
+        }
+    }
+
+    OffsetType AllocateCompareExchange(OffsetType Size, OffsetType Alignment)
+    {
+        auto Head = m_Head.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            const auto Offset        = static_cast<OffsetType>(Head % m_MaxSize);
+            const auto AlignedOffset = AlignUp(Offset, Alignment);
+
+            OffsetType AllocOffset = 0;
+            Uint64     NewHead     = 0;
+            if (AlignedOffset + Size <= m_MaxSize)
+            {
+                AllocOffset = AlignedOffset;
+                NewHead     = Head + (AlignedOffset - Offset) + Size;
+            }
+            else
+            {
+                // Allocate from the beginning of the buffer
+                AllocOffset = 0;
+                NewHead     = Head + (m_MaxSize - Offset) + Size;
+            }
+
+            if (NewHead > m_Tail.load(std::memory_order_acquire) + m_MaxSize)
+                return InvalidOffset;
+
+            if (m_Head.compare_exchange_weak(Head, NewHead, std::memory_order_acq_rel, std::memory_order_relaxed))
+                return AllocOffset;
+        }
+    }
+
+    struct FrameHeadAttribs
+    {
+        FrameHeadAttribs(Uint64 fv, Uint64 h) noexcept :
+            FenceValue{fv},
+            Head{h}
+        {}
+
+        // Fence value associated with the command list in which
+        // the allocation could have been referenced last time
+        Uint64 FenceValue;
+        Uint64 Head;
+    };
+    std::deque<FrameHeadAttribs, STDAllocatorRawMem<FrameHeadAttribs>> m_CompletedFrameHeads;
+
+    std::atomic<Uint64> m_Head{0};
+    std::atomic<Uint64> m_Tail{0};
+
+    // Head of the last finished frame, only accessed by FinishCurrentFrame()
+    Uint64 m_LastFrameHead = 0;
+
+    const OffsetType m_MaxSize;
+    const OffsetType m_MinAlignment;
+};
+
+} // namespace Diligent
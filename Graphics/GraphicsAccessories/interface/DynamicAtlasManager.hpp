@@ -32,7 +32,9 @@
 /// Declaration of DynamicAtlasManager class
 
 #include <map>
+#include <set>
 #include <unordered_map>
+#include <vector>
 
 #include "../../../Primitives/interface/BasicTypes.h"
 #include "../../../Common/interface/HashUtils.hpp"
@@ -44,6 +46,23 @@ namespace Diligent
 class DynamicAtlasManager
 {
 public:
+    // Packing mode
+    enum class Mode : Uint8
+    {
+        // Free space is kept in a tree of regions that are split when allocated and
+        // merged back when released. Free regions are ordered by width and by height,
+        // and the smallest suitable region is used.
+        SplitTree,
+
+        // Allocated regions are placed on top of the skyline, the upper boundary of the
+        // used space, at the lowest position where they fit. The space under the skyline
+        // that is not covered by the regions is kept in the list of free regions and is
+        // used first. Released regions lower the skyline when they are at its top.
+        // This mode packs regions tighter and is faster when a large number of regions
+        // is allocated and then released at once, like glyphs or lightmap charts.
+        Skyline
+    };
+
     struct Region
     {
         Uint32 x = 0;
@@ -98,7 +117,7 @@ public:
         };
     };
 
-    DynamicAtlasManager(Uint32 Width, Uint32 Height);
+    DynamicAtlasManager(Uint32 Width, Uint32 Height, Mode PackingMode = Mode::SplitTree);
     ~DynamicAtlasManager();
 
     // clang-format off
@@ -111,15 +130,41 @@ public:
     Region Allocate(Uint32 Width, Uint32 Height);
     void   Free(Region&& R);
 
+    /// Allocates multiple regions at once.
+
+    /// \param [in,out] pRegions   - An array of regions. On input, the width and height of
+    ///                              every region define the size to allocate (x and y are ignored).
+    ///                              On output, the array contains the allocated regions.
+    ///                              Regions that could not be allocated are empty.
+    /// \param [in]     NumRegions - The number of regions in the array.
+    ///
+    /// \return     The number of regions that were allocated.
+    ///
+    /// \remarks    The regions are allocated from the largest to the smallest, which
+    ///             packs them tighter than allocating in arbitrary order.
+    Uint32 Allocate(Region* pRegions, Uint32 NumRegions);
+
     Uint32 GetFreeRegionCount() const
     {
         VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
-        return static_cast<Uint32>(m_FreeRegionsByWidth.size());
+        auto Count = static_cast<Uint32>(m_FreeRegionsByWidth.size());
+        // In skyline mode, the space above every skyline segment is also a free region
+        for (const auto& Segment : m_Skyline)
+            Count += Segment.y < m_Height ? 1 : 0;
+        return Count;
     }
 
     Uint32 GetWidth() const { return m_Width; }
     Uint32 GetHeight() const { return m_Height; }
     Uint64 GetTotalFreeArea() const { return m_TotalFreeArea; }
+    Mode   GetMode() const { return m_Mode; }
+
+    /// Returns the fraction of the atlas area that is occupied by the allocated regions.
+    float GetOccupancy() const
+    {
+        const auto TotalArea = Uint64{m_Width} * Uint64{m_Height};
+        return TotalArea != 0 ? static_cast<float>(TotalArea - m_TotalFreeArea) / static_cast<float>(TotalArea) : 0.f;
+    }
 
     bool IsEmpty() const
     {
@@ -168,6 +213,7 @@ private:
 
     const Uint32 m_Width;
     const Uint32 m_Height;
+    const Mode   m_Mode;
 
     Uint64 m_TotalFreeArea = 0;
 
@@ -218,16 +264,61 @@ private:
         Uint32                  NumChildren = 0;
         std::unique_ptr<Node[]> Children;
     };
-    std::unique_ptr<Node> m_Root{new Node};
+    // Root of the region tree, null in skyline mode
+    std::unique_ptr<Node> m_Root;
 
     void RegisterNode(Node& N);
     void UnregisterNode(const Node& N);
 
-    // Free regions ordered by width->height->x->y
+    // Finds the smallest free region that fits the given size.
+    // Returns the empty region if there is no such region.
+    std::pair<Region, Node*> FindFreeRegion(Uint32 Width, Uint32 Height) const;
+
+    Region AllocateFromTree(Uint32 Width, Uint32 Height);
+    void   FreeInTree(const Region& R);
+
+    Region AllocateFromSkyline(Uint32 Width, Uint32 Height);
+    void   FreeInSkyline(const Region& R);
+
+    void ResetSkyline();
+    void AddFreeRegion(const Region& R);
+    void RemoveFreeRegion(const Region& R);
+
+    // Returns the skyline height under the given span, or UINT_MAX if the heights are not all the same
+    Uint32 GetSkylineLevel(Uint32 x, Uint32 Width) const;
+    // Sets the skyline height under the given span
+    void SetSkylineLevel(Uint32 x, Uint32 Width, Uint32 y);
+    // Lowers the skyline under the given span and merges the free regions that appear on top of it
+    void LowerSkyline(Uint32 x, Uint32 Width, Uint32 y);
+
+    // Skyline segment [x, x + width) at the height y
+    struct SkylineSegment
+    {
+        Uint32 x     = 0;
+        Uint32 y     = 0;
+        Uint32 width = 0;
+    };
+    // Skyline segments ordered by x, only used in skyline mode
+    std::vector<SkylineSegment> m_Skyline;
+
+    struct TopFirstCompare
+    {
+        bool operator()(const Region& R0, const Region& R1) const
+        {
+            const auto Top0 = R0.y + R0.height;
+            const auto Top1 = R1.y + R1.height;
+            return Top0 != Top1 ? Top0 < Top1 : R0.x < R1.x;
+        }
+    };
+    // Free regions under the skyline ordered by top->x, only used in skyline mode
+    std::set<Region, TopFirstCompare> m_FreeRegionsByTop;
+
+    // Free regions ordered by width->height->x->y.
+    // In skyline mode, these are the free regions under the skyline, and nodes are null.
     std::map<Region, Node*, WidthFirstCompare> m_FreeRegionsByWidth;
     // Free regions ordered by height->width->y->x
     std::map<Region, Node*, HeightFirstCompare> m_FreeRegionsByHeight;
-    // Allocated regions
+    // Allocated regions (nodes are null in skyline mode)
     std::unordered_map<Region, Node*, Region::Hasher> m_AllocatedRegions;
 };
 
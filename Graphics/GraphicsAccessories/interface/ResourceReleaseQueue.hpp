@@ -36,6 +36,10 @@
 #include <mutex>
 #include <deque>
 #include <atomic>
+#include <thread>
+#include <chrono>
+#include <condition_variable>
+#include <algorithm>
 
 #include "../../../Primitives/interface/MemoryAllocator.h"
 #include "../../../Common/interface/STDAllocator.hpp"
@@ -211,6 +215,28 @@ private:
     ResourceType m_StaleResource;
 };
 
+/// Resource release queue statistics
+struct ResourceReleaseQueueStats
+{
+    /// The number of stale resources waiting for their command lists to be submitted
+    size_t StaleResourceCount = 0;
+
+    /// The number of resources in the release queue, including those whose
+    /// fence has completed but that were not released because of the budget
+    size_t PendingReleaseResourceCount = 0;
+
+    /// The number of resources waiting to be destroyed by the background thread
+    size_t BackgroundReleaseResourceCount = 0;
+
+    /// The number of resources destroyed since the queue creation or the last ResetStats() call
+    Uint64 ReleasedResourceCount = 0;
+
+    /// Average and maximum time, in seconds, between the moment when a resource
+    /// was added to the release queue and the moment when it was destroyed
+    double AvgReleaseLatency = 0;
+    double MaxReleaseLatency = 0;
+};
+
 /// Facilitates safe resource destruction in D3D12 and Vulkan
 
 /// Resource destruction is a two-stage process:
@@ -220,6 +246,11 @@ private:
 ///   the command list
 /// * Resources are removed and actually destroyed from the queue when fence is signaled and the queue is Purged
 ///
+/// Purge() may limit the number of resources it destroys or the time it spends, in which case
+/// the remaining resources are destroyed by the following calls. This allows spreading the release
+/// of a large number of resources over several frames. Alternatively, resources may be destroyed
+/// by a background thread, see StartBackgroundRelease().
+///
 /// \tparam ResourceWrapperType -  Type of the resource wrapper used by the release queue.
 template <typename ResourceWrapperType>
 class ResourceReleaseQueue
@@ -227,17 +258,27 @@ class ResourceReleaseQueue
 public:
     // clang-format off
     ResourceReleaseQueue(IMemoryAllocator& Allocator) :
-        m_ReleaseQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
-        m_StaleResources(STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
+        m_ReleaseQueue     (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>")),
+        m_StaleResources   (STD_ALLOCATOR_RAW_MEM(StaleResourceElemType, Allocator, "Allocator for deque<StaleResourceElemType>")),
+        m_BackgroundQueue  (STD_ALLOCATOR_RAW_MEM(ReleaseQueueElemType, Allocator, "Allocator for deque<ReleaseQueueElemType>"))
     {}
     // clang-format on
 
     ~ResourceReleaseQueue()
     {
+        StopBackgroundRelease();
+
         DEV_CHECK_ERR(m_StaleResources.empty(), "Not all stale objects were destroyed");
         DEV_CHECK_ERR(m_ReleaseQueue.empty(), "Release queue is not empty");
     }
 
+    // clang-format off
+    ResourceReleaseQueue             (const ResourceReleaseQueue&)  = delete;
+    ResourceReleaseQueue             (      ResourceReleaseQueue&&) = delete;
+    ResourceReleaseQueue& operator = (const ResourceReleaseQueue&)  = delete;
+    ResourceReleaseQueue& operator = (      ResourceReleaseQueue&&) = delete;
+    // clang-format on
+
     /// Creates a resource wrapper for the specific resource type
     /// \param [in] Resource      - Resource to be released
     /// \param [in] NumReferences - Number of references to the resource
@@ -288,8 +329,9 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(ResourceWrapperType&& Wrapper, Uint64 FenceValue)
     {
+        const auto                  DiscardTime = ClockType::now();
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, std::move(Wrapper));
+        m_ReleaseQueue.emplace_back(FenceValue, DiscardTime, std::move(Wrapper));
     }
 
     /// Adds a copy of the resource wrapper directly to the release queue
@@ -297,8 +339,9 @@ public:
     /// \param [in] FenceValue  - Fence value indicating when the resource was used last time.
     void DiscardResource(const ResourceWrapperType& Wrapper, Uint64 FenceValue)
     {
+        const auto                  DiscardTime = ClockType::now();
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
-        m_ReleaseQueue.emplace_back(FenceValue, Wrapper);
+        m_ReleaseQueue.emplace_back(FenceValue, DiscardTime, Wrapper);
     }
 
     /// Adds multiple resources directly to the release queue
@@ -307,11 +350,12 @@ public:
     template <typename ResourceType, typename IteratorType>
     void DiscardResources(Uint64 FenceValue, IteratorType Iterator)
     {
+        const auto                  DiscardTime = ClockType::now();
         std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
         ResourceType                Resource;
         while (Iterator(Resource))
         {
-            m_ReleaseQueue.emplace_back(FenceValue, CreateWrapper(std::move(Resource), 1));
+            m_ReleaseQueue.emplace_back(FenceValue, DiscardTime, CreateWrapper(std::move(Resource), 1));
         }
     }
 
@@ -324,6 +368,8 @@ public:
     ///                                      is greater or equal to the fence value associated with the resource
     void DiscardStaleResources(Uint64 SubmittedCmdBuffNumber, Uint64 FenceValue)
     {
+        const auto DiscardTime = ClockType::now();
+
         // Only discard these stale objects that were released before CmdBuffNumber
         // was executed
         std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
@@ -333,7 +379,7 @@ public:
             auto& FirstStaleObj = m_StaleResources.front();
             if (FirstStaleObj.first <= SubmittedCmdBuffNumber)
             {
-                m_ReleaseQueue.emplace_back(FenceValue, std::move(FirstStaleObj.second));
+                m_ReleaseQueue.emplace_back(FenceValue, DiscardTime, std::move(FirstStaleObj.second));
                 m_StaleResources.pop_front();
             }
             else
@@ -347,18 +393,113 @@ public:
     /// \param [in] CompletedFenceValue  -  Value of the fence that has been completed by the GPU
     void Purge(Uint64 CompletedFenceValue)
     {
+        Purge(CompletedFenceValue, 0, 0);
+    }
+
+    /// Removes objects from the release queue whose fence value is less than or equal
+    /// to CompletedFenceValue, while the budget allows.
+    /// \param [in] CompletedFenceValue  - Value of the fence that has been completed by the GPU
+    /// \param [in] MaxResourceCount     - The maximum number of resources to release, or 0 if there is no limit.
+    /// \param [in] MaxTime              - The maximum time, in seconds, to spend releasing resources, or 0 if there is no limit.
+    ///
+    /// \return     The number of resources that were released.
+    ///
+    /// \remarks    At least one resource is released when any resource is ready, so that the queue always
+    ///             makes progress. The resources that were not released because of the budget stay in
+    ///             the queue and are released by the next calls.
+    ///             When background release is enabled, all completed resources are handed to the background
+    ///             thread regardless of the budget, as this is cheap.
+    size_t Purge(Uint64 CompletedFenceValue, size_t MaxResourceCount, double MaxTime)
+    {
+        const auto StartTime = ClockType::now();
+
         std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
 
-        // Release all objects whose associated fence value is at most CompletedFenceValue
+        if (m_BackgroundReleaseEnabled)
+        {
+            size_t NumResources = 0;
+            {
+                std::lock_guard<std::mutex> BackgroundQueueLock{m_BackgroundQueueMutex};
+                while (!m_ReleaseQueue.empty() && m_ReleaseQueue.front().FenceValue <= CompletedFenceValue)
+                {
+                    m_BackgroundQueue.emplace_back(std::move(m_ReleaseQueue.front()));
+                    m_ReleaseQueue.pop_front();
+                    ++NumResources;
+                }
+            }
+            if (NumResources > 0)
+                m_BackgroundQueueCondVar.notify_one();
+            return NumResources;
+        }
+
+        // Release objects whose associated fence value is at most CompletedFenceValue
         // See http://diligentgraphics.com/diligent-engine/architecture/d3d12/managing-resource-lifetimes/
+        ReleaseLatencyStats Stats;
+        auto                CurrTime = StartTime;
         while (!m_ReleaseQueue.empty())
         {
             auto& FirstObj = m_ReleaseQueue.front();
-            if (FirstObj.first <= CompletedFenceValue)
-                m_ReleaseQueue.pop_front();
-            else
+            if (FirstObj.FenceValue > CompletedFenceValue)
+                break;
+
+            if (MaxResourceCount != 0 && Stats.Count >= MaxResourceCount)
                 break;
+
+            if (MaxTime > 0 && Stats.Count > 0)
+            {
+                CurrTime = ClockType::now();
+                if (std::chrono::duration<double>{CurrTime - StartTime}.count() >= MaxTime)
+                    break;
+            }
+
+            Stats.Add(CurrTime - FirstObj.DiscardTime);
+            m_ReleaseQueue.pop_front();
+        }
+        UpdateStats(Stats);
+
+        return static_cast<size_t>(Stats.Count);
+    }
+
+    /// Starts a thread that destroys the resources released by Purge().
+
+    /// \remarks    Only enable background release when the destructors of all resources in the queue
+    ///             are safe to run on a thread other than the one that calls Purge().
+    ///             The method must not be called simultaneously with Purge() or StopBackgroundRelease().
+    void StartBackgroundRelease()
+    {
+        if (m_BackgroundReleaseThread.joinable())
+            return;
+
+        m_StopBackgroundThread = false;
+
+        m_BackgroundReleaseThread = std::thread{[this]() { BackgroundReleaseThreadProc(); }};
+
+        std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+        m_BackgroundReleaseEnabled = true;
+    }
+
+    /// Stops the background release thread after it destroys all resources handed to it.
+    void StopBackgroundRelease()
+    {
+        if (!m_BackgroundReleaseThread.joinable())
+            return;
+
+        {
+            std::lock_guard<std::mutex> LockGuard(m_ReleaseQueueMutex);
+            m_BackgroundReleaseEnabled = false;
+        }
+        {
+            std::lock_guard<std::mutex> BackgroundQueueLock{m_BackgroundQueueMutex};
+            m_StopBackgroundThread = true;
         }
+        m_BackgroundQueueCondVar.notify_one();
+        m_BackgroundReleaseThread.join();
+        VERIFY_EXPR(m_BackgroundQueue.empty());
+    }
+
+    bool IsBackgroundReleaseEnabled() const
+    {
+        return m_BackgroundReleaseThread.joinable();
     }
 
     /// Returns the number of stale resources
@@ -373,13 +514,129 @@ public:
         return m_ReleaseQueue.size();
     }
 
+    /// Returns the queue statistics
+    ResourceReleaseQueueStats GetStats() const
+    {
+        ResourceReleaseQueueStats Stats;
+        {
+            std::lock_guard<std::mutex> StaleObjectsLock(m_StaleObjectsMutex);
+            Stats.StaleResourceCount = m_StaleResources.size();
+        }
+        {
+            std::lock_guard<std::mutex> ReleaseQueueLock(m_ReleaseQueueMutex);
+            Stats.PendingReleaseResourceCount = m_ReleaseQueue.size();
+        }
+        {
+            std::lock_guard<std::mutex> BackgroundQueueLock{m_BackgroundQueueMutex};
+            Stats.BackgroundReleaseResourceCount = m_BackgroundQueue.size();
+        }
+
+        Stats.ReleasedResourceCount = m_ReleasedResourceCount.load();
+        if (Stats.ReleasedResourceCount > 0)
+            Stats.AvgReleaseLatency = static_cast<double>(m_TotalReleaseLatency.load()) * 1e-9 / static_cast<double>(Stats.ReleasedResourceCount);
+        Stats.MaxReleaseLatency = static_cast<double>(m_MaxReleaseLatency.load()) * 1e-9;
+
+        return Stats;
+    }
+
+    /// Resets the number of released resources and the release latency statistics
+    void ResetStats()
+    {
+        m_ReleasedResourceCount.store(0);
+        m_TotalReleaseLatency.store(0);
+        m_MaxReleaseLatency.store(0);
+    }
+
 private:
-    std::mutex m_ReleaseQueueMutex;
-    using ReleaseQueueElemType = std::pair<Uint64, ResourceWrapperType>;
+    using ClockType = std::chrono::steady_clock;
+
+    struct ReleaseQueueElemType
+    {
+        template <typename WrapperType>
+        ReleaseQueueElemType(Uint64 _FenceValue, ClockType::time_point _DiscardTime, WrapperType&& _Wrapper) :
+            FenceValue{_FenceValue},
+            DiscardTime{_DiscardTime},
+            Wrapper{std::forward<WrapperType>(_Wrapper)}
+        {}
+
+        Uint64                FenceValue;
+        ClockType::time_point DiscardTime;
+        ResourceWrapperType   Wrapper;
+    };
+
+    struct ReleaseLatencyStats
+    {
+        Uint64 Count        = 0;
+        Uint64 TotalLatency = 0; // In nanoseconds
+        Uint64 MaxLatency   = 0;
+
+        void Add(ClockType::duration Latency)
+        {
+            const auto LatencyNs = static_cast<Uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(Latency).count());
+            ++Count;
+            TotalLatency += LatencyNs;
+            MaxLatency = std::max(MaxLatency, LatencyNs);
+        }
+    };
+
+    void UpdateStats(const ReleaseLatencyStats& Stats)
+    {
+        if (Stats.Count == 0)
+            return;
+
+        m_ReleasedResourceCount.fetch_add(Stats.Count);
+        m_TotalReleaseLatency.fetch_add(Stats.TotalLatency);
+        auto MaxLatency = m_MaxReleaseLatency.load();
+        while (MaxLatency < Stats.MaxLatency && !m_MaxReleaseLatency.compare_exchange_weak(MaxLatency, Stats.MaxLatency))
+        {
+        }
+    }
+
+    void BackgroundReleaseThreadProc()
+    {
+        std::unique_lock<std::mutex> Lock{m_BackgroundQueueMutex};
+
+        auto Batch = decltype(m_BackgroundQueue){m_BackgroundQueue.get_allocator()};
+        for (;;)
+        {
+            m_BackgroundQueueCondVar.wait(Lock, [this]() { return !m_BackgroundQueue.empty() || m_StopBackgroundThread; });
+            if (m_BackgroundQueue.empty())
+                break;
+
+            // Destroy the resources without holding the lock
+            Batch.swap(m_BackgroundQueue);
+            Lock.unlock();
+
+            const auto          CurrTime = ClockType::now();
+            ReleaseLatencyStats Stats;
+            for (const auto& Elem : Batch)
+                Stats.Add(CurrTime - Elem.DiscardTime);
+            Batch.clear();
+            UpdateStats(Stats);
+
+            Lock.lock();
+        }
+    }
+
+    mutable std::mutex                                                         m_ReleaseQueueMutex;
     std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_ReleaseQueue;
 
-    std::mutex                                                                 m_StaleObjectsMutex;
-    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_StaleResources;
+    using StaleResourceElemType = std::pair<Uint64, ResourceWrapperType>;
+    mutable std::mutex                                                           m_StaleObjectsMutex;
+    std::deque<StaleResourceElemType, STDAllocatorRawMem<StaleResourceElemType>> m_StaleResources;
+
+    // Protected by m_ReleaseQueueMutex
+    bool m_BackgroundReleaseEnabled = false;
+
+    mutable std::mutex                                                         m_BackgroundQueueMutex;
+    std::condition_variable                                                    m_BackgroundQueueCondVar;
+    std::deque<ReleaseQueueElemType, STDAllocatorRawMem<ReleaseQueueElemType>> m_BackgroundQueue;
+    bool                                                                       m_StopBackgroundThread = false;
+    std::thread                                                                m_BackgroundReleaseThread;
+
+    std::atomic<Uint64> m_ReleasedResourceCount{0};
+    std::atomic<Uint64> m_TotalReleaseLatency{0}; // In nanoseconds
+    std::atomic<Uint64> m_MaxReleaseLatency{0};   // In nanoseconds
 };
 
 } // namespace Diligent
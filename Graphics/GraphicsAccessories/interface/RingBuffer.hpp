@@ -40,6 +40,7 @@
 namespace Diligent
 {
 /// Implementation of a ring buffer. The class is not thread-safe.
+/// See ConcurrentRingBuffer for the version that allows allocating from multiple threads.
 class RingBuffer
 {
 public:
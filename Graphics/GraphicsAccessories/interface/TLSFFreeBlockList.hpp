@@ -0,0 +1,534 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::TLSFFreeBlockList class
+
+#include <vector>
+#include <algorithm>
+
+#include "../../../Primitives/interface/MemoryAllocator.h"
+#include "../../../Platforms/interface/PlatformMisc.hpp"
+#include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
+#include "../../../Common/interface/STDAllocator.hpp"
+
+namespace Diligent
+{
+
+// The class keeps track of free blocks using the two-level segregated fit (TLSF) scheme.
+// Free blocks are distributed between size classes: the first level splits the sizes
+// into power-of-two ranges, and the second level splits every range into SLCount
+// equal subranges. Every class keeps a doubly-linked list of its blocks, and two levels
+// of bitmaps indicate non-empty classes, so that a suitable block is found with a couple
+// of bit scans.
+//
+//      FL     Size range       SL classes
+//       0     [0, 16)          16 classes, 1 byte each
+//       1     [16, 32)         16 classes, 1 byte each
+//       2     [32, 64)         16 classes, 2 bytes each
+//       3     [64, 128)        16 classes, 4 bytes each
+//      ...
+//
+// The list manages offsets rather than memory, so block nodes are kept in a separate array,
+// and two open-addressing hash tables map block start and end offsets to the nodes.
+// This allows finding the adjacent free blocks when a block is released.
+// All operations take constant time, and memory is only allocated when the number
+// of free blocks exceeds the previous maximum. The only exception is the largest block,
+// which is tracked incrementally, but has to be searched for in the top size class when
+// it is requested after the block has been removed.
+class TLSFFreeBlockList
+{
+public:
+    using OffsetType = size_t;
+
+    static constexpr Uint32 InvalidIndex = ~Uint32{0};
+
+    struct Block
+    {
+        OffsetType Offset = 0;
+        OffsetType Size   = 0;
+
+        // Previous and next blocks in the list of the size class.
+        // For unused nodes, NextFree is the next unused node.
+        Uint32 PrevFree = InvalidIndex;
+        Uint32 NextFree = InvalidIndex;
+    };
+
+    explicit TLSFFreeBlockList(IMemoryAllocator& Allocator) :
+        // clang-format off
+        m_Blocks     {STD_ALLOCATOR_RAW_MEM(Block,  Allocator, "Allocator for vector<TLSFFreeBlockList::Block>")},
+        m_Heads      {STD_ALLOCATOR_RAW_MEM(Uint32, Allocator, "Allocator for vector<Uint32>")},
+        m_SLBitmaps  {STD_ALLOCATOR_RAW_MEM(Uint32, Allocator, "Allocator for vector<Uint32>")},
+        m_OffsetTable{Allocator},
+        m_EndTable   {Allocator}
+    // clang-format on
+    {}
+
+    // clang-format off
+    TLSFFreeBlockList(TLSFFreeBlockList&& rhs) noexcept
+        : m_Blocks          {std::move(rhs.m_Blocks)     }
+        , m_Heads           {std::move(rhs.m_Heads)      }
+        , m_SLBitmaps       {std::move(rhs.m_SLBitmaps)  }
+        , m_OffsetTable     {std::move(rhs.m_OffsetTable)}
+        , m_EndTable        {std::move(rhs.m_EndTable)   }
+        , m_FLBitmap        {rhs.m_FLBitmap        }
+        , m_FirstUnusedBlock{rhs.m_FirstUnusedBlock}
+        , m_NumBlocks       {rhs.m_NumBlocks       }
+        , m_MaxBlock        {rhs.m_MaxBlock        }
+        , m_MaxBlockSize    {rhs.m_MaxBlockSize    }
+    {
+        rhs.m_FLBitmap         = 0;
+        rhs.m_FirstUnusedBlock = InvalidIndex;
+        rhs.m_NumBlocks        = 0;
+        rhs.m_MaxBlock         = InvalidIndex;
+        rhs.m_MaxBlockSize     = 0;
+    }
+
+    TLSFFreeBlockList           (const TLSFFreeBlockList&) = delete;
+    TLSFFreeBlockList& operator=(const TLSFFreeBlockList&) = delete;
+    TLSFFreeBlockList& operator=(TLSFFreeBlockList&&)      = delete;
+    // clang-format on
+
+    void AddBlock(OffsetType Offset, OffsetType Size)
+    {
+        VERIFY_EXPR(Size > 0);
+        if (m_Heads.empty())
+        {
+            // Class lists are only allocated when the first block is added
+            m_Heads.resize(size_t{FLCount} * SLCount, Uint32{InvalidIndex});
+            m_SLBitmaps.resize(FLCount);
+        }
+
+        Uint32 Index = m_FirstUnusedBlock;
+        if (Index != InvalidIndex)
+        {
+            m_FirstUnusedBlock = m_Blocks[Index].NextFree;
+        }
+        else
+        {
+            Index = static_cast<Uint32>(m_Blocks.size());
+            m_Blocks.emplace_back();
+        }
+
+        auto& NewBlock  = m_Blocks[Index];
+        NewBlock.Offset = Offset;
+        NewBlock.Size   = Size;
+
+        Uint32 FL = 0, SL = 0;
+        GetClass(Size, FL, SL);
+
+        auto& Head        = m_Heads[FL * SLCount + SL];
+        NewBlock.PrevFree = InvalidIndex;
+        NewBlock.NextFree = Head;
+        if (Head != InvalidIndex)
+            m_Blocks[Head].PrevFree = Index;
+        Head = Index;
+
+        m_FLBitmap |= Uint64{1} << FL;
+        m_SLBitmaps[FL] |= 1u << SL;
+
+        m_OffsetTable.Insert(Offset, Index);
+        m_EndTable.Insert(Offset + Size, Index);
+        ++m_NumBlocks;
+
+        // m_MaxBlockSize is never less than the size of any block in the list, so a block that
+        // is at least as large is the largest one, even if the largest block is not known.
+        if (Size >= m_MaxBlockSize)
+        {
+            m_MaxBlock     = Index;
+            m_MaxBlockSize = Size;
+        }
+    }
+
+    void RemoveBlock(Uint32 Index)
+    {
+        VERIFY_EXPR(Index < m_Blocks.size());
+        auto& RemovedBlock = m_Blocks[Index];
+        VERIFY(RemovedBlock.Size != 0, "The block is not in the list");
+
+        Uint32 FL = 0, SL = 0;
+        GetClass(RemovedBlock.Size, FL, SL);
+
+        if (RemovedBlock.PrevFree != InvalidIndex)
+        {
+            m_Blocks[RemovedBlock.PrevFree].NextFree = RemovedBlock.NextFree;
+        }
+        else
+        {
+            auto& Head = m_Heads[FL * SLCount + SL];
+            VERIFY_EXPR(Head == Index);
+            Head = RemovedBlock.NextFree;
+            if (Head == InvalidIndex)
+            {
+                m_SLBitmaps[FL] &= ~(1u << SL);
+                if (m_SLBitmaps[FL] == 0)
+                    m_FLBitmap &= ~(Uint64{1} << FL);
+            }
+        }
+        if (RemovedBlock.NextFree != InvalidIndex)
+            m_Blocks[RemovedBlock.NextFree].PrevFree = RemovedBlock.PrevFree;
+
+        m_OffsetTable.Erase(RemovedBlock.Offset);
+        m_EndTable.Erase(RemovedBlock.Offset + RemovedBlock.Size);
+
+        RemovedBlock          = Block{};
+        RemovedBlock.NextFree = m_FirstUnusedBlock;
+        m_FirstUnusedBlock    = Index;
+
+        VERIFY_EXPR(m_NumBlocks > 0);
+        --m_NumBlocks;
+
+        // The largest block is found by GetMaxBlock() when it is requested.
+        if (Index == m_MaxBlock)
+            m_MaxBlock = InvalidIndex;
+        if (m_NumBlocks == 0)
+            m_MaxBlockSize = 0;
+    }
+
+    // Returns the index of a block that is at least MinSize bytes large, or InvalidIndex
+    // if there is no such block.
+    Uint32 FindBlock(OffsetType MinSize) const
+    {
+        VERIFY_EXPR(MinSize > 0);
+        if (m_FLBitmap == 0)
+            return InvalidIndex;
+
+        // Round the size up to the next class boundary, so that every block
+        // in the class found by the bitmap search is large enough.
+        Uint32     FL = 0, SL = 0;
+        OffsetType RoundedSize = MinSize;
+        if (MinSize >= SLCount)
+            RoundedSize += (OffsetType{1} << (GetMSB(MinSize) - SLI)) - 1;
+        if (RoundedSize >= MinSize)
+        {
+            GetClass(RoundedSize, FL, SL);
+
+            Uint32 SLBitmap = m_SLBitmaps[FL] & (~0u << SL);
+            if (SLBitmap == 0)
+            {
+                const auto FLBitmap = FL + 1 < FLCount ? m_FLBitmap & (~Uint64{0} << (FL + 1)) : 0;
+                if (FLBitmap != 0)
+                {
+                    FL       = PlatformMisc::GetLSB(FLBitmap);
+                    SLBitmap = m_SLBitmaps[FL];
+                }
+            }
+
+            if (SLBitmap != 0)
+            {
+                SL = PlatformMisc::GetLSB(SLBitmap);
+                VERIFY_EXPR(m_Heads[FL * SLCount + SL] != InvalidIndex);
+                return m_Heads[FL * SLCount + SL];
+            }
+        }
+
+        // Larger classes are empty, but the class of MinSize may still contain a large
+        // enough block. This only happens when the free space is almost exhausted, and
+        // the largest block is the only candidate.
+        const auto MaxBlock = GetMaxBlock();
+        return m_Blocks[MaxBlock].Size >= MinSize ? MaxBlock : InvalidIndex;
+    }
+
+    // Returns the index of the block that starts at the given offset, or InvalidIndex.
+    Uint32 FindBlockByOffset(OffsetType Offset) const
+    {
+        return m_OffsetTable.Find(Offset);
+    }
+
+    // Returns the index of the block that ends at the given offset, or InvalidIndex.
+    Uint32 FindBlockByEnd(OffsetType EndOffset) const
+    {
+        return m_EndTable.Find(EndOffset);
+    }
+
+    const Block& GetBlock(Uint32 Index) const
+    {
+        VERIFY_EXPR(Index < m_Blocks.size() && m_Blocks[Index].Size != 0);
+        return m_Blocks[Index];
+    }
+
+    size_t GetNumBlocks() const
+    {
+        return m_NumBlocks;
+    }
+
+    OffsetType GetMaxBlockSize() const
+    {
+        return m_FLBitmap != 0 ? m_Blocks[GetMaxBlock()].Size : 0;
+    }
+
+    // Calls Handler(const Block&) for every free block in no particular order.
+    template <typename HandlerType>
+    void ProcessBlocks(HandlerType&& Handler) const
+    {
+        for (const auto& FreeBlock : m_Blocks)
+        {
+            if (FreeBlock.Size != 0)
+                Handler(FreeBlock);
+        }
+    }
+
+#ifdef DILIGENT_DEBUG
+    void DbgVerifyConsistency() const
+    {
+        size_t NumBlocks = 0;
+        for (Uint32 FL = 0; FL < FLCount && !m_Heads.empty(); ++FL)
+        {
+            VERIFY(((m_FLBitmap >> FL) & 1) == (m_SLBitmaps[FL] != 0 ? 1 : 0), "Inconsistent first-level bitmap");
+            for (Uint32 SL = 0; SL < SLCount; ++SL)
+            {
+                const auto Head = m_Heads[FL * SLCount + SL];
+                VERIFY(((m_SLBitmaps[FL] >> SL) & 1) == (Head != InvalidIndex ? 1u : 0u), "Inconsistent second-level bitmap");
+
+                Uint32 Prev = InvalidIndex;
+                for (auto Index = Head; Index != InvalidIndex; Index = m_Blocks[Index].NextFree)
+                {
+                    const auto& FreeBlock = m_Blocks[Index];
+                    VERIFY_EXPR(FreeBlock.PrevFree == Prev);
+
+                    Uint32 BlockFL = 0, BlockSL = 0;
+                    GetClass(FreeBlock.Size, BlockFL, BlockSL);
+                    VERIFY(BlockFL == FL && BlockSL == SL, "Block is in the wrong size class");
+                    VERIFY_EXPR(FindBlockByOffset(FreeBlock.Offset) == Index);
+                    VERIFY_EXPR(FindBlockByEnd(FreeBlock.Offset + FreeBlock.Size) == Index);
+
+                    Prev = Index;
+                    ++NumBlocks;
+                }
+            }
+        }
+        VERIFY_EXPR(NumBlocks == m_NumBlocks);
+        VERIFY_EXPR(m_OffsetTable.GetSize() == m_NumBlocks && m_EndTable.GetSize() == m_NumBlocks);
+        ProcessBlocks([this](const Block& FreeBlock) {
+            VERIFY(FreeBlock.Size <= m_MaxBlockSize, "Block size exceeds the max block size");
+        });
+        VERIFY_EXPR(m_MaxBlock == InvalidIndex || m_Blocks[m_MaxBlock].Size == m_MaxBlockSize);
+    }
+#endif
+
+private:
+    // Log2 of the number of second-level classes
+    static constexpr Uint32 SLI     = 4;
+    static constexpr Uint32 SLCount = 1u << SLI;
+    // The number of first-level classes required to cover the entire OffsetType range
+    static constexpr Uint32 FLCount = sizeof(OffsetType) * 8 - SLI + 1;
+
+    static Uint32 GetMSB(OffsetType Val)
+    {
+        return PlatformMisc::GetMSB(static_cast<Uint64>(Val));
+    }
+
+    // Returns the index of the largest block. The list must not be empty.
+    Uint32 GetMaxBlock() const
+    {
+        VERIFY_EXPR(m_FLBitmap != 0);
+        if (m_MaxBlock == InvalidIndex)
+        {
+            // The largest block has been removed. Find the new one in the top non-empty class.
+            // This is only done on request, and the result is cached until the block is removed.
+            const auto FL = PlatformMisc::GetMSB(m_FLBitmap);
+            const auto SL = PlatformMisc::GetMSB(m_SLBitmaps[FL]);
+
+            m_MaxBlockSize = 0;
+            for (auto Index = m_Heads[FL * SLCount + SL]; Index != InvalidIndex; Index = m_Blocks[Index].NextFree)
+            {
+                if (m_Blocks[Index].Size > m_MaxBlockSize)
+                {
+                    m_MaxBlock     = Index;
+                    m_MaxBlockSize = m_Blocks[Index].Size;
+                }
+            }
+        }
+        return m_MaxBlock;
+    }
+
+    static void GetClass(OffsetType Size, Uint32& FL, Uint32& SL)
+    {
+        if (Size < SLCount)
+        {
+            FL = 0;
+            SL = static_cast<Uint32>(Size);
+        }
+        else
+        {
+            const auto MSB = GetMSB(Size);
+            FL             = MSB - SLI + 1;
+            SL             = static_cast<Uint32>(Size >> (MSB - SLI)) - SLCount;
+        }
+        VERIFY_EXPR(FL < FLCount && SL < SLCount);
+    }
+
+    // Open-addressing hash table with linear probing that maps offsets to block indices.
+    class OffsetHashTable
+    {
+    public:
+        explicit OffsetHashTable(IMemoryAllocator& Allocator) :
+            m_Entries{STD_ALLOCATOR_RAW_MEM(Entry, Allocator, "Allocator for vector<TLSFFreeBlockList::OffsetHashTable::Entry>")}
+        {}
+
+        // clang-format off
+        OffsetHashTable(OffsetHashTable&& rhs) noexcept
+            : m_Entries{std::move(rhs.m_Entries)}
+            , m_Size   {rhs.m_Size }
+            , m_Mask   {rhs.m_Mask }
+            , m_Shift  {rhs.m_Shift}
+        {
+            // clang-format on
+            rhs.m_Entries.clear();
+            rhs.m_Size  = 0;
+            rhs.m_Mask  = 0;
+            rhs.m_Shift = 64;
+        }
+
+        // clang-format off
+        OffsetHashTable           (const OffsetHashTable&) = delete;
+        OffsetHashTable& operator=(const OffsetHashTable&) = delete;
+        OffsetHashTable& operator=(OffsetHashTable&&)      = delete;
+        // clang-format on
+
+        void Insert(OffsetType Key, Uint32 Value)
+        {
+            VERIFY_EXPR(Key != EmptyKey);
+            // Keep the load factor at or below 1/2
+            if ((m_Size + 1) * 2 > m_Entries.size())
+                Grow();
+
+            auto Slot = GetSlot(Key);
+            while (m_Entries[Slot].Key != EmptyKey)
+            {
+                VERIFY(m_Entries[Slot].Key != Key, "Key ", Key, " is already in the table");
+                Slot = (Slot + 1) & m_Mask;
+            }
+            m_Entries[Slot] = {Key, Value};
+            ++m_Size;
+        }
+
+        Uint32 Find(OffsetType Key) const
+        {
+            if (m_Size == 0)
+                return InvalidIndex;
+
+            for (auto Slot = GetSlot(Key); m_Entries[Slot].Key != EmptyKey; Slot = (Slot + 1) & m_Mask)
+            {
+                if (m_Entries[Slot].Key == Key)
+                    return m_Entries[Slot].Value;
+            }
+            return InvalidIndex;
+        }
+
+        void Erase(OffsetType Key)
+        {
+            auto Slot = GetSlot(Key);
+            while (m_Entries[Slot].Key != Key)
+            {
+                VERIFY(m_Entries[Slot].Key != EmptyKey, "Key ", Key, " is not found in the table");
+                Slot = (Slot + 1) & m_Mask;
+            }
+
+            // Shift the following entries of the probe sequence back to fill the gap
+            for (auto Next = (Slot + 1) & m_Mask; m_Entries[Next].Key != EmptyKey; Next = (Next + 1) & m_Mask)
+            {
+                const auto Home = GetSlot(m_Entries[Next].Key);
+                // The entry may be moved to the gap if its home slot is not in the range (Slot, Next]
+                if (((Next - Home) & m_Mask) >= ((Next - Slot) & m_Mask))
+                {
+                    m_Entries[Slot] = m_Entries[Next];
+                    Slot            = Next;
+                }
+            }
+            m_Entries[Slot].Key = EmptyKey;
+            --m_Size;
+        }
+
+        size_t GetSize() const
+        {
+            return m_Size;
+        }
+
+    private:
+        static constexpr OffsetType EmptyKey = ~OffsetType{0};
+
+        struct Entry
+        {
+            OffsetType Key   = EmptyKey;
+            Uint32     Value = InvalidIndex;
+        };
+
+        size_t GetSlot(OffsetType Key) const
+        {
+            // Fibonacci hashing spreads aligned offsets evenly over the table
+            return static_cast<size_t>((static_cast<Uint64>(Key) * 0x9E3779B97F4A7C15ull) >> m_Shift) & m_Mask;
+        }
+
+        void Grow()
+        {
+            std::vector<Entry, STDAllocatorRawMem<Entry>> OldEntries{m_Entries.get_allocator()};
+            OldEntries.swap(m_Entries);
+
+            const size_t NewCapacity = std::max(OldEntries.size() * 2, size_t{16});
+            m_Entries.resize(NewCapacity);
+            m_Mask  = NewCapacity - 1;
+            m_Shift = 64 - PlatformMisc::GetMSB(static_cast<Uint64>(NewCapacity));
+            m_Size  = 0;
+            for (const auto& OldEntry : OldEntries)
+            {
+                if (OldEntry.Key != EmptyKey)
+                    Insert(OldEntry.Key, OldEntry.Value);
+            }
+        }
+
+        std::vector<Entry, STDAllocatorRawMem<Entry>> m_Entries;
+
+        size_t m_Size  = 0;
+        size_t m_Mask  = 0;
+        Uint32 m_Shift = 64;
+    };
+
+    std::vector<Block, STDAllocatorRawMem<Block>> m_Blocks;
+    // Heads of the free lists of all size classes
+    std::vector<Uint32, STDAllocatorRawMem<Uint32>> m_Heads;
+    // Second-level bitmaps of non-empty classes, one per first-level class
+    std::vector<Uint32, STDAllocatorRawMem<Uint32>> m_SLBitmaps;
+
+    OffsetHashTable m_OffsetTable;
+    OffsetHashTable m_EndTable;
+
+    // First-level bitmap of non-empty classes
+    Uint64 m_FLBitmap = 0;
+
+    Uint32 m_FirstUnusedBlock = InvalidIndex;
+    size_t m_NumBlocks        = 0;
+
+    // The largest block, or InvalidIndex if it has been removed and is not known yet.
+    mutable Uint32 m_MaxBlock = InvalidIndex;
+    // The size of the largest block. When m_MaxBlock is invalid, this is the upper bound of the block sizes.
+    mutable OffsetType m_MaxBlockSize = 0;
+};
+
+} // namespace Diligent
@@ -37,6 +37,7 @@
 #include "../../../Platforms/Basic/interface/DebugUtilities.hpp"
 #include "../../../Common/interface/Align.hpp"
 #include "../../../Common/interface/STDAllocator.hpp"
+#include "TLSFFreeBlockList.hpp"
 
 namespace Diligent
 {
@@ -61,6 +62,10 @@ namespace Diligent
 //
 //                32 ------------------> 104 ---------->  {size = 32, &m_FreeBlocksBySize[3]}
 //
+// In the TLSF mode, the maps are replaced with the TLSFFreeBlockList that finds, inserts and
+// merges free blocks in constant time. The lookup is good-fit rather than best-fit: the block
+// is taken from the smallest non-empty size class that is guaranteed to accommodate the request.
+// Allocation and alignment semantics are the same in both modes.
 class VariableSizeAllocationsManager
 {
 public:
@@ -98,18 +103,33 @@ private:
     };
 
 public:
+    // Free block management mode
+    enum class Mode : Uint8
+    {
+        // Free blocks are kept in ordered maps, and the smallest suitable block is used.
+        // Allocation and deallocation take O(log n) time.
+        BestFit,
+
+        // Free blocks are kept in the two-level segregated fit lists.
+        // Allocation and deallocation take O(1) time.
+        TLSF
+    };
+
     struct CreateInfo
     {
         IMemoryAllocator& Allocator;
         OffsetType        MaxSize                   = 0;
         bool              DbgDisableDebugValidation = false;
+        Mode              AllocationMode            = Mode::BestFit;
     };
     explicit VariableSizeAllocationsManager(const CreateInfo& CI)
         // clang-format off
         : m_FreeBlocksByOffset{STD_ALLOCATOR_RAW_MEM(TFreeBlocksByOffsetMap::value_type, CI.Allocator, "Allocator for map<OffsetType, FreeBlockInfo>")}
         , m_FreeBlocksBySize  {STD_ALLOCATOR_RAW_MEM(TFreeBlocksBySizeMap::value_type,   CI.Allocator, "Allocator for multimap<OffsetType, TFreeBlocksByOffsetMap::iterator>")}
+        , m_TLSFFreeBlocks    {CI.Allocator}
         , m_MaxSize {CI.MaxSize}
         , m_FreeSize{CI.MaxSize}
+        , m_Mode    {CI.AllocationMode}
 #ifdef DILIGENT_DEBUG
         , m_DbgDisableDebugValidation{CI.DbgDisableDebugValidation}
 #endif
@@ -124,14 +144,24 @@ public:
 #endif
     }
 
-    VariableSizeAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
-        VariableSizeAllocationsManager{CreateInfo{Allocator, MaxSize}}
+    VariableSizeAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator, Mode AllocationMode = Mode::BestFit) :
+        VariableSizeAllocationsManager{CreateInfo{Allocator, MaxSize, false, AllocationMode}}
     {}
 
     ~VariableSizeAllocationsManager()
     {
 #ifdef DILIGENT_DEBUG
-        if (!m_FreeBlocksByOffset.empty() || !m_FreeBlocksBySize.empty())
+        if (m_Mode == Mode::TLSF)
+        {
+            if (m_TLSFFreeBlocks.GetNumBlocks() != 0)
+            {
+                VERIFY(m_TLSFFreeBlocks.GetNumBlocks() == 1, "Single free block is expected");
+                const auto HeadBlock = m_TLSFFreeBlocks.FindBlockByOffset(0);
+                VERIFY(HeadBlock != TLSFFreeBlockList::InvalidIndex, "Head chunk offset is expected to be 0");
+                VERIFY(HeadBlock == TLSFFreeBlockList::InvalidIndex || m_TLSFFreeBlocks.GetBlock(HeadBlock).Size == m_MaxSize, "Head chunk size is expected to be ", m_MaxSize);
+            }
+        }
+        else if (!m_FreeBlocksByOffset.empty() || !m_FreeBlocksBySize.empty())
         {
             VERIFY(m_FreeBlocksByOffset.size() == 1, "Single free block is expected");
             VERIFY(m_FreeBlocksByOffset.begin()->first == 0, "Head chunk offset is expected to be 0");
@@ -150,9 +180,11 @@ public:
     VariableSizeAllocationsManager(VariableSizeAllocationsManager&& rhs) noexcept
         : m_FreeBlocksByOffset{std::move(rhs.m_FreeBlocksByOffset)}
         , m_FreeBlocksBySize  {std::move(rhs.m_FreeBlocksBySize)  }
+        , m_TLSFFreeBlocks    {std::move(rhs.m_TLSFFreeBlocks)    }
         , m_MaxSize           {rhs.m_MaxSize      }
         , m_FreeSize          {rhs.m_FreeSize     }
         , m_CurrAlignment     {rhs.m_CurrAlignment}
+        , m_Mode              {rhs.m_Mode         }
 #ifdef DILIGENT_DEBUG
         , m_DbgDisableDebugValidation{rhs.m_DbgDisableDebugValidation}
 #endif
@@ -212,60 +244,66 @@ public:
             return Allocation::InvalidAllocation();
 
         auto AlignmentReserve = (Alignment > m_CurrAlignment) ? Alignment - m_CurrAlignment : 0;
-        // Get the first block that is large enough to encompass Size + AlignmentReserve bytes
-        // lower_bound() returns an iterator pointing to the first element that
-        // is not less (i.e. >= ) than key
-        auto SmallestBlockItIt = m_FreeBlocksBySize.lower_bound(Size + AlignmentReserve);
-        if (SmallestBlockItIt == m_FreeBlocksBySize.end())
+        // Get the block that is large enough to encompass Size + AlignmentReserve bytes
+        OffsetType Offset    = 0;
+        OffsetType BlockSize = 0;
+        if (!RemoveBlockForAllocation(Size + AlignmentReserve, Offset, BlockSize))
             return Allocation::InvalidAllocation();
 
-        auto SmallestBlockIt = SmallestBlockItIt->second;
-        VERIFY_EXPR(Size + AlignmentReserve <= SmallestBlockIt->second.Size);
-        VERIFY_EXPR(SmallestBlockIt->second.Size == SmallestBlockItIt->first);
+        VERIFY_EXPR(Size + AlignmentReserve <= BlockSize);
+        VERIFY_EXPR(AlignUp(Offset, Alignment) - Offset <= AlignmentReserve);
 
-        //     SmallestBlockIt.Offset
-        //        |                                  |
-        //        |<------SmallestBlockIt.Size------>|
-        //        |<------Size------>|<---NewSize--->|
-        //        |                  |
-        //      Offset              NewOffset
-        //
-        auto Offset = SmallestBlockIt->first;
-        VERIFY_EXPR(Offset % m_CurrAlignment == 0);
-        auto AlignedOffset = AlignUp(Offset, Alignment);
-        auto AdjustedSize  = Size + (AlignedOffset - Offset);
-        VERIFY_EXPR(AdjustedSize <= Size + AlignmentReserve);
-        auto NewOffset = Offset + AdjustedSize;
-        auto NewSize   = SmallestBlockIt->second.Size - AdjustedSize;
-        VERIFY_EXPR(SmallestBlockItIt == SmallestBlockIt->second.OrderBySizeIt);
-        m_FreeBlocksBySize.erase(SmallestBlockItIt);
-        m_FreeBlocksByOffset.erase(SmallestBlockIt);
-        if (NewSize > 0)
-        {
-            AddNewBlock(NewOffset, NewSize);
-        }
+        return AllocateFromBlock(Offset, BlockSize, Size, Alignment);
+    }
 
-        m_FreeSize -= AdjustedSize;
+    // Allocates space from the free block with the lowest offset that can accommodate
+    // the request so that the allocation ends at or before MaxOffset. Unlike Allocate(),
+    // the method scans the free blocks and takes O(n) time. It is intended for moving
+    // existing allocations towards the beginning of the space.
+    Allocation AllocateBelow(OffsetType Size, OffsetType Alignment, OffsetType MaxOffset)
+    {
+        VERIFY_EXPR(Size > 0);
+        VERIFY(IsPowerOfTwo(Alignment), "Alignment (", Alignment, ") must be power of 2");
+        Size = AlignUp(Size, Alignment);
+        if (m_FreeSize < Size)
+            return Allocation::InvalidAllocation();
 
-        if ((Size & (m_CurrAlignment - 1)) != 0)
+        const auto FitsBelow = [&](OffsetType BlockOffset, OffsetType BlockSize) {
+            const auto AllocationEnd = AlignUp(BlockOffset, Alignment) + Size;
+            return AllocationEnd <= BlockOffset + BlockSize && AllocationEnd <= MaxOffset;
+        };
+
+        OffsetType Offset    = Allocation::InvalidOffset;
+        OffsetType BlockSize = 0;
+        if (m_Mode == Mode::TLSF)
         {
-            if (IsPowerOfTwo(Size))
-            {
-                VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
-                m_CurrAlignment = Size;
-            }
-            else
-            {
-                m_CurrAlignment = (std::min)(m_CurrAlignment, Alignment);
-            }
+            m_TLSFFreeBlocks.ProcessBlocks([&](const TLSFFreeBlockList::Block& FreeBlock) {
+                if (FreeBlock.Offset < Offset && FitsBelow(FreeBlock.Offset, FreeBlock.Size))
+                {
+                    Offset    = FreeBlock.Offset;
+                    BlockSize = FreeBlock.Size;
+                }
+            });
+            if (Offset == Allocation::InvalidOffset)
+                return Allocation::InvalidAllocation();
+
+            m_TLSFFreeBlocks.RemoveBlock(m_TLSFFreeBlocks.FindBlockByOffset(Offset));
+        }
+        else
+        {
+            auto BlockIt = m_FreeBlocksByOffset.begin();
+            while (BlockIt != m_FreeBlocksByOffset.end() && BlockIt->first < MaxOffset && !FitsBelow(BlockIt->first, BlockIt->second.Size))
+                ++BlockIt;
+            if (BlockIt == m_FreeBlocksByOffset.end() || BlockIt->first >= MaxOffset)
+                return Allocation::InvalidAllocation();
+
+            Offset    = BlockIt->first;
+            BlockSize = BlockIt->second.Size;
+            m_FreeBlocksBySize.erase(BlockIt->second.OrderBySizeIt);
+            m_FreeBlocksByOffset.erase(BlockIt);
         }
 
-#ifdef DILIGENT_DEBUG
-        VERIFY_EXPR(m_FreeBlocksByOffset.size() == m_FreeBlocksBySize.size());
-        if (!m_DbgDisableDebugValidation)
-            DbgVerifyList();
-#endif
-        return Allocation{Offset, AdjustedSize};
+        return AllocateFromBlock(Offset, BlockSize, Size, Alignment);
     }
 
     void Free(Allocation&& allocation)
@@ -279,6 +317,106 @@ public:
     {
         VERIFY_EXPR(Offset != Allocation::InvalidOffset && Offset + Size <= m_MaxSize);
 
+        OffsetType NewSize, NewOffset;
+        if (m_Mode == Mode::TLSF)
+            MergeWithFreeNeighborsTLSF(Offset, Size, NewOffset, NewSize);
+        else
+            MergeWithFreeNeighbors(Offset, Size, NewOffset, NewSize);
+
+        AddNewBlock(NewOffset, NewSize);
+
+        m_FreeSize += Size;
+        if (IsEmpty())
+        {
+            // Reset current alignment
+            VERIFY_EXPR(GetNumFreeBlocks() == 1);
+            ResetCurrAlignment();
+        }
+
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+    }
+
+    // clang-format off
+    bool IsFull() const{ return m_FreeSize==0; };
+    bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
+    OffsetType GetMaxSize() const{return m_MaxSize;}
+    OffsetType GetFreeSize()const{return m_FreeSize;}
+    OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
+    // clang-format on
+
+    size_t GetNumFreeBlocks() const
+    {
+        return m_Mode == Mode::TLSF ? m_TLSFFreeBlocks.GetNumBlocks() : m_FreeBlocksByOffset.size();
+    }
+
+    OffsetType GetMaxFreeBlockSize() const
+    {
+        if (m_Mode == Mode::TLSF)
+            return m_TLSFFreeBlocks.GetMaxBlockSize();
+
+        return !m_FreeBlocksBySize.empty() ? m_FreeBlocksBySize.rbegin()->first : 0;
+    }
+
+    Mode GetMode() const
+    {
+        return m_Mode;
+    }
+
+    void Extend(size_t ExtraSize)
+    {
+        size_t NewBlockOffset = m_MaxSize;
+        size_t NewBlockSize   = ExtraSize;
+
+        if (m_Mode == Mode::TLSF)
+        {
+            const auto LastBlock = m_TLSFFreeBlocks.FindBlockByEnd(m_MaxSize);
+            if (LastBlock != TLSFFreeBlockList::InvalidIndex)
+            {
+                // Extend the last block
+                NewBlockOffset = m_TLSFFreeBlocks.GetBlock(LastBlock).Offset;
+                NewBlockSize += m_TLSFFreeBlocks.GetBlock(LastBlock).Size;
+                m_TLSFFreeBlocks.RemoveBlock(LastBlock);
+            }
+        }
+        else if (!m_FreeBlocksByOffset.empty())
+        {
+            auto LastBlockIt = m_FreeBlocksByOffset.end();
+            --LastBlockIt;
+
+            const auto LastBlockOffset = LastBlockIt->first;
+            const auto LastBlockSize   = LastBlockIt->second.Size;
+            if (LastBlockOffset + LastBlockSize == m_MaxSize)
+            {
+                // Extend the last block
+                NewBlockOffset = LastBlockOffset;
+                NewBlockSize += LastBlockSize;
+
+                VERIFY_EXPR(LastBlockIt->second.OrderBySizeIt->first == LastBlockSize &&
+                            LastBlockIt->second.OrderBySizeIt->second == LastBlockIt);
+                m_FreeBlocksBySize.erase(LastBlockIt->second.OrderBySizeIt);
+                m_FreeBlocksByOffset.erase(LastBlockIt);
+            }
+        }
+
+        AddNewBlock(NewBlockOffset, NewBlockSize);
+
+        m_MaxSize += ExtraSize;
+        m_FreeSize += ExtraSize;
+
+#ifdef DILIGENT_DEBUG
+        if (!m_DbgDisableDebugValidation)
+            DbgVerifyList();
+#endif
+    }
+
+private:
+    // Removes the free blocks adjacent to the released range [Offset, Offset + Size) and
+    // returns the range of the merged block.
+    void MergeWithFreeNeighbors(OffsetType Offset, OffsetType Size, OffsetType& NewOffset, OffsetType& NewSize)
+    {
         // Find the first element whose offset is greater than the specified offset.
         // upper_bound() returns an iterator pointing to the first element in the
         // container whose key is considered to go after k.
@@ -302,7 +440,6 @@ public:
         else
             PrevBlockIt = m_FreeBlocksByOffset.end();
 
-        OffsetType NewSize, NewOffset;
         if (PrevBlockIt != m_FreeBlocksByOffset.end() && Offset == PrevBlockIt->first + PrevBlockIt->second.Size)
         {
             //  PrevBlock.Offset             Offset
@@ -355,82 +492,123 @@ public:
             NewSize   = Size;
             NewOffset = Offset;
         }
+    }
 
-        AddNewBlock(NewOffset, NewSize);
+    void MergeWithFreeNeighborsTLSF(OffsetType Offset, OffsetType Size, OffsetType& NewOffset, OffsetType& NewSize)
+    {
+        NewOffset = Offset;
+        NewSize   = Size;
 
-        m_FreeSize += Size;
-        if (IsEmpty())
+        const auto PrevBlock = m_TLSFFreeBlocks.FindBlockByEnd(Offset);
+        if (PrevBlock != TLSFFreeBlockList::InvalidIndex)
         {
-            // Reset current alignment
-            VERIFY_EXPR(GetNumFreeBlocks() == 1);
-            ResetCurrAlignment();
+            //  PrevBlock.Offset             Offset
+            //       |                          |
+            //       |<-----PrevBlock.Size----->|<------Size-------->|
+            //
+            NewOffset = m_TLSFFreeBlocks.GetBlock(PrevBlock).Offset;
+            NewSize += m_TLSFFreeBlocks.GetBlock(PrevBlock).Size;
+            m_TLSFFreeBlocks.RemoveBlock(PrevBlock);
         }
 
-#ifdef DILIGENT_DEBUG
-        VERIFY_EXPR(m_FreeBlocksByOffset.size() == m_FreeBlocksBySize.size());
-        if (!m_DbgDisableDebugValidation)
-            DbgVerifyList();
-#endif
-    }
-
-    // clang-format off
-    bool IsFull() const{ return m_FreeSize==0; };
-    bool IsEmpty()const{ return m_FreeSize==m_MaxSize; };
-    OffsetType GetMaxSize() const{return m_MaxSize;}
-    OffsetType GetFreeSize()const{return m_FreeSize;}
-    OffsetType GetUsedSize()const{return m_MaxSize - m_FreeSize;}
-    // clang-format on
-
-    size_t GetNumFreeBlocks() const
-    {
-        return m_FreeBlocksByOffset.size();
+        const auto NextBlock = m_TLSFFreeBlocks.FindBlockByOffset(Offset + Size);
+        if (NextBlock != TLSFFreeBlockList::InvalidIndex)
+        {
+            //                 Offset            NextBlock.Offset
+            //                   |                    |
+            //                   |<------Size-------->|<-----NextBlock.Size----->|
+            //
+            NewSize += m_TLSFFreeBlocks.GetBlock(NextBlock).Size;
+            m_TLSFFreeBlocks.RemoveBlock(NextBlock);
+        }
     }
 
-    OffsetType GetMaxFreeBlockSize() const
+    // Allocates Size bytes aligned by Alignment from the beginning of the free block that has
+    // already been removed from the list, and returns the remaining part of the block to the list.
+    Allocation AllocateFromBlock(OffsetType Offset, OffsetType BlockSize, OffsetType Size, OffsetType Alignment)
     {
-        return !m_FreeBlocksBySize.empty() ? m_FreeBlocksBySize.rbegin()->first : 0;
-    }
+        //       Block.Offset
+        //        |                                  |
+        //        |<-----------Block.Size----------->|
+        //        |<------Size------>|<---NewSize--->|
+        //        |                  |
+        //      Offset              NewOffset
+        //
+        VERIFY_EXPR(Offset % m_CurrAlignment == 0);
+        auto AlignedOffset = AlignUp(Offset, Alignment);
+        auto AdjustedSize  = Size + (AlignedOffset - Offset);
+        VERIFY_EXPR(AdjustedSize <= BlockSize);
+        auto NewOffset = Offset + AdjustedSize;
+        auto NewSize   = BlockSize - AdjustedSize;
+        if (NewSize > 0)
+        {
+            AddNewBlock(NewOffset, NewSize);
+        }
 
-    void Extend(size_t ExtraSize)
-    {
-        size_t NewBlockOffset = m_MaxSize;
-        size_t NewBlockSize   = ExtraSize;
+        m_FreeSize -= AdjustedSize;
 
-        if (!m_FreeBlocksByOffset.empty())
+        if ((Size & (m_CurrAlignment - 1)) != 0)
         {
-            auto LastBlockIt = m_FreeBlocksByOffset.end();
-            --LastBlockIt;
-
-            const auto LastBlockOffset = LastBlockIt->first;
-            const auto LastBlockSize   = LastBlockIt->second.Size;
-            if (LastBlockOffset + LastBlockSize == m_MaxSize)
+            if (IsPowerOfTwo(Size))
             {
-                // Extend the last block
-                NewBlockOffset = LastBlockOffset;
-                NewBlockSize += LastBlockSize;
-
-                VERIFY_EXPR(LastBlockIt->second.OrderBySizeIt->first == LastBlockSize &&
-                            LastBlockIt->second.OrderBySizeIt->second == LastBlockIt);
-                m_FreeBlocksBySize.erase(LastBlockIt->second.OrderBySizeIt);
-                m_FreeBlocksByOffset.erase(LastBlockIt);
+                VERIFY_EXPR(Size >= Alignment && Size < m_CurrAlignment);
+                m_CurrAlignment = Size;
+            }
+            else
+            {
+                m_CurrAlignment = (std::min)(m_CurrAlignment, Alignment);
             }
         }
 
-        AddNewBlock(NewBlockOffset, NewBlockSize);
-
-        m_MaxSize += ExtraSize;
-        m_FreeSize += ExtraSize;
-
 #ifdef DILIGENT_DEBUG
-        VERIFY_EXPR(m_FreeBlocksByOffset.size() == m_FreeBlocksBySize.size());
         if (!m_DbgDisableDebugValidation)
             DbgVerifyList();
 #endif
+        return Allocation{Offset, AdjustedSize};
+    }
+
+    // Finds the free block that is at least MinSize bytes large and removes it from the list.
+    bool RemoveBlockForAllocation(OffsetType MinSize, OffsetType& Offset, OffsetType& Size)
+    {
+        if (m_Mode == Mode::TLSF)
+        {
+            const auto BlockIdx = m_TLSFFreeBlocks.FindBlock(MinSize);
+            if (BlockIdx == TLSFFreeBlockList::InvalidIndex)
+                return false;
+
+            const auto& FreeBlock = m_TLSFFreeBlocks.GetBlock(BlockIdx);
+            Offset                = FreeBlock.Offset;
+            Size                  = FreeBlock.Size;
+            m_TLSFFreeBlocks.RemoveBlock(BlockIdx);
+            return true;
+        }
+
+        // Get the first block that is large enough to encompass MinSize bytes.
+        // lower_bound() returns an iterator pointing to the first element that
+        // is not less (i.e. >= ) than key
+        auto SmallestBlockItIt = m_FreeBlocksBySize.lower_bound(MinSize);
+        if (SmallestBlockItIt == m_FreeBlocksBySize.end())
+            return false;
+
+        auto SmallestBlockIt = SmallestBlockItIt->second;
+        VERIFY_EXPR(SmallestBlockIt->second.Size == SmallestBlockItIt->first);
+        VERIFY_EXPR(SmallestBlockItIt == SmallestBlockIt->second.OrderBySizeIt);
+
+        Offset = SmallestBlockIt->first;
+        Size   = SmallestBlockIt->second.Size;
+        m_FreeBlocksBySize.erase(SmallestBlockItIt);
+        m_FreeBlocksByOffset.erase(SmallestBlockIt);
+        return true;
     }
 
-private:
     void AddNewBlock(OffsetType Offset, OffsetType Size)
     {
+        if (m_Mode == Mode::TLSF)
+        {
+            m_TLSFFreeBlocks.AddBlock(Offset, Size);
+            return;
+        }
+
         auto NewBlockIt = m_FreeBlocksByOffset.emplace(Offset, Size);
         VERIFY_EXPR(NewBlockIt.second);
         auto OrderIt                           = m_FreeBlocksBySize.emplace(Size, NewBlockIt.first);
@@ -449,6 +627,22 @@ private:
         OffsetType TotalFreeSize = 0;
 
         VERIFY_EXPR(IsPowerOfTwo(m_CurrAlignment));
+        if (m_Mode == Mode::TLSF)
+        {
+            m_TLSFFreeBlocks.DbgVerifyConsistency();
+            m_TLSFFreeBlocks.ProcessBlocks([&](const TLSFFreeBlockList::Block& FreeBlock) {
+                VERIFY_EXPR(FreeBlock.Offset + FreeBlock.Size <= m_MaxSize);
+                VERIFY((FreeBlock.Offset & (m_CurrAlignment - 1)) == 0, "Block offset (", FreeBlock.Offset, ") is not ", m_CurrAlignment, "-aligned");
+                if (FreeBlock.Offset + FreeBlock.Size < m_MaxSize)
+                    VERIFY((FreeBlock.Size & (m_CurrAlignment - 1)) == 0, "All block sizes except for the last one must be ", m_CurrAlignment, "-aligned");
+                VERIFY(m_TLSFFreeBlocks.FindBlockByOffset(FreeBlock.Offset + FreeBlock.Size) == TLSFFreeBlockList::InvalidIndex, "Unmerged adjacent blocks detected");
+                TotalFreeSize += FreeBlock.Size;
+            });
+            VERIFY_EXPR(TotalFreeSize == m_FreeSize);
+            return;
+        }
+
+        VERIFY_EXPR(m_FreeBlocksByOffset.size() == m_FreeBlocksBySize.size());
         auto BlockIt     = m_FreeBlocksByOffset.begin();
         auto PrevBlockIt = m_FreeBlocksByOffset.end();
         VERIFY_EXPR(m_FreeBlocksByOffset.size() == m_FreeBlocksBySize.size());
@@ -484,10 +678,13 @@ private:
 
     TFreeBlocksByOffsetMap m_FreeBlocksByOffset;
     TFreeBlocksBySizeMap   m_FreeBlocksBySize;
+    TLSFFreeBlockList      m_TLSFFreeBlocks;
 
     OffsetType m_MaxSize       = 0;
     OffsetType m_FreeSize      = 0;
     OffsetType m_CurrAlignment = 0;
+
+    Mode m_Mode = Mode::BestFit;
 #ifdef DILIGENT_DEBUG
     bool m_DbgDisableDebugValidation = false;
 #endif
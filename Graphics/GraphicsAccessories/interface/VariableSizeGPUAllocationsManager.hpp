@@ -53,8 +53,12 @@ private:
 
 public:
     VariableSizeGPUAllocationsManager(OffsetType MaxSize, IMemoryAllocator& Allocator) :
-        VariableSizeAllocationsManager{MaxSize, Allocator},
-        m_StaleAllocations{0, StaleAllocationAttribs(0, 0, 0), STD_ALLOCATOR_RAW_MEM(StaleAllocationAttribs, Allocator, "Allocator for deque<StaleAllocationAttribs>")}
+        VariableSizeGPUAllocationsManager{CreateInfo{Allocator, MaxSize}}
+    {}
+
+    explicit VariableSizeGPUAllocationsManager(const CreateInfo& CI) :
+        VariableSizeAllocationsManager{CI},
+        m_StaleAllocations{0, StaleAllocationAttribs(0, 0, 0), STD_ALLOCATOR_RAW_MEM(StaleAllocationAttribs, CI.Allocator, "Allocator for deque<StaleAllocationAttribs>")}
     {}
 
     ~VariableSizeGPUAllocationsManager()
@@ -27,7 +27,13 @@
 
 #include <array>
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
 #include "ColorConversion.h"
+#include "BasicMathSIMD.hpp"
+#include "DebugUtilities.hpp"
 
 namespace Diligent
 {
@@ -75,6 +81,260 @@ private:
     std::array<float, 256> m_ToLinear;
 };
 
+Uint32 FloatBits(float f)
+{
+    Uint32 Bits;
+    std::memcpy(&Bits, &f, sizeof(Bits));
+    return Bits;
+}
+
+float BitsToFloat(Uint32 Bits)
+{
+    float f;
+    std::memcpy(&f, &Bits, sizeof(f));
+    return f;
+}
+
+float HalfToFloat(Uint16 h)
+{
+    const Uint32 Sign = Uint32{h & 0x8000u} << 16;
+    const Uint32 Exp  = (h >> 10) & 0x1Fu;
+    const Uint32 Mant = h & 0x3FFu;
+    if (Exp == 0)
+    {
+        // Zero or denormal
+        const float f = std::ldexp(static_cast<float>(Mant), -24);
+        return Sign != 0 ? -f : f;
+    }
+    else if (Exp == 31)
+    {
+        // Infinity or NaN
+        return BitsToFloat(Sign | 0x7F800000u | (Mant << 13));
+    }
+    else
+    {
+        return BitsToFloat(Sign | ((Exp + 112) << 23) | (Mant << 13));
+    }
+}
+
+// Converts a value in [0, 1] range to half precision with rounding to nearest even.
+Uint16 UnitFloatToHalf(float f)
+{
+    VERIFY_EXPR(f >= 0 && f <= 1);
+    if (f < 6.103515625e-05f) // 2^-14, the smallest normal half
+    {
+        // Denormal. Multiplication by power of two is exact.
+        return static_cast<Uint16>(std::nearbyint(f * 16777216.f));
+    }
+
+    const Uint32 Bits = FloatBits(f);
+    const Uint32 Exp  = ((Bits >> 23) & 0xFFu) - 112;
+    const Uint32 Mant = Bits & 0x7FFFFFu;
+
+    Uint32       h   = (Exp << 10) | (Mant >> 13);
+    const Uint32 Rem = Mant & 0x1FFFu;
+    if (Rem > 0x1000u || (Rem == 0x1000u && (h & 1u) != 0))
+        ++h; // Carry to the exponent is correct
+    return static_cast<Uint16>(h);
+}
+
+// Converts linear float values to 8-bit sRGB values with exact rounding.
+//
+// Every value k in [1, 255] has a threshold T[k] - the smallest float that is converted to k.
+// The float range is split into buckets by the exponent and the top 7 bits of the mantissa.
+// Every bucket contains at most one threshold, so the result is the value at the bucket start,
+// incremented by one if the threshold of the next value is reached.
+class LinearToSRGB8Converter
+{
+public:
+    LinearToSRGB8Converter()
+    {
+        m_Thresholds[0] = 0;
+        for (Uint32 k = 1; k < 256; ++k)
+        {
+            // Threshold in the sRGB space is (k - 0.5) / 255
+            const double SRGB = (static_cast<double>(k) - 0.5) / 255.0;
+            const double Lin  = SRGB <= 0.04045 ? SRGB / 12.92 : std::pow((SRGB + 0.055) / 1.055, 2.4);
+
+            float T = static_cast<float>(Lin);
+            if (static_cast<double>(T) < Lin)
+                T = std::nextafter(T, 2.f);
+            m_Thresholds[k] = T;
+        }
+        m_Thresholds[256] = std::numeric_limits<float>::infinity();
+
+        Uint32 k = 0;
+        for (Uint32 b = 0; b < NumBuckets; ++b)
+        {
+            const float BucketStart = BitsToFloat(MinValueBits + (b << BucketShift));
+            while (BucketStart >= m_Thresholds[k + 1])
+                ++k;
+            m_Buckets[b] = static_cast<Uint8>(k);
+
+            // Make sure that the bucket contains at most one threshold
+            VERIFY_EXPR(b + 1 == NumBuckets || BitsToFloat(MinValueBits + ((b + 1) << BucketShift)) <= m_Thresholds[std::min(k + 2, 256u)]);
+        }
+    }
+
+    Uint8 operator()(float x) const
+    {
+        // Note that NaN is converted to 0
+        x = x > 0 ? (x < 1 ? x : 1) : 0;
+
+        const Uint32 b = (FloatBits(std::max(x, float{MinValue})) - MinValueBits) >> BucketShift;
+        return Convert(x, b);
+    }
+
+    void operator()(const float* pLinear, Uint8* pSRGB, size_t NumValues) const
+    {
+        size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+        const __m128  Zero       = _mm_setzero_ps();
+        const __m128  One        = _mm_set1_ps(1.f);
+        const __m128  MinVal     = _mm_set1_ps(MinValue);
+        const __m128i MinValBits = _mm_set1_epi32(static_cast<int>(MinValueBits));
+
+        alignas(16) float  Values[4];
+        alignas(16) Uint32 Buckets[4];
+        for (; i + 4 <= NumValues; i += 4)
+        {
+            // _mm_max_ps returns the second operand if the first one is NaN
+            const __m128  x = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(pLinear + i), Zero), One);
+            const __m128i b = _mm_srli_epi32(_mm_sub_epi32(_mm_castps_si128(_mm_max_ps(x, MinVal)), MinValBits), BucketShift);
+            _mm_store_ps(Values, x);
+            _mm_store_si128(reinterpret_cast<__m128i*>(Buckets), b);
+
+            pSRGB[i + 0] = Convert(Values[0], Buckets[0]);
+            pSRGB[i + 1] = Convert(Values[1], Buckets[1]);
+            pSRGB[i + 2] = Convert(Values[2], Buckets[2]);
+            pSRGB[i + 3] = Convert(Values[3], Buckets[3]);
+        }
+#endif
+        for (; i < NumValues; ++i)
+            pSRGB[i] = (*this)(pLinear[i]);
+    }
+
+private:
+    Uint8 Convert(float x, Uint32 Bucket) const
+    {
+        const Uint32 k = m_Buckets[Bucket];
+        return static_cast<Uint8>(k + (x >= m_Thresholds[k + 1] ? 1 : 0));
+    }
+
+    // All values below the first threshold (~1.5e-4) are converted to 0
+    static constexpr float  MinValue     = 1.f / 8192.f;
+    static constexpr Uint32 MinValueBits = (127 - 13) << 23;
+    static constexpr Uint32 BucketShift  = 23 - 7;
+    // Buckets cover [2^-13, 1], the last bucket only contains 1.0
+    static constexpr Uint32 NumBuckets = 13 * (1u << 7) + 1;
+
+    float m_Thresholds[257];
+    Uint8 m_Buckets[NumBuckets];
+};
+
+const GammaToLinearMap& GetGammaToLinearMap()
+{
+    static const GammaToLinearMap map;
+    return map;
+}
+
+const LinearToSRGB8Converter& GetLinearToSRGB8Converter()
+{
+    static const LinearToSRGB8Converter Converter;
+    return Converter;
+}
+
+class SRGBA8ToRGBA16FMap
+{
+public:
+    SRGBA8ToRGBA16FMap() noexcept
+    {
+        for (Uint32 i = 0; i < 256; ++i)
+        {
+            // Compute the values in double precision to get exact rounding
+            const double SRGB = static_cast<double>(i) / 255.0;
+            const double Lin  = SRGB <= 0.04045 ? SRGB / 12.92 : std::pow((SRGB + 0.055) / 1.055, 2.4);
+
+            m_Color[i] = DoubleToHalf(Lin);
+            m_Alpha[i] = DoubleToHalf(SRGB);
+        }
+    }
+
+    void operator()(const Uint8* pSRGBA, Uint16* pRGBA16F, size_t NumPixels) const
+    {
+        for (size_t i = 0; i < NumPixels; ++i)
+        {
+            pRGBA16F[i * 4 + 0] = m_Color[pSRGBA[i * 4 + 0]];
+            pRGBA16F[i * 4 + 1] = m_Color[pSRGBA[i * 4 + 1]];
+            pRGBA16F[i * 4 + 2] = m_Color[pSRGBA[i * 4 + 2]];
+            pRGBA16F[i * 4 + 3] = m_Alpha[pSRGBA[i * 4 + 3]];
+        }
+    }
+
+private:
+    static Uint16 DoubleToHalf(double d)
+    {
+        // Rounding to float first may result in double rounding, so check the neighbors.
+        const Uint16 h = UnitFloatToHalf(static_cast<float>(d));
+
+        Uint16 Best     = h;
+        double BestDist = std::abs(static_cast<double>(HalfToFloat(h)) - d);
+        for (Uint16 Neighbor : {static_cast<Uint16>(h - 1), static_cast<Uint16>(h + 1)})
+        {
+            if (Neighbor > 0x3C00u) // 1.0
+                continue;
+
+            const double Dist = std::abs(static_cast<double>(HalfToFloat(Neighbor)) - d);
+            if (Dist < BestDist || (Dist == BestDist && (Neighbor & 1u) == 0))
+            {
+                Best     = Neighbor;
+                BestDist = Dist;
+            }
+        }
+        return Best;
+    }
+
+    std::array<Uint16, 256> m_Color;
+    std::array<Uint16, 256> m_Alpha;
+};
+
+// Maps every half-precision value to the 8-bit sRGB and 8-bit linear values.
+class RGBA16FToSRGBA8Map
+{
+public:
+    RGBA16FToSRGBA8Map() :
+        m_Color(65536),
+        m_Alpha(65536)
+    {
+        const auto& ToSRGB = GetLinearToSRGB8Converter();
+        for (Uint32 h = 0; h < 65536; ++h)
+        {
+            float f    = HalfToFloat(static_cast<Uint16>(h));
+            m_Color[h] = ToSRGB(f);
+
+            f = f > 0 ? (f < 1 ? f : 1) : 0;
+            // Every half value in [0, 1] is exactly representable as float, and f * 255 + 0.5
+            // is computed exactly in double precision.
+            m_Alpha[h] = static_cast<Uint8>(std::floor(static_cast<double>(f) * 255.0 + 0.5));
+        }
+    }
+
+    void operator()(const Uint16* pRGBA16F, Uint8* pSRGBA, size_t NumPixels) const
+    {
+        for (size_t i = 0; i < NumPixels; ++i)
+        {
+            pSRGBA[i * 4 + 0] = m_Color[pRGBA16F[i * 4 + 0]];
+            pSRGBA[i * 4 + 1] = m_Color[pRGBA16F[i * 4 + 1]];
+            pSRGBA[i * 4 + 2] = m_Color[pRGBA16F[i * 4 + 2]];
+            pSRGBA[i * 4 + 3] = m_Alpha[pRGBA16F[i * 4 + 3]];
+        }
+    }
+
+private:
+    std::vector<Uint8> m_Color;
+    std::vector<Uint8> m_Alpha;
+};
+
 } // namespace
 
 float LinearToGamma(Uint8 x)
@@ -85,8 +345,31 @@ float LinearToGamma(Uint8 x)
 
 float GammaToLinear(Uint8 x)
 {
-    static const GammaToLinearMap map;
-    return map[x];
+    return GetGammaToLinearMap()[x];
+}
+
+void SRGBToLinear(const Uint8* pSRGB, float* pLinear, size_t NumValues)
+{
+    const GammaToLinearMap& map = GetGammaToLinearMap();
+    for (size_t i = 0; i < NumValues; ++i)
+        pLinear[i] = map[pSRGB[i]];
+}
+
+void LinearToSRGB(const float* pLinear, Uint8* pSRGB, size_t NumValues)
+{
+    GetLinearToSRGB8Converter()(pLinear, pSRGB, NumValues);
+}
+
+void SRGBA8ToLinearRGBA16F(const Uint8* pSRGBA, Uint16* pRGBA16F, size_t NumPixels)
+{
+    static const SRGBA8ToRGBA16FMap map;
+    map(pSRGBA, pRGBA16F, NumPixels);
+}
+
+void LinearRGBA16FToSRGBA8(const Uint16* pRGBA16F, Uint8* pSRGBA, size_t NumPixels)
+{
+    static const RGBA16FToSRGBA8Map map;
+    map(pRGBA16F, pSRGBA, NumPixels);
 }
 
 } // namespace Diligent
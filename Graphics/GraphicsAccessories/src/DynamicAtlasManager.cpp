@@ -28,6 +28,8 @@
 #include "DynamicAtlasManager.hpp"
 
 #include <climits>
+#include <algorithm>
+#include <numeric>
 
 #include "AdvancedMath.hpp"
 
@@ -110,13 +112,22 @@ void DynamicAtlasManager::Node::MergeChildren()
 }
 
 
-DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height) :
+DynamicAtlasManager::DynamicAtlasManager(Uint32 Width, Uint32 Height, Mode PackingMode) :
     m_Width{Width},
     m_Height{Height},
+    m_Mode{PackingMode},
     m_TotalFreeArea{Uint64{Width} * Uint64{Height}}
 {
-    m_Root->R = Region{0, 0, Width, Height};
-    RegisterNode(*m_Root);
+    if (m_Mode == Mode::Skyline)
+    {
+        ResetSkyline();
+    }
+    else
+    {
+        m_Root.reset(new Node);
+        m_Root->R = Region{0, 0, Width, Height};
+        RegisterNode(*m_Root);
+    }
 }
 
 
@@ -133,6 +144,16 @@ DynamicAtlasManager::~DynamicAtlasManager()
         DEV_CHECK_ERR(m_FreeRegionsByWidth.size() == 1, "There expected to be a single free region");
         DEV_CHECK_ERR(m_AllocatedRegions.empty(), "There must be no allocated regions");
     }
+    else if (!m_Skyline.empty())
+    {
+#if DILIGENT_DEBUG
+        DbgVerifyConsistency();
+#endif
+
+        DEV_CHECK_ERR(m_AllocatedRegions.empty(), "There must be no allocated regions");
+        DEV_CHECK_ERR(m_Skyline.size() == 1 && m_Skyline[0].y == 0, "The skyline is expected to be flat");
+        VERIFY_EXPR(m_FreeRegionsByWidth.empty() && m_FreeRegionsByHeight.empty());
+    }
     else
     {
         VERIFY_EXPR(m_FreeRegionsByWidth.empty());
@@ -182,7 +203,7 @@ void DynamicAtlasManager::UnregisterNode(const Node& N)
 
 
 
-DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
+std::pair<DynamicAtlasManager::Region, DynamicAtlasManager::Node*> DynamicAtlasManager::FindFreeRegion(Uint32 Width, Uint32 Height) const
 {
     auto it_w = m_FreeRegionsByWidth.lower_bound(Region{0, 0, Width, 0});
     while (it_w != m_FreeRegionsByWidth.end() && it_w->first.height < Height)
@@ -199,25 +220,90 @@ DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 H
     VERIFY_EXPR(AreaW == 0 || AreaW >= Width * Height);
     VERIFY_EXPR(AreaH == 0 || AreaH >= Width * Height);
 
-    Node* pSrcNode = nullptr;
     // Use the smaller area source region
     if (AreaW > 0 && AreaH > 0)
     {
-        pSrcNode = AreaW < AreaH ? it_w->second : it_h->second;
+        return AreaW < AreaH ? *it_w : *it_h;
     }
     else if (AreaW > 0)
     {
-        pSrcNode = it_w->second;
+        return *it_w;
     }
     else if (AreaH > 0)
     {
-        pSrcNode = it_h->second;
+        return *it_h;
     }
     else
     {
-        return Region{};
+        return {Region{}, nullptr};
+    }
+}
+
+
+DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 Height)
+{
+    auto R = m_Mode == Mode::Skyline ?
+        AllocateFromSkyline(Width, Height) :
+        AllocateFromTree(Width, Height);
+    if (R.IsEmpty())
+        return R;
+
+    VERIFY_EXPR(m_TotalFreeArea >= Uint64{R.width} * Uint64{R.height});
+    m_TotalFreeArea -= Uint64{R.width} * Uint64{R.height};
+
+#if DILIGENT_DEBUG
+    DbgVerifyConsistency();
+#endif
+
+    return R;
+}
+
+
+Uint32 DynamicAtlasManager::Allocate(Region* pRegions, Uint32 NumRegions)
+{
+    std::vector<Uint32> Order(NumRegions);
+    std::iota(Order.begin(), Order.end(), 0u);
+    if (m_Mode == Mode::Skyline)
+    {
+        // Taller regions go first so that the skyline stays as flat as possible
+        std::sort(Order.begin(), Order.end(), [pRegions](Uint32 i0, Uint32 i1) {
+            const auto& R0 = pRegions[i0];
+            const auto& R1 = pRegions[i1];
+            return R0.height != R1.height ? R0.height > R1.height : R0.width > R1.width;
+        });
+    }
+    else
+    {
+        // Regions with the longer side go first as they are the hardest to fit
+        std::sort(Order.begin(), Order.end(), [pRegions](Uint32 i0, Uint32 i1) {
+            const auto& R0 = pRegions[i0];
+            const auto& R1 = pRegions[i1];
+
+            const auto MaxSide0 = std::max(R0.width, R0.height);
+            const auto MaxSide1 = std::max(R1.width, R1.height);
+            return MaxSide0 != MaxSide1 ? MaxSide0 > MaxSide1 : std::min(R0.width, R0.height) > std::min(R1.width, R1.height);
+        });
+    }
+
+    Uint32 NumAllocated = 0;
+    for (auto i : Order)
+    {
+        auto& R = pRegions[i];
+        R       = Allocate(R.width, R.height);
+        if (!R.IsEmpty())
+            ++NumAllocated;
     }
 
+    return NumAllocated;
+}
+
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateFromTree(Uint32 Width, Uint32 Height)
+{
+    auto* pSrcNode = FindFreeRegion(Width, Height).second;
+    if (pSrcNode == nullptr)
+        return Region{};
+
     UnregisterNode(*pSrcNode);
 
     auto R = pSrcNode->R;
@@ -316,13 +402,6 @@ DynamicAtlasManager::Region DynamicAtlasManager::Allocate(Uint32 Width, Uint32 H
         RegisterNode(*pSrcNode);
     }
 
-    VERIFY_EXPR(m_TotalFreeArea >= Uint64{R.width} * Uint64{R.height});
-    m_TotalFreeArea -= Uint64{R.width} * Uint64{R.height};
-
-#if DILIGENT_DEBUG
-    DbgVerifyConsistency();
-#endif
-
     return R;
 }
 
@@ -333,13 +412,30 @@ void DynamicAtlasManager::Free(Region&& R)
     DbgVerifyRegion(R);
 #endif
 
-    auto node_it = m_AllocatedRegions.find(R);
-    if (node_it == m_AllocatedRegions.end())
+    if (m_AllocatedRegions.find(R) == m_AllocatedRegions.end())
     {
         UNEXPECTED("Unable to find region [", R.x, ", ", R.x + R.width, ") x [", R.y, ", ", R.y + R.height, ") among allocated regions. Have you ever allocated it?");
         return;
     }
 
+    if (m_Mode == Mode::Skyline)
+        FreeInSkyline(R);
+    else
+        FreeInTree(R);
+
+    m_TotalFreeArea += Uint64{R.width} * Uint64{R.height};
+
+#if DILIGENT_DEBUG
+    DbgVerifyConsistency();
+#endif
+
+    R = InvalidRegion;
+}
+
+
+void DynamicAtlasManager::FreeInTree(const Region& R)
+{
+    auto node_it = m_AllocatedRegions.find(R);
     VERIFY_EXPR(node_it->first == R && node_it->second->R == R);
     auto* N = node_it->second;
     VERIFY_EXPR(N->IsAllocated && !N->HasChildren());
@@ -359,14 +455,227 @@ void DynamicAtlasManager::Free(Region&& R)
 
         N = N->Parent;
     }
+}
 
-    m_TotalFreeArea += Uint64{R.width} * Uint64{R.height};
 
-#if DILIGENT_DEBUG
-    DbgVerifyConsistency();
-#endif
+void DynamicAtlasManager::ResetSkyline()
+{
+    m_Skyline.clear();
+    m_Skyline.push_back({0, 0, m_Width});
+    m_FreeRegionsByWidth.clear();
+    m_FreeRegionsByHeight.clear();
+    m_FreeRegionsByTop.clear();
+}
 
-    R = InvalidRegion;
+void DynamicAtlasManager::AddFreeRegion(const Region& R)
+{
+    VERIFY(!R.IsEmpty(), "Region must not be empty");
+    VERIFY(m_FreeRegionsByWidth.find(R) == m_FreeRegionsByWidth.end(), "New region should not be present in free regions map");
+    m_FreeRegionsByWidth.emplace(R, nullptr);
+    m_FreeRegionsByHeight.emplace(R, nullptr);
+    m_FreeRegionsByTop.emplace(R);
+}
+
+void DynamicAtlasManager::RemoveFreeRegion(const Region& R)
+{
+    VERIFY(m_FreeRegionsByWidth.find(R) != m_FreeRegionsByWidth.end(), "Region is not found in free regions map");
+    VERIFY(m_FreeRegionsByHeight.find(R) != m_FreeRegionsByHeight.end(), "Region is not found in free regions map");
+    m_FreeRegionsByWidth.erase(R);
+    m_FreeRegionsByHeight.erase(R);
+    m_FreeRegionsByTop.erase(R);
+}
+
+Uint32 DynamicAtlasManager::GetSkylineLevel(Uint32 x, Uint32 Width) const
+{
+    // Find the segment that contains x
+    auto it = std::upper_bound(m_Skyline.begin(), m_Skyline.end(), x,
+                               [](Uint32 _x, const SkylineSegment& S) { return _x < S.x; });
+    VERIFY_EXPR(it != m_Skyline.begin());
+    --it;
+    // Adjacent segments always have different heights, so the level is
+    // the same under the span only if the span is inside one segment.
+    return x + Width <= it->x + it->width ? it->y : UINT_MAX;
+}
+
+void DynamicAtlasManager::SetSkylineLevel(Uint32 x, Uint32 Width, Uint32 y)
+{
+    const auto End = x + Width;
+    VERIFY_EXPR(Width > 0 && End <= m_Width);
+
+    const auto SegmentComp = [](Uint32 _x, const SkylineSegment& S) { return _x < S.x; };
+
+    auto First = std::upper_bound(m_Skyline.begin(), m_Skyline.end(), x, SegmentComp) - 1;
+    auto Last  = std::upper_bound(First, m_Skyline.end(), End - 1, SegmentComp);
+
+    //          x                 End
+    //          |<-----Width----->|
+    //     _____                     ______
+    //    |     |_______            |
+    //    |             |___________|
+    //   First                     Last-1
+    //
+    SkylineSegment NewSegments[3];
+    size_t         NumNewSegments = 0;
+    if (First->x < x)
+        NewSegments[NumNewSegments++] = {First->x, First->y, x - First->x};
+    NewSegments[NumNewSegments++] = {x, y, Width};
+    {
+        const auto& LastSegment = *(Last - 1);
+        const auto  LastEnd     = LastSegment.x + LastSegment.width;
+        if (LastEnd > End)
+            NewSegments[NumNewSegments++] = {End, LastSegment.y, LastEnd - End};
+    }
+
+    const auto Pos = static_cast<size_t>(m_Skyline.erase(First, Last) - m_Skyline.begin());
+    m_Skyline.insert(m_Skyline.begin() + Pos, NewSegments, NewSegments + NumNewSegments);
+
+    // Merge the segments with their neighbors at the same height
+    size_t i    = Pos > 0 ? Pos - 1 : 0;
+    size_t iEnd = Pos + NumNewSegments;
+    while (i < iEnd && i + 1 < m_Skyline.size())
+    {
+        if (m_Skyline[i].y == m_Skyline[i + 1].y)
+        {
+            m_Skyline[i].width += m_Skyline[i + 1].width;
+            m_Skyline.erase(m_Skyline.begin() + i + 1);
+            --iEnd;
+        }
+        else
+        {
+            ++i;
+        }
+    }
+}
+
+DynamicAtlasManager::Region DynamicAtlasManager::AllocateFromSkyline(Uint32 Width, Uint32 Height)
+{
+    VERIFY_EXPR(Width > 0 && Height > 0);
+    if (Width > m_Width || Height > m_Height)
+        return Region{};
+
+    // Use the free space under the skyline first
+    const auto FreeR = FindFreeRegion(Width, Height).first;
+    if (!FreeR.IsEmpty())
+    {
+        RemoveFreeRegion(FreeR);
+
+        // Split the remaining space along the longer side, same as in the region tree
+        if (FreeR.width > FreeR.height)
+        {
+            if (FreeR.width > Width)
+                AddFreeRegion(Region{FreeR.x + Width, FreeR.y, FreeR.width - Width, FreeR.height});
+            if (FreeR.height > Height)
+                AddFreeRegion(Region{FreeR.x, FreeR.y + Height, Width, FreeR.height - Height});
+        }
+        else
+        {
+            if (FreeR.height > Height)
+                AddFreeRegion(Region{FreeR.x, FreeR.y + Height, FreeR.width, FreeR.height - Height});
+            if (FreeR.width > Width)
+                AddFreeRegion(Region{FreeR.x + Width, FreeR.y, FreeR.width - Width, Height});
+        }
+
+        const Region R{FreeR.x, FreeR.y, Width, Height};
+        m_AllocatedRegions.emplace(R, nullptr);
+        return R;
+    }
+
+    // Find the position where the top of the region is the lowest
+    size_t BestSegment = m_Skyline.size();
+    Uint32 BestY       = 0;
+    Uint32 BestTop     = m_Height + 1;
+    for (size_t i = 0; i < m_Skyline.size(); ++i)
+    {
+        const auto x = m_Skyline[i].x;
+        if (x + Width > m_Width)
+            break;
+
+        // The region rests on the highest segment under it
+        Uint32 y = 0;
+        for (size_t j = i; j < m_Skyline.size() && m_Skyline[j].x < x + Width && y + Height < BestTop; ++j)
+            y = std::max(y, m_Skyline[j].y);
+
+        if (y + Height < BestTop)
+        {
+            BestSegment = i;
+            BestY       = y;
+            BestTop     = y + Height;
+        }
+    }
+    if (BestSegment == m_Skyline.size())
+        return Region{};
+
+    //                  _____________
+    //                 |             |
+    //                 |      R      |
+    //     ____________|_____________|
+    //    |            |    Free     |______
+    //                 |_____________|
+    //
+    const Region R{m_Skyline[BestSegment].x, BestY, Width, Height};
+    for (size_t j = BestSegment; j < m_Skyline.size() && m_Skyline[j].x < R.x + Width; ++j)
+    {
+        const auto& S = m_Skyline[j];
+        if (S.y < BestY)
+            AddFreeRegion(Region{S.x, S.y, std::min(S.x + S.width, R.x + Width) - S.x, BestY - S.y});
+    }
+    SetSkylineLevel(R.x, Width, BestTop);
+
+    m_AllocatedRegions.emplace(R, nullptr);
+    return R;
+}
+
+void DynamicAtlasManager::FreeInSkyline(const Region& R)
+{
+    m_AllocatedRegions.erase(R);
+    if (m_AllocatedRegions.empty())
+    {
+        ResetSkyline();
+        return;
+    }
+
+    if (GetSkylineLevel(R.x, R.width) != R.y + R.height)
+    {
+        // There are other regions above
+        AddFreeRegion(R);
+        return;
+    }
+
+    LowerSkyline(R.x, R.width, R.y);
+}
+
+void DynamicAtlasManager::LowerSkyline(Uint32 x, Uint32 Width, Uint32 y)
+{
+    SetSkylineLevel(x, Width, y);
+
+    // Free regions that are on top of the lowered segment become part of the space above
+    // the skyline. This lowers the skyline further, so repeat the process for every region.
+    std::vector<Uint32> Positions{x};
+    std::vector<Region> TopRegions;
+    while (!Positions.empty())
+    {
+        auto it = std::upper_bound(m_Skyline.begin(), m_Skyline.end(), Positions.back(),
+                                   [](Uint32 _x, const SkylineSegment& S) { return _x < S.x; });
+        Positions.pop_back();
+        VERIFY_EXPR(it != m_Skyline.begin());
+        const auto S = *(--it);
+
+        TopRegions.clear();
+        for (auto region_it = m_FreeRegionsByTop.lower_bound(Region{S.x, S.y, 0, 0});
+             region_it != m_FreeRegionsByTop.end() && region_it->y + region_it->height == S.y && region_it->x < S.x + S.width;
+             ++region_it)
+        {
+            if (region_it->x + region_it->width <= S.x + S.width)
+                TopRegions.push_back(*region_it);
+        }
+
+        for (const auto& FreeR : TopRegions)
+        {
+            RemoveFreeRegion(FreeR);
+            SetSkylineLevel(FreeR.x, FreeR.width, FreeR.y);
+            Positions.push_back(FreeR.x);
+        }
+    }
 }
 
 
@@ -420,6 +729,35 @@ void DynamicAtlasManager::DbgRecursiveVerifyConsistency(const Node& N, Uint32& A
 void DynamicAtlasManager::DbgVerifyConsistency() const
 {
     VERIFY_EXPR(m_FreeRegionsByWidth.size() == m_FreeRegionsByHeight.size());
+
+    if (m_Mode == Mode::Skyline)
+    {
+        VERIFY_EXPR(!m_Root);
+
+        Uint64 FreeArea = 0;
+        Uint32 x        = 0;
+        for (size_t i = 0; i < m_Skyline.size(); ++i)
+        {
+            const auto& S = m_Skyline[i];
+            VERIFY(S.x == x, "Skyline segments must be contiguous");
+            VERIFY(S.width > 0, "Skyline segment must not be empty");
+            VERIFY(S.y <= m_Height, "Skyline segment height (", S.y, ") exceeds atlas height (", m_Height, ").");
+            VERIFY(i == 0 || S.y != m_Skyline[i - 1].y, "Adjacent skyline segments must have different heights");
+            FreeArea += Uint64{S.width} * Uint64{m_Height - S.y};
+            x += S.width;
+        }
+        VERIFY(x == m_Width, "Skyline does not cover entire atlas width");
+
+        VERIFY_EXPR(m_FreeRegionsByTop.size() == m_FreeRegionsByWidth.size());
+        for (const auto& it : m_FreeRegionsByWidth)
+        {
+            VERIFY(m_FreeRegionsByHeight.find(it.first) != m_FreeRegionsByHeight.end(), "Free region is not found in free regions map");
+            VERIFY(m_FreeRegionsByTop.find(it.first) != m_FreeRegionsByTop.end(), "Free region is not found in free regions map");
+            FreeArea += Uint64{it.first.width} * Uint64{it.first.height};
+        }
+        VERIFY_EXPR(FreeArea == m_TotalFreeArea);
+        return;
+    }
     Uint32 Area = 0;
 
     DbgRecursiveVerifyConsistency(*m_Root, Area);
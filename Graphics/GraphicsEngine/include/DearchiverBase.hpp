@@ -65,6 +65,9 @@ public:
     /// Implementation of IDearchiver::LoadArchive().
     virtual bool DILIGENT_CALL_TYPE LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVersion, bool MakeCopy) override final;
 
+    /// Implementation of IDearchiver::LoadArchiveFromFile().
+    virtual bool DILIGENT_CALL_TYPE LoadArchiveFromFile(const Char* FilePath, Uint32 ContentVersion) override final;
+
     /// Implementation of IDearchiver::UnpackShader().
     virtual void DILIGENT_CALL_TYPE UnpackShader(const ShaderUnpackInfo& UnpackInfo,
                                                  IShader**               ppShader) override final;
@@ -32,9 +32,11 @@
 #include <array>
 #include <vector>
 #include <unordered_map>
+#include <mutex>
 
 #include "GraphicsTypes.h"
 #include "FileStream.h"
+#include "FlagEnum.h"
 
 #include "HashUtils.hpp"
 #include "RefCntAutoPtr.hpp"
@@ -44,26 +46,45 @@
 
 // Device object archive structure:
 //
-// | Header |  Resource Data  |  Shader Data  |
+// | Header |  Resource Index  |  Shader Index  |  Resource Data  |  Shader Data  |
 //
-//     |  Resource Data  | = | Res1 | Res2 | ... | ResN |
+//     |  Resource Index  | = | Res1 | Res2 | ... | ResN |
 //
-//         | ResI | = | Type | Name | Common Data |  OpenGL data | D3D11 data | ...  | Metal-iOS data |
+//         | ResI | = | Type | Name | Common Data Size |  OpenGL data size | D3D11 data size | ...  | Metal-iOS data size |
 //
-//     |  Shader Data  | =  |  OpenGL shaders | D3D11 shaders | ...  | Metal-iOS shaders |
+//     |  Shader Index  | = | OpenGL shaders | D3D11 shaders | ...  | Metal-iOS shaders |
+//
+//         | Device shaders | = | NumShaders | Shader 0 size | Shader 1 size | ... |
+//
+//     In compressed archives, every data block size in the index is followed by the size of the
+//     compressed block, e.g. | Common Data Size | Common Data Compressed Size | OpenGL data size | ...
+//
+//     |  Resource Data  | = | Res1 Common Data | Res1 OpenGL data | ... | ResN Metal-iOS data |
+//
+//     |  Shader Data  | = | GL Shader 0 | GL Shader 1 | ... | Metal-iOS Shader M |
 //
 // The header contains general information such as:
 // - Magic number
 // - Archive version
 // - API version
+// - Archive flags
 
-// Resource data contains an array of resources. Each resource contains:
-// - Type (Signature, Graphics Pipeline, Render Pass, etc.)
-// - Name
+// The index contains the type and name of each resource and the sizes of all data blocks.
+// Resource data contains the data blocks of all resources in the order of the index:
 // - Common data (e.g. a resource description)
 // - Device-specific data (e.g. shader indices)
 //
-// Shader data contains an array of shaders for each device type
+// Shader data contains the data blocks of all shaders for each device type.
+//
+// Every data block is aligned by 8 bytes relative to the start of the archive.
+// Since the offsets of all blocks are determined by the index, the archive can be
+// opened without accessing the data, which allows e.g. memory-mapping large archives
+// and loading the data from disk only when the resource is unpacked.
+//
+// If the archive is compressed (ArchiveFlags::CompressedData), every data block is compressed
+// independently, so that only the blocks required by the unpacked resource are decompressed.
+// Blocks that do not benefit from compression are stored as is, in which case the compressed
+// size is equal to the data size.
 //
 //
 // For pipelines, device-specific data is the array of shader indices in the
@@ -79,6 +100,8 @@
 namespace Diligent
 {
 
+class IThreadPool;
+
 /// Device object archive object.
 class DeviceObjectArchive
 {
@@ -127,17 +150,26 @@ public:
     };
 
     static constexpr Uint32 HeaderMagicNumber = 0xDE00000A;
-    static constexpr Uint32 ArchiveVersion    = 5;
+    static constexpr Uint32 ArchiveVersion    = 8;
+
+    enum class ArchiveFlags : Uint32
+    {
+        None = 0u,
+
+        // Data blocks are compressed with CompressBlock().
+        CompressedData = 1u << 0u,
+    };
 
     struct ArchiveHeader
     {
         ArchiveHeader() noexcept;
 
-        Uint32      MagicNumber    = HeaderMagicNumber;
-        Uint32      Version        = ArchiveVersion;
-        Uint32      APIVersion     = DILIGENT_API_VERSION;
-        Uint32      ContentVersion = 0;
-        const char* GitHash        = nullptr;
+        Uint32       MagicNumber    = HeaderMagicNumber;
+        Uint32       Version        = ArchiveVersion;
+        Uint32       APIVersion     = DILIGENT_API_VERSION;
+        Uint32       ContentVersion = 0;
+        ArchiveFlags Flags          = ArchiveFlags::None;
+        const char*  GitHash        = nullptr;
     };
 
     struct ResourceData
@@ -224,6 +256,17 @@ public:
         return m_ContentVersion;
     }
 
+    ArchiveFlags GetFlags() const
+    {
+        return m_Flags;
+    }
+
+    // Sets the flags that will be used when the archive is serialized.
+    void SetFlags(ArchiveFlags Flags)
+    {
+        m_Flags = Flags;
+    }
+
 public:
     struct CreateInfo
     {
@@ -262,7 +305,7 @@ public:
         // Use string copy from the map
         Name = it->first.GetName();
 
-        Serializer<SerializerMode::Read> Ser{it->second.Common};
+        Serializer<SerializerMode::Read> Ser{GetUncompressedData(it->second.Common)};
 
         auto Res = ResData.Deserialize(Name, Ser);
         VERIFY_EXPR(Ser.IsEnded());
@@ -275,12 +318,15 @@ public:
 
     ResourceData& GetResourceData(ResourceType Type, const char* Name) noexcept
     {
+        DecompressAllBlocks();
         constexpr auto MakeCopy = true;
         return m_NamedResources[NamedResourceKey{Type, Name, MakeCopy}];
     }
 
     auto& GetDeviceShaders(DeviceType Type) noexcept
     {
+        // The shader array may be modified, so the data must not be referenced by compressed blocks.
+        DecompressAllBlocks();
         return m_DeviceShaders[static_cast<size_t>(Type)];
     }
 
@@ -288,18 +334,61 @@ public:
     {
         const auto& DeviceShaders = m_DeviceShaders[static_cast<size_t>(Type)];
         if (Idx < DeviceShaders.size())
-            return DeviceShaders[Idx];
+            return GetUncompressedData(DeviceShaders[Idx]);
 
         static const SerializedData NullData;
         return NullData;
     }
 
+    // NB: the data of compressed archives must be accessed through GetUncompressedData().
     const auto& GetNamedResources() const
     {
         return m_NamedResources;
     }
 
+    // Returns the data block, decompressing it first if necessary.
+    // The method is thread-safe: every block is decompressed only once, while
+    // different blocks may be decompressed by multiple threads simultaneously.
+    // Blocks are decompressed on the calling thread.
+    const SerializedData& GetUncompressedData(const SerializedData& Data) const noexcept;
+
+    // Decompresses all data blocks that have not been decompressed yet using the thread pool.
+    // If pThreadPool is null, the blocks are decompressed by the calling thread.
+    // NumTasks is the maximum number of tasks to split the work into, including the part
+    // that is processed by the calling thread. The method blocks until all blocks are
+    // decompressed, and must not be called from a worker thread of the same thread pool.
+    void DecompressBlocks(IThreadPool* pThreadPool, Uint32 NumTasks) const noexcept;
+
+    // Returns the resource data that references the decompressed blocks.
+    // The returned object does not own the data and is valid as long as the archive is not modified.
+    ResourceData GetUncompressedData(const ResourceData& ResData) const noexcept;
+
 private:
+    // Decompresses all data blocks so that the archive can be modified.
+    void DecompressAllBlocks() noexcept;
+
+    struct CompressedBlock
+    {
+        CompressedBlock(SerializedData* _pDst, const void* _pData, Uint32 _Size, Uint32 _UncompressedSize) noexcept :
+            pDst{_pDst},
+            pData{_pData},
+            Size{_Size},
+            UncompressedSize{_UncompressedSize}
+        {}
+
+        // Data object that receives the decompressed data when the archive is modified
+        SerializedData* const pDst;
+
+        const void* const pData;
+        const Uint32      Size;
+        const Uint32      UncompressedSize;
+
+        mutable std::once_flag DecompressFlag;
+
+        // Decompressed data, written once under DecompressFlag
+        mutable SerializedData Decompressed;
+    };
+
     // Named resources
     std::unordered_map<NamedResourceKey, ResourceData, NamedResourceKey::Hasher> m_NamedResources;
 
@@ -310,8 +399,16 @@ private:
     // Resources will not make copies and reference this data.
     RefCntAutoPtr<IDataBlob> m_pArchiveData;
 
-    Uint32 m_ContentVersion = 0;
+    // Data blocks that have not been decompressed yet. The map is populated when
+    // the archive is deserialized and is not modified by const methods, so that it can
+    // be searched by multiple threads. The data objects remain empty until DecompressAllBlocks()
+    // moves the decompressed data into them.
+    std::unordered_map<const SerializedData*, CompressedBlock> m_CompressedBlocks;
+
+    Uint32       m_ContentVersion = 0;
+    ArchiveFlags m_Flags          = ArchiveFlags::None;
 };
+DEFINE_FLAG_ENUM_OPERATORS(DeviceObjectArchive::ArchiveFlags)
 
 DeviceObjectArchive::DeviceType RenderDeviceTypeToArchiveDeviceType(RENDER_DEVICE_TYPE Type);
 
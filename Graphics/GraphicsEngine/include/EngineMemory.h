@@ -43,6 +43,15 @@ IMemoryAllocator& GetRawAllocator();
 
 IMemoryAllocator& GetStringAllocator();
 
+class ScratchArena;
+
+/// Returns the scratch arena of the calling thread.
+
+/// The arena is used for temporary allocations during object creation
+/// and allocates its pages from the default raw memory allocator rather than
+/// the one set by SetRawAllocator(), since the arena may outlive the latter.
+ScratchArena& GetThreadScratchArena();
+
 #define ALLOCATE_RAW(Allocator, Desc, Size)    (Allocator).Allocate(Size, Desc, __FILE__, __LINE__)
 #define ALLOCATE(Allocator, Desc, Type, Count) reinterpret_cast<Type*>(ALLOCATE_RAW(Allocator, Desc, sizeof(Type) * (Count)))
 #define FREE(Allocator, Ptr)                   Allocator.Free(Ptr)
@@ -132,4 +132,10 @@ DECL_TRIVIALLY_SERIALIZABLE(DepthStencilStateDesc);
 DECL_TRIVIALLY_SERIALIZABLE(SampleDesc);
 DECL_TRIVIALLY_SERIALIZABLE(ShaderCreateInfo);
 
+// The structures below have no padding, so that their arrays are serialized as raw bytes
+// and are referenced in place when deserialized.
+DECL_TRIVIALLY_SERIALIZABLE(AttachmentReference);
+DECL_TRIVIALLY_SERIALIZABLE(ShadingRateAttachment);
+DECL_TRIVIALLY_SERIALIZABLE(SubpassDependencyDesc);
+
 } // namespace Diligent
@@ -43,6 +43,7 @@
 #include "EngineMemory.h"
 #include "GraphicsAccessories.hpp"
 #include "FixedLinearAllocator.hpp"
+#include "ScratchArena.hpp"
 #include "HashUtils.hpp"
 #include "PipelineResourceSignatureBase.hpp"
 
@@ -691,7 +692,9 @@ public:
     {
         VERIFY_EXPR(CreateInfo.PSODesc.IsRayTracingPipeline());
 
-        std::unordered_set<IShader*> UniqueShaders;
+        ScratchArena::Scope Scratch{GetThreadScratchArena()};
+
+        ScratchUnorderedSet<IShader*> UniqueShaders{Scratch.GetSTDAllocator()};
 
         auto AddShader = [&ShaderStages, &UniqueShaders, &ActiveShaderStages](IShader* pShader) {
             if (pShader != nullptr && UniqueShaders.insert(pShader).second)
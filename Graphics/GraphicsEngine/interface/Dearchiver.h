@@ -243,6 +243,31 @@ DILIGENT_BEGIN_INTERFACE(IDearchiver, IObject)
                                      Uint32           ContentVersion DEFAULT_VALUE(~0u),
                                      Bool             MakeCopy       DEFAULT_VALUE(false)) PURE;
 
+    /// Loads a device object archive from a file.
+
+    /// \param [in] FilePath       - Path to the archive file.
+    /// \param [in] ContentVersion - The expected version of the content in the archive.
+    ///                              If the version of the content in the archive does not
+    ///                              match the expected version, the method will fail.
+    ///                              If default value is used (~0u aka 0xFFFFFFFF), the version
+    ///                              will not be checked.
+    ///
+    /// \return     true if the archive has been loaded successfully, and false otherwise.
+    ///
+    /// \note       On platforms that support it (Linux, Android, MacOS, iOS, tvOS), the file is
+    ///             memory-mapped rather than read into memory. Only the archive index is parsed
+    ///             when the archive is loaded, while resource data is paged in from the file when
+    ///             the resource is unpacked for the first time.
+    ///             The file is kept open until the dearchiver object is released or the Reset()
+    ///             method is called. The application must not modify the file while it is in use
+    ///             by the dearchiver.
+    ///
+    /// \warning    This method is not thread-safe and must not be called simultaneously
+    ///             with other methods.
+    VIRTUAL Bool METHOD(LoadArchiveFromFile)(THIS_
+                                             const Char* FilePath,
+                                             Uint32      ContentVersion DEFAULT_VALUE(~0u)) PURE;
+
     /// Unpacks a shader from the device object archive.
 
     /// \param [in]  UnpackInfo - Shader unpack info, see Diligent::ShaderUnpackInfo.
@@ -326,6 +351,7 @@ DILIGENT_END_INTERFACE
 #if DILIGENT_C_INTERFACE
 
 #    define IDearchiver_LoadArchive(This, ...)             CALL_IFACE_METHOD(Dearchiver, LoadArchive,             This, __VA_ARGS__)
+#    define IDearchiver_LoadArchiveFromFile(This, ...)     CALL_IFACE_METHOD(Dearchiver, LoadArchiveFromFile,     This, __VA_ARGS__)
 #    define IDearchiver_UnpackShader(This, ...)            CALL_IFACE_METHOD(Dearchiver, UnpackShader,            This, __VA_ARGS__)
 #    define IDearchiver_UnpackPipelineState(This, ...)     CALL_IFACE_METHOD(Dearchiver, UnpackPipelineState,     This, __VA_ARGS__)
 #    define IDearchiver_UnpackResourceSignature(This, ...) CALL_IFACE_METHOD(Dearchiver, UnpackResourceSignature, This, __VA_ARGS__)
@@ -27,6 +27,7 @@
 #include "DearchiverBase.hpp"
 #include "PipelineStateBase.hpp"
 #include "PSOSerializer.hpp"
+#include "MappedFileDataBlob.hpp"
 
 namespace Diligent
 {
@@ -677,12 +678,13 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVe
             const auto it_inserted = m_ResNameToArchiveIdx.emplace(NamedResourceKey{ResType, ResName, MakeNameCopy}, ArchiveIdx);
             if (!it_inserted.second)
             {
-                const auto& OtherArchiveResources = m_Archives[it_inserted.first->second].pObjArchive->GetNamedResources();
+                const auto& pOtherArchive         = m_Archives[it_inserted.first->second].pObjArchive;
+                const auto& OtherArchiveResources = pOtherArchive->GetNamedResources();
                 const auto  it_other              = OtherArchiveResources.find(NamedResourceKey{ResType, ResName});
 
                 const auto IsDuplicate =
                     (it_other != OtherArchiveResources.end()) &&
-                    (it.second == it_other->second);
+                    (pObjArchive->GetUncompressedData(it.second) == pOtherArchive->GetUncompressedData(it_other->second));
                 if (!IsDuplicate)
                 {
                     LOG_ERROR_MESSAGE("Resource with name '", ResName, "' already exists in the archive.");
@@ -701,6 +703,23 @@ bool DearchiverBase::LoadArchive(const IDataBlob* pArchiveData, Uint32 ContentVe
     }
 }
 
+bool DearchiverBase::LoadArchiveFromFile(const Char* FilePath, Uint32 ContentVersion)
+{
+    if (FilePath == nullptr)
+        return false;
+
+    // Resources are unpacked on demand in arbitrary order, so read-ahead is not useful
+    auto pArchiveData = MappedFileDataBlob::Create(FilePath, EFileAccessPattern::Random);
+    if (!pArchiveData)
+    {
+        LOG_ERROR_MESSAGE("Failed to open device object archive file '", FilePath, "'.");
+        return false;
+    }
+
+    // The archive keeps a strong reference to the blob, so the file stays mapped while it is in use.
+    return LoadArchive(pArchiveData, ContentVersion, /*MakeCopy = */ false);
+}
+
 void DearchiverBase::UnpackPipelineState(const PipelineStateUnpackInfo& UnpackInfo, IPipelineState** ppPSO)
 {
     if (!VerifyPipelineStateUnpackInfo(UnpackInfo, ppPSO))
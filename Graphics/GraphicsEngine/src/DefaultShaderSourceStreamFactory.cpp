@@ -31,6 +31,7 @@
 #include "RefCntAutoPtr.hpp"
 #include "EngineMemory.h"
 #include "BasicFileStream.hpp"
+#include "MappedFileStream.hpp"
 
 namespace Diligent
 {
@@ -80,17 +81,23 @@ void DefaultShaderSourceStreamFactory::CreateInputStream2(const Char*
 {
     auto CreateFileStream = [](const char* Path) //
     {
-        RefCntAutoPtr<BasicFileStream> pFileStream;
+        RefCntAutoPtr<IFileStream> pFileStream;
         if (FileSystem::FileExists(Path))
         {
+#if PLATFORM_LINUX || PLATFORM_APPLE
+            // Mapped streams let ReadFileStreamData() use the file data without copying it.
+            // Note that on Android, shader sources are typically stored in assets that can't be mapped.
+            pFileStream = MappedFileStream::Create(Path, EFileAccessPattern::Sequential);
+#else
             pFileStream = MakeNewRCObj<BasicFileStream>()(Path, EFileAccessMode::Read);
             if (!pFileStream->IsValid())
                 pFileStream.Release();
+#endif
         }
         return pFileStream;
     };
 
-    RefCntAutoPtr<BasicFileStream> pFileStream;
+    RefCntAutoPtr<IFileStream> pFileStream;
     if (FileSystem::IsPathAbsolute(Name))
     {
         pFileStream = CreateFileStream(Name);
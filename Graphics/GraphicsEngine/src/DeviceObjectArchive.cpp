@@ -28,11 +28,16 @@
 
 #include <algorithm>
 #include <sstream>
+#include <cstring>
+#include <tuple>
+#include <atomic>
 
 #include "Shader.h"
 #include "EngineMemory.h"
 #include "DataBlobImpl.hpp"
 #include "PSOSerializer.hpp"
+#include "BlockCompression.hpp"
+#include "ThreadPool.hpp"
 
 namespace Diligent
 {
@@ -70,76 +75,94 @@ DeviceObjectArchive::ArchiveHeader::ArchiveHeader() noexcept
 namespace
 {
 
+// Data blocks are aligned to this boundary relative to the start of the archive.
+constexpr size_t DataBlockAlignment = 8;
+
+// Data block as it is written to the archive
+struct ArchiveDataBlock
+{
+    // The size of the uncompressed data
+    Uint32 Size = 0;
+
+    // Compressed data, or a reference to the original data if the block is not compressed
+    SerializedData StoredData;
+};
+
+ArchiveDataBlock MakeArchiveDataBlock(const SerializedData& Data, bool Compress, std::vector<Uint8>& Scratch)
+{
+    ArchiveDataBlock Block;
+    Block.Size = StaticCast<Uint32>(Data.Size());
+
+    if (Compress && Data.Size() > 0)
+    {
+        // Only keep the compressed data if it is smaller than the original
+        Scratch.resize(Data.Size() - 1);
+
+        const auto CompressedSize = CompressBlock(Data.Ptr(), Data.Size(), Scratch.data(), Scratch.size());
+        if (CompressedSize > 0)
+        {
+            Block.StoredData = SerializedData{CompressedSize, GetRawAllocator()};
+            memcpy(Block.StoredData.Ptr(), Scratch.data(), CompressedSize);
+            return Block;
+        }
+    }
+
+    Block.StoredData = SerializedData{Data.Ptr(), Data.Size()};
+    return Block;
+}
+
 template <SerializerMode Mode>
 struct ArchiveSerializer
 {
     Serializer<Mode>& Ser;
 
+    // Whether the index contains compressed block sizes
+    const bool CompressedData = false;
+
     template <typename T>
     using ConstQual = typename Serializer<Mode>::template ConstQual<T>;
 
     using ArchiveHeader = DeviceObjectArchive::ArchiveHeader;
-    using ResourceData  = DeviceObjectArchive::ResourceData;
-    using ShadersVector = std::vector<SerializedData>;
 
     bool SerializeHeader(ConstQual<ArchiveHeader>& Header) const
     {
-        ASSERT_SIZEOF64(Header, 24, "Please handle new members here");
+        ASSERT_SIZEOF64(Header, 32, "Please handle new members here");
         // NB: this must match header deserialization in DeviceObjectArchive::Deserialize
-        return Ser(Header.MagicNumber, Header.Version, Header.APIVersion, Header.ContentVersion, Header.GitHash);
+        return Ser(Header.MagicNumber, Header.Version, Header.APIVersion, Header.ContentVersion, Header.Flags, Header.GitHash);
     }
 
-    bool SerializeResourceData(ConstQual<ResourceData>& ResData) const
+    // NB: the functions below must match the index parsing in DeviceObjectArchive::Deserialize
+
+    bool SerializeDataSize(const ArchiveDataBlock& Block) const
     {
-        if (!Ser.Serialize(ResData.Common))
-            return true;
+        if (!Ser(Block.Size))
+            return false;
 
-        for (auto& DevData : ResData.DeviceSpecific)
+        const auto StoredSize = StaticCast<Uint32>(Block.StoredData.Size());
+        if (!CompressedData)
         {
-            if (!Ser.Serialize(DevData))
-                return false;
+            VERIFY_EXPR(StoredSize == Block.Size);
+            return true;
         }
 
-        return true;
+        return Ser(StoredSize);
     }
 
-    bool SerializeShaders(ConstQual<ShadersVector>& Shaders) const;
-};
-
-template <SerializerMode Mode>
-bool ArchiveSerializer<Mode>::SerializeShaders(ConstQual<ShadersVector>& Shaders) const
-{
-    static_assert(Mode == SerializerMode::Measure || Mode == SerializerMode::Write, "Measure or Write mode is expected.");
-
-    Uint32 NumShaders = static_cast<Uint32>(Shaders.size());
-    if (!Ser(NumShaders))
-        return false;
-
-    for (const auto& Shader : Shaders)
+    bool SerializeDataBlock(const ArchiveDataBlock& Block) const
     {
-        if (!Ser.Serialize(Shader))
-            return false;
-    }
-
-    return true;
-}
+        static_assert(Mode == SerializerMode::Measure || Mode == SerializerMode::Write, "Measure or Write mode is expected.");
 
-template <>
-bool ArchiveSerializer<SerializerMode::Read>::SerializeShaders(ShadersVector& Shaders) const
-{
-    Uint32 NumShaders = 0;
-    if (!Ser(NumShaders))
-        return false;
+        // Write zero padding explicitly so that the archive contents are deterministic
+        static constexpr Uint8 Padding[DataBlockAlignment] = {};
 
-    Shaders.resize(NumShaders);
-    for (auto& Shader : Shaders)
-    {
-        if (!Ser.Serialize(Shader))
+        const auto Offset = Ser.GetSize();
+        if (!Ser.CopyBytes(Padding, AlignUp(Offset, DataBlockAlignment) - Offset))
             return false;
-    }
 
-    return true;
-}
+        const auto& Data = Block.StoredData;
+        return Data.Size() == 0 || Ser.CopyBytes(Data.Ptr(), Data.Size());
+    }
+};
 
 } // namespace
 
@@ -160,7 +183,7 @@ void DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept(false)
 
     // NB: this must match header serialization in DeviceObjectArchive::SerializeHeader
     ArchiveHeader Header;
-    ASSERT_SIZEOF64(Header, 24, "Please handle new members here");
+    ASSERT_SIZEOF64(Header, 32, "Please handle new members here");
     if (!ArchiveReader.Ser(Header.MagicNumber))
         LOG_ERROR_AND_THROW("Failed to read device object archive header magic number.");
 
@@ -183,6 +206,12 @@ void DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept(false)
         LOG_ERROR_AND_THROW("Invalid archive content version: ", Header.ContentVersion, ". Expected version: ", CI.ContentVersion);
     m_ContentVersion = Header.ContentVersion;
 
+    if (!ArchiveReader.Ser(Header.Flags))
+        LOG_ERROR_AND_THROW("Failed to read device object archive flags.");
+    m_Flags = Header.Flags;
+
+    const auto CompressedData = (m_Flags & ArchiveFlags::CompressedData) != ArchiveFlags::None;
+
     if (!ArchiveReader.Ser(Header.GitHash))
         LOG_ERROR_AND_THROW("Failed to read Git Hash.");
 
@@ -190,6 +219,30 @@ void DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept(false)
     if (!Reader(NumResources))
         LOG_ERROR_AND_THROW("Failed to read the number of named resources in the device object archive.");
 
+    // The index contains the sizes of all data blocks, while the blocks themselves follow the
+    // index in the same order. This way the index can be parsed without touching the memory
+    // that holds the data, which allows loading resource data lazily from memory-mapped files.
+    struct DataBlockInfo
+    {
+        SerializedData* pData;
+        Uint32          Size;
+        Uint32          StoredSize;
+    };
+    std::vector<DataBlockInfo> DataBlocks;
+
+    auto ReadDataSize = [&](SerializedData& Data) {
+        Uint32 Size = 0;
+        if (!Reader(Size))
+            return false;
+
+        Uint32 StoredSize = Size;
+        if (CompressedData && (!Reader(StoredSize) || StoredSize > Size))
+            return false;
+
+        DataBlocks.push_back({&Data, Size, StoredSize});
+        return true;
+    };
+
     for (Uint32 res = 0; res < NumResources; ++res)
     {
         const char*  Name    = nullptr;
@@ -202,15 +255,136 @@ void DeviceObjectArchive::Deserialize(const CreateInfo& CI) noexcept(false)
         constexpr auto MakeNameCopy = false;
         auto&          ResData      = m_NamedResources[NamedResourceKey{ResType, Name, MakeNameCopy}];
 
-        if (!ArchiveReader.SerializeResourceData(ResData))
-            LOG_ERROR_AND_THROW("Failed to read data of resource '", Name, "'.");
+        bool Res = ReadDataSize(ResData.Common);
+        for (size_t i = 0; i < ResData.DeviceSpecific.size() && Res; ++i)
+            Res = ReadDataSize(ResData.DeviceSpecific[i]);
+        if (!Res)
+            LOG_ERROR_AND_THROW("Failed to read data sizes of resource '", Name, "'.");
     }
 
     for (auto& Shaders : m_DeviceShaders)
     {
-        if (!ArchiveReader.SerializeShaders(Shaders))
-            LOG_ERROR_AND_THROW("Failed to read shader data from the device object archive.");
+        Uint32 NumShaders = 0;
+        if (!Reader(NumShaders) || NumShaders > Reader.GetRemainingSize() / sizeof(Uint32))
+            LOG_ERROR_AND_THROW("Failed to read the number of shaders in the device object archive.");
+
+        Shaders.resize(NumShaders);
+        for (auto& Shader : Shaders)
+        {
+            if (!ReadDataSize(Shader))
+                LOG_ERROR_AND_THROW("Failed to read shader data sizes from the device object archive.");
+        }
     }
+
+    auto* const  pArchiveData = static_cast<Uint8*>(const_cast<void*>(CI.pData->GetConstDataPtr()));
+    const size_t ArchiveSize  = CI.pData->GetSize();
+
+    size_t Offset = Reader.GetSize();
+    for (const auto& Block : DataBlocks)
+    {
+        Offset = AlignUp(Offset, DataBlockAlignment);
+        if (Block.StoredSize > ArchiveSize - std::min(Offset, ArchiveSize))
+            LOG_ERROR_AND_THROW("Device object archive data is truncated: data block at offset ", Offset, " with size ", Block.StoredSize,
+                                " exceeds the archive size (", ArchiveSize, ").");
+
+        if (Block.StoredSize < Block.Size)
+        {
+            // Compressed blocks are decompressed on first access by GetUncompressedData()
+            m_CompressedBlocks.emplace(std::piecewise_construct,
+                                       std::forward_as_tuple(Block.pData),
+                                       std::forward_as_tuple(Block.pData, pArchiveData + Offset, Block.StoredSize, Block.Size));
+        }
+        else if (Block.Size > 0)
+        {
+            *Block.pData = SerializedData{pArchiveData + Offset, Block.Size};
+        }
+        Offset += Block.StoredSize;
+    }
+}
+
+const SerializedData& DeviceObjectArchive::GetUncompressedData(const SerializedData& Data) const noexcept
+{
+    if (m_CompressedBlocks.empty())
+        return Data;
+
+    auto it = m_CompressedBlocks.find(&Data);
+    if (it == m_CompressedBlocks.end())
+        return Data;
+
+    const auto& Block = it->second;
+    std::call_once(Block.DecompressFlag, [&Block]() {
+        SerializedData UncompressedData{Block.UncompressedSize, GetRawAllocator()};
+        if (DecompressBlock(Block.pData, Block.Size, UncompressedData.Ptr(), UncompressedData.Size()))
+            Block.Decompressed = std::move(UncompressedData);
+        else
+            LOG_ERROR_MESSAGE("Failed to decompress device object archive data block. Archive file may be corrupted or invalid.");
+    });
+
+    return Block.Decompressed;
+}
+
+DeviceObjectArchive::ResourceData DeviceObjectArchive::GetUncompressedData(const ResourceData& ResData) const noexcept
+{
+    auto MakeView = [this](const SerializedData& Data) {
+        const auto& Uncompressed = GetUncompressedData(Data);
+        return SerializedData{Uncompressed.Ptr(), Uncompressed.Size()};
+    };
+
+    ResourceData View;
+    View.Common = MakeView(ResData.Common);
+    for (size_t i = 0; i < ResData.DeviceSpecific.size(); ++i)
+        View.DeviceSpecific[i] = MakeView(ResData.DeviceSpecific[i]);
+    return View;
+}
+
+void DeviceObjectArchive::DecompressBlocks(IThreadPool* pThreadPool, Uint32 NumTasks) const noexcept
+{
+    if (m_CompressedBlocks.empty())
+        return;
+
+    std::vector<const SerializedData*> Blocks;
+    Blocks.reserve(m_CompressedBlocks.size());
+    for (const auto& it : m_CompressedBlocks)
+        Blocks.push_back(it.first);
+
+    // Blocks differ in size, so the tasks take them one by one rather than in fixed ranges.
+    std::atomic<size_t> NextBlock{0};
+
+    const auto ProcessBlocks = [&]() {
+        for (size_t i = NextBlock.fetch_add(1); i < Blocks.size(); i = NextBlock.fetch_add(1))
+            GetUncompressedData(*Blocks[i]);
+    };
+
+    const Uint32 TaskCount = pThreadPool != nullptr ? std::min(std::max(NumTasks, 1u), static_cast<Uint32>(Blocks.size())) : 1;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(TaskCount - 1);
+    for (Uint32 Task = 1; Task < TaskCount; ++Task)
+    {
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&ProcessBlocks](Uint32) {
+                                                ProcessBlocks();
+                                            }));
+    }
+
+    ProcessBlocks();
+
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+}
+
+void DeviceObjectArchive::DecompressAllBlocks() noexcept
+{
+    if (m_CompressedBlocks.empty())
+        return;
+
+    for (auto& it : m_CompressedBlocks)
+    {
+        GetUncompressedData(*it.first);
+        // Decompressed data is moved without reallocation, so references returned earlier remain valid.
+        *it.second.pDst = std::move(it.second.Decompressed);
+    }
+    m_CompressedBlocks.clear();
 }
 
 void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
@@ -222,12 +396,40 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
     }
     DEV_CHECK_ERR(*ppDataBlob == nullptr, "Data blob object must be null");
 
-    auto SerializeThis = [this](auto& Ser) {
+    const auto CompressedData = (m_Flags & ArchiveFlags::CompressedData) != ArchiveFlags::None;
+
+    // Data blocks in the order they are written to the archive
+    std::vector<ArchiveDataBlock> DataBlocks;
+    {
+        std::vector<Uint8> Scratch;
+
+        auto AddDataBlock = [&](const SerializedData& Data) {
+            DataBlocks.emplace_back(MakeArchiveDataBlock(GetUncompressedData(Data), CompressedData, Scratch));
+        };
+
+        for (const auto& res_it : m_NamedResources)
+        {
+            const auto& ResData = res_it.second;
+
+            AddDataBlock(ResData.Common);
+            for (const auto& DevData : ResData.DeviceSpecific)
+                AddDataBlock(DevData);
+        }
+
+        for (const auto& Shaders : m_DeviceShaders)
+        {
+            for (const auto& Shader : Shaders)
+                AddDataBlock(Shader);
+        }
+    }
+
+    auto SerializeThis = [&](auto& Ser) {
         constexpr auto SerMode    = std::remove_reference<decltype(Ser)>::type::GetMode();
-        const auto     ArchiveSer = ArchiveSerializer<SerMode>{Ser};
+        const auto     ArchiveSer = ArchiveSerializer<SerMode>{Ser, CompressedData};
 
         ArchiveHeader Header;
         Header.ContentVersion = m_ContentVersion;
+        Header.Flags          = m_Flags;
 
         auto res = ArchiveSer.SerializeHeader(Header);
         VERIFY(res, "Failed to serialize header");
@@ -236,6 +438,8 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
         res                 = Ser(NumResources);
         VERIFY(res, "Failed to serialize the number of resources");
 
+        // Index
+        size_t BlockIdx = 0;
         for (const auto& res_it : m_NamedResources)
         {
             const auto* Name    = res_it.first.GetName();
@@ -244,14 +448,34 @@ void DeviceObjectArchive::Serialize(IDataBlob** ppDataBlob) const
             res = Ser(ResType, Name);
             VERIFY(res, "Failed to serialize resource type and name");
 
-            res = ArchiveSer.SerializeResourceData(res_it.second);
-            VERIFY(res, "Failed to serialize resource data");
+            // Common data followed by device-specific data
+            for (size_t i = 0; i < 1 + res_it.second.DeviceSpecific.size(); ++i)
+            {
+                res = ArchiveSer.SerializeDataSize(DataBlocks[BlockIdx++]);
+                VERIFY(res, "Failed to serialize resource data size");
+            }
+        }
+
+        for (const auto& Shaders : m_DeviceShaders)
+        {
+            const auto NumShaders = StaticCast<Uint32>(Shaders.size());
+
+            res = Ser(NumShaders);
+            VERIFY(res, "Failed to serialize the number of shaders");
+
+            for (size_t i = 0; i < Shaders.size(); ++i)
+            {
+                res = ArchiveSer.SerializeDataSize(DataBlocks[BlockIdx++]);
+                VERIFY(res, "Failed to serialize shader data size");
+            }
         }
+        VERIFY_EXPR(BlockIdx == DataBlocks.size());
 
-        for (auto& Shaders : m_DeviceShaders)
+        // Data blocks in the same order as in the index
+        for (const auto& Block : DataBlocks)
         {
-            res = ArchiveSer.SerializeShaders(Shaders);
-            VERIFY(res, "Failed to serialize shaders");
+            res = ArchiveSer.SerializeDataBlock(Block);
+            VERIFY(res, "Failed to serialize data block");
         }
     };
 
@@ -341,7 +565,7 @@ const SerializedData& DeviceObjectArchive::GetDeviceSpecificData(ResourceType Ty
         return NullData;
     }
     VERIFY_EXPR(SafeStrEqual(Name, it->first.GetName()));
-    return it->second.DeviceSpecific[static_cast<size_t>(DevType)];
+    return GetUncompressedData(it->second.DeviceSpecific[static_cast<size_t>(DevType)]);
 }
 
 std::string DeviceObjectArchive::ToString() const
@@ -357,7 +581,8 @@ std::string DeviceObjectArchive::ToString() const
     {
         Output << "Header\n"
                << Ident1 << "Archive version: " << ArchiveVersion << '\n'
-               << Ident1 << "Content version: " << m_ContentVersion << '\n';
+               << Ident1 << "Content version: " << m_ContentVersion << '\n'
+               << Ident1 << "Compressed data: " << ((m_Flags & ArchiveFlags::CompressedData) != ArchiveFlags::None ? "yes" : "no") << '\n';
     }
 
     constexpr char CommonDataName[] = "Common";
@@ -404,7 +629,7 @@ std::string DeviceObjectArchive::ToString() const
                 Output << Ident1 << it.first.GetName() << '\n';
                 // ..Test PRS
 
-                const auto& Res = it.second;
+                const auto& Res = GetUncompressedData(it.second);
 
                 auto   MaxSize       = Res.Common.Size();
                 size_t MaxDevNameLen = strlen(CommonDataName);
@@ -474,8 +699,10 @@ std::string DeviceObjectArchive::ToString() const
 
                 size_t MaxSize    = 0;
                 size_t MaxNameLen = 0;
-                for (const auto& ShaderData : Shaders)
+                for (const auto& Shader : Shaders)
                 {
+                    const auto& ShaderData = GetUncompressedData(Shader);
+
                     MaxSize = std::max(MaxSize, ShaderData.Size());
 
                     ShaderCreateInfo                 ShaderCI;
@@ -506,6 +733,8 @@ std::string DeviceObjectArchive::ToString() const
 
 void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
 {
+    DecompressAllBlocks();
+
     for (auto& res_it : m_NamedResources)
         res_it.second.DeviceSpecific[static_cast<size_t>(Dev)] = {};
 
@@ -514,6 +743,8 @@ void DeviceObjectArchive::RemoveDeviceData(DeviceType Dev) noexcept(false)
 
 void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, DeviceType Dev) noexcept(false)
 {
+    DecompressAllBlocks();
+
     auto& Allocator = GetRawAllocator();
     for (auto& dst_res_it : m_NamedResources)
     {
@@ -525,7 +756,7 @@ void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, Devic
         if (src_res_it == Src.m_NamedResources.end())
             continue;
 
-        const auto& SrcData{src_res_it->second.DeviceSpecific[static_cast<size_t>(Dev)]};
+        const auto& SrcData = Src.GetUncompressedData(src_res_it->second.DeviceSpecific[static_cast<size_t>(Dev)]);
         // Always copy src data even if it is empty
         DstData = SrcData.MakeCopy(Allocator);
     }
@@ -535,7 +766,7 @@ void DeviceObjectArchive::AppendDeviceData(const DeviceObjectArchive& Src, Devic
     auto&       DstShaders = m_DeviceShaders[static_cast<size_t>(Dev)];
     DstShaders.clear();
     for (const auto& SrcShader : SrcShaders)
-        DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
+        DstShaders.emplace_back(Src.GetUncompressedData(SrcShader).MakeCopy(Allocator));
 }
 
 void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
@@ -545,6 +776,8 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
 
     static_assert(static_cast<size_t>(ResourceType::Count) == 8, "Did you add a new resource type? You may need to handle it here.");
 
+    DecompressAllBlocks();
+
     auto&                  Allocator = GetRawAllocator();
     DynamicLinearAllocator DynAllocator{Allocator, 512};
 
@@ -559,7 +792,7 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
             continue;
         DstShaders.reserve(DstShaders.size() + SrcShaders.size());
         for (const auto& SrcShader : SrcShaders)
-            DstShaders.emplace_back(SrcShader.MakeCopy(Allocator));
+            DstShaders.emplace_back(Src.GetUncompressedData(SrcShader).MakeCopy(Allocator));
     }
 
     // Copy named resources
@@ -568,11 +801,13 @@ void DeviceObjectArchive::Merge(const DeviceObjectArchive& Src) noexcept(false)
         const auto  ResType = src_res_it.first.GetType();
         const auto* ResName = src_res_it.first.GetName();
 
-        auto it_inserted = m_NamedResources.emplace(NamedResourceKey{ResType, ResName, /*CopyName = */ true}, src_res_it.second.MakeCopy(Allocator));
+        const auto& SrcData = Src.GetUncompressedData(src_res_it.second);
+
+        auto it_inserted = m_NamedResources.emplace(NamedResourceKey{ResType, ResName, /*CopyName = */ true}, SrcData.MakeCopy(Allocator));
         if (!it_inserted.second)
         {
             // Silently skip duplicate resources
-            if (it_inserted.first->second != src_res_it.second)
+            if (it_inserted.first->second != SrcData)
                 LOG_WARNING_MESSAGE("Failed to copy resource '", ResName, "': resource with the same name already exists.");
 
             continue;
@@ -31,6 +31,7 @@
 
 #include "EngineMemory.h"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "ScratchArena.hpp"
 #include "DebugUtilities.hpp"
 
 namespace Diligent
@@ -63,6 +64,15 @@ IMemoryAllocator& GetStringAllocator()
     return GetRawAllocator();
 }
 
+ScratchArena& GetThreadScratchArena()
+{
+    // The arena is destroyed when the thread exits, which may happen after the engine and the
+    // user-provided raw allocator are gone. The default allocator outlives all threads that
+    // use the engine, so the pages are always released to it.
+    static thread_local ScratchArena Arena{DefaultRawMemoryAllocator::GetAllocator()};
+    return Arena;
+}
+
 } // namespace Diligent
 #if 0
 
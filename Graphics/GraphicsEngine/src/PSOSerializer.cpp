@@ -377,61 +377,29 @@ bool RPSerializer<Mode>::SerializeDesc(
                            [&Allocator](Serializer<Mode>&       Ser,
                                         ConstQual<SubpassDesc>& Subpass) //
                            {
-                               auto SerializeAttachmentRef = [](Serializer<Mode>&               Ser,
-                                                                ConstQual<AttachmentReference>& AttachRef) //
-                               {
-                                   return Ser(AttachRef.AttachmentIndex,
-                                              AttachRef.State);
-                               };
-
-                               if (!Ser.SerializeArray(Allocator, Subpass.pInputAttachments, Subpass.InputAttachmentCount, SerializeAttachmentRef))
+                               if (!Ser.SerializeArrayRaw(Allocator, Subpass.pInputAttachments, Subpass.InputAttachmentCount))
                                    return false;
-                               if (!Ser.SerializeArray(Allocator, Subpass.pRenderTargetAttachments, Subpass.RenderTargetAttachmentCount, SerializeAttachmentRef))
+                               if (!Ser.SerializeArrayRaw(Allocator, Subpass.pRenderTargetAttachments, Subpass.RenderTargetAttachmentCount))
                                    return false;
 
                                // Note: in Read mode, ResolveAttachCount, DepthStencilAttachCount, and ShadingRateAttachCount will be overwritten
                                Uint32 ResolveAttachCount = Subpass.pResolveAttachments != nullptr ? Subpass.RenderTargetAttachmentCount : 0;
-                               if (!Ser.SerializeArray(Allocator, Subpass.pResolveAttachments, ResolveAttachCount, SerializeAttachmentRef))
+                               if (!Ser.SerializeArrayRaw(Allocator, Subpass.pResolveAttachments, ResolveAttachCount))
                                    return false;
 
                                Uint32 DepthStencilAttachCount = Subpass.pDepthStencilAttachment != nullptr ? 1 : 0;
-                               if (!Ser.SerializeArray(Allocator, Subpass.pDepthStencilAttachment, DepthStencilAttachCount, SerializeAttachmentRef))
+                               if (!Ser.SerializeArrayRaw(Allocator, Subpass.pDepthStencilAttachment, DepthStencilAttachCount))
                                    return false;
 
-
-                               if (!Ser.SerializeArray(Allocator, Subpass.pPreserveAttachments, Subpass.PreserveAttachmentCount,
-                                                       [](Serializer<Mode>&  Ser,
-                                                          ConstQual<Uint32>& Attach) //
-                                                       {
-                                                           return Ser(Attach);
-                                                       }))
+                               if (!Ser.SerializeArrayRaw(Allocator, Subpass.pPreserveAttachments, Subpass.PreserveAttachmentCount))
                                    return false;
 
                                Uint32 ShadingRateAttachCount = Subpass.pShadingRateAttachment != nullptr ? 1 : 0;
-                               return Ser.SerializeArray(Allocator, Subpass.pShadingRateAttachment, ShadingRateAttachCount,
-                                                         [](Serializer<Mode>&                 Ser,
-                                                            ConstQual<ShadingRateAttachment>& SRAttachment) //
-                                                         {
-                                                             return Ser(SRAttachment.Attachment.AttachmentIndex,
-                                                                        SRAttachment.Attachment.State,
-                                                                        SRAttachment.TileSize);
-                                                         });
+                               return Ser.SerializeArrayRaw(Allocator, Subpass.pShadingRateAttachment, ShadingRateAttachCount);
                            });
     if (!res) return false;
 
-    res =
-        Ser.SerializeArray(Allocator, RPDesc.pDependencies, RPDesc.DependencyCount,
-                           [](Serializer<Mode>&                 Ser,
-                              ConstQual<SubpassDependencyDesc>& Dep) //
-                           {
-                               return Ser(Dep.SrcSubpass,
-                                          Dep.DstSubpass,
-                                          Dep.SrcStageMask,
-                                          Dep.DstStageMask,
-                                          Dep.SrcAccessMask,
-                                          Dep.DstAccessMask);
-                           });
-    return res;
+    return Ser.SerializeArrayRaw(Allocator, RPDesc.pDependencies, RPDesc.DependencyCount);
 
     ASSERT_SIZEOF64(RenderPassDesc, 56, "Did you add a new member to RenderPassDesc? Please add serialization here.");
     ASSERT_SIZEOF64(SubpassDesc, 72, "Did you add a new member to SubpassDesc? Please add serialization here.");
@@ -27,10 +27,10 @@
 
 #include "PipelineResourceSignatureBase.hpp"
 
-#include <unordered_map>
-
 #include "HashUtils.hpp"
 #include "StringTools.hpp"
+#include "EngineMemory.h"
+#include "ScratchArena.hpp"
 
 namespace Diligent
 {
@@ -63,8 +63,12 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
         LOG_PRS_ERROR_AND_THROW("Desc.UseCombinedTextureSamplers is true, but Desc.CombinedSamplerSuffix is null or empty");
 
 
+    // All temporary containers allocate memory from the thread's scratch arena
+    ScratchArena::Scope Scratch{GetThreadScratchArena()};
+
     // Hash map of all resources by name
-    std::unordered_multimap<HashMapStringKey, const PipelineResourceDesc&> Resources;
+    ScratchUnorderedMultimap<HashMapStringKey, const PipelineResourceDesc&> Resources{Scratch.GetSTDAllocator()};
+    Resources.reserve(Desc.NumResources);
     for (Uint32 i = 0; i < Desc.NumResources; ++i)
     {
         const auto& Res = Desc.Resources[i];
@@ -158,7 +162,8 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
     }
 
     // Hash map of all immutable samplers by name
-    std::unordered_multimap<HashMapStringKey, const ImmutableSamplerDesc&> ImtblSamplers;
+    ScratchUnorderedMultimap<HashMapStringKey, const ImmutableSamplerDesc&> ImtblSamplers{Scratch.GetSTDAllocator()};
+    ImtblSamplers.reserve(Desc.NumImmutableSamplers);
     for (Uint32 i = 0; i < Desc.NumImmutableSamplers; ++i)
     {
         const auto& SamDesc = Desc.ImmutableSamplers[i];
@@ -200,9 +205,13 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
         VERIFY_EXPR(Desc.CombinedSamplerSuffix != nullptr);
 
         // List of samplers assigned to some texture
-        std::unordered_multimap<HashMapStringKey, SHADER_TYPE> AssignedSamplers;
+        ScratchUnorderedMultimap<HashMapStringKey, SHADER_TYPE> AssignedSamplers{Scratch.GetSTDAllocator()};
         // List of immutable samplers assigned to some texture
-        std::unordered_multimap<HashMapStringKey, SHADER_TYPE> AssignedImtblSamplers;
+        ScratchUnorderedMultimap<HashMapStringKey, SHADER_TYPE> AssignedImtblSamplers{Scratch.GetSTDAllocator()};
+        // Name of the sampler assigned to the current texture
+        ScratchVector<Char> AssignedSamplerName{Scratch.GetSTDAllocator()};
+
+        const auto SuffixLen = strlen(Desc.CombinedSamplerSuffix);
         for (Uint32 i = 0; i < Desc.NumResources; ++i)
         {
             const auto& Res = Desc.Resources[i];
@@ -213,13 +222,14 @@ void ValidatePipelineResourceSignatureDesc(const PipelineResourceSignatureDesc&
             }
 
             {
-                const auto AssignedSamplerName = String{Res.Name} + Desc.CombinedSamplerSuffix;
+                AssignedSamplerName.assign(Res.Name, Res.Name + strlen(Res.Name));
+                AssignedSamplerName.insert(AssignedSamplerName.end(), Desc.CombinedSamplerSuffix, Desc.CombinedSamplerSuffix + SuffixLen + 1);
 
-                const auto sam_range = Resources.equal_range(AssignedSamplerName.c_str());
+                const auto sam_range = Resources.equal_range(AssignedSamplerName.data());
                 for (auto sam_it = sam_range.first; sam_it != sam_range.second; ++sam_it)
                 {
                     const auto& Sam = sam_it->second;
-                    VERIFY_EXPR(AssignedSamplerName == Sam.Name);
+                    VERIFY_EXPR(strcmp(AssignedSamplerName.data(), Sam.Name) == 0);
 
                     if ((Sam.ShaderStages & Res.ShaderStages) != 0)
                     {
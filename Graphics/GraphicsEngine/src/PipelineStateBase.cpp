@@ -262,8 +262,10 @@ void ValidatePipelineResourceSignatures(const PipelineStateCreateInfo& CreateInf
         const ImmutableSamplerDesc&       Desc;
     };
 
-    std::unordered_multimap<HashMapStringKey, ResourceInfo> AllResources;
-    std::unordered_multimap<HashMapStringKey, ImtblSamInfo> AllImtblSamplers;
+    ScratchArena::Scope Scratch{GetThreadScratchArena()};
+
+    ScratchUnorderedMultimap<HashMapStringKey, ResourceInfo> AllResources{Scratch.GetSTDAllocator()};
+    ScratchUnorderedMultimap<HashMapStringKey, ImtblSamInfo> AllImtblSamplers{Scratch.GetSTDAllocator()};
 
     std::array<const IPipelineResourceSignature*, MAX_RESOURCE_SIGNATURES> ppSignatures = {};
     for (Uint32 i = 0; i < CreateInfo.ResourceSignaturesCount; ++i)
@@ -463,8 +465,11 @@ void ValidatePipelineResourceSignatures(const PipelineStateCreateInfo& CreateInf
 void ValidatePipelineResourceLayoutDesc(const PipelineStateDesc& PSODesc, const DeviceFeatures& Features) noexcept(false)
 {
     const auto& Layout = PSODesc.ResourceLayout;
+
+    ScratchArena::Scope Scratch{GetThreadScratchArena()};
     {
-        std::unordered_multimap<HashMapStringKey, SHADER_TYPE> UniqueVariables;
+        ScratchUnorderedMultimap<HashMapStringKey, SHADER_TYPE> UniqueVariables{Scratch.GetSTDAllocator()};
+        UniqueVariables.reserve(Layout.NumVariables);
         for (Uint32 i = 0; i < Layout.NumVariables; ++i)
         {
             const auto& Var = Layout.Variables[i];
@@ -502,7 +507,8 @@ void ValidatePipelineResourceLayoutDesc(const PipelineStateDesc& PSODesc, const
         }
     }
     {
-        std::unordered_multimap<HashMapStringKey, SHADER_TYPE> UniqueSamplers;
+        ScratchUnorderedMultimap<HashMapStringKey, SHADER_TYPE> UniqueSamplers{Scratch.GetSTDAllocator()};
+        UniqueSamplers.reserve(Layout.NumImmutableSamplers);
         for (Uint32 i = 0; i < Layout.NumImmutableSamplers; ++i)
         {
             const auto& Sam = Layout.ImmutableSamplers[i];
@@ -717,7 +723,9 @@ void ValidateRayTracingPipelineCreateInfo(const IRenderDevice*
                                 ") exceeds device limit (", RTProps.MaxRecursionDepth, ").");
     }
 
-    std::unordered_set<HashMapStringKey> GroupNames;
+    ScratchArena::Scope Scratch{GetThreadScratchArena()};
+
+    ScratchUnorderedSet<HashMapStringKey> GroupNames{Scratch.GetSTDAllocator()};
 
     auto VerifyShaderGroupName = [&](const char* MemberName, // "pGeneralShaders", "pTriangleHitShaders", or "pProceduralHitShaders"
                                      Uint32      GroupInd,
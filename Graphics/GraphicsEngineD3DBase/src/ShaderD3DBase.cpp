@@ -37,7 +37,7 @@
 #include "dxc/dxcapi.h"
 
 #include "D3DErrors.hpp"
-#include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderD3DBase.hpp"
 #include "DXCompiler.hpp"
@@ -70,10 +70,9 @@ public:
             return E_FAIL;
         }
 
-        auto pFileData = DataBlobImpl::Create();
-        pSourceStream->ReadBlob(pFileData);
-        *ppData = pFileData->GetDataPtr();
-        *pBytes = StaticCast<UINT>(pFileData->GetSize());
+        auto pFileData = ReadFileStreamData(pSourceStream);
+        *ppData        = pFileData->GetDataPtr();
+        *pBytes        = StaticCast<UINT>(pFileData->GetSize());
 
         m_DataBlobs.insert(std::make_pair(*ppData, pFileData));
 
@@ -53,6 +53,8 @@ static DILIGENT_CONSTEXPR INTERFACE_ID IID_BufferSuballocator =
 struct IBufferSuballocation : public IObject
 {
     /// Returns the start offset of the suballocation, in bytes.
+
+    /// \remarks    The offset changes when the suballocation is moved by IBufferSuballocator::Defragment().
     virtual Uint32 GetOffset() const = 0;
 
     /// Returns the suballocation size, in bytes.
@@ -103,12 +105,29 @@ struct BufferSuballocatorUsageStats
     /// The current number of allocations.
     Uint32 AllocationCount = 0;
 
+    /// The total size of all free chunks in the buffer, in bytes.
+    Uint64 FreeSize = 0;
+
+    /// The number of free chunks in the buffer.
+    Uint32 FreeChunkCount = 0;
+
+    /// Free space fragmentation, in range [0, 1].
+
+    /// The fraction of the free space that is not in the largest free chunk,
+    /// i.e. 1 - MaxFreeChunkSize / FreeSize. Zero means that all free space is
+    /// contiguous. When stats of several suballocators are accumulated, this is
+    /// the maximum fragmentation.
+    float Fragmentation = 0;
+
     BufferSuballocatorUsageStats& operator+=(const BufferSuballocatorUsageStats& rhs)
     {
         CommittedSize += rhs.CommittedSize;
         UsedSize += rhs.UsedSize;
         MaxFreeChunkSize = std::max(MaxFreeChunkSize, rhs.MaxFreeChunkSize);
         AllocationCount += rhs.AllocationCount;
+        FreeSize += rhs.FreeSize;
+        FreeChunkCount += rhs.FreeChunkCount;
+        Fragmentation = std::max(Fragmentation, rhs.Fragmentation);
         return *this;
     }
 };
@@ -154,8 +173,39 @@ struct IBufferSuballocator : public IObject
 
 
     /// Returns the internal buffer version. The version is incremented every time
-    /// the buffer is expanded.
+    /// the buffer is expanded or allocations are moved by Defragment().
     virtual Uint32 GetVersion() const = 0;
+
+
+    /// Performs an incremental defragmentation step.
+
+    /// \param[in]  pDevice        - A pointer to the render device that will be used to
+    ///                              create the intermediate copy buffer, if necessary.
+    /// \param[in]  pContext       - A pointer to the device context that will be used to
+    ///                              record the copy commands.
+    /// \param[in]  MaxBytesToMove - The maximum number of bytes to move in this step.
+    ///                              If zero, the number of bytes is not limited.
+    ///
+    /// \return     The number of bytes moved by this step. Zero indicates that no
+    ///             allocation can be moved to a lower offset.
+    ///
+    /// \remarks    A defragmentation pass starts with a relocation plan that orders live allocations
+    ///             from the end of the buffer towards the beginning. Every step takes allocations from the
+    ///             plan and moves each one to the lowest free chunk that can hold it, until the byte budget
+    ///             is exhausted. At least one allocation is moved by a step that moves anything, even if it
+    ///             is larger than the budget. When the plan is exhausted, the next step starts a new pass.
+    ///
+    ///             The copy commands are recorded in pContext, after which the offsets of all allocations
+    ///             moved by the step are updated at once and the buffer version is incremented. Commands
+    ///             recorded in pContext afterwards see the data at the new offsets. The application must
+    ///             re-query offsets of the allocations when the version changes, and must not execute
+    ///             previously recorded deferred command lists that reference the old offsets.
+    ///
+    ///             The method must be called from the thread that calls Update(). Allocate() and releasing
+    ///             suballocations may be performed by other threads simultaneously.
+    virtual Uint64 Defragment(IRenderDevice*  pDevice,
+                              IDeviceContext* pContext,
+                              Uint64          MaxBytesToMove) = 0;
 };
 
 /// Buffer suballocator create information.
@@ -185,6 +235,15 @@ struct BufferSuballocatorCreateInfo
     ///             to true, the validation is disabled.
     ///             The flag is ignored in release builds as the validation is always disabled.
     bool DisableDebugValidation = false;
+
+    /// Whether to manage free space using the two-level segregated fit (TLSF) lists.
+
+    /// \remarks    By default, free blocks are kept in ordered maps, and the smallest suitable
+    ///             block is used for every allocation, which takes O(log n) time. When this flag
+    ///             is set to true, allocation and deallocation take constant time and do not
+    ///             allocate memory in steady state, at the cost of slightly higher fragmentation.
+    ///             This is preferable when the suballocator is used for many short-lived allocations.
+    bool UseTLSF = false;
 };
 
 /// Creates a new buffer suballocator.
@@ -140,6 +140,40 @@ public:
                     IDeviceContext* pContext);
 
 
+    /// Describes a region of the buffer to copy to another location within the same buffer.
+    struct RegionCopy
+    {
+        /// Offset of the source region, in bytes.
+        Uint64 SrcOffset = 0;
+
+        /// Offset of the destination region, in bytes.
+        Uint64 DstOffset = 0;
+
+        /// The region size, in bytes.
+        Uint64 Size = 0;
+    };
+
+    /// Copies regions of the buffer to other locations within the same buffer.
+
+    /// \param[in] pDevice   - Render device that will be used to create the intermediate buffer,
+    ///                        if necessary.
+    /// \param[in] pContext  - Device context that will be used to record the copy commands.
+    /// \param[in] pCopies   - A pointer to the array of NumCopies region copies.
+    /// \param[in] NumCopies - The number of copies.
+    ///
+    /// \remarks    Copies within the same buffer are not supported by all backends, so the regions
+    ///             are first copied to an intermediate buffer, and then to their destinations.
+    ///             The intermediate buffer is large enough to hold all regions of the call and is
+    ///             kept for subsequent calls.
+    ///
+    ///             No source region may overlap any destination region.
+    ///             The buffer must not have pending updates (see PendingUpdate()).
+    void CopyRegions(IRenderDevice*    pDevice,
+                     IDeviceContext*   pContext,
+                     const RegionCopy* pCopies,
+                     Uint32            NumCopies);
+
+
     /// Returns a pointer to the buffer object.
     ///
     /// \remarks    If the buffer has not been initialized, the method returns null.
@@ -215,6 +249,9 @@ private:
 
     RefCntAutoPtr<IFence> m_pBeforeResizeFence;
     RefCntAutoPtr<IFence> m_pAfterResizeFence;
+
+    // Intermediate buffer used by CopyRegions()
+    RefCntAutoPtr<IBuffer> m_pCopyBuffer;
 };
 
 } // namespace Diligent
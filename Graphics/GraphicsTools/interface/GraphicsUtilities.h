@@ -70,7 +70,13 @@ DILIGENT_TYPED_ENUM(MIP_FILTER_TYPE, Uint8)
     /// Use the most frequent element from the 2x2 box.
     /// This filter does not introduce new values and should be used
     /// for integer textures that contain non-filterable data (e.g. indices).
-    MIP_FILTER_TYPE_MOST_FREQUENT
+    MIP_FILTER_TYPE_MOST_FREQUENT,
+
+    /// Kaiser-windowed sinc filter with 8x8 footprint.
+    /// The filter preserves more detail than the box filter.
+    /// It is supported for 8-bit UNORM, 8-bit sRGB and 32-bit float formats.
+    /// Other formats use the box filter.
+    MIP_FILTER_TYPE_KAISER
 };
 
 
@@ -138,6 +144,97 @@ typedef struct ComputeMipLevelAttribs ComputeMipLevelAttribs;
 void DILIGENT_GLOBAL_FUNCTION(ComputeMipLevel)(const ComputeMipLevelAttribs REF Attribs);
 
 
+// clang-format off
+
+/// ComputeMipChain function attributes
+struct ComputeMipChainAttribs
+{
+    /// Texture format.
+    TEXTURE_FORMAT Format            DEFAULT_INITIALIZER(TEX_FORMAT_UNKNOWN);
+
+    /// Base mip level width.
+    Uint32 Width                     DEFAULT_INITIALIZER(0);
+
+    /// Base mip level height.
+    Uint32 Height                    DEFAULT_INITIALIZER(0);
+
+    /// Pointer to the base mip level data.
+    const void* pBaseMipData         DEFAULT_INITIALIZER(nullptr);
+
+    /// Base mip level data stride, in bytes.
+    size_t BaseMipStride             DEFAULT_INITIALIZER(0);
+
+    /// The number of coarse mip levels to compute.
+    Uint32 NumCoarseMips             DEFAULT_INITIALIZER(0);
+
+    /// An array of NumCoarseMips pointers to the coarse mip level data.
+    /// Element i receives mip level i + 1.
+    void* const* ppCoarseMipData     DEFAULT_INITIALIZER(nullptr);
+
+    /// An array of NumCoarseMips coarse mip level data strides, in bytes.
+    const size_t* pCoarseMipStrides  DEFAULT_INITIALIZER(nullptr);
+
+    /// Filter type.
+    MIP_FILTER_TYPE FilterType       DEFAULT_INITIALIZER(MIP_FILTER_TYPE_DEFAULT);
+
+    /// Alpha cutoff value, see ComputeMipLevelAttribs::AlphaCutoff.
+    float AlphaCutoff                DEFAULT_INITIALIZER(0);
+
+    /// An optional thread pool that is used to process the rows of large levels in parallel.
+    /// The object must implement the IThreadPool interface (see Common/interface/ThreadPool.hpp).
+    IObject* pThreadPool             DEFAULT_INITIALIZER(nullptr);
+
+    /// The maximum number of tasks every level is split into, including the part that is
+    /// processed by the calling thread. If zero, the number of hardware threads is used.
+    Uint32 NumTasks                  DEFAULT_INITIALIZER(0);
+
+#if DILIGENT_CPP_INTERFACE
+    constexpr ComputeMipChainAttribs() noexcept {}
+
+    constexpr ComputeMipChainAttribs(TEXTURE_FORMAT  _Format,
+                                     Uint32          _Width,
+                                     Uint32          _Height,
+                                     const void*     _pBaseMipData,
+                                     size_t          _BaseMipStride,
+                                     Uint32          _NumCoarseMips,
+                                     void* const*    _ppCoarseMipData,
+                                     const size_t*   _pCoarseMipStrides,
+                                     MIP_FILTER_TYPE _FilterType  = ComputeMipChainAttribs{}.FilterType,
+                                     float           _AlphaCutoff = ComputeMipChainAttribs{}.AlphaCutoff) noexcept :
+        Format            {_Format},
+        Width             {_Width},
+        Height            {_Height},
+        pBaseMipData      {_pBaseMipData},
+        BaseMipStride     {_BaseMipStride},
+        NumCoarseMips     {_NumCoarseMips},
+        ppCoarseMipData   {_ppCoarseMipData},
+        pCoarseMipStrides {_pCoarseMipStrides},
+        FilterType        {_FilterType},
+        AlphaCutoff       {_AlphaCutoff}
+    {}
+#endif
+};
+typedef struct ComputeMipChainAttribs ComputeMipChainAttribs;
+// clang-format on
+
+/// Computes the coarse mip levels of a texture from its base level.
+
+/// \remarks    Every level is computed from the previous one. For 8-bit UNORM, 8-bit sRGB
+///             and 32-bit float formats, the function uses SIMD kernels and optionally
+///             processes the rows of large levels in the thread pool:
+///             - 8-bit UNORM levels computed with the box filter are identical to the levels
+///               produced by calling ComputeMipLevel() for every level.
+///             - sRGB levels and Kaiser-filtered 8-bit levels are computed in linear
+///               float space from the unquantized values of the previous level.
+///
+///             Other formats and the MIP_FILTER_TYPE_MOST_FREQUENT filter are processed
+///             by ComputeMipLevel() level by level.
+///
+///             When the thread pool is used, the function must not be called from
+///             a worker thread of the same pool.
+void DILIGENT_GLOBAL_FUNCTION(ComputeMipChain)(const ComputeMipChainAttribs REF Attribs);
+
+
 /// Creates a sparse texture in Metal backend.
 
 /// \param [in]  pDevice   - A pointer to the render device.
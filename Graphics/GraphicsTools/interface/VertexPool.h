@@ -52,6 +52,8 @@ static DILIGENT_CONSTEXPR INTERFACE_ID IID_VertexPool =
 struct IVertexPoolAllocation : public IObject
 {
     /// Returns the start vertex of the allocation.
+
+    /// \remarks    The start vertex changes when the allocation is moved by IVertexPool::Defragment().
     virtual Uint32 GetStartVertex() const = 0;
 
     /// Returns the number of vertices in the allocation.
@@ -105,6 +107,20 @@ struct VertexPoolUsageStats
     /// The number of allocations.
     Uint32 AllocationCount = 0;
 
+    /// The number of vertices in the largest free range.
+    Uint64 MaxFreeRangeSize = 0;
+
+    /// The number of free vertex ranges.
+    Uint32 FreeRangeCount = 0;
+
+    /// Free space fragmentation, in range [0, 1].
+
+    /// The fraction of free vertices that are not in the largest free range,
+    /// i.e. 1 - MaxFreeRangeSize / (TotalVertexCount - AllocatedVertexCount).
+    /// Zero means that all free vertices are contiguous. When stats of several
+    /// pools are accumulated, this is the maximum fragmentation.
+    float Fragmentation = 0;
+
     VertexPoolUsageStats& operator+=(const VertexPoolUsageStats& RHS)
     {
         TotalVertexCount += RHS.TotalVertexCount;
@@ -112,6 +128,9 @@ struct VertexPoolUsageStats
         CommittedMemorySize += RHS.CommittedMemorySize;
         UsedMemorySize += RHS.UsedMemorySize;
         AllocationCount += RHS.AllocationCount;
+        MaxFreeRangeSize = std::max(MaxFreeRangeSize, RHS.MaxFreeRangeSize);
+        FreeRangeCount += RHS.FreeRangeCount;
+        Fragmentation = std::max(Fragmentation, RHS.Fragmentation);
         return *this;
     }
 };
@@ -254,11 +273,35 @@ struct IVertexPool : public IObject
     virtual void GetUsageStats(VertexPoolUsageStats& UsageStats) = 0;
 
     /// Returns the internal buffer version. The version is incremented every time
-    /// any internal buffer is recreated.
+    /// any internal buffer is recreated or allocations are moved by Defragment().
     virtual Uint32 GetVersion() const = 0;
 
     /// Returns the pool description.
     virtual const VertexPoolDesc& GetDesc() const = 0;
+
+
+    /// Performs an incremental defragmentation step.
+
+    /// \param[in]  pDevice        - A pointer to the render device that will be used to
+    ///                              create intermediate copy buffers, if necessary.
+    /// \param[in]  pContext       - A pointer to the device context that will be used to
+    ///                              record the copy commands.
+    /// \param[in]  MaxBytesToMove - The maximum number of bytes to move in this step, in all
+    ///                              buffers. If zero, the number of bytes is not limited.
+    ///
+    /// \return     The number of bytes moved by this step. Zero indicates that no
+    ///             allocation can be moved to a lower start vertex.
+    ///
+    /// \remarks    The method works the same way as IBufferSuballocator::Defragment():
+    ///             allocations are moved from the end of the pool to the lowest free ranges that
+    ///             can hold them, their start vertices are updated once the copy commands are
+    ///             recorded in pContext, and the pool version is incremented.
+    ///
+    ///             The method must be called from the thread that calls Update(). Allocate() and releasing
+    ///             allocations may be performed by other threads simultaneously.
+    virtual Uint64 Defragment(IRenderDevice*  pDevice,
+                              IDeviceContext* pContext,
+                              Uint64          MaxBytesToMove) = 0;
 };
 
 
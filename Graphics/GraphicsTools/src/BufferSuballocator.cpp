@@ -29,6 +29,8 @@
 
 #include <mutex>
 #include <atomic>
+#include <vector>
+#include <algorithm>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
@@ -52,13 +54,15 @@ public:
                             BufferSuballocatorImpl*                      pParentAllocator,
                             Uint32                                       Offset,
                             Uint32                                       Size,
+                            Uint32                                       Alignment,
                             VariableSizeAllocationsManager::Allocation&& Subregion) :
         // clang-format off
         TBase             {pRefCounters},
         m_pParentAllocator{pParentAllocator},
         m_Subregion       {std::move(Subregion)},
         m_Offset          {Offset},
-        m_Size            {Size}
+        m_Size            {Size},
+        m_Alignment       {Alignment}
     // clang-format on
     {
         VERIFY_EXPR(m_pParentAllocator);
@@ -83,7 +87,7 @@ public:
 
     virtual Uint32 GetOffset() const override final
     {
-        return m_Offset;
+        return m_Offset.load();
     }
 
     virtual Uint32 GetSize() const override final
@@ -108,12 +112,28 @@ public:
     }
 
 private:
+    friend class BufferSuballocatorImpl;
+
     RefCntAutoPtr<BufferSuballocatorImpl> m_pParentAllocator;
 
+    // The subregion and the links are protected by the parent allocator mutex
     VariableSizeAllocationsManager::Allocation m_Subregion;
 
-    const Uint32 m_Offset;
-    const Uint32 m_Size;
+    std::atomic<Uint32> m_Offset;
+    const Uint32        m_Size;
+    const Uint32        m_Alignment;
+
+    // Links in the list of live suballocations
+    BufferSuballocationImpl* m_pPrev = nullptr;
+    BufferSuballocationImpl* m_pNext = nullptr;
+
+    // Index in the defragmentation plan
+    static constexpr size_t InvalidDefragPlanIdx = ~size_t{0};
+    size_t                  m_DefragPlanIdx      = InvalidDefragPlanIdx;
+
+    // Index in the list of relocations of the running defragmentation step
+    static constexpr size_t InvalidRelocationIdx = ~size_t{0};
+    size_t                  m_RelocationIdx      = InvalidRelocationIdx;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
@@ -148,6 +168,7 @@ public:
                 DefaultRawMemoryAllocator::GetAllocator(),
                 StaticCast<size_t>(CreateInfo.Desc.Size),
                 CreateInfo.DisableDebugValidation,
+                CreateInfo.UseTLSF ? VariableSizeAllocationsManager::Mode::TLSF : VariableSizeAllocationsManager::Mode::BestFit,
             },
         },
         m_MgrSize{m_Mgr.GetMaxSize()},
@@ -217,7 +238,7 @@ public:
 
         DEV_CHECK_ERR(*ppSuballocation == nullptr, "Overwriting reference to existing object may cause memory leaks");
 
-        VariableSizeAllocationsManager::Allocation Subregion;
+        BufferSuballocationImpl* pSuballocation = nullptr;
         {
             std::lock_guard<std::mutex> Lock{m_MgrMtx};
 
@@ -234,7 +255,7 @@ public:
                 }
             }
 
-            Subregion = m_Mgr.Allocate(Size, Alignment);
+            auto Subregion = m_Mgr.Allocate(Size, Alignment);
 
             while (!Subregion.IsValid() && (m_MaxSize == 0 || m_MaxSize > m_Mgr.GetMaxSize()))
             {
@@ -251,39 +272,61 @@ public:
                 Subregion = m_Mgr.Allocate(Size, Alignment);
             }
 
+            if (Subregion.IsValid())
+            {
+                // Create the object under the mutex to add it to the list of live suballocations
+                // clang-format off
+                pSuballocation =
+                    NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
+                    (
+                        this,
+                        AlignUp(static_cast<Uint32>(Subregion.UnalignedOffset), Alignment),
+                        Size,
+                        Alignment,
+                        std::move(Subregion)
+                    );
+                // clang-format on
+
+                pSuballocation->m_pNext = m_pSuballocations;
+                if (m_pSuballocations != nullptr)
+                    m_pSuballocations->m_pPrev = pSuballocation;
+                m_pSuballocations = pSuballocation;
+            }
+
             UpdateUsageStats();
         }
 
-        if (Subregion.IsValid())
+        if (pSuballocation != nullptr)
         {
-            // clang-format off
-            BufferSuballocationImpl* pSuballocation{
-                NEW_RC_OBJ(m_SuballocationsAllocator, "BufferSuballocationImpl instance", BufferSuballocationImpl)
-                (
-                    this,
-                    AlignUp(static_cast<Uint32>(Subregion.UnalignedOffset), Alignment),
-                    Size,
-                    std::move(Subregion)
-                )
-            };
-            // clang-format on
-
             pSuballocation->QueryInterface(IID_BufferSuballocation, reinterpret_cast<IObject**>(ppSuballocation));
             m_AllocationCount.fetch_add(1);
         }
     }
 
-    void Free(VariableSizeAllocationsManager::Allocation&& Subregion)
+    void Free(BufferSuballocationImpl& Suballocation)
     {
         std::lock_guard<std::mutex> Lock{m_MgrMtx};
-        m_Mgr.Free(std::move(Subregion));
+
+        if (Suballocation.m_pPrev != nullptr)
+            Suballocation.m_pPrev->m_pNext = Suballocation.m_pNext;
+        else
+            m_pSuballocations = Suballocation.m_pNext;
+        if (Suballocation.m_pNext != nullptr)
+            Suballocation.m_pNext->m_pPrev = Suballocation.m_pPrev;
+
+        if (Suballocation.m_DefragPlanIdx != BufferSuballocationImpl::InvalidDefragPlanIdx)
+            m_DefragPlan[Suballocation.m_DefragPlanIdx] = nullptr;
+        if (Suballocation.m_RelocationIdx != BufferSuballocationImpl::InvalidRelocationIdx)
+            m_Relocations[Suballocation.m_RelocationIdx].pSuballocation = nullptr;
+
+        m_Mgr.Free(std::move(Suballocation.m_Subregion));
         m_AllocationCount.fetch_add(-1);
         UpdateUsageStats();
     }
 
     virtual Uint32 GetVersion() const override final
     {
-        return m_Buffer.GetVersion();
+        return m_Buffer.GetVersion() + m_DefragVersion.load();
     }
 
     virtual void GetUsageStats(BufferSuballocatorUsageStats& UsageStats) override final
@@ -293,6 +336,123 @@ public:
         UsageStats.UsedSize         = m_UsedSize.load();
         UsageStats.MaxFreeChunkSize = m_MaxFreeBlockSize.load();
         UsageStats.AllocationCount  = m_AllocationCount.load();
+        UsageStats.FreeSize         = m_FreeSize.load();
+        UsageStats.FreeChunkCount   = m_FreeBlockCount.load();
+        UsageStats.Fragmentation    = UsageStats.FreeSize > 0 ?
+            1.f - static_cast<float>(UsageStats.MaxFreeChunkSize) / static_cast<float>(UsageStats.FreeSize) :
+            0.f;
+    }
+
+    virtual Uint64 Defragment(IRenderDevice*  pDevice,
+                              IDeviceContext* pContext,
+                              Uint64          MaxBytesToMove) override final
+    {
+        if (pDevice == nullptr || pContext == nullptr)
+        {
+            UNEXPECTED("Device and context must not be null");
+            return 0;
+        }
+
+        // Make sure that all allocations are backed by the buffer
+        Update(pDevice, pContext);
+        const auto BufferSize = m_BufferSize.load();
+
+        std::vector<DynamicBuffer::RegionCopy> Copies;
+
+        Uint64 BytesMoved = 0;
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+            VERIFY(m_Relocations.empty(), "Defragment() must not be called by multiple threads simultaneously");
+
+            for (;;)
+            {
+                if (m_DefragPlanPos == m_DefragPlan.size())
+                    PlanDefragmentation();
+
+                while (m_DefragPlanPos < m_DefragPlan.size())
+                {
+                    auto* const pSuballocation = m_DefragPlan[m_DefragPlanPos];
+                    if (pSuballocation != nullptr)
+                    {
+                        if (MaxBytesToMove != 0 && BytesMoved != 0 && BytesMoved + pSuballocation->m_Size > MaxBytesToMove)
+                            break;
+                        pSuballocation->m_DefragPlanIdx = BufferSuballocationImpl::InvalidDefragPlanIdx;
+                    }
+                    ++m_DefragPlanPos;
+
+                    // Skip released suballocations and those that are not in the buffer yet
+                    if (pSuballocation == nullptr ||
+                        pSuballocation->m_Subregion.UnalignedOffset + pSuballocation->m_Subregion.Size > BufferSize)
+                        continue;
+
+                    auto NewSubregion = m_Mgr.AllocateBelow(pSuballocation->m_Size, pSuballocation->m_Alignment, pSuballocation->m_Subregion.UnalignedOffset);
+                    if (!NewSubregion.IsValid())
+                        continue;
+
+                    const auto NewOffset = AlignUp(static_cast<Uint32>(NewSubregion.UnalignedOffset), pSuballocation->m_Alignment);
+
+                    DynamicBuffer::RegionCopy Copy;
+                    Copy.SrcOffset = pSuballocation->m_Offset.load();
+                    Copy.DstOffset = NewOffset;
+                    Copy.Size      = pSuballocation->m_Size;
+                    Copies.push_back(Copy);
+
+                    pSuballocation->m_RelocationIdx = m_Relocations.size();
+                    m_Relocations.push_back({pSuballocation, std::move(NewSubregion), NewOffset});
+                    BytesMoved += pSuballocation->m_Size;
+                    m_DefragPassBytesMoved += pSuballocation->m_Size;
+                }
+
+                if (m_DefragPlanPos < m_DefragPlan.size())
+                    break; // The budget is exhausted
+
+                // The pass is complete
+                const bool RestartPass = BytesMoved == 0 && m_DefragPassBytesMoved != 0;
+                m_DefragPlan.clear();
+                m_DefragPlanPos        = 0;
+                m_DefragPassBytesMoved = 0;
+
+                // Allocations moved by the previous steps may have made room for the allocations
+                // that could not be moved. Start a new pass to only report zero bytes when no
+                // allocation can be moved.
+                if (!RestartPass)
+                    break;
+            }
+        }
+
+        if (Copies.empty())
+            return BytesMoved;
+
+        // Create the intermediate buffer and record the copies without holding the mutex so that
+        // the threads that allocate and release suballocations are not blocked. The new subregions
+        // stay reserved in the manager until the relocations are committed.
+        m_Buffer.CopyRegions(pDevice, pContext, Copies.data(), static_cast<Uint32>(Copies.size()));
+
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+            // All commands recorded after the copies use the new offsets
+            for (auto& Reloc : m_Relocations)
+            {
+                if (Reloc.pSuballocation == nullptr)
+                {
+                    // The suballocation was released while the data was being copied
+                    m_Mgr.Free(std::move(Reloc.NewSubregion));
+                    continue;
+                }
+
+                auto& Suballocation           = *Reloc.pSuballocation;
+                Suballocation.m_RelocationIdx = BufferSuballocationImpl::InvalidRelocationIdx;
+                m_Mgr.Free(std::move(Suballocation.m_Subregion));
+                Suballocation.m_Subregion = std::move(Reloc.NewSubregion);
+                Suballocation.m_Offset.store(Reloc.NewOffset);
+            }
+            m_Relocations.clear();
+            m_DefragVersion.fetch_add(1);
+            UpdateUsageStats();
+        }
+
+        return BytesMoved;
     }
 
 private:
@@ -300,6 +460,24 @@ private:
     {
         m_UsedSize.store(m_Mgr.GetUsedSize());
         m_MaxFreeBlockSize.store(m_Mgr.GetMaxFreeBlockSize());
+        m_FreeSize.store(m_Mgr.GetFreeSize());
+        m_FreeBlockCount.store(static_cast<Uint32>(m_Mgr.GetNumFreeBlocks()));
+    }
+
+    // Orders live suballocations from the end of the buffer towards the beginning
+    void PlanDefragmentation()
+    {
+        VERIFY_EXPR(m_DefragPlan.empty() && m_DefragPlanPos == 0);
+        for (auto* pSuballocation = m_pSuballocations; pSuballocation != nullptr; pSuballocation = pSuballocation->m_pNext)
+            m_DefragPlan.push_back(pSuballocation);
+
+        std::sort(m_DefragPlan.begin(), m_DefragPlan.end(),
+                  [](const BufferSuballocationImpl* pLHS, const BufferSuballocationImpl* pRHS) {
+                      return pLHS->m_Subregion.UnalignedOffset > pRHS->m_Subregion.UnalignedOffset;
+                  });
+
+        for (size_t i = 0; i < m_DefragPlan.size(); ++i)
+            m_DefragPlan[i]->m_DefragPlanIdx = i;
     }
 
 private:
@@ -317,6 +495,29 @@ private:
     std::atomic<Int32>  m_AllocationCount{0};
     std::atomic<Uint64> m_UsedSize{0};
     std::atomic<Uint64> m_MaxFreeBlockSize{0};
+    std::atomic<Uint64> m_FreeSize{0};
+    std::atomic<Uint32> m_FreeBlockCount{0};
+
+    // The list of live suballocations, protected by m_MgrMtx
+    BufferSuballocationImpl* m_pSuballocations = nullptr;
+
+    // Suballocations to move in the current defragmentation pass, protected by m_MgrMtx.
+    // Released suballocations are replaced with null.
+    std::vector<BufferSuballocationImpl*> m_DefragPlan;
+    size_t                                m_DefragPlanPos        = 0;
+    Uint64                                m_DefragPassBytesMoved = 0;
+
+    struct Relocation
+    {
+        BufferSuballocationImpl*                   pSuballocation;
+        VariableSizeAllocationsManager::Allocation NewSubregion;
+        Uint32                                     NewOffset;
+    };
+    // Relocations of the running defragmentation step, protected by m_MgrMtx.
+    // Suballocations released while the data is being copied are replaced with null.
+    std::vector<Relocation> m_Relocations;
+
+    std::atomic<Uint32> m_DefragVersion{0};
 
     FixedBlockMemoryAllocator m_SuballocationsAllocator;
 };
@@ -324,7 +525,7 @@ private:
 
 BufferSuballocationImpl::~BufferSuballocationImpl()
 {
-    m_pParentAllocator->Free(std::move(m_Subregion));
+    m_pParentAllocator->Free(*this);
 }
 
 IBufferSuballocator* BufferSuballocationImpl::GetAllocator()
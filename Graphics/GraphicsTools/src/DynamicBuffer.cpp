@@ -355,4 +355,70 @@ IBuffer* DynamicBuffer::Update(IRenderDevice*  pDevice,
     return m_pBuffer;
 }
 
+void DynamicBuffer::CopyRegions(IRenderDevice*    pDevice,
+                                IDeviceContext*   pContext,
+                                const RegionCopy* pCopies,
+                                Uint32            NumCopies)
+{
+    if (NumCopies == 0)
+        return;
+
+    DEV_CHECK_ERR(pDevice != nullptr && pContext != nullptr, "Device and context must not be null");
+    DEV_CHECK_ERR(pCopies != nullptr, "pCopies must not be null");
+    DEV_CHECK_ERR(m_pBuffer && !PendingUpdate(), "The buffer must be updated before copying regions");
+
+    // Keep the regions in the intermediate buffer 16-byte aligned
+    constexpr Uint64 RegionAlignment = 16;
+
+    Uint64 CopyBufferSize = 0;
+    for (Uint32 i = 0; i < NumCopies; ++i)
+    {
+        const auto& Copy = pCopies[i];
+        DEV_CHECK_ERR(Copy.SrcOffset + Copy.Size <= m_Desc.Size && Copy.DstOffset + Copy.Size <= m_Desc.Size,
+                      "Region copy [", Copy.SrcOffset, ", ", Copy.SrcOffset + Copy.Size, ") -> [", Copy.DstOffset, ", ",
+                      Copy.DstOffset + Copy.Size, ") is out of the buffer bounds (", m_Desc.Size, ")");
+        CopyBufferSize += AlignUp(Copy.Size, RegionAlignment);
+    }
+
+    if (!m_pCopyBuffer || m_pCopyBuffer->GetDesc().Size < CopyBufferSize)
+    {
+        m_pCopyBuffer.Release();
+
+        const std::string Name = m_Name + " - copy buffer";
+
+        auto Desc           = m_Desc;
+        Desc.Name           = Name.c_str();
+        Desc.Usage          = USAGE_DEFAULT;
+        Desc.CPUAccessFlags = CPU_ACCESS_NONE;
+        Desc.MiscFlags      = MISC_BUFFER_FLAG_NONE;
+        Desc.Size           = m_Desc.ElementByteStride != 0 ?
+            AlignUpNonPw2(CopyBufferSize, m_Desc.ElementByteStride) :
+            CopyBufferSize;
+        pDevice->CreateBuffer(Desc, nullptr, &m_pCopyBuffer);
+        DEV_CHECK_ERR(m_pCopyBuffer, "Failed to create the intermediate buffer");
+        if (!m_pCopyBuffer)
+            return;
+    }
+
+    // Copy all regions to the intermediate buffer first, and then to their
+    // destinations, so that each buffer changes its state only twice.
+    Uint64 CopyBufferOffset = 0;
+    for (Uint32 i = 0; i < NumCopies; ++i)
+    {
+        const auto& Copy = pCopies[i];
+        pContext->CopyBuffer(m_pBuffer, Copy.SrcOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             m_pCopyBuffer, CopyBufferOffset, Copy.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        CopyBufferOffset += AlignUp(Copy.Size, RegionAlignment);
+    }
+
+    CopyBufferOffset = 0;
+    for (Uint32 i = 0; i < NumCopies; ++i)
+    {
+        const auto& Copy = pCopies[i];
+        pContext->CopyBuffer(m_pCopyBuffer, CopyBufferOffset, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             m_pBuffer, Copy.DstOffset, Copy.Size, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        CopyBufferOffset += AlignUp(Copy.Size, RegionAlignment);
+    }
+}
+
 } // namespace Diligent
@@ -28,12 +28,16 @@
 #include <algorithm>
 #include <cmath>
 #include <limits>
+#include <thread>
+#include <vector>
 
 #include "GraphicsUtilities.h"
 #include "DebugUtilities.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ColorConversion.h"
 #include "RefCntAutoPtr.hpp"
+#include "ThreadPool.hpp"
+#include "BasicMathSIMD.hpp"
 
 #define PI_F 3.1415926f
 
@@ -328,6 +332,555 @@ void FilterMipLevel(const ComputeMipLevelAttribs& Attribs,
     }
 }
 
+
+namespace
+{
+
+// Returns true if the format is supported by the Kaiser filter
+bool IsKaiserFilterSupported(const TextureFormatAttribs& FmtAttribs)
+{
+    return (FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT && FmtAttribs.ComponentSize == 4) ||
+        ((FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM || FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB) && FmtAttribs.ComponentSize == 1);
+}
+
+MIP_FILTER_TYPE ResolveMipFilterType(MIP_FILTER_TYPE FilterType, const TextureFormatAttribs& FmtAttribs)
+{
+    if (FilterType == MIP_FILTER_TYPE_DEFAULT)
+    {
+        FilterType = FmtAttribs.ComponentType == COMPONENT_TYPE_UINT || FmtAttribs.ComponentType == COMPONENT_TYPE_SINT ?
+            MIP_FILTER_TYPE_MOST_FREQUENT :
+            MIP_FILTER_TYPE_BOX_AVERAGE;
+    }
+    else if (FilterType == MIP_FILTER_TYPE_KAISER && !IsKaiserFilterSupported(FmtAttribs))
+    {
+        FilterType = MIP_FILTER_TYPE_BOX_AVERAGE;
+    }
+    return FilterType;
+}
+
+// Kaiser-windowed sinc filter that reduces the resolution by a factor of two.
+// Coarse texel i is centered between fine texels 2i and 2i+1, and the filter
+// uses fine texels 2i-3 .. 2i+4.
+struct KaiserDownsampleFilter
+{
+    static constexpr int NumTaps  = 8;
+    static constexpr int FirstTap = -3;
+
+    float Weights[NumTaps] = {};
+
+    KaiserDownsampleFilter()
+    {
+        // Filter radius, in coarse texels
+        constexpr double Radius = 2;
+        // Window shape parameter
+        constexpr double Alpha = 4;
+
+        double Sum = 0;
+        double w[NumTaps];
+        for (int t = 0; t < NumTaps; ++t)
+        {
+            // Distance from the fine texel center to the coarse texel center, in coarse texels.
+            const double x = (static_cast<double>(t + FirstTap) - 0.5) * 0.5;
+            const double r = x / Radius;
+
+            const double Sinc   = std::sin(PI * x) / (PI * x);
+            const double Window = BesselI0(Alpha * std::sqrt(std::max(1.0 - r * r, 0.0))) / BesselI0(Alpha);
+
+            w[t] = Sinc * Window;
+            Sum += w[t];
+        }
+        for (int t = 0; t < NumTaps; ++t)
+            Weights[t] = static_cast<float>(w[t] / Sum);
+    }
+
+private:
+    static constexpr double PI = 3.14159265358979323846;
+
+    // Zero-order modified Bessel function of the first kind
+    static double BesselI0(double x)
+    {
+        double Sum  = 1;
+        double Term = 1;
+        for (int k = 1; k < 32; ++k)
+        {
+            const double t = x / (2 * k);
+            Term *= t * t;
+            Sum += Term;
+            if (Term < Sum * 1e-12)
+                break;
+        }
+        return Sum;
+    }
+};
+
+const KaiserDownsampleFilter& GetKaiserDownsampleFilter()
+{
+    static const KaiserDownsampleFilter Filter;
+    return Filter;
+}
+
+// Returns the table that maps 8-bit UNORM or sRGB values to linear float values.
+const float* Get8BitDecodeTable(bool IsSRGB)
+{
+    struct Tables
+    {
+        float Linear[256];
+        float SRGB[256];
+
+        Tables()
+        {
+            for (Uint32 i = 0; i < 256; ++i)
+            {
+                // Use the same math as SRGBAverage
+                const float f = static_cast<float>(i) * (1.f / 255.f);
+                Linear[i]     = f;
+                SRGB[i]       = FastGammaToLinear(f);
+            }
+        }
+    };
+    static const Tables DecodeTables;
+    return IsSRGB ? DecodeTables.SRGB : DecodeTables.Linear;
+}
+
+// Dst[i] = Src0[i] + Src1[i]
+void AddRows(const float* pSrc0, const float* pSrc1, float* pDst, size_t Count)
+{
+    size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    for (; i + 4 <= Count; i += 4)
+        _mm_storeu_ps(pDst + i, _mm_add_ps(_mm_loadu_ps(pSrc0 + i), _mm_loadu_ps(pSrc1 + i)));
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = pSrc0[i] + pSrc1[i];
+}
+
+// Dst[i] = Src[i] * Weight
+void ScaleRow(const float* pSrc, float Weight, float* pDst, size_t Count)
+{
+    size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    const __m128 w = _mm_set1_ps(Weight);
+    for (; i + 4 <= Count; i += 4)
+        _mm_storeu_ps(pDst + i, _mm_mul_ps(_mm_loadu_ps(pSrc + i), w));
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = pSrc[i] * Weight;
+}
+
+// Dst[i] += Src[i] * Weight
+void AccumulateRow(const float* pSrc, float Weight, float* pDst, size_t Count)
+{
+    size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    const __m128 w = _mm_set1_ps(Weight);
+    for (; i + 4 <= Count; i += 4)
+        _mm_storeu_ps(pDst + i, _mm_add_ps(_mm_loadu_ps(pDst + i), _mm_mul_ps(_mm_loadu_ps(pSrc + i), w)));
+#endif
+    for (; i < Count; ++i)
+        pDst[i] += pSrc[i] * Weight;
+}
+
+// Averages pairs of adjacent texels of the row and multiplies the result by Scale.
+void DownsampleRowBox(const float* pSrc, Uint32 FineWidth, float* pDst, Uint32 CoarseWidth, Uint32 NumChannels, float Scale)
+{
+    Uint32 col = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    if (NumChannels == 4)
+    {
+        const __m128 s = _mm_set1_ps(Scale);
+        for (; col * 2 + 1 < FineWidth && col < CoarseWidth; ++col)
+        {
+            const __m128 t0 = _mm_loadu_ps(pSrc + col * 8);
+            const __m128 t1 = _mm_loadu_ps(pSrc + col * 8 + 4);
+            _mm_storeu_ps(pDst + col * 4, _mm_mul_ps(_mm_add_ps(t0, t1), s));
+        }
+    }
+#endif
+    for (; col < CoarseWidth; ++col)
+    {
+        const Uint32 src_col0 = col * 2;
+        const Uint32 src_col1 = std::min(col * 2 + 1, FineWidth - 1);
+        for (Uint32 c = 0; c < NumChannels; ++c)
+            pDst[col * NumChannels + c] = (pSrc[src_col0 * NumChannels + c] + pSrc[src_col1 * NumChannels + c]) * Scale;
+    }
+}
+
+// Applies the Kaiser filter to the row and reduces its resolution by a factor of two.
+void DownsampleRowKaiser(const float* pSrc, Uint32 FineWidth, float* pDst, Uint32 CoarseWidth, Uint32 NumChannels)
+{
+    constexpr int NumTaps  = KaiserDownsampleFilter::NumTaps;
+    constexpr int FirstTap = KaiserDownsampleFilter::FirstTap;
+
+    const float* Weights = GetKaiserDownsampleFilter().Weights;
+
+    // Columns that don't require clamping
+    const Uint32 FirstInnerCol = (-FirstTap + 1) / 2;
+    const Uint32 EndInnerCol   = FineWidth >= NumTaps + FirstTap ? std::min((FineWidth - (NumTaps + FirstTap)) / 2 + 1, CoarseWidth) : 0;
+
+    const auto FilterClamped = [&](Uint32 col) {
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            float Sum = 0;
+            for (int t = 0; t < NumTaps; ++t)
+            {
+                const int src_col = std::min(std::max(static_cast<int>(col * 2) + FirstTap + t, 0), static_cast<int>(FineWidth) - 1);
+                Sum += pSrc[src_col * NumChannels + c] * Weights[t];
+            }
+            pDst[col * NumChannels + c] = Sum;
+        }
+    };
+
+    if (FirstInnerCol >= EndInnerCol)
+    {
+        for (Uint32 col = 0; col < CoarseWidth; ++col)
+            FilterClamped(col);
+        return;
+    }
+
+    for (Uint32 col = 0; col < FirstInnerCol; ++col)
+        FilterClamped(col);
+
+    Uint32 col = FirstInnerCol;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    if (NumChannels == 4)
+    {
+        __m128 w[NumTaps];
+        for (int t = 0; t < NumTaps; ++t)
+            w[t] = _mm_set1_ps(Weights[t]);
+
+        for (; col < EndInnerCol; ++col)
+        {
+            const float* pTaps = pSrc + (col * 2 + FirstTap) * 4;
+
+            __m128 Sum = _mm_mul_ps(_mm_loadu_ps(pTaps), w[0]);
+            for (int t = 1; t < NumTaps; ++t)
+                Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_loadu_ps(pTaps + t * 4), w[t]));
+            _mm_storeu_ps(pDst + col * 4, Sum);
+        }
+    }
+#endif
+    for (; col < EndInnerCol; ++col)
+    {
+        const float* pTaps = pSrc + (col * 2 + FirstTap) * NumChannels;
+        for (Uint32 c = 0; c < NumChannels; ++c)
+        {
+            float Sum = 0;
+            for (int t = 0; t < NumTaps; ++t)
+                Sum += pTaps[t * NumChannels + c] * Weights[t];
+            pDst[col * NumChannels + c] = Sum;
+        }
+    }
+
+    for (; col < CoarseWidth; ++col)
+        FilterClamped(col);
+}
+
+// Converts linear float values to 8-bit UNORM values with rounding.
+void EncodeUnorm8Row(const float* pSrc, Uint8* pDst, size_t Count)
+{
+    size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    const __m128 Zero   = _mm_setzero_ps();
+    const __m128 MaxVal = _mm_set1_ps(255.f);
+    const __m128 Half   = _mm_set1_ps(0.5f);
+    for (; i + 8 <= Count; i += 8)
+    {
+        const __m128  f0 = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(pSrc + i), MaxVal), Half), Zero), MaxVal);
+        const __m128  f1 = _mm_min_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(pSrc + i + 4), MaxVal), Half), Zero), MaxVal);
+        const __m128i i16 = _mm_packs_epi32(_mm_cvttps_epi32(f0), _mm_cvttps_epi32(f1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + i), _mm_packus_epi16(i16, i16));
+    }
+#endif
+    for (; i < Count; ++i)
+        pDst[i] = static_cast<Uint8>(std::min(std::max(pSrc[i] * 255.f + 0.5f, 0.f), 255.f));
+}
+
+// Converts linear float values to 8-bit sRGB values using the same math as SRGBAverage.
+void EncodeSRGB8Row(const float* pSrc, Uint8* pDst, size_t Count)
+{
+    size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    const auto FastLinearToGamma4 = [](__m128 x) {
+        const __m128 AbsMask = _mm_castsi128_ps(_mm_set1_epi32(0x7FFFFFFF));
+        const __m128 Lin     = _mm_mul_ps(x, _mm_set1_ps(12.92f));
+        const __m128 Sqrt    = _mm_sqrt_ps(_mm_and_ps(_mm_sub_ps(x, _mm_set1_ps(0.00228f)), AbsMask));
+        const __m128 Pow     = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(Sqrt, _mm_set1_ps(1.13005f)), _mm_mul_ps(x, _mm_set1_ps(0.13448f))), _mm_set1_ps(0.005719f));
+        const __m128 IsLin   = _mm_cmplt_ps(x, _mm_set1_ps(0.0031308f));
+        return _mm_or_ps(_mm_and_ps(IsLin, Lin), _mm_andnot_ps(IsLin, Pow));
+    };
+
+    const __m128 Zero   = _mm_setzero_ps();
+    const __m128 MaxVal = _mm_set1_ps(255.f);
+    for (; i + 8 <= Count; i += 8)
+    {
+        const __m128  f0  = _mm_min_ps(_mm_max_ps(_mm_mul_ps(FastLinearToGamma4(_mm_loadu_ps(pSrc + i)), MaxVal), Zero), MaxVal);
+        const __m128  f1  = _mm_min_ps(_mm_max_ps(_mm_mul_ps(FastLinearToGamma4(_mm_loadu_ps(pSrc + i + 4)), MaxVal), Zero), MaxVal);
+        const __m128i i16 = _mm_packs_epi32(_mm_cvttps_epi32(f0), _mm_cvttps_epi32(f1));
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(pDst + i), _mm_packus_epi16(i16, i16));
+    }
+#endif
+    for (; i < Count; ++i)
+    {
+        float fSRGB = FastLinearToGamma(pSrc[i]) * 255.f;
+        fSRGB       = std::max(fSRGB, 0.f);
+        fSRGB       = std::min(fSRGB, 255.f);
+        pDst[i]     = static_cast<Uint8>(fSRGB);
+    }
+}
+
+void RemapAlphaRow(Uint8* pRow, Uint32 Width, Uint32 NumChannels, Uint32 AlphaChannelInd, float AlphaCutoff)
+{
+    for (Uint32 col = 0; col < Width; ++col)
+    {
+        auto& Alpha = pRow[col * NumChannels + AlphaChannelInd];
+
+        // Remap alpha channel using the following formula to improve mip maps:
+        //
+        //      A_new = max(A_old; 1/3 * A_old + 2/3 * CutoffThreshold)
+        //
+        // https://asawicki.info/articles/alpha_test.php5
+
+        auto AlphaNew = std::min((static_cast<float>(Alpha) + 2.f * (AlphaCutoff * 255.f)) / 3.f, 255.f);
+
+        Alpha = std::max(Alpha, static_cast<Uint8>(AlphaNew));
+    }
+}
+
+// Computes rows [FirstRow, FirstRow + NumRows) of the coarse level of an 8-bit
+// texture using the 2x2 box filter. The results are identical to LinearAverage<Uint8>.
+void DownsampleRowsUnorm8Box(const Uint8* pFineData,
+                             size_t       FineStride,
+                             Uint32       FineWidth,
+                             Uint32       FineHeight,
+                             Uint8*       pCoarseData,
+                             size_t       CoarseStride,
+                             Uint32       CoarseWidth,
+                             Uint32       NumChannels,
+                             Uint32       FirstRow,
+                             Uint32       NumRows)
+{
+    const size_t        FineRowSize = size_t{FineWidth} * NumChannels;
+    std::vector<Uint16> VertSum(FineRowSize);
+    for (Uint32 row = FirstRow; row < FirstRow + NumRows; ++row)
+    {
+        const Uint8* pSrcRow0 = pFineData + size_t{row * 2} * FineStride;
+        const Uint8* pSrcRow1 = pFineData + size_t{std::min(row * 2 + 1, FineHeight - 1)} * FineStride;
+        Uint8*       pDstRow  = pCoarseData + size_t{row} * CoarseStride;
+
+        size_t i = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+        const __m128i Zero = _mm_setzero_si128();
+        for (; i + 16 <= FineRowSize; i += 16)
+        {
+            const __m128i r0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcRow0 + i));
+            const __m128i r1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pSrcRow1 + i));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&VertSum[i]), _mm_add_epi16(_mm_unpacklo_epi8(r0, Zero), _mm_unpacklo_epi8(r1, Zero)));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&VertSum[i + 8]), _mm_add_epi16(_mm_unpackhi_epi8(r0, Zero), _mm_unpackhi_epi8(r1, Zero)));
+        }
+#endif
+        for (; i < FineRowSize; ++i)
+            VertSum[i] = static_cast<Uint16>(Uint16{pSrcRow0[i]} + Uint16{pSrcRow1[i]});
+
+        Uint32 col = 0;
+#if DILIGENT_MATH_SIMD_SUPPORTED
+        if (NumChannels == 4)
+        {
+            // Every iteration processes 8 fine texels and produces 4 coarse texels
+            for (; col + 4 <= CoarseWidth && (col + 4) * 2 <= FineWidth; col += 4)
+            {
+                const __m128i* pSums = reinterpret_cast<const __m128i*>(&VertSum[size_t{col} * 8]);
+
+                const __m128i t01 = _mm_loadu_si128(pSums + 0);
+                const __m128i t23 = _mm_loadu_si128(pSums + 1);
+                const __m128i t45 = _mm_loadu_si128(pSums + 2);
+                const __m128i t67 = _mm_loadu_si128(pSums + 3);
+
+                const __m128i c01 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(t01, t23), _mm_unpackhi_epi64(t01, t23)), 2);
+                const __m128i c23 = _mm_srli_epi16(_mm_add_epi16(_mm_unpacklo_epi64(t45, t67), _mm_unpackhi_epi64(t45, t67)), 2);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDstRow + col * 4), _mm_packus_epi16(c01, c23));
+            }
+        }
+#endif
+        for (; col < CoarseWidth; ++col)
+        {
+            const Uint32 src_col0 = col * 2;
+            const Uint32 src_col1 = std::min(col * 2 + 1, FineWidth - 1);
+            for (Uint32 c = 0; c < NumChannels; ++c)
+                pDstRow[col * NumChannels + c] = static_cast<Uint8>((VertSum[src_col0 * NumChannels + c] + VertSum[src_col1 * NumChannels + c]) >> 2);
+        }
+    }
+}
+
+// Provides access to the rows of the fine mip level as linear float values.
+// 8-bit rows are decoded on demand and kept in a small cache, so that every
+// row is decoded once even though it is used by several coarse rows.
+class FineLevelReader
+{
+public:
+    FineLevelReader(const void* pData, size_t Stride, Uint32 Width, Uint32 NumChannels, const float* pDecodeTable) :
+        m_pData{static_cast<const Uint8*>(pData)},
+        m_Stride{Stride},
+        m_RowSize{size_t{Width} * NumChannels},
+        m_pDecodeTable{pDecodeTable}
+    {
+        if (m_pDecodeTable != nullptr)
+        {
+            m_Rows.resize(m_RowSize * CacheSize);
+            std::fill(std::begin(m_RowIds), std::end(m_RowIds), ~Uint32{0});
+        }
+    }
+
+    const float* GetRow(Uint32 Row)
+    {
+        const Uint8* pSrcRow = m_pData + size_t{Row} * m_Stride;
+        if (m_pDecodeTable == nullptr)
+            return reinterpret_cast<const float*>(pSrcRow);
+
+        const Uint32 Slot = Row % CacheSize;
+        float*       pRow = &m_Rows[Slot * m_RowSize];
+        if (m_RowIds[Slot] != Row)
+        {
+            for (size_t i = 0; i < m_RowSize; ++i)
+                pRow[i] = m_pDecodeTable[pSrcRow[i]];
+            m_RowIds[Slot] = Row;
+        }
+        return pRow;
+    }
+
+private:
+    // Must not be less than the number of filter taps
+    static constexpr Uint32 CacheSize = KaiserDownsampleFilter::NumTaps;
+
+    const Uint8* const m_pData;
+    const size_t       m_Stride;
+    const size_t       m_RowSize;
+    const float* const m_pDecodeTable;
+
+    std::vector<float> m_Rows;
+    Uint32             m_RowIds[CacheSize] = {};
+};
+
+// Describes one step of the mip chain computed in float space.
+struct FloatMipLevelInfo
+{
+    COMPONENT_TYPE  ComponentType = COMPONENT_TYPE_UNDEFINED;
+    MIP_FILTER_TYPE FilterType    = MIP_FILTER_TYPE_BOX_AVERAGE;
+    Uint32          NumChannels   = 0;
+    float           AlphaCutoff   = 0;
+
+    Uint32 FineWidth   = 0;
+    Uint32 FineHeight  = 0;
+    Uint32 CoarseWidth = 0;
+
+    // Fine level data. For 8-bit formats, this is either the texture data (pDecodeTable is not null),
+    // or the linear float values of the fine level computed at the previous step.
+    const void*  pFineData    = nullptr;
+    size_t       FineStride   = 0;
+    const float* pDecodeTable = nullptr;
+
+    void*  pCoarseData  = nullptr;
+    size_t CoarseStride = 0;
+
+    // Optional buffer that receives the linear float values of the coarse level
+    float* pCoarseCache = nullptr;
+};
+
+// Computes rows [FirstRow, FirstRow + NumRows) of the coarse level. The vertical pass is performed
+// first on whole fine rows, which is SIMD-friendly for any number of channels.
+void FilterRowsFloat(const FloatMipLevelInfo& Info, Uint32 FirstRow, Uint32 NumRows)
+{
+    const size_t FineRowSize   = size_t{Info.FineWidth} * Info.NumChannels;
+    const size_t CoarseRowSize = size_t{Info.CoarseWidth} * Info.NumChannels;
+
+    FineLevelReader Reader{Info.pFineData, Info.FineStride, Info.FineWidth, Info.NumChannels, Info.pDecodeTable};
+
+    std::vector<float> VertRow(FineRowSize);
+    std::vector<float> CoarseRow(Info.ComponentType == COMPONENT_TYPE_FLOAT || Info.pCoarseCache != nullptr ? 0 : CoarseRowSize);
+
+    const float* Weights = GetKaiserDownsampleFilter().Weights;
+    for (Uint32 row = FirstRow; row < FirstRow + NumRows; ++row)
+    {
+        if (Info.FilterType == MIP_FILTER_TYPE_KAISER)
+        {
+            for (int t = 0; t < KaiserDownsampleFilter::NumTaps; ++t)
+            {
+                const int    src_row = static_cast<int>(row * 2) + KaiserDownsampleFilter::FirstTap + t;
+                const float* pSrcRow = Reader.GetRow(static_cast<Uint32>(std::min(std::max(src_row, 0), static_cast<int>(Info.FineHeight) - 1)));
+                if (t == 0)
+                    ScaleRow(pSrcRow, Weights[t], VertRow.data(), FineRowSize);
+                else
+                    AccumulateRow(pSrcRow, Weights[t], VertRow.data(), FineRowSize);
+            }
+        }
+        else
+        {
+            const float* pSrcRow0 = Reader.GetRow(row * 2);
+            const float* pSrcRow1 = Reader.GetRow(std::min(row * 2 + 1, Info.FineHeight - 1));
+            AddRows(pSrcRow0, pSrcRow1, VertRow.data(), FineRowSize);
+        }
+
+        // Float results are written directly to the coarse level
+        float* pDstRow = nullptr;
+        if (Info.ComponentType == COMPONENT_TYPE_FLOAT)
+            pDstRow = reinterpret_cast<float*>(static_cast<Uint8*>(Info.pCoarseData) + size_t{row} * Info.CoarseStride);
+        else if (Info.pCoarseCache != nullptr)
+            pDstRow = Info.pCoarseCache + row * CoarseRowSize;
+        else
+            pDstRow = CoarseRow.data();
+
+        if (Info.FilterType == MIP_FILTER_TYPE_KAISER)
+            DownsampleRowKaiser(VertRow.data(), Info.FineWidth, pDstRow, Info.CoarseWidth, Info.NumChannels);
+        else
+            DownsampleRowBox(VertRow.data(), Info.FineWidth, pDstRow, Info.CoarseWidth, Info.NumChannels, 0.25f);
+
+        if (Info.ComponentType != COMPONENT_TYPE_FLOAT)
+        {
+            Uint8* pDst8 = static_cast<Uint8*>(Info.pCoarseData) + size_t{row} * Info.CoarseStride;
+            if (Info.ComponentType == COMPONENT_TYPE_UNORM_SRGB)
+                EncodeSRGB8Row(pDstRow, pDst8, CoarseRowSize);
+            else
+                EncodeUnorm8Row(pDstRow, pDst8, CoarseRowSize);
+
+            if (Info.AlphaCutoff > 0)
+                RemapAlphaRow(pDst8, Info.CoarseWidth, Info.NumChannels, Info.NumChannels - 1, Info.AlphaCutoff);
+        }
+    }
+}
+
+// Splits the rows into up to NumTasks ranges and runs Handler(FirstRow, NumRows) for every range
+// in the thread pool. The first range is processed by the calling thread.
+template <typename HandlerType>
+void ProcessRowRanges(IThreadPool* pThreadPool, Uint32 NumTasks, Uint32 NumRows, Uint32 MinRowsPerTask, const HandlerType& Handler)
+{
+    MinRowsPerTask         = std::max(MinRowsPerTask, 1u);
+    const Uint32 TaskCount = pThreadPool != nullptr ? std::min(std::max(NumTasks, 1u), (NumRows + MinRowsPerTask - 1) / MinRowsPerTask) : 1;
+    if (TaskCount <= 1)
+    {
+        Handler(Uint32{0}, NumRows);
+        return;
+    }
+
+    const Uint32 RowsPerTask = (NumRows + TaskCount - 1) / TaskCount;
+
+    std::vector<RefCntAutoPtr<IAsyncTask>> Tasks;
+    Tasks.reserve(TaskCount - 1);
+    for (Uint32 FirstRow = RowsPerTask; FirstRow < NumRows; FirstRow += RowsPerTask)
+    {
+        const Uint32 RangeSize = std::min(RowsPerTask, NumRows - FirstRow);
+        Tasks.emplace_back(EnqueueAsyncWork(pThreadPool,
+                                            [&Handler, FirstRow, RangeSize](Uint32) {
+                                                Handler(FirstRow, RangeSize);
+                                            }));
+    }
+
+    Handler(Uint32{0}, std::min(RowsPerTask, NumRows));
+
+    for (auto& pTask : Tasks)
+        pTask->WaitForCompletion();
+}
+
+} // namespace
+
 void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
                 Uint32                        NumChannels,
                 Uint32                        AlphaChannelInd)
@@ -336,20 +889,7 @@ void RemapAlpha(const ComputeMipLevelAttribs& Attribs,
     const auto CoarseMipHeight = std::max(Attribs.FineMipHeight / Uint32{2}, Uint32{1});
     for (Uint32 row = 0; row < CoarseMipHeight; ++row)
     {
-        for (Uint32 col = 0; col < CoarseMipWidth; ++col)
-        {
-            auto& Alpha = (reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride)[col * NumChannels + AlphaChannelInd];
-
-            // Remap alpha channel using the following formula to improve mip maps:
-            //
-            //      A_new = max(A_old; 1/3 * A_old + 2/3 * CutoffThreshold)
-            //
-            // https://asawicki.info/articles/alpha_test.php5
-
-            auto AlphaNew = std::min((static_cast<float>(Alpha) + 2.f * (Attribs.AlphaCutoff * 255.f)) / 3.f, 255.f);
-
-            Alpha = std::max(Alpha, static_cast<Uint8>(AlphaNew));
-        }
+        RemapAlphaRow(reinterpret_cast<Uint8*>(Attribs.pCoarseMipData) + row * Attribs.CoarseMipStride, CoarseMipWidth, NumChannels, AlphaChannelInd, Attribs.AlphaCutoff);
     }
 }
 
@@ -357,13 +897,7 @@ template <typename ChannelType>
 void ComputeMipLevelInternal(const ComputeMipLevelAttribs& Attribs,
                              const TextureFormatAttribs&   FmtAttribs)
 {
-    auto FilterType = Attribs.FilterType;
-    if (FilterType == MIP_FILTER_TYPE_DEFAULT)
-    {
-        FilterType = FmtAttribs.ComponentType == COMPONENT_TYPE_UINT || FmtAttribs.ComponentType == COMPONENT_TYPE_SINT ?
-            MIP_FILTER_TYPE_MOST_FREQUENT :
-            MIP_FILTER_TYPE_BOX_AVERAGE;
-    }
+    const auto FilterType = ResolveMipFilterType(Attribs.FilterType, FmtAttribs);
 
     FilterMipLevel<ChannelType>(Attribs, FmtAttribs.NumComponents,
                                 FilterType == MIP_FILTER_TYPE_BOX_AVERAGE ?
@@ -385,6 +919,24 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
     VERIFY(Attribs.AlphaCutoff == 0 || FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1,
            "Alpha remapping is only supported for 4-channel 8-bit textures");
 
+    if (Attribs.FilterType == MIP_FILTER_TYPE_KAISER && IsKaiserFilterSupported(FmtAttribs))
+    {
+        // Kaiser filter is only implemented by ComputeMipChain
+        ComputeMipChainAttribs ChainAttribs;
+        ChainAttribs.Format            = Attribs.Format;
+        ChainAttribs.Width             = Attribs.FineMipWidth;
+        ChainAttribs.Height            = Attribs.FineMipHeight;
+        ChainAttribs.pBaseMipData      = Attribs.pFineMipData;
+        ChainAttribs.BaseMipStride     = Attribs.FineMipStride;
+        ChainAttribs.NumCoarseMips     = 1;
+        ChainAttribs.ppCoarseMipData   = &Attribs.pCoarseMipData;
+        ChainAttribs.pCoarseMipStrides = &Attribs.CoarseMipStride;
+        ChainAttribs.FilterType        = Attribs.FilterType;
+        ChainAttribs.AlphaCutoff       = Attribs.AlphaCutoff;
+        ComputeMipChain(ChainAttribs);
+        return;
+    }
+
     switch (FmtAttribs.ComponentType)
     {
         case COMPONENT_TYPE_UNORM_SRGB:
@@ -455,6 +1007,148 @@ void ComputeMipLevel(const ComputeMipLevelAttribs& Attribs)
     }
 }
 
+void ComputeMipChain(const ComputeMipChainAttribs& Attribs)
+{
+    DEV_CHECK_ERR(Attribs.Format != TEX_FORMAT_UNKNOWN, "Format must not be unknown");
+    DEV_CHECK_ERR(Attribs.Width != 0, "Width must not be zero");
+    DEV_CHECK_ERR(Attribs.Height != 0, "Height must not be zero");
+    DEV_CHECK_ERR(Attribs.pBaseMipData != nullptr, "Base level data must not be null");
+    DEV_CHECK_ERR(Attribs.NumCoarseMips == 0 || Attribs.ppCoarseMipData != nullptr, "Coarse level data must not be null");
+    DEV_CHECK_ERR(Attribs.NumCoarseMips == 0 || Attribs.pCoarseMipStrides != nullptr, "Coarse level strides must not be null");
+
+    const auto& FmtAttribs = GetTextureFormatAttribs(Attribs.Format);
+
+    VERIFY_EXPR(Attribs.AlphaCutoff >= 0 && Attribs.AlphaCutoff <= 1);
+    VERIFY(Attribs.AlphaCutoff == 0 || FmtAttribs.NumComponents == 4 && FmtAttribs.ComponentSize == 1,
+           "Alpha remapping is only supported for 4-channel 8-bit textures");
+
+    const auto FilterType = ResolveMipFilterType(Attribs.FilterType, FmtAttribs);
+
+    const bool IsFloat = FmtAttribs.ComponentType == COMPONENT_TYPE_FLOAT && FmtAttribs.ComponentSize == 4;
+    const bool Is8Bit  = FmtAttribs.ComponentSize == 1 &&
+        (FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM || FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB || FmtAttribs.ComponentType == COMPONENT_TYPE_UINT);
+    if (FilterType == MIP_FILTER_TYPE_MOST_FREQUENT || !(IsFloat || Is8Bit))
+    {
+        // Generic path: compute the levels one by one
+        ComputeMipLevelAttribs LevelAttribs;
+        LevelAttribs.Format        = Attribs.Format;
+        LevelAttribs.FineMipWidth  = Attribs.Width;
+        LevelAttribs.FineMipHeight = Attribs.Height;
+        LevelAttribs.pFineMipData  = Attribs.pBaseMipData;
+        LevelAttribs.FineMipStride = Attribs.BaseMipStride;
+        LevelAttribs.FilterType    = FilterType;
+        LevelAttribs.AlphaCutoff   = Attribs.AlphaCutoff;
+        for (Uint32 mip = 0; mip < Attribs.NumCoarseMips; ++mip)
+        {
+            LevelAttribs.pCoarseMipData  = Attribs.ppCoarseMipData[mip];
+            LevelAttribs.CoarseMipStride = Attribs.pCoarseMipStrides[mip];
+            ComputeMipLevel(LevelAttribs);
+
+            LevelAttribs.FineMipWidth  = std::max(LevelAttribs.FineMipWidth / 2u, 1u);
+            LevelAttribs.FineMipHeight = std::max(LevelAttribs.FineMipHeight / 2u, 1u);
+            LevelAttribs.pFineMipData  = LevelAttribs.pCoarseMipData;
+            LevelAttribs.FineMipStride = LevelAttribs.CoarseMipStride;
+        }
+        return;
+    }
+
+    RefCntAutoPtr<IThreadPool> pThreadPool{Attribs.pThreadPool, IID_ThreadPool};
+    DEV_CHECK_ERR(Attribs.pThreadPool == nullptr || pThreadPool, "The thread pool object does not implement IThreadPool interface");
+
+    const Uint32 NumTasks = Attribs.NumTasks != 0 ? Attribs.NumTasks : std::max(std::thread::hardware_concurrency(), 1u);
+    // The minimum number of coarse texels processed by one task
+    constexpr Uint32 MinTexelsPerTask = 16384;
+
+    const Uint32 NumChannels = FmtAttribs.NumComponents;
+
+    // 8-bit box-filtered levels are computed from the previous 8-bit level and exactly match ComputeMipLevel.
+    // All other levels are computed in linear float space. For 8-bit formats, the unquantized float values of
+    // the previous level are cached and used to compute the next level.
+    const bool UseFloatCache = Is8Bit && (FilterType == MIP_FILTER_TYPE_KAISER || FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB);
+
+    std::vector<float> LevelCache[2];
+
+    Uint32      FineWidth  = Attribs.Width;
+    Uint32      FineHeight = Attribs.Height;
+    const void* pFineData  = Attribs.pBaseMipData;
+    size_t      FineStride = Attribs.BaseMipStride;
+    for (Uint32 mip = 0; mip < Attribs.NumCoarseMips; ++mip)
+    {
+        const Uint32 CoarseWidth  = std::max(FineWidth / 2u, 1u);
+        const Uint32 CoarseHeight = std::max(FineHeight / 2u, 1u);
+        void* const  pCoarseData  = Attribs.ppCoarseMipData[mip];
+        const size_t CoarseStride = Attribs.pCoarseMipStrides[mip];
+        DEV_CHECK_ERR(pCoarseData != nullptr, "Coarse level ", mip + 1, " data must not be null");
+        VERIFY(CoarseHeight == 1 || CoarseStride >= size_t{CoarseWidth} * FmtAttribs.ComponentSize * NumChannels, "Coarse mip level stride is too small");
+
+        const Uint32 MinRowsPerTask = std::max(MinTexelsPerTask / CoarseWidth, 1u);
+        if (Is8Bit && !UseFloatCache)
+        {
+            ProcessRowRanges(pThreadPool, NumTasks, CoarseHeight, MinRowsPerTask,
+                             [&](Uint32 FirstRow, Uint32 NumRows) {
+                                 DownsampleRowsUnorm8Box(static_cast<const Uint8*>(pFineData), FineStride, FineWidth, FineHeight,
+                                                         static_cast<Uint8*>(pCoarseData), CoarseStride, CoarseWidth,
+                                                         NumChannels, FirstRow, NumRows);
+                                 if (Attribs.AlphaCutoff > 0)
+                                 {
+                                     for (Uint32 row = FirstRow; row < FirstRow + NumRows; ++row)
+                                         RemapAlphaRow(static_cast<Uint8*>(pCoarseData) + size_t{row} * CoarseStride, CoarseWidth, NumChannels, NumChannels - 1, Attribs.AlphaCutoff);
+                                 }
+                             });
+        }
+        else
+        {
+            FloatMipLevelInfo Info;
+            Info.ComponentType = FmtAttribs.ComponentType;
+            Info.FilterType    = FilterType;
+            Info.NumChannels   = NumChannels;
+            Info.AlphaCutoff   = Attribs.AlphaCutoff;
+            Info.FineWidth     = FineWidth;
+            Info.FineHeight    = FineHeight;
+            Info.CoarseWidth   = CoarseWidth;
+            Info.pCoarseData   = pCoarseData;
+            Info.CoarseStride  = CoarseStride;
+            if (UseFloatCache)
+            {
+                if (mip == 0)
+                {
+                    Info.pFineData    = pFineData;
+                    Info.FineStride   = FineStride;
+                    Info.pDecodeTable = Get8BitDecodeTable(FmtAttribs.ComponentType == COMPONENT_TYPE_UNORM_SRGB);
+                }
+                else
+                {
+                    Info.pFineData  = LevelCache[(mip - 1) & 1].data();
+                    Info.FineStride = size_t{FineWidth} * NumChannels * sizeof(float);
+                }
+
+                // The cache is not needed for the last level
+                if (mip + 1 < Attribs.NumCoarseMips)
+                {
+                    auto& Cache = LevelCache[mip & 1];
+                    Cache.resize(size_t{CoarseWidth} * CoarseHeight * NumChannels);
+                    Info.pCoarseCache = Cache.data();
+                }
+            }
+            else
+            {
+                Info.pFineData  = pFineData;
+                Info.FineStride = FineStride;
+            }
+
+            ProcessRowRanges(pThreadPool, NumTasks, CoarseHeight, MinRowsPerTask,
+                             [&Info](Uint32 FirstRow, Uint32 NumRows) {
+                                 FilterRowsFloat(Info, FirstRow, NumRows);
+                             });
+        }
+
+        FineWidth  = CoarseWidth;
+        FineHeight = CoarseHeight;
+        pFineData  = pCoarseData;
+        FineStride = CoarseStride;
+    }
+}
+
 #if !METAL_SUPPORTED
 void CreateSparseTextureMtl(IRenderDevice*     pDevice,
                             const TextureDesc& TexDesc,
@@ -573,6 +1267,11 @@ extern "C"
         Diligent::ComputeMipLevel(Attribs);
     }
 
+    void Diligent_ComputeMipChain(const Diligent::ComputeMipChainAttribs& Attribs)
+    {
+        Diligent::ComputeMipChain(Attribs);
+    }
+
     void Diligent_CreateSparseTextureMtl(Diligent::IRenderDevice*     pDevice,
                                          const Diligent::TextureDesc& TexDesc,
                                          Diligent::IDeviceMemory*     pMemory,
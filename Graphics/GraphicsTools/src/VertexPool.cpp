@@ -29,6 +29,8 @@
 #include <mutex>
 #include <atomic>
 #include <memory>
+#include <vector>
+#include <algorithm>
 
 #include "DebugUtilities.hpp"
 #include "ObjectBase.hpp"
@@ -83,7 +85,7 @@ public:
 
     virtual Uint32 GetStartVertex() const override final
     {
-        return m_StartVertex;
+        return m_StartVertex.load();
     }
 
     virtual Uint32 GetVertexCount() const override final
@@ -108,12 +110,27 @@ public:
     }
 
 private:
+    friend class VertexPoolImpl;
+
     RefCntAutoPtr<VertexPoolImpl> m_pParentPool;
 
+    // The region and the links are protected by the pool mutex
     VariableSizeAllocationsManager::Allocation m_Region;
 
-    const Uint32 m_StartVertex;
-    const Uint32 m_VertexCount;
+    std::atomic<Uint32> m_StartVertex;
+    const Uint32        m_VertexCount;
+
+    // Links in the list of live allocations
+    VertexPoolAllocationImpl* m_pPrev = nullptr;
+    VertexPoolAllocationImpl* m_pNext = nullptr;
+
+    // Index in the defragmentation plan
+    static constexpr size_t InvalidDefragPlanIdx = ~size_t{0};
+    size_t                  m_DefragPlanIdx      = InvalidDefragPlanIdx;
+
+    // Index in the list of relocations of the running defragmentation step
+    static constexpr size_t InvalidRelocationIdx = ~size_t{0};
+    size_t                  m_RelocationIdx      = InvalidRelocationIdx;
 
     RefCntAutoPtr<IObject> m_pUserData;
 };
@@ -268,7 +285,7 @@ public:
 
         DEV_CHECK_ERR(*ppAllocation == nullptr, "Overwriting reference to existing object may cause memory leaks");
 
-        VariableSizeAllocationsManager::Allocation Region;
+        VertexPoolAllocationImpl* pAllocation = nullptr;
         {
             std::lock_guard<std::mutex> Lock{m_MgrMtx};
 
@@ -292,7 +309,7 @@ public:
                 }
             }
 
-            Region = m_Mgr.Allocate(NumVertices, 1);
+            auto Region = m_Mgr.Allocate(NumVertices, 1);
 
             while (!Region.IsValid() && (m_MaxVertexCount == 0 || m_Mgr.GetMaxSize() < m_MaxVertexCount))
             {
@@ -310,39 +327,60 @@ public:
                 Region = m_Mgr.Allocate(NumVertices, 1);
             }
 
+            if (Region.IsValid())
+            {
+                // Create the object under the mutex to add it to the list of live allocations
+                // clang-format off
+                pAllocation =
+                    NEW_RC_OBJ(m_AllocationObjAllocator, "VertexPoolAllocationImpl instance", VertexPoolAllocationImpl)
+                    (
+                        this,
+                        static_cast<Uint32>(Region.UnalignedOffset),
+                        NumVertices,
+                        std::move(Region)
+                    );
+                // clang-format on
+
+                pAllocation->m_pNext = m_pAllocations;
+                if (m_pAllocations != nullptr)
+                    m_pAllocations->m_pPrev = pAllocation;
+                m_pAllocations = pAllocation;
+            }
+
             UpdateUsageStats();
         }
 
-        if (Region.IsValid())
+        if (pAllocation != nullptr)
         {
-            // clang-format off
-            VertexPoolAllocationImpl* pSuballocation{
-                NEW_RC_OBJ(m_AllocationObjAllocator, "VertexPoolAllocationImpl instance", VertexPoolAllocationImpl)
-                (
-                    this,
-                    static_cast<Uint32>(Region.UnalignedOffset),
-                    NumVertices,
-                    std::move(Region)
-                )
-            };
-            // clang-format on
-
-            pSuballocation->QueryInterface(IID_VertexPoolAllocation, reinterpret_cast<IObject**>(ppAllocation));
+            pAllocation->QueryInterface(IID_VertexPoolAllocation, reinterpret_cast<IObject**>(ppAllocation));
             m_AllocationCount.fetch_add(1);
         }
     }
 
-    void Free(VariableSizeAllocationsManager::Allocation&& Region)
+    void Free(VertexPoolAllocationImpl& Allocation)
     {
         std::lock_guard<std::mutex> Lock{m_MgrMtx};
-        m_Mgr.Free(std::move(Region));
+
+        if (Allocation.m_pPrev != nullptr)
+            Allocation.m_pPrev->m_pNext = Allocation.m_pNext;
+        else
+            m_pAllocations = Allocation.m_pNext;
+        if (Allocation.m_pNext != nullptr)
+            Allocation.m_pNext->m_pPrev = Allocation.m_pPrev;
+
+        if (Allocation.m_DefragPlanIdx != VertexPoolAllocationImpl::InvalidDefragPlanIdx)
+            m_DefragPlan[Allocation.m_DefragPlanIdx] = nullptr;
+        if (Allocation.m_RelocationIdx != VertexPoolAllocationImpl::InvalidRelocationIdx)
+            m_Relocations[Allocation.m_RelocationIdx].pAllocation = nullptr;
+
+        m_Mgr.Free(std::move(Allocation.m_Region));
         m_AllocationCount.fetch_add(-1);
         UpdateUsageStats();
     }
 
     virtual Uint32 GetVersion() const override final
     {
-        Uint32 Version = 0;
+        Uint32 Version = m_DefragVersion.load();
         for (const auto& Buffer : m_Buffers)
             Version += Buffer->GetVersion();
         return Version;
@@ -365,7 +403,144 @@ public:
             VertexSize += m_Desc.pElements[Elem].Size;
         UsageStats.UsedMemorySize = UsageStats.AllocatedVertexCount * VertexSize;
 
-        UsageStats.AllocationCount = m_AllocationCount.load();
+        UsageStats.AllocationCount  = m_AllocationCount.load();
+        UsageStats.MaxFreeRangeSize = m_MaxFreeRangeSize.load();
+        UsageStats.FreeRangeCount   = m_FreeRangeCount.load();
+
+        const auto FreeVertexCount = UsageStats.TotalVertexCount - UsageStats.AllocatedVertexCount;
+        UsageStats.Fragmentation   = FreeVertexCount > 0 ?
+            1.f - static_cast<float>(UsageStats.MaxFreeRangeSize) / static_cast<float>(FreeVertexCount) :
+            0.f;
+    }
+
+    virtual Uint64 Defragment(IRenderDevice*  pDevice,
+                              IDeviceContext* pContext,
+                              Uint64          MaxBytesToMove) override final
+    {
+        if (pDevice == nullptr || pContext == nullptr)
+        {
+            UNEXPECTED("Device and context must not be null");
+            return 0;
+        }
+
+        // Make sure that all allocations are backed by the buffers
+        UpdateAll(pDevice, pContext);
+
+        Uint64 VertexSize     = 0;
+        Uint64 BufferCapacity = ~Uint64{0};
+        for (Uint32 i = 0; i < m_Desc.NumElements; ++i)
+        {
+            VertexSize += m_Elements[i].Size;
+            BufferCapacity = std::min(BufferCapacity, m_BufferSizes[i].load() / m_Elements[i].Size);
+        }
+
+        struct VertexRangeCopy
+        {
+            Uint64 SrcVertex;
+            Uint64 DstVertex;
+            Uint64 NumVertices;
+        };
+        std::vector<VertexRangeCopy> VertexCopies;
+
+        Uint64 BytesMoved = 0;
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+            VERIFY(m_Relocations.empty(), "Defragment() must not be called by multiple threads simultaneously");
+
+            for (;;)
+            {
+                if (m_DefragPlanPos == m_DefragPlan.size())
+                    PlanDefragmentation();
+
+                while (m_DefragPlanPos < m_DefragPlan.size())
+                {
+                    auto* const pAllocation = m_DefragPlan[m_DefragPlanPos];
+                    if (pAllocation != nullptr)
+                    {
+                        if (MaxBytesToMove != 0 && BytesMoved != 0 && BytesMoved + pAllocation->m_VertexCount * VertexSize > MaxBytesToMove)
+                            break;
+                        pAllocation->m_DefragPlanIdx = VertexPoolAllocationImpl::InvalidDefragPlanIdx;
+                    }
+                    ++m_DefragPlanPos;
+
+                    // Skip released allocations and those that are not in the buffers yet
+                    if (pAllocation == nullptr ||
+                        pAllocation->m_Region.UnalignedOffset + pAllocation->m_Region.Size > BufferCapacity)
+                        continue;
+
+                    auto NewRegion = m_Mgr.AllocateBelow(pAllocation->m_VertexCount, 1, pAllocation->m_Region.UnalignedOffset);
+                    if (!NewRegion.IsValid())
+                        continue;
+
+                    VertexCopies.push_back({pAllocation->m_StartVertex.load(), NewRegion.UnalignedOffset, pAllocation->m_VertexCount});
+
+                    pAllocation->m_RelocationIdx = m_Relocations.size();
+                    m_Relocations.push_back({pAllocation, std::move(NewRegion)});
+                    BytesMoved += pAllocation->m_VertexCount * VertexSize;
+                    m_DefragPassBytesMoved += pAllocation->m_VertexCount * VertexSize;
+                }
+
+                if (m_DefragPlanPos < m_DefragPlan.size())
+                    break; // The budget is exhausted
+
+                // The pass is complete
+                const bool RestartPass = BytesMoved == 0 && m_DefragPassBytesMoved != 0;
+                m_DefragPlan.clear();
+                m_DefragPlanPos        = 0;
+                m_DefragPassBytesMoved = 0;
+
+                // Allocations moved by the previous steps may have made room for the allocations
+                // that could not be moved. Start a new pass to only report zero bytes when no
+                // allocation can be moved.
+                if (!RestartPass)
+                    break;
+            }
+        }
+
+        if (VertexCopies.empty())
+            return BytesMoved;
+
+        // Create the intermediate buffers and record the copies without holding the mutex so that
+        // the threads that allocate and release vertices are not blocked. The new regions stay
+        // reserved in the manager until the relocations are committed.
+        std::vector<DynamicBuffer::RegionCopy> Copies(VertexCopies.size());
+        for (Uint32 i = 0; i < m_Desc.NumElements; ++i)
+        {
+            const Uint64 ElementSize = m_Elements[i].Size;
+            for (size_t r = 0; r < VertexCopies.size(); ++r)
+            {
+                Copies[r].SrcOffset = VertexCopies[r].SrcVertex * ElementSize;
+                Copies[r].DstOffset = VertexCopies[r].DstVertex * ElementSize;
+                Copies[r].Size      = VertexCopies[r].NumVertices * ElementSize;
+            }
+            m_Buffers[i]->CopyRegions(pDevice, pContext, Copies.data(), static_cast<Uint32>(Copies.size()));
+        }
+
+        {
+            std::lock_guard<std::mutex> Lock{m_MgrMtx};
+
+            // All commands recorded after the copies use the new start vertices
+            for (auto& Reloc : m_Relocations)
+            {
+                if (Reloc.pAllocation == nullptr)
+                {
+                    // The allocation was released while the data was being copied
+                    m_Mgr.Free(std::move(Reloc.NewRegion));
+                    continue;
+                }
+
+                auto& Allocation           = *Reloc.pAllocation;
+                Allocation.m_RelocationIdx = VertexPoolAllocationImpl::InvalidRelocationIdx;
+                m_Mgr.Free(std::move(Allocation.m_Region));
+                Allocation.m_Region = std::move(Reloc.NewRegion);
+                Allocation.m_StartVertex.store(static_cast<Uint32>(Allocation.m_Region.UnalignedOffset));
+            }
+            m_Relocations.clear();
+            m_DefragVersion.fetch_add(1);
+            UpdateUsageStats();
+        }
+
+        return BytesMoved;
     }
 
 private:
@@ -373,8 +548,26 @@ private:
     {
         m_AllocatedVertexCount.store(m_Mgr.GetUsedSize());
         m_TotalVertexCount.store(m_Mgr.GetMaxSize());
+        m_MaxFreeRangeSize.store(m_Mgr.GetMaxFreeBlockSize());
+        m_FreeRangeCount.store(static_cast<Uint32>(m_Mgr.GetNumFreeBlocks()));
         UpdateCommittedMemorySize();
     }
+
+    // Orders live allocations from the end of the pool towards the beginning
+    void PlanDefragmentation()
+    {
+        VERIFY_EXPR(m_DefragPlan.empty() && m_DefragPlanPos == 0);
+        for (auto* pAllocation = m_pAllocations; pAllocation != nullptr; pAllocation = pAllocation->m_pNext)
+            m_DefragPlan.push_back(pAllocation);
+
+        std::sort(m_DefragPlan.begin(), m_DefragPlan.end(),
+                  [](const VertexPoolAllocationImpl* pLHS, const VertexPoolAllocationImpl* pRHS) {
+                      return pLHS->m_Region.UnalignedOffset > pRHS->m_Region.UnalignedOffset;
+                  });
+
+        for (size_t i = 0; i < m_DefragPlan.size(); ++i)
+            m_DefragPlan[i]->m_DefragPlanIdx = i;
+    }
     void UpdateCommittedMemorySize()
     {
         Uint64 CommittedMemorySize = 0;
@@ -404,6 +597,28 @@ private:
     std::atomic<Uint64> m_AllocatedVertexCount{0};
     std::atomic<Uint64> m_CommittedMemorySize{0};
     std::atomic<Uint64> m_TotalVertexCount{0};
+    std::atomic<Uint64> m_MaxFreeRangeSize{0};
+    std::atomic<Uint32> m_FreeRangeCount{0};
+
+    // The list of live allocations, protected by m_MgrMtx
+    VertexPoolAllocationImpl* m_pAllocations = nullptr;
+
+    // Allocations to move in the current defragmentation pass, protected by m_MgrMtx.
+    // Released allocations are replaced with null.
+    std::vector<VertexPoolAllocationImpl*> m_DefragPlan;
+    size_t                                 m_DefragPlanPos        = 0;
+    Uint64                                 m_DefragPassBytesMoved = 0;
+
+    struct Relocation
+    {
+        VertexPoolAllocationImpl*                  pAllocation;
+        VariableSizeAllocationsManager::Allocation NewRegion;
+    };
+    // Relocations of the running defragmentation step, protected by m_MgrMtx.
+    // Allocations released while the data is being copied are replaced with null.
+    std::vector<Relocation> m_Relocations;
+
+    std::atomic<Uint32> m_DefragVersion{0};
 
     FixedBlockMemoryAllocator m_AllocationObjAllocator;
 };
@@ -411,7 +626,7 @@ private:
 
 VertexPoolAllocationImpl::~VertexPoolAllocationImpl()
 {
-    m_pParentPool->Free(std::move(m_Region));
+    m_pParentPool->Free(*this);
 }
 
 IVertexPool* VertexPoolAllocationImpl::GetPool()
@@ -360,6 +360,7 @@
 #include "HLSL2GLSLConverterImpl.hpp"
 #include "GraphicsAccessories.hpp"
 #include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "StringDataBlobImpl.hpp"
 #include "StringTools.hpp"
 #include "ParsingTools.hpp"
@@ -4464,8 +4465,7 @@ HLSL2GLSLConverterImpl::ConversionStream::ConversionStream(IReferenceCounters*
         if (pSourceStream == nullptr)
             LOG_ERROR_AND_THROW("Failed to open shader source file ", InputFileName);
 
-        pFileData = DataBlobImpl::Create();
-        pSourceStream->ReadBlob(pFileData);
+        pFileData  = ReadFileStreamData(pSourceStream);
         HLSLSource = reinterpret_cast<char*>(pFileData->GetDataPtr());
         NumSymbols = pFileData->GetSize();
     }
@@ -44,7 +44,7 @@
 #    error DXC is not supported on this platform
 #endif
 
-#include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
 
@@ -249,8 +249,7 @@ public:
             return E_FAIL;
         }
 
-        auto pFileData = DataBlobImpl::Create();
-        pSourceStream->ReadBlob(pFileData);
+        auto pFileData = ReadFileStreamData(pSourceStream);
 
         CComPtr<IDxcBlobEncoding> pSourceBlob;
 
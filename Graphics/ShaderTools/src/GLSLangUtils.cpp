@@ -45,6 +45,7 @@
 
 #include "DebugUtilities.hpp"
 #include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "RefCntAutoPtr.hpp"
 #include "ShaderToolsCommon.hpp"
 #include "SPIRVTools.hpp"
@@ -314,8 +315,7 @@ public:
             return nullptr;
         }
 
-        auto pFileData = DataBlobImpl::Create();
-        pSourceStream->ReadBlob(pFileData);
+        auto  pFileData   = ReadFileStreamData(pSourceStream);
         auto* pNewInclude =
             new IncludeResult{
                 headerName,
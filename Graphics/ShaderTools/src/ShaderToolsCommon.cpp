@@ -31,7 +31,7 @@
 
 #include "BasicFileSystem.hpp"
 #include "DebugUtilities.hpp"
-#include "DataBlobImpl.hpp"
+#include "MappedFileStream.hpp"
 #include "StringDataBlobImpl.hpp"
 #include "GraphicsAccessories.hpp"
 #include "ParsingTools.hpp"
@@ -220,8 +220,7 @@ ShaderSourceFileData ReadShaderSourceFile(const char*                      Sourc
                 if (pSourceStream == nullptr)
                     LOG_ERROR_AND_THROW("Failed to load shader source file '", FilePath, '\'');
 
-                SourceData.pFileData = DataBlobImpl::Create();
-                pSourceStream->ReadBlob(SourceData.pFileData);
+                SourceData.pFileData    = ReadFileStreamData(pSourceStream);
                 SourceData.Source       = reinterpret_cast<char*>(SourceData.pFileData->GetDataPtr());
                 SourceData.SourceLength = StaticCast<Uint32>(SourceData.pFileData->GetSize());
             }
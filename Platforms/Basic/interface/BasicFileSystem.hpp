@@ -44,6 +44,20 @@ enum class EFileAccessMode
     AppendUpdate
 };
 
+/// Expected access pattern of a memory-mapped file
+enum class EFileAccessPattern
+{
+    /// No special treatment
+    Normal,
+
+    /// Data is read sequentially: pages may be read ahead aggressively
+    /// and released soon after they have been accessed
+    Sequential,
+
+    /// Data is accessed in random order: read-ahead is not useful
+    Random
+};
+
 enum class FilePosOrigin
 {
     Start,
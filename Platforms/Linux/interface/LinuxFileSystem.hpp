@@ -39,6 +39,36 @@ namespace Diligent
 
 using LinuxFile = StandardFile;
 
+/// Memory mapping of a whole file opened for reading.
+
+/// The file is mapped privately (copy-on-write), so the contents may be modified
+/// through GetData() without affecting the file on disk. Pages are loaded on demand
+/// when they are first accessed.
+class LinuxMappedFile
+{
+public:
+    explicit LinuxMappedFile(const Char* Path) noexcept(false);
+    ~LinuxMappedFile();
+
+    // clang-format off
+    LinuxMappedFile           (const LinuxMappedFile&)  = delete;
+    LinuxMappedFile           (      LinuxMappedFile&&) = delete;
+    LinuxMappedFile& operator=(const LinuxMappedFile&)  = delete;
+    LinuxMappedFile& operator=(      LinuxMappedFile&&) = delete;
+    // clang-format on
+
+    void*       GetData() { return m_pData; }
+    const void* GetData() const { return m_pData; }
+    size_t      GetSize() const { return m_Size; }
+
+    /// Tells the system how the mapped data is going to be accessed.
+    bool SetAccessPattern(EFileAccessPattern Pattern);
+
+private:
+    void*  m_pData = nullptr;
+    size_t m_Size  = 0;
+};
+
 struct LinuxFileSystem : public BasicFileSystem
 {
 public:
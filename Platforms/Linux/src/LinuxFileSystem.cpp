@@ -29,6 +29,8 @@
 #include <stdlib.h>
 #include <unistd.h>
 #include <cstdio>
+#include <fcntl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <ftw.h>
@@ -36,6 +38,7 @@
 #include <mutex>
 #include <pwd.h>
 #include <errno.h>
+#include <string.h>
 
 #include "../interface/LinuxFileSystem.hpp"
 #include "Errors.hpp"
@@ -60,6 +63,74 @@ LinuxFile* LinuxFileSystem::OpenFile(const FileOpenAttribs& OpenAttribs)
 }
 #endif
 
+LinuxMappedFile::LinuxMappedFile(const Char* Path) noexcept(false)
+{
+    std::string path{Path};
+    LinuxFileSystem::CorrectSlashes(path);
+
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        LOG_ERROR_AND_THROW("Failed to open file ", path, "\nThe following error occurred: ", strerror(errno));
+
+    struct stat StatBuff;
+    if (fstat(fd, &StatBuff) != 0)
+    {
+        const auto Err = errno;
+        close(fd);
+        LOG_ERROR_AND_THROW("Failed to get the size of file ", path, "\nThe following error occurred: ", strerror(Err));
+    }
+
+    m_Size = static_cast<size_t>(StatBuff.st_size);
+    if (m_Size > 0)
+    {
+        // Private mapping with write access lets the caller patch the data in place:
+        // modified pages are copied on write and never reach the file.
+        void* pData = mmap(nullptr, m_Size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (pData == MAP_FAILED)
+        {
+            const auto Err = errno;
+            close(fd);
+            LOG_ERROR_AND_THROW("Failed to map file ", path, "\nThe following error occurred: ", strerror(Err));
+        }
+        m_pData = pData;
+    }
+
+    // The mapping keeps its own reference to the file
+    close(fd);
+}
+
+LinuxMappedFile::~LinuxMappedFile()
+{
+    if (m_pData != nullptr)
+        munmap(m_pData, m_Size);
+}
+
+bool LinuxMappedFile::SetAccessPattern(EFileAccessPattern Pattern)
+{
+    if (m_pData == nullptr)
+        return true;
+
+    int Advice = MADV_NORMAL;
+    switch (Pattern)
+    {
+        // clang-format off
+        case EFileAccessPattern::Normal:     Advice = MADV_NORMAL;     break;
+        case EFileAccessPattern::Sequential: Advice = MADV_SEQUENTIAL; break;
+        case EFileAccessPattern::Random:     Advice = MADV_RANDOM;     break;
+        // clang-format on
+        default:
+            UNEXPECTED("Unexpected file access pattern");
+    }
+
+    if (madvise(m_pData, m_Size, Advice) != 0)
+    {
+        LOG_WARNING_MESSAGE("madvise failed: ", strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
 bool LinuxFileSystem::FileExists(const Char* strFilePath)
 {
     std::string path{strFilePath};
@@ -0,0 +1,145 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#pragma once
+
+/// \file
+/// Defines Diligent::IMemoryAccounting interface
+
+#include "BasicTypes.h"
+
+DILIGENT_BEGIN_NAMESPACE(Diligent)
+
+/// Memory allocation statistics
+struct MemoryAllocationStats
+{
+    /// The name of the allocation group, or null for the total statistics.
+    const Char* Name DEFAULT_INITIALIZER(nullptr);
+
+    /// The number of bytes that are currently allocated.
+    Uint64 LiveBytes DEFAULT_INITIALIZER(0);
+
+    /// The maximum value of LiveBytes since the statistics
+    /// were created or the peak values were last reset.
+    Uint64 PeakBytes DEFAULT_INITIALIZER(0);
+
+    /// The number of allocations that have not been released yet.
+    Uint64 LiveAllocations DEFAULT_INITIALIZER(0);
+
+    /// The total number of allocations.
+
+    /// \remarks    The counter is never reset. The allocation rate can be computed
+    ///             from the difference of the values queried at different times.
+    Uint64 TotalAllocations DEFAULT_INITIALIZER(0);
+
+    /// The total number of allocated bytes.
+    Uint64 TotalBytes DEFAULT_INITIALIZER(0);
+};
+typedef struct MemoryAllocationStats MemoryAllocationStats;
+
+
+/// Memory accounting group type
+DILIGENT_TYPED_ENUM(MEMORY_ACCOUNTING_GROUP, Uint8)
+{
+    /// Allocations are grouped by their tag, i.e. the dbgDescription
+    /// argument of IMemoryAllocator::Allocate().
+    MEMORY_ACCOUNTING_GROUP_TAG = 0,
+
+    /// Allocations are grouped by the subsystem, which is identified by the name of
+    /// the source file that requested the allocation, i.e. the dbgFileName argument
+    /// of IMemoryAllocator::Allocate() without the directory.
+    ///
+    /// \remarks    For instance, object pool pages are allocated by FixedBlockMemoryAllocator.cpp,
+    ///             string pools by StringPool.hpp, and shader resource caches by ShaderResourceCache*.cpp.
+    MEMORY_ACCOUNTING_GROUP_SUBSYSTEM,
+
+    MEMORY_ACCOUNTING_GROUP_COUNT
+};
+
+
+#if DILIGENT_CPP_INTERFACE
+
+/// Interface to query the statistics of the memory allocations
+struct IMemoryAccounting
+{
+    /// Returns the statistics of all allocations.
+    virtual MemoryAllocationStats GetTotalStats() = 0;
+
+    /// Returns the statistics of the allocation groups.
+
+    /// \param [in]  Group    - Allocation group type, see Diligent::MEMORY_ACCOUNTING_GROUP.
+    /// \param [out] pStats   - A pointer to the array where the statistics will be written.
+    ///                         May be null.
+    /// \param [in]  MaxStats - The size of the pStats array.
+    ///
+    /// \return     The total number of groups of the given type.
+    ///
+    /// \remarks    Groups are sorted by the number of live bytes in descending order,
+    ///             so the first MaxStats elements contain the largest consumers.
+    ///             Group names remain valid for the lifetime of the object.
+    virtual Uint32 GetGroupStats(MEMORY_ACCOUNTING_GROUP Group, MemoryAllocationStats* pStats, Uint32 MaxStats) = 0;
+
+    /// Sets peak values of all statistics to the current live values.
+    virtual void ResetPeakStats() = 0;
+};
+
+#else
+
+struct IMemoryAccounting;
+
+// clang-format off
+
+struct IMemoryAccountingMethods
+{
+    MemoryAllocationStats (*GetTotalStats)  (struct IMemoryAccounting*);
+    Uint32                (*GetGroupStats)  (struct IMemoryAccounting*, MEMORY_ACCOUNTING_GROUP Group, MemoryAllocationStats* pStats, Uint32 MaxStats);
+    void                  (*ResetPeakStats) (struct IMemoryAccounting*);
+};
+
+struct IMemoryAccountingVtbl
+{
+    struct IMemoryAccountingMethods MemoryAccounting;
+};
+
+// clang-format on
+
+typedef struct IMemoryAccounting
+{
+    struct IMemoryAccountingVtbl* pVtbl;
+} IMemoryAccounting;
+
+// clang-format off
+
+#    define IMemoryAccounting_GetTotalStats(This)      CALL_IFACE_METHOD(MemoryAccounting, GetTotalStats,  This)
+#    define IMemoryAccounting_GetGroupStats(This, ...) CALL_IFACE_METHOD(MemoryAccounting, GetGroupStats,  This, __VA_ARGS__)
+#    define IMemoryAccounting_ResetPeakStats(This)     CALL_IFACE_METHOD(MemoryAccounting, ResetPeakStats, This)
+
+// clang-format on
+
+#endif
+
+DILIGENT_END_NAMESPACE // namespace Diligent
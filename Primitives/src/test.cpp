@@ -30,6 +30,7 @@
 #include "ReferenceCounters.h"
 #include "Object.h"
 #include "MemoryAllocator.h"
+#include "MemoryAccounting.h"
 #include "FormatString.hpp"
 #include "FileStream.h"
 #include "DataBlob.h"
@@ -35,6 +35,8 @@
 #include "SerializedPipelineState.h"
 #include "SerializedShader.h"
 #include "ShaderMacroHelper.hpp"
+#include "FileWrapper.hpp"
+#include "TempDirectory.hpp"
 
 #include "ResourceLayoutTestCommon.hpp"
 #include "gtest/gtest.h"
@@ -262,6 +264,89 @@ TEST(ArchiveTest, ResourceSignature)
 }
 
 
+TEST(ArchiveTest, LoadArchiveFromFile)
+{
+    auto* pEnv    = GPUTestingEnvironment::GetInstance();
+    auto* pDevice = pEnv->GetDevice();
+
+    RefCntAutoPtr<IDearchiver> pDearchiver;
+    DearchiverCreateInfo       DearchiverCI{};
+    pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &pDearchiver);
+    if (!pDearchiver)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    constexpr char PRS1Name[] = "ArchiveTest.LoadArchiveFromFile - PRS 1";
+    constexpr char PRS2Name[] = "ArchiveTest.LoadArchiveFromFile - PRS 2";
+
+    RefCntAutoPtr<IDataBlob>                  pArchive;
+    RefCntAutoPtr<IPipelineResourceSignature> pRefPRS_1;
+    RefCntAutoPtr<IPipelineResourceSignature> pRefPRS_2;
+    ArchivePRS(pArchive, PRS1Name, PRS2Name, pRefPRS_1, pRefPRS_2, GetDeviceBits());
+    ASSERT_NE(pArchive, nullptr);
+
+    TempDirectory TmpDir;
+    const auto    FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "Archive.bin";
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        ASSERT_TRUE(File->Write(pArchive->GetConstDataPtr(), pArchive->GetSize()));
+    }
+
+    ASSERT_TRUE(pDearchiver->LoadArchiveFromFile(FilePath.c_str(), ContentVersion));
+
+    for (auto* PRSName : {PRS1Name, PRS2Name})
+    {
+        ResourceSignatureUnpackInfo UnpackInfo;
+        UnpackInfo.Name                     = PRSName;
+        UnpackInfo.pDevice                  = pDevice;
+        UnpackInfo.SRBAllocationGranularity = 10;
+
+        RefCntAutoPtr<IPipelineResourceSignature> pUnpackedPRS;
+        pDearchiver->UnpackResourceSignature(UnpackInfo, &pUnpackedPRS);
+        ASSERT_NE(pUnpackedPRS, nullptr);
+        EXPECT_TRUE(pUnpackedPRS->IsCompatibleWith(PRSName == PRS1Name ? pRefPRS_1 : pRefPRS_2));
+    }
+
+    // Release the mapping before the temporary directory is removed
+    pDearchiver->Reset();
+}
+
+TEST(ArchiveTest, CompressArchive)
+{
+    auto* pEnv             = GPUTestingEnvironment::GetInstance();
+    auto* pDevice          = pEnv->GetDevice();
+    auto* pArchiverFactory = pEnv->GetArchiverFactory();
+
+    RefCntAutoPtr<IDearchiver> pDearchiver;
+    DearchiverCreateInfo       DearchiverCI{};
+    pDevice->GetEngineFactory()->CreateDearchiver(DearchiverCI, &pDearchiver);
+    if (!pDearchiver || !pArchiverFactory)
+        GTEST_SKIP() << "Archiver library is not loaded";
+
+    constexpr char PRS1Name[] = "ArchiveTest.CompressArchive - PRS 1";
+    constexpr char PRS2Name[] = "ArchiveTest.CompressArchive - PRS 2";
+
+    RefCntAutoPtr<IDataBlob>                  pArchive;
+    RefCntAutoPtr<IPipelineResourceSignature> pRefPRS_1;
+    RefCntAutoPtr<IPipelineResourceSignature> pRefPRS_2;
+    ArchivePRS(pArchive, PRS1Name, PRS2Name, pRefPRS_1, pRefPRS_2, GetDeviceBits());
+    ASSERT_NE(pArchive, nullptr);
+
+    RefCntAutoPtr<IDataBlob> pCompressedArchive;
+    ASSERT_TRUE(pArchiverFactory->CompressArchive(pArchive, true, &pCompressedArchive));
+    ASSERT_NE(pCompressedArchive, nullptr);
+    LOG_INFO_MESSAGE("Archive size: ", pArchive->GetSize(), " bytes, compressed size: ", pCompressedArchive->GetSize(),
+                     " bytes (", static_cast<double>(pArchive->GetSize()) / static_cast<double>(pCompressedArchive->GetSize()), ":1)");
+
+    UnpackPRS(pCompressedArchive, PRS1Name, PRS2Name, pRefPRS_1, pRefPRS_2);
+
+    RefCntAutoPtr<IDataBlob> pDecompressedArchive;
+    ASSERT_TRUE(pArchiverFactory->CompressArchive(pCompressedArchive, false, &pDecompressedArchive));
+    ASSERT_NE(pDecompressedArchive, nullptr);
+
+    UnpackPRS(pDecompressedArchive, PRS1Name, PRS2Name, pRefPRS_1, pRefPRS_2);
+}
+
 TEST(ArchiveTest, RemoveDeviceData)
 {
     auto* pEnv             = GPUTestingEnvironment::GetInstance();
@@ -30,6 +30,7 @@
 #include <vector>
 #include <algorithm>
 #include <thread>
+#include <cstring>
 
 #include "GPUTestingEnvironment.hpp"
 #include "FastRand.hpp"
@@ -69,7 +70,7 @@ TEST(BufferSuballocatorTest, Create)
     pAlloc.Release();
 }
 
-TEST(BufferSuballocatorTest, Allocate)
+void TestAllocate(bool UseTLSF)
 {
     auto* pEnv     = GPUTestingEnvironment::GetInstance();
     auto* pDevice  = pEnv->GetDevice();
@@ -83,6 +84,7 @@ TEST(BufferSuballocatorTest, Allocate)
     CI.Desc.Size      = 32;
     CI.ExpansionSize  = 32;
     CI.MaxSize        = 1u << 20u;
+    CI.UseTLSF        = UseTLSF;
 
     RefCntAutoPtr<IBufferSuballocator> pAllocator;
     CreateBufferSuballocator(pDevice, CI, &pAllocator);
@@ -153,4 +155,110 @@ TEST(BufferSuballocatorTest, Allocate)
     }
 }
 
+TEST(BufferSuballocatorTest, Allocate)
+{
+    TestAllocate(false);
+}
+
+TEST(BufferSuballocatorTest, Allocate_TLSF)
+{
+    TestAllocate(true);
+}
+
+TEST(BufferSuballocatorTest, Defragment)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr Uint32 BufferSize     = 4096;
+    constexpr Uint32 NumAllocations = 32;
+    constexpr Uint32 AllocSize      = 100;
+    constexpr Uint32 Alignment      = 16;
+
+    BufferSuballocatorCreateInfo CI;
+    CI.Desc.Name      = "Buffer Suballocator Defragment Test";
+    CI.Desc.BindFlags = BIND_VERTEX_BUFFER;
+    CI.Desc.Size      = BufferSize;
+
+    RefCntAutoPtr<IBufferSuballocator> pAllocator;
+    CreateBufferSuballocator(pDevice, CI, &pAllocator);
+    ASSERT_NE(pAllocator, nullptr);
+
+    std::vector<RefCntAutoPtr<IBufferSuballocation>> Allocs(NumAllocations);
+    for (auto& Alloc : Allocs)
+    {
+        pAllocator->Allocate(AllocSize, Alignment, &Alloc);
+        ASSERT_NE(Alloc, nullptr);
+    }
+
+    auto* pBuffer = pAllocator->Update(pDevice, pContext);
+    ASSERT_NE(pBuffer, nullptr);
+
+    // Fill every allocation with its own value
+    for (Uint32 i = 0; i < NumAllocations; ++i)
+    {
+        const std::vector<Uint8> Data(AllocSize, static_cast<Uint8>(i + 1));
+        pContext->UpdateBuffer(pBuffer, Allocs[i]->GetOffset(), AllocSize, Data.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    }
+
+    // Release every other allocation to fragment the buffer
+    for (Uint32 i = 0; i < NumAllocations; i += 2)
+        Allocs[i].Release();
+
+    BufferSuballocatorUsageStats Stats;
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+    // Released allocations and the unused space at the end of the buffer
+    EXPECT_EQ(Stats.FreeChunkCount, NumAllocations / 2 + 1);
+    EXPECT_GT(Stats.Fragmentation, 0.f);
+
+    const auto Version  = pAllocator->GetVersion();
+    Uint32     NumSteps = 0;
+    while (pAllocator->Defragment(pDevice, pContext, 2 * AllocSize) != 0)
+    {
+        ++NumSteps;
+        ASSERT_LE(NumSteps, NumAllocations);
+    }
+    // Half of the remaining allocations are moved, two per step
+    EXPECT_EQ(NumSteps, NumAllocations / 8);
+    EXPECT_NE(pAllocator->GetVersion(), Version);
+    EXPECT_EQ(pAllocator->GetBuffer(), pBuffer);
+
+    pAllocator->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+    EXPECT_EQ(Stats.FreeChunkCount, 1u);
+    EXPECT_EQ(Stats.Fragmentation, 0.f);
+    EXPECT_EQ(Stats.MaxFreeChunkSize, BufferSize - NumAllocations / 2 * AlignUp(AllocSize, Alignment));
+
+    RefCntAutoPtr<IBuffer> pStagingBuff;
+    {
+        BufferDesc BuffDesc;
+        BuffDesc.Name           = "Staging buffer for buffer suballocator defragment test";
+        BuffDesc.Usage          = USAGE_STAGING;
+        BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+        BuffDesc.Size           = BufferSize;
+        pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuff);
+        ASSERT_NE(pStagingBuff, nullptr);
+    }
+    pContext->CopyBuffer(pBuffer, 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION, pStagingBuff, 0, BufferSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+    pContext->WaitForIdle();
+
+    void* pData = nullptr;
+    pContext->MapBuffer(pStagingBuff, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+    ASSERT_NE(pData, nullptr);
+    for (Uint32 i = 1; i < NumAllocations; i += 2)
+    {
+        const auto Offset = Allocs[i]->GetOffset();
+        EXPECT_LT(Offset, NumAllocations / 2 * AlignUp(AllocSize, Alignment));
+        EXPECT_EQ(Offset % Alignment, 0u);
+
+        const std::vector<Uint8> RefData(AllocSize, static_cast<Uint8>(i + 1));
+        EXPECT_EQ(memcmp(static_cast<const Uint8*>(pData) + Offset, RefData.data(), AllocSize), 0) << "Allocation " << i;
+    }
+    pContext->UnmapBuffer(pStagingBuff, MAP_READ);
+}
+
 } // namespace
@@ -29,6 +29,7 @@
 #include <vector>
 #include <algorithm>
 #include <thread>
+#include <cstring>
 
 #include "GPUTestingEnvironment.hpp"
 #include "FastRand.hpp"
@@ -183,4 +184,108 @@ TEST(VertexPoolTest, Allocate)
     }
 }
 
+TEST(VertexPoolTest, Defragment)
+{
+    auto* pEnv     = GPUTestingEnvironment::GetInstance();
+    auto* pDevice  = pEnv->GetDevice();
+    auto* pContext = pEnv->GetDeviceContext();
+
+    GPUTestingEnvironment::ScopedReleaseResources AutoreleaseResources;
+
+    constexpr VertexPoolElementDesc Elements[] =
+        {
+            VertexPoolElementDesc{16},
+            VertexPoolElementDesc{24, BIND_SHADER_RESOURCE, USAGE_DEFAULT, BUFFER_MODE_STRUCTURED, CPU_ACCESS_NONE},
+        };
+    constexpr Uint32 VertexSize     = 16 + 24;
+    constexpr Uint32 PoolSize       = 256;
+    constexpr Uint32 NumAllocations = 16;
+    constexpr Uint32 AllocSize      = 10;
+
+    VertexPoolCreateInfo CI;
+    CI.Desc.Name        = "Vertex pool defragment test";
+    CI.Desc.pElements   = Elements;
+    CI.Desc.NumElements = _countof(Elements);
+    CI.Desc.VertexCount = PoolSize;
+
+    RefCntAutoPtr<IVertexPool> pVtxPool;
+    CreateVertexPool(pDevice, CI, &pVtxPool);
+    ASSERT_NE(pVtxPool, nullptr);
+
+    std::vector<RefCntAutoPtr<IVertexPoolAllocation>> Allocs(NumAllocations);
+    for (auto& Alloc : Allocs)
+    {
+        pVtxPool->Allocate(AllocSize, &Alloc);
+        ASSERT_NE(Alloc, nullptr);
+    }
+    pVtxPool->UpdateAll(pDevice, pContext);
+
+    // Fill every allocation with its own value
+    for (Uint32 elem = 0; elem < _countof(Elements); ++elem)
+    {
+        const auto ElemSize = Elements[elem].Size;
+        for (Uint32 i = 0; i < NumAllocations; ++i)
+        {
+            const std::vector<Uint8> Data(AllocSize * ElemSize, static_cast<Uint8>(i + 1));
+            pContext->UpdateBuffer(pVtxPool->GetBuffer(elem), Allocs[i]->GetStartVertex() * ElemSize, AllocSize * ElemSize, Data.data(), RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        }
+    }
+
+    // Release every other allocation to fragment the pool
+    for (Uint32 i = 0; i < NumAllocations; i += 2)
+        Allocs[i].Release();
+
+    VertexPoolUsageStats Stats;
+    pVtxPool->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+    // Released allocations and the unused space at the end of the pool
+    EXPECT_EQ(Stats.FreeRangeCount, NumAllocations / 2 + 1);
+    EXPECT_GT(Stats.Fragmentation, 0.f);
+
+    const auto Version = pVtxPool->GetVersion();
+    // Allocations at the end of the pool fill the gaps at the beginning
+    EXPECT_EQ(pVtxPool->Defragment(pDevice, pContext, 0), Uint64{NumAllocations / 4 * AllocSize * VertexSize});
+    EXPECT_EQ(pVtxPool->Defragment(pDevice, pContext, 0), Uint64{0});
+    EXPECT_NE(pVtxPool->GetVersion(), Version);
+
+    pVtxPool->GetUsageStats(Stats);
+    EXPECT_EQ(Stats.AllocationCount, NumAllocations / 2);
+    EXPECT_EQ(Stats.FreeRangeCount, 1u);
+    EXPECT_EQ(Stats.MaxFreeRangeSize, PoolSize - NumAllocations / 2 * AllocSize);
+    EXPECT_EQ(Stats.Fragmentation, 0.f);
+
+    for (Uint32 elem = 0; elem < _countof(Elements); ++elem)
+    {
+        const auto ElemSize = Elements[elem].Size;
+
+        RefCntAutoPtr<IBuffer> pStagingBuff;
+        {
+            BufferDesc BuffDesc;
+            BuffDesc.Name           = "Staging buffer for vertex pool defragment test";
+            BuffDesc.Usage          = USAGE_STAGING;
+            BuffDesc.CPUAccessFlags = CPU_ACCESS_READ;
+            BuffDesc.Size           = PoolSize * ElemSize;
+            pDevice->CreateBuffer(BuffDesc, nullptr, &pStagingBuff);
+            ASSERT_NE(pStagingBuff, nullptr);
+        }
+        pContext->CopyBuffer(pVtxPool->GetBuffer(elem), 0, RESOURCE_STATE_TRANSITION_MODE_TRANSITION,
+                             pStagingBuff, 0, PoolSize * ElemSize, RESOURCE_STATE_TRANSITION_MODE_TRANSITION);
+        pContext->WaitForIdle();
+
+        void* pData = nullptr;
+        pContext->MapBuffer(pStagingBuff, MAP_READ, MAP_FLAG_DO_NOT_WAIT, pData);
+        ASSERT_NE(pData, nullptr);
+        for (Uint32 i = 1; i < NumAllocations; i += 2)
+        {
+            const auto StartVertex = Allocs[i]->GetStartVertex();
+            EXPECT_LT(StartVertex, NumAllocations / 2 * AllocSize);
+
+            const std::vector<Uint8> RefData(AllocSize * ElemSize, static_cast<Uint8>(i + 1));
+            EXPECT_EQ(memcmp(static_cast<const Uint8*>(pData) + StartVertex * ElemSize, RefData.data(), RefData.size()), 0)
+                << "Element " << elem << ", allocation " << i;
+        }
+        pContext->UnmapBuffer(pStagingBuff, MAP_READ);
+    }
+}
+
 } // namespace
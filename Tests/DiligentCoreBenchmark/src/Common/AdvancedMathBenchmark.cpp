@@ -0,0 +1,90 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "AdvancedMath.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Compares the performance of TriangulatePolygon() and TriangulatePolygonWithHoles() for 100 to 1M vertices
+TEST(Common_AdvancedMath, TriangulatePolygonBenchmark)
+{
+    FastRandFloat Rnd{0, -1, 1};
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "Triangulation time, ms:\n"
+       << "Vertices     TriangulatePolygon  TriangulatePolygonWithHoles\n";
+    for (size_t NumVerts : {100, 1000, 10000, 100000, 1000000})
+    {
+        // Smooth contour with a small jitter relative to the vertex spacing, similar to glyph or map outlines
+        std::vector<float2> Polygon(NumVerts);
+        for (size_t i = 0; i < NumVerts; ++i)
+        {
+            const float Angle = static_cast<float>(i) / static_cast<float>(NumVerts) * 2.f * PI_F;
+            const float R     = 100.f * (1.f + 0.2f * std::sin(7.f * Angle)) + Rnd() * 300.f / static_cast<float>(NumVerts);
+            Polygon[i]        = float2{std::cos(Angle), std::sin(Angle)} * R;
+        }
+
+        ss << std::setw(8) << NumVerts;
+
+        // Ear clipping is quadratic and takes too long for large polygons
+        if (NumVerts <= 10000)
+        {
+            Timer      T;
+            const auto Tris = TriangulatePolygon<Uint32>(Polygon, false);
+            ss << std::setw(23) << T.GetElapsedTime() * 1000;
+            EXPECT_EQ(Tris.size(), (NumVerts - 2) * 3);
+        }
+        else
+        {
+            ss << std::setw(23) << "-";
+        }
+
+        {
+            Timer      T;
+            const auto Tris = TriangulatePolygonWithHoles<Uint32>(Polygon);
+            ss << std::setw(29) << T.GetElapsedTime() * 1000 << '\n';
+            EXPECT_EQ(Tris.size(), (NumVerts - 2) * 3);
+        }
+    }
+    LOG_INFO_MESSAGE(ss.str());
+}
+
+} // namespace
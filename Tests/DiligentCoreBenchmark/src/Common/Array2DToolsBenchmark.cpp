@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "Array2DTools.hpp"
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+void GetArray2DMinMaxValueScalar(const float* pData, size_t Stride, Uint32 Width, Uint32 Height, float& Min, float& Max)
+{
+    Min = Max = pData[0];
+    for (size_t row = 0; row < Height; ++row)
+    {
+        for (size_t col = 0; col < Width; ++col)
+        {
+            Min = std::min(Min, pData[col + row * Stride]);
+            Max = std::max(Max, pData[col + row * Stride]);
+        }
+    }
+}
+
+// Compares the min/max reductions with a scalar loop and measures the min/max pyramid queries and updates
+TEST(Common_Array2DTools, MinMaxBenchmark)
+{
+    const Uint32 Width  = 4096;
+    const Uint32 Height = 4096;
+
+    std::vector<float> Data(size_t{Width} * Height);
+    FastRandFloat      Rnd{0, -100, +100};
+    for (auto& Val : Data)
+        Val = Rnd();
+
+    Timer  T;
+    double StartTime = T.GetElapsedTime();
+    float  Min, Max;
+    GetArray2DMinMaxValueScalar(Data.data(), Width, Width, Height, Min, Max);
+    LOG_INFO_MESSAGE("Scalar loop:                   ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    GetArray2DMinMaxValue(Data.data(), Width, Width, Height, Min, Max);
+    LOG_INFO_MESSAGE("GetArray2DMinMaxValue:         ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{std::max(std::thread::hardware_concurrency(), 2u) - 1});
+    StartTime        = T.GetElapsedTime();
+    GetArray2DMinMaxValueParallel(pThreadPool, std::thread::hardware_concurrency(), Data.data(), Width, Width, Height, Min, Max);
+    LOG_INFO_MESSAGE("GetArray2DMinMaxValueParallel: ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    Array2DMinMaxPyramid Pyramid{Data.data(), Width, Width, Height};
+    LOG_INFO_MESSAGE("Array2DMinMaxPyramid build:    ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    constexpr Uint32 NumQueries = 1000;
+    FastRandInt      RndInt{0, 0, 2047};
+
+    StartTime = T.GetElapsedTime();
+    for (Uint32 i = 0; i < NumQueries; ++i)
+        GetArray2DMinMaxValue(&Data[RndInt() + RndInt() * size_t{Width}], Width, 2048, 2048, Min, Max);
+    LOG_INFO_MESSAGE(NumQueries, " 2048x2048 queries, array:   ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    for (Uint32 i = 0; i < NumQueries; ++i)
+        Pyramid.GetMinMax(RndInt(), RndInt(), 2048, 2048, Min, Max);
+    LOG_INFO_MESSAGE(NumQueries, " 2048x2048 queries, pyramid: ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    for (Uint32 i = 0; i < NumQueries; ++i)
+        Pyramid.Update(RndInt(), RndInt(), 64, 64);
+    LOG_INFO_MESSAGE(NumQueries, " 64x64 pyramid updates:      ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+}
+
+} // namespace
@@ -0,0 +1,92 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "FilteringTools.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Compares batched bilinear sampling and grid resampling with sampling one value at a time
+TEST(Common_FilteringTools, BilinearBenchmark)
+{
+    constexpr Uint32 Width  = 1024;
+    constexpr Uint32 Height = 1024;
+
+    std::vector<float> Data(size_t{Width} * Height);
+    FastRandFloat      Rnd{0, 0, 1};
+    for (auto& Val : Data)
+        Val = Rnd();
+
+    constexpr size_t   NumSamples = 4 << 20;
+    std::vector<float> U(NumSamples), V(NumSamples), Samples(NumSamples);
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        U[i] = Rnd();
+        V[i] = Rnd();
+    }
+
+    Timer  T;
+    double StartTime = T.GetElapsedTime();
+    for (size_t i = 0; i < NumSamples; ++i)
+        Samples[i] = FilterTexture2DBilinear<float, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_WRAP, true>(Width, Height, Data.data(), Width, U[i], V[i]);
+    LOG_INFO_MESSAGE(NumSamples, " samples, single:  ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    FilterTexture2DBilinear<float, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_WRAP, true>(Width, Height, Data.data(), Width, U.data(), V.data(), NumSamples, Samples.data());
+    LOG_INFO_MESSAGE(NumSamples, " samples, batched: ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    constexpr Uint32 DstWidth  = 2048;
+    constexpr Uint32 DstHeight = 2048;
+
+    StartTime = T.GetElapsedTime();
+    for (Uint32 y = 0; y < DstHeight; ++y)
+    {
+        for (Uint32 x = 0; x < DstWidth; ++x)
+        {
+            const float u = (static_cast<float>(x) + 0.5f) / static_cast<float>(DstWidth);
+            const float v = (static_cast<float>(y) + 0.5f) / static_cast<float>(DstHeight);
+
+            Samples[x + y * size_t{DstWidth}] = FilterTexture2DBilinearClamp<float, float>(Width, Height, Data.data(), Width, u, v);
+        }
+    }
+    LOG_INFO_MESSAGE(DstWidth, "x", DstHeight, " resample, single: ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    ResampleTexture2DBilinearClamp(Width, Height, Data.data(), Width, DstWidth, DstHeight, Samples.data(), DstWidth);
+    LOG_INFO_MESSAGE(DstWidth, "x", DstHeight, " resample, grid:   ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+}
+
+} // namespace
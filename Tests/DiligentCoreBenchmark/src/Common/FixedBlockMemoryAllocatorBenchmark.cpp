@@ -0,0 +1,93 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "FixedBlockMemoryAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <iomanip>
+#include <thread>
+#include <vector>
+
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Compares the throughput of the allocator with and without the thread cache
+TEST(Common_FixedBlockMemoryAllocator, ThroughputBenchmark)
+{
+    constexpr Uint32 AllocSize             = 64;
+    constexpr Uint32 NumAllocationsPerPage = 256;
+    constexpr Uint32 NumIterations         = 8192;
+    constexpr Uint32 NumAllocations        = 32;
+
+    LOG_INFO_MESSAGE("Running fixed block allocator benchmark on ", std::thread::hardware_concurrency(), " cores");
+
+    for (Uint32 NumThreads = 1; NumThreads <= 32; NumThreads *= 2)
+    {
+        double Time[2] = {};
+        for (bool EnableThreadCache : {false, true})
+        {
+            FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, EnableThreadCache};
+
+            Timer T;
+
+            std::vector<std::thread> Threads;
+            for (Uint32 t = 0; t < NumThreads; ++t)
+            {
+                Threads.emplace_back(
+                    [&]() //
+                    {
+                        std::array<void*, NumAllocations> Allocations;
+                        for (Uint32 it = 0; it < NumIterations; ++it)
+                        {
+                            for (auto& pBlock : Allocations)
+                                pBlock = TestAllocator.Allocate(AllocSize, "Fixed block allocator benchmark", __FILE__, __LINE__);
+                            for (auto* pBlock : Allocations)
+                                TestAllocator.Free(pBlock);
+                        }
+                    });
+            }
+            for (auto& Thread : Threads)
+                Thread.join();
+
+            Time[EnableThreadCache ? 1 : 0] = T.GetElapsedTime();
+        }
+
+        const double NumOps = static_cast<double>(NumThreads) * NumIterations * NumAllocations;
+        LOG_INFO_MESSAGE(std::setw(2), NumThreads, " threads: ", std::fixed, std::setprecision(1),
+                         "mutex only ", std::setw(6), NumOps / Time[0] * 1e-6, " M alloc+free/s; ",
+                         "thread cache ", std::setw(6), NumOps / Time[1] * 1e-6, " M alloc+free/s");
+    }
+}
+
+} // namespace
@@ -0,0 +1,78 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "HashUtils.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Compares the throughput of the raw hash algorithms for data sizes from 8 bytes to 1 MB
+TEST(Common_HashUtils, ComputeHashRawBenchmark)
+{
+    std::vector<Uint8> Data(size_t{1} << 20);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i * 13u + (i >> 8));
+
+    auto Measure = [&](RawHashAlgorithm Algorithm, size_t Size) {
+        // Hash about 256 MB in total
+        const size_t NumIterations = std::max((size_t{256} << 20) / Size, size_t{1});
+
+        size_t Hash = 0;
+        Timer  T;
+        for (size_t i = 0; i < NumIterations; ++i)
+            Hash += ComputeHashRaw(&Data[(i * 64) % (Data.size() - Size + 1)], Size, Algorithm);
+        const auto Time = T.GetElapsedTime();
+        EXPECT_NE(Hash, size_t{0});
+
+        // Throughput in GB/s
+        return static_cast<double>(NumIterations * Size) / Time / double{1 << 30};
+    };
+
+    std::stringstream ss;
+    ss << "ComputeHashRaw throughput, GB/s:\n"
+       << "      Size    Combine   MultiplyMix\n";
+    for (size_t Size : {size_t{8}, size_t{64}, size_t{512}, size_t{4} << 10, size_t{32} << 10, size_t{256} << 10, size_t{1} << 20})
+    {
+        ss << std::setw(10) << Size << std::fixed << std::setprecision(2)
+           << std::setw(11) << Measure(RawHashAlgorithm::Combine, Size)
+           << std::setw(14) << Measure(RawHashAlgorithm::MultiplyMix, Size) << '\n';
+    }
+    LOG_INFO_MESSAGE(ss.str());
+}
+
+} // namespace
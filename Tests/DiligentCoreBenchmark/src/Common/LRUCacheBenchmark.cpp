@@ -0,0 +1,113 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "LRUCache.hpp"
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "ThreadSignal.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct CacheData
+{
+    Uint32 Value = ~0u;
+};
+
+template <typename CacheType>
+void GetOrCreate(CacheType& Cache, int Key)
+{
+    Cache.Get(Key,
+              [&](CacheData& Data, size_t& Size) //
+              {
+                  Data.Value = static_cast<Uint32>(Key);
+                  Size       = 1;
+              });
+}
+
+template <typename CacheType>
+double MeasureHitLatency(CacheType& Cache, Uint32 NumThreads)
+{
+    constexpr int NumKeys       = 256;
+    constexpr int NumIterations = 1 << 16;
+
+    for (int Key = 0; Key < NumKeys; ++Key)
+        GetOrCreate(Cache, Key);
+
+    std::vector<std::thread> Threads(NumThreads);
+    Threading::Signal        StartSignal;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                StartSignal.Wait();
+                for (int i = 0; i < NumIterations; ++i)
+                    GetOrCreate(Cache, static_cast<int>((i + ThreadId * 31) % NumKeys));
+            },
+            i);
+    }
+
+    Timer T;
+    StartSignal.Trigger(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+    const auto Time = T.GetElapsedTime();
+
+    // Average latency of a single Get, in nanoseconds
+    return Time * 1e+9 / NumIterations;
+}
+
+// Compares the hit latency of different cache configurations
+TEST(Common_ShardedLRUCache, HitLatencyBenchmark)
+{
+    std::stringstream ss;
+    ss << "Get() hit latency, ns:\n"
+       << "Threads      LRUCache   Sharded    Sharded (CLOCK)\n";
+    for (Uint32 NumThreads = 1; NumThreads <= 16; NumThreads *= 2)
+    {
+        LRUCache<int, CacheData>        Cache{1024};
+        ShardedLRUCache<int, CacheData> ShardedCache{1024, 16, LRUCacheEvictionPolicy::Exact};
+        ShardedLRUCache<int, CacheData> ClockCache{1024, 16, LRUCacheEvictionPolicy::Clock};
+
+        ss << std::setw(7) << NumThreads << std::fixed << std::setprecision(1)
+           << std::setw(14) << MeasureHitLatency(Cache, NumThreads)
+           << std::setw(10) << MeasureHitLatency(ShardedCache, NumThreads)
+           << std::setw(19) << MeasureHitLatency(ClockCache, NumThreads) << '\n';
+    }
+    LOG_INFO_MESSAGE(ss.str());
+}
+
+} // namespace
@@ -0,0 +1,135 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "BasicMath.hpp"
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+float4x4 MakeRandomMatrix(FastRandFloat& Rnd)
+{
+    float4x4 m;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+            m[i][j] = Rnd();
+        // Make the matrix diagonally dominant so that it is well-conditioned
+        m[i][i] += 4;
+    }
+    return m;
+}
+
+// Compares the performance of the scalar and SIMD implementations
+TEST(Common_BasicMath, MatrixSIMDBenchmark)
+{
+    constexpr size_t NumMatrices   = 1024;
+    constexpr size_t NumIterations = 1024;
+
+    FastRandFloat         Rnd{0, -1, 1};
+    std::vector<float4x4> Matrices(NumMatrices);
+    for (auto& m : Matrices)
+        m = MakeRandomMatrix(Rnd);
+    std::vector<float3> Points(NumMatrices * 16);
+    for (auto& Pt : Points)
+        Pt = float3{Rnd(), Rnd(), Rnd()};
+    std::vector<float3> Dst(Points.size());
+
+    float4x4 Res;
+
+    auto MulScalar = [&]() {
+        for (size_t i = 1; i < NumMatrices; ++i)
+            Res += Matrices[i - 1] * Matrices[i];
+    };
+    auto InvScalar = [&]() {
+        for (size_t i = 0; i < NumMatrices; ++i)
+            Res += Matrices[i].Inverse();
+    };
+    auto TransformScalar = [&]() {
+        for (size_t i = 0; i < Points.size(); ++i)
+            Dst[i] = Points[i] * Matrices[0];
+    };
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    auto MulSIMD = [&]() {
+        for (size_t i = 1; i < NumMatrices; ++i)
+        {
+            float4x4 m;
+            MathSIMD::MulMatrix4x4(Matrices[i - 1].Data(), Matrices[i].Data(), m.Data());
+            Res += m;
+        }
+    };
+    auto InvSIMD = [&]() {
+        for (size_t i = 0; i < NumMatrices; ++i)
+        {
+            float4x4 m;
+            MathSIMD::InverseMatrix4x4(Matrices[i].Data(), m.Data());
+            Res += m;
+        }
+    };
+#endif
+    auto TransformBatch = [&]() {
+        TransformPoints(Points.data(), Dst.data(), Points.size(), Matrices[0]);
+    };
+
+    // Returns the average time of a single operation, in nanoseconds
+    auto Measure = [&](const auto& Op, size_t NumOps) {
+        Timer T;
+        for (size_t i = 0; i < NumIterations; ++i)
+            Op();
+        return T.GetElapsedTime() * 1e+9 / static_cast<double>(NumIterations * NumOps);
+    };
+
+    std::stringstream ss;
+    ss << std::fixed << std::setprecision(2)
+       << "Time per operation, ns:\n"
+       << "Operation              Operators   MathSIMD\n"
+       << "float4x4 * float4x4" << std::setw(14) << Measure(MulScalar, NumMatrices - 1);
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    ss << std::setw(11) << Measure(MulSIMD, NumMatrices - 1);
+#endif
+    ss << "\nfloat4x4::Inverse()" << std::setw(14) << Measure(InvScalar, NumMatrices);
+#if DILIGENT_MATH_SIMD_SUPPORTED
+    ss << std::setw(11) << Measure(InvSIMD, NumMatrices);
+#endif
+    ss << "\nTransformPoints()  " << std::setw(14) << Measure(TransformScalar, Points.size())
+       << std::setw(11) << Measure(TransformBatch, Points.size()) << '\n';
+    LOG_INFO_MESSAGE(ss.str());
+
+    EXPECT_NE(Res, float4x4{});
+}
+
+} // namespace
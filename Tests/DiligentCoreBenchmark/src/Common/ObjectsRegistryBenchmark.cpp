@@ -0,0 +1,117 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ObjectsRegistry.hpp"
+
+#include "gtest/gtest.h"
+
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "ObjectBase.hpp"
+#include "ThreadSignal.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+struct RegistryDataObj : public ObjectBase<IObject>
+{
+    RegistryDataObj(IReferenceCounters* pRefCounters, Uint32 _Value) :
+        ObjectBase<IObject>{pRefCounters},
+        Value{_Value}
+    {}
+
+    Uint32 Value = ~0u;
+
+    static RefCntAutoPtr<RegistryDataObj> Create(Uint32 _Value)
+    {
+        return RefCntAutoPtr<RegistryDataObj>{MakeNewRCObj<RegistryDataObj>()(_Value)};
+    }
+};
+
+double MeasureLookupTime(bool ReadMostly, Uint32 NumThreads)
+{
+    constexpr Uint32 NumKeys       = 256;
+    constexpr Uint32 NumIterations = 1 << 15;
+
+    ObjectsRegistry<int, RefCntAutoPtr<RegistryDataObj>> Registry{1024, ReadMostly};
+
+    std::vector<RefCntAutoPtr<RegistryDataObj>> Objects(NumKeys);
+    for (Uint32 i = 0; i < NumKeys; ++i)
+        Objects[i] = Registry.Get(static_cast<int>(i), std::bind(RegistryDataObj::Create, i));
+    // Warm up the snapshot
+    for (Uint32 i = 0; i < NumKeys; ++i)
+        Registry.Get(static_cast<int>(i));
+
+    std::vector<std::thread> Threads(NumThreads);
+    Threading::Signal        StartSignal;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                StartSignal.Wait();
+                for (Uint32 i = 0; i < NumIterations; ++i)
+                {
+                    const auto Key = (i + ThreadId * 37) % NumKeys;
+                    if (Registry.Get(static_cast<int>(Key)) != Objects[Key])
+                        ADD_FAILURE() << "Unexpected object";
+                }
+            },
+            i);
+    }
+
+    Timer T;
+    StartSignal.Trigger(true);
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    // Average time of a single lookup in each thread, in nanoseconds
+    return T.GetElapsedTime() * 1e+9 / NumIterations;
+}
+
+// Compares the lookup times of the default and read-mostly modes
+TEST(Common_ObjectsRegistry, ContentionBenchmark)
+{
+    std::stringstream ss;
+    ss << "ObjectsRegistry::Get() lookup time, ns:\n"
+       << "Threads    Default   Read-mostly\n";
+    for (Uint32 NumThreads = 1; NumThreads <= 16; NumThreads *= 2)
+    {
+        ss << std::setw(7) << NumThreads << std::fixed << std::setprecision(1)
+           << std::setw(11) << MeasureLookupTime(false, NumThreads)
+           << std::setw(14) << MeasureLookupTime(true, NumThreads) << '\n';
+    }
+    LOG_INFO_MESSAGE(ss.str());
+}
+
+} // namespace
@@ -0,0 +1,121 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <thread>
+
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Enqueues root tasks that enqueue child tasks from worker threads
+void RunNestedTasks(IThreadPool* pThreadPool, Uint32 NumRootTasks, Uint32 NumChildTasks, Uint32 NumIterations, std::atomic<Uint32>& NumTasksComplete)
+{
+    for (Uint32 i = 0; i < NumRootTasks; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [pThreadPool, NumChildTasks, NumIterations, &NumTasksComplete](Uint32 ThreadId) //
+                         {
+                             for (Uint32 j = 0; j < NumChildTasks; ++j)
+                             {
+                                 EnqueueAsyncWork(pThreadPool,
+                                                  [NumIterations, &NumTasksComplete](Uint32 ThreadId) //
+                                                  {
+                                                      float f = 0.5;
+                                                      for (Uint32 k = 0; k < NumIterations; ++k)
+                                                          f = std::sin(f + 1.f);
+                                                      if (f != 0)
+                                                          NumTasksComplete.fetch_add(1);
+                                                  });
+                             }
+                             NumTasksComplete.fetch_add(1);
+                         });
+    }
+
+    pThreadPool->WaitForAllTasks();
+}
+
+// Compares the throughput of the default and the work-stealing schedulers
+TEST(Common_ThreadPool, ScalingBenchmark)
+{
+    constexpr Uint32 NumRootTasks = 64;
+
+    struct TaskSizeInfo
+    {
+        const char* Name;
+        Uint32      NumChildTasks;
+        Uint32      NumIterations;
+    };
+    constexpr TaskSizeInfo TaskSizes[] = {
+        {"tiny", 1024, 4},
+        {"coarse", 32, 16384},
+    };
+
+    const auto NumCores = std::thread::hardware_concurrency();
+    LOG_INFO_MESSAGE("Running thread pool scaling benchmark on ", NumCores, " cores");
+
+    for (const auto& TaskSize : TaskSizes)
+    {
+        for (size_t NumThreads = 1; NumThreads <= 64; NumThreads *= 2)
+        {
+            double Time[2] = {};
+            for (bool EnableWorkStealing : {false, true})
+            {
+                ThreadPoolCreateInfo PoolCI{NumThreads};
+                PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+                auto pThreadPool = CreateThreadPool(PoolCI);
+                ASSERT_NE(pThreadPool, nullptr);
+
+                std::atomic<Uint32> NumTasksComplete{0};
+
+                Timer T;
+                RunNestedTasks(pThreadPool, NumRootTasks, TaskSize.NumChildTasks, TaskSize.NumIterations, NumTasksComplete);
+                Time[EnableWorkStealing ? 1 : 0] = T.GetElapsedTime();
+
+                EXPECT_EQ(NumTasksComplete.load(), NumRootTasks * (TaskSize.NumChildTasks + 1));
+            }
+
+            const auto NumTasks = NumRootTasks * (TaskSize.NumChildTasks + 1);
+            LOG_INFO_MESSAGE(std::setw(6), TaskSize.Name, " tasks, ", std::setw(2), NumThreads, " threads: ",
+                             std::fixed, std::setprecision(1),
+                             "global queue ", std::setw(7), Time[0] * 1000, " ms (", std::setw(5), Time[0] * 1e9 / NumTasks, " ns/task); ",
+                             "work stealing ", std::setw(7), Time[1] * 1000, " ms (", std::setw(5), Time[1] * 1e9 / NumTasks, " ns/task)");
+        }
+    }
+}
+
+} // namespace
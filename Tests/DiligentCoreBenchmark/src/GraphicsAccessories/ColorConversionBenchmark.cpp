@@ -0,0 +1,81 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "ColorConversion.h"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Compares span conversion functions with per-value conversions
+TEST(GraphicsAccessories_ColorConversion, Benchmark)
+{
+    const size_t NumValues = 1 << 24;
+
+    std::vector<float> Linear(NumValues);
+    for (size_t i = 0; i < NumValues; ++i)
+        Linear[i] = static_cast<float>(i % 4096) / 4095.f;
+
+    std::vector<Uint8> SRGB(NumValues);
+
+    Timer  T;
+    double StartTime = T.GetElapsedTime();
+    for (size_t i = 0; i < NumValues; ++i)
+        SRGB[i] = static_cast<Uint8>(LinearToGamma(Linear[i]) * 255.f + 0.5f);
+    LOG_INFO_MESSAGE("LinearToGamma(float):  ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    LinearToSRGB(Linear.data(), SRGB.data(), NumValues);
+    LOG_INFO_MESSAGE("LinearToSRGB(span):    ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    for (size_t i = 0; i < NumValues; ++i)
+        Linear[i] = GammaToLinear(SRGB[i]);
+    LOG_INFO_MESSAGE("GammaToLinear(Uint8):  ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    SRGBToLinear(SRGB.data(), Linear.data(), NumValues);
+    LOG_INFO_MESSAGE("SRGBToLinear(span):    ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    std::vector<Uint16> RGBA16F(NumValues);
+    StartTime = T.GetElapsedTime();
+    SRGBA8ToLinearRGBA16F(SRGB.data(), RGBA16F.data(), NumValues / 4);
+    LOG_INFO_MESSAGE("SRGBA8ToLinearRGBA16F: ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+
+    StartTime = T.GetElapsedTime();
+    LinearRGBA16FToSRGBA8(RGBA16F.data(), SRGB.data(), NumValues / 4);
+    LOG_INFO_MESSAGE("LinearRGBA16FToSRGBA8: ", (T.GetElapsedTime() - StartTime) * 1000, " ms");
+}
+
+} // namespace
@@ -0,0 +1,104 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "DynamicAtlasManager.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <iomanip>
+#include <vector>
+
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+using Region      = DynamicAtlasManager::Region;
+using PackingMode = DynamicAtlasManager::Mode;
+
+// Compares the fill rate and the allocation time of the split-tree and skyline packing modes
+TEST(GraphicsAccessories_DynamicAtlasManager, Benchmark)
+{
+    constexpr Uint32 AtlasSize  = 2048;
+    constexpr size_t NumRegions = 65536;
+
+    // Glyph-like regions: their total area is about seven times larger than the atlas
+    std::vector<Region> Sizes(NumRegions);
+    {
+        FastRandInt WidthRnd{0, 4, 32};
+        FastRandInt HeightRnd{1, 8, 40};
+        for (auto& R : Sizes)
+        {
+            R.width  = WidthRnd();
+            R.height = HeightRnd();
+        }
+    }
+
+    for (auto Mode : {PackingMode::SplitTree, PackingMode::Skyline})
+    {
+        for (bool Batch : {false, true})
+        {
+            DynamicAtlasManager Mgr{AtlasSize, AtlasSize, Mode};
+
+            auto Regions = Sizes;
+
+            Timer T;
+            if (Batch)
+            {
+                Mgr.Allocate(Regions.data(), static_cast<Uint32>(Regions.size()));
+            }
+            else
+            {
+                for (auto& R : Regions)
+                    R = Mgr.Allocate(R.width, R.height);
+            }
+            const auto AllocTime = T.GetElapsedTime();
+
+            const auto Occupancy    = Mgr.GetOccupancy();
+            const auto NumAllocated = std::count_if(Regions.begin(), Regions.end(), [](const Region& R) { return !R.IsEmpty(); });
+
+            T.Restart();
+            for (auto& R : Regions)
+            {
+                if (!R.IsEmpty())
+                    Mgr.Free(std::move(R));
+            }
+            const auto FreeTime = T.GetElapsedTime();
+            EXPECT_TRUE(Mgr.IsEmpty());
+
+            LOG_INFO_MESSAGE(Mode == PackingMode::Skyline ? "Skyline   " : "Split tree", (Batch ? ", batch:  " : ", single: "),
+                             "occupancy: ", std::fixed, std::setprecision(1), Occupancy * 100, "%; allocated: ", NumAllocated,
+                             " regions in ", std::setprecision(2), AllocTime * 1000, " ms; released in ", FreeTime * 1000, " ms");
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,107 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "VariableSizeAllocationsManager.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "PlatformDefinitions.h"
+
+#include "gtest/gtest.h"
+
+#include <iomanip>
+#include <vector>
+
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+using AllocationMode = VariableSizeAllocationsManager::Mode;
+
+// Compares the throughput and fragmentation of the best-fit and TLSF modes under random churn
+TEST(GraphicsAccessories_VariableSizeAllocationsManager, TLSFBenchmark)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    constexpr OffsetType MaxSize        = OffsetType{64} << 20;
+    constexpr size_t     NumLiveAllocs  = 8192;
+    constexpr size_t     NumIterations  = 1 << 20;
+    constexpr OffsetType Alignments[]   = {4, 16, 256};
+    constexpr int        MaxAllocSize   = 4096;
+    constexpr int        MaxLargeAllocs = 65536;
+
+    for (auto Mode : {AllocationMode::BestFit, AllocationMode::TLSF})
+    {
+        VariableSizeAllocationsManager::CreateInfo CI{Allocator, MaxSize};
+        CI.DbgDisableDebugValidation = true;
+        CI.AllocationMode            = Mode;
+        VariableSizeAllocationsManager ListMgr{CI};
+
+        FastRandInt SizeRnd{0, 1, MaxAllocSize};
+        FastRandInt LargeSizeRnd{1, MaxAllocSize, MaxLargeAllocs};
+        FastRandInt SlotRnd{2, 0, NumLiveAllocs - 1};
+        FastRandInt MiscRnd{3, 0, 99};
+
+        std::vector<VariableSizeAllocationsManager::Allocation> Allocations(NumLiveAllocs);
+
+        size_t NumFailed = 0;
+        Timer  T;
+        for (size_t i = 0; i < NumIterations; ++i)
+        {
+            // Replace a random allocation to churn the free space
+            auto& Alloc = Allocations[SlotRnd()];
+            if (Alloc.IsValid())
+                ListMgr.Free(std::move(Alloc));
+
+            const OffsetType Size = static_cast<OffsetType>(MiscRnd() < 5 ? LargeSizeRnd() : SizeRnd());
+            Alloc                 = ListMgr.Allocate(Size, Alignments[MiscRnd() % _countof(Alignments)]);
+            if (!Alloc.IsValid())
+                ++NumFailed;
+        }
+        const auto Time = T.GetElapsedTime();
+
+        // External fragmentation: the fraction of the free space that is not in the largest free block
+        const double Fragmentation = 1.0 - static_cast<double>(ListMgr.GetMaxFreeBlockSize()) / static_cast<double>(ListMgr.GetFreeSize());
+
+        LOG_INFO_MESSAGE(Mode == AllocationMode::TLSF ? "TLSF    " : "Best fit",
+                         ": ", std::fixed, std::setprecision(1), NumIterations / Time / 1e+6, " M alloc+free/s; ",
+                         "used: ", ListMgr.GetUsedSize() >> 10, " KB; free blocks: ", ListMgr.GetNumFreeBlocks(),
+                         "; fragmentation: ", std::setprecision(3), Fragmentation, "; failed allocations: ", NumFailed);
+
+        for (auto& Alloc : Allocations)
+        {
+            if (Alloc.IsValid())
+                ListMgr.Free(std::move(Alloc));
+        }
+        EXPECT_TRUE(ListMgr.IsEmpty());
+    }
+}
+
+} // namespace
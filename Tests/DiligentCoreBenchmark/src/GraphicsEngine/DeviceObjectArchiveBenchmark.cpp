@@ -0,0 +1,85 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "DeviceObjectArchiveTestHelpers.hpp"
+
+#include "gtest/gtest.h"
+
+#include "Timer.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+using DeviceType   = DeviceObjectArchive::DeviceType;
+using ArchiveFlags = DeviceObjectArchive::ArchiveFlags;
+
+// Measures the compression ratio and the decompression throughput of archive data blocks
+TEST(DeviceObjectArchiveTest, CompressionBenchmark)
+{
+    DeviceObjectArchive RefArchive{TestArchiveVersion};
+    PopulateTestArchive(RefArchive, /*Compressible = */ true, /*SizeScale = */ 64);
+
+    auto pData = SerializeTestArchive(RefArchive, ArchiveFlags::None);
+
+    Timer      T;
+    const auto CompressStartTime = T.GetElapsedTime();
+    auto       pCompressedData   = SerializeTestArchive(RefArchive, ArchiveFlags::CompressedData);
+    const auto CompressTime      = T.GetElapsedTime() - CompressStartTime;
+    ASSERT_NE(pCompressedData, nullptr);
+
+    DeviceObjectArchive Archive{{pCompressedData, TestArchiveVersion, false}};
+
+    const auto DecompressStartTime = T.GetElapsedTime();
+
+    size_t DecompressedSize = 0;
+    for (const auto& it : Archive.GetNamedResources())
+    {
+        const auto& ResData = Archive.GetUncompressedData(it.second);
+        DecompressedSize += ResData.Common.Size();
+        for (const auto& DevData : ResData.DeviceSpecific)
+            DecompressedSize += DevData.Size();
+    }
+    for (Uint32 dev = 0; dev < static_cast<Uint32>(DeviceType::Count); ++dev)
+    {
+        for (size_t i = 0; i < NumTestArchiveShaders; ++i)
+            DecompressedSize += Archive.GetSerializedShader(static_cast<DeviceType>(dev), i).Size();
+    }
+
+    const auto DecompressTime = T.GetElapsedTime() - DecompressStartTime;
+
+    LOG_INFO_MESSAGE("Archive size:       ", pData->GetSize(), " bytes\n",
+                     "Compressed size:    ", pCompressedData->GetSize(), " bytes (",
+                     static_cast<double>(pData->GetSize()) / static_cast<double>(pCompressedData->GetSize()), ":1)\n",
+                     "Compression time:   ", CompressTime * 1000, " ms\n",
+                     "Decompression time: ", DecompressTime * 1000, " ms (",
+                     static_cast<double>(DecompressedSize) / (1024.0 * 1024.0) / DecompressTime, " MB/s)");
+}
+
+} // namespace
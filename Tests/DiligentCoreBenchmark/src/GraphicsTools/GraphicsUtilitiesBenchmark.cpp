@@ -0,0 +1,131 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "GraphicsUtilities.h"
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "FastRand.hpp"
+#include "Timer.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+// Coarse levels of a 4-channel 8-bit mip chain
+struct MipChain
+{
+    MipChain(Uint32 Width, Uint32 Height)
+    {
+        while (Width > 1 || Height > 1)
+        {
+            Width  = std::max(Width / 2u, 1u);
+            Height = std::max(Height / 2u, 1u);
+            Levels.emplace_back(size_t{Width} * Height * 4);
+            Widths.push_back(Width);
+            Heights.push_back(Height);
+            pData.push_back(Levels.back().data());
+            Strides.push_back(size_t{Width} * 4);
+        }
+    }
+
+    std::vector<std::vector<Uint8>> Levels;
+    std::vector<Uint32>             Widths;
+    std::vector<Uint32>             Heights;
+    std::vector<void*>              pData;
+    std::vector<size_t>             Strides;
+};
+
+// Compares ComputeMipChain with computing every level by ComputeMipLevel
+TEST(GraphicsTools_ComputeMipChain, Benchmark)
+{
+    const auto NumThreads  = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+    auto       pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+
+    const Uint32 Width  = 4096;
+    const Uint32 Height = 4096;
+
+    std::vector<Uint8> BaseData(size_t{Width} * Height * 4);
+    {
+        FastRandInt Rnd{0, 0, 255};
+        for (auto& c : BaseData)
+            c = static_cast<Uint8>(Rnd());
+    }
+
+    MipChain Chain{Width, Height};
+
+    LOG_INFO_MESSAGE("Running ComputeMipChain benchmark on ", std::thread::hardware_concurrency(), " cores");
+    for (auto Format : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB})
+    {
+        const auto* Name = GetTextureFormatAttribs(Format).Name;
+
+        Timer T;
+        {
+            const void* pFineData  = BaseData.data();
+            size_t      FineStride = size_t{Width} * 4;
+            Uint32      FineWidth  = Width;
+            Uint32      FineHeight = Height;
+            for (size_t mip = 0; mip < Chain.Levels.size(); ++mip)
+            {
+                ComputeMipLevel({Format, FineWidth, FineHeight, pFineData, FineStride, Chain.pData[mip], Chain.Strides[mip], MIP_FILTER_TYPE_BOX_AVERAGE});
+                pFineData  = Chain.pData[mip];
+                FineStride = Chain.Strides[mip];
+                FineWidth  = Chain.Widths[mip];
+                FineHeight = Chain.Heights[mip];
+            }
+        }
+        LOG_INFO_MESSAGE(Name, " ComputeMipLevel, box:    ", T.GetElapsedTime() * 1000, " ms");
+
+        for (auto FilterType : {MIP_FILTER_TYPE_BOX_AVERAGE, MIP_FILTER_TYPE_KAISER})
+        {
+            const char* FilterName = FilterType == MIP_FILTER_TYPE_KAISER ? "kaiser: " : "box:    ";
+
+            ComputeMipChainAttribs Attribs{Format, Width, Height, BaseData.data(), size_t{Width} * 4,
+                                           static_cast<Uint32>(Chain.Levels.size()), Chain.pData.data(), Chain.Strides.data(), FilterType};
+
+            T.Restart();
+            ComputeMipChain(Attribs);
+            LOG_INFO_MESSAGE(Name, " ComputeMipChain, ", FilterName, T.GetElapsedTime() * 1000, " ms");
+
+            Attribs.pThreadPool = pThreadPool;
+            Attribs.NumTasks    = NumThreads + 1;
+
+            T.Restart();
+            ComputeMipChain(Attribs);
+            LOG_INFO_MESSAGE(Name, " ComputeMipChain, ", FilterName, T.GetElapsedTime() * 1000, " ms (", NumThreads, " worker threads)");
+        }
+    }
+}
+
+} // namespace
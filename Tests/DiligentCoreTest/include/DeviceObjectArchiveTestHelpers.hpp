@@ -0,0 +1,124 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#pragma once
+
+#include "../../../Graphics/GraphicsEngine/include/DeviceObjectArchive.hpp"
+#include "../../../Graphics/GraphicsEngine/include/EngineMemory.h"
+
+#include <algorithm>
+#include <string>
+
+#include "FastRand.hpp"
+
+namespace Diligent
+{
+
+namespace Testing
+{
+
+constexpr Uint32 NumTestArchiveResources = 64;
+constexpr Uint32 NumTestArchiveShaders   = 32;
+constexpr Uint32 TestArchiveVersion      = 1234;
+
+inline SerializedData MakeRandomArchiveData(FastRandInt& Rnd, size_t Size, bool Compressible)
+{
+    SerializedData Data{Size, GetRawAllocator()};
+
+    auto* pData = Data.Ptr<Uint8>();
+    for (size_t i = 0; i < Size; ++i)
+    {
+        // Similar to byte code, compressible data contains repeated fragments
+        if (Compressible && i >= 16 && Rnd() % 4 != 0)
+        {
+            const size_t Len  = std::min<size_t>(4 + Rnd() % 16, Size - i);
+            const auto*  pRef = pData + i - 16 + Rnd() % 8;
+            for (size_t j = 0; j < Len; ++j)
+                pData[i + j] = pRef[j];
+            i += Len - 1;
+        }
+        else
+        {
+            pData[i] = static_cast<Uint8>(Rnd());
+        }
+    }
+    return Data;
+}
+
+inline std::string GetTestArchiveResourceName(Uint32 Idx)
+{
+    return std::string{"Resource "} + std::to_string(Idx);
+}
+
+inline DeviceObjectArchive::ResourceType GetTestArchiveResourceType(Uint32 Idx)
+{
+    using ResourceType = DeviceObjectArchive::ResourceType;
+    return static_cast<ResourceType>(1 + Idx % (static_cast<Uint32>(ResourceType::Count) - 1));
+}
+
+/// Adds NumTestArchiveResources resources and NumTestArchiveShaders shaders for three device types.
+/// SizeScale multiplies the sizes of all data blocks.
+inline void PopulateTestArchive(DeviceObjectArchive& Archive, bool Compressible = false, Uint32 SizeScale = 1)
+{
+    using DeviceType = DeviceObjectArchive::DeviceType;
+
+    FastRandInt Rnd{0, 0, 255};
+    FastRandInt RndSize{1, 0, 100};
+    for (Uint32 i = 0; i < NumTestArchiveResources; ++i)
+    {
+        auto& ResData = Archive.GetResourceData(GetTestArchiveResourceType(i), GetTestArchiveResourceName(i).c_str());
+
+        // Use odd sizes to test data block alignment
+        ResData.Common = MakeRandomArchiveData(Rnd, 1 + RndSize() * SizeScale, Compressible);
+        for (size_t dev = 0; dev < ResData.DeviceSpecific.size(); ++dev)
+        {
+            // Leave some device-specific data empty
+            if ((i + dev) % 3 != 0)
+                ResData.DeviceSpecific[dev] = MakeRandomArchiveData(Rnd, RndSize() * 3 * SizeScale + 1, Compressible);
+        }
+    }
+
+    for (auto dev : {DeviceType::OpenGL, DeviceType::Vulkan, DeviceType::Metal_iOS})
+    {
+        auto& Shaders = Archive.GetDeviceShaders(dev);
+        for (Uint32 i = 0; i < NumTestArchiveShaders; ++i)
+            Shaders.emplace_back(MakeRandomArchiveData(Rnd, 4 + RndSize() * 7 * SizeScale, Compressible));
+    }
+}
+
+inline RefCntAutoPtr<IDataBlob> SerializeTestArchive(DeviceObjectArchive& Archive, DeviceObjectArchive::ArchiveFlags Flags)
+{
+    Archive.SetFlags(Flags);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    Archive.Serialize(&pData);
+    return pData;
+}
+
+} // namespace Testing
+
+} // namespace Diligent
@@ -26,6 +26,9 @@
  */
 
 #include <array>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 #include "DefaultRawMemoryAllocator.hpp"
 #include "FixedBlockMemoryAllocator.hpp"
@@ -124,6 +127,69 @@ TEST(Common_FixedBlockMemoryAllocator, UnalignedSize)
     }
 }
 
+TEST(Common_FixedBlockMemoryAllocator, ThreadCache)
+{
+    constexpr Uint32 AllocSize             = 32;
+    constexpr Uint32 NumAllocationsPerPage = 64;
+    constexpr Uint32 NumThreads            = 8;
+    constexpr Uint32 NumIterations         = 64;
+    constexpr Uint32 NumAllocations        = 256;
+
+    FixedBlockMemoryAllocator TestAllocator{DefaultRawMemoryAllocator::GetAllocator(), AllocSize, NumAllocationsPerPage, /*EnableThreadCache = */ true};
+
+    // Blocks allocated by one thread are released by another one
+    std::mutex                      ExchangeMtx;
+    std::vector<std::vector<void*>> ExchangeBuffers(NumThreads);
+
+    // Threads of the second round take over the cache slots of the exited threads
+    // together with the blocks left in their caches
+    for (Uint32 Round = 0; Round < 2; ++Round)
+    {
+        std::vector<std::thread> Threads;
+        for (Uint32 t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&, t]() //
+                {
+                    for (Uint32 it = 0; it < NumIterations; ++it)
+                    {
+                        std::vector<void*> Allocations(NumAllocations);
+                        for (Uint32 i = 0; i < NumAllocations; ++i)
+                        {
+                            Allocations[i] = TestAllocator.Allocate(AllocSize, "Fixed block allocator test", __FILE__, __LINE__);
+                            // Write a unique value to every block to detect the blocks given out twice
+                            *reinterpret_cast<Uint32*>(Allocations[i]) = t * NumAllocations + i;
+                        }
+
+                        for (Uint32 i = 0; i < NumAllocations; ++i)
+                            EXPECT_EQ(*reinterpret_cast<Uint32*>(Allocations[i]), t * NumAllocations + i);
+
+                        std::vector<void*> BlocksToFree;
+                        {
+                            std::lock_guard<std::mutex> Lock{ExchangeMtx};
+                            BlocksToFree.swap(ExchangeBuffers[(t + it) % NumThreads]);
+                            ExchangeBuffers[t].insert(ExchangeBuffers[t].end(), Allocations.begin() + NumAllocations / 2, Allocations.end());
+                        }
+
+                        for (Uint32 i = 0; i < NumAllocations / 2; ++i)
+                            TestAllocator.Free(Allocations[i]);
+                        for (auto* pBlock : BlocksToFree)
+                            TestAllocator.Free(pBlock);
+                    }
+                });
+        }
+
+        for (auto& Thread : Threads)
+            Thread.join();
+    }
+
+    for (auto& Buffer : ExchangeBuffers)
+    {
+        for (auto* pBlock : Buffer)
+            TestAllocator.Free(pBlock);
+    }
+}
+
 TEST(Common_FixedLinearAllocator, EmptyAllocator)
 {
     FixedLinearAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
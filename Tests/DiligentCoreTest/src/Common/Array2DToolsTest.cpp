@@ -27,10 +27,12 @@
 #include "Array2DTools.hpp"
 
 #include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "FastRand.hpp"
+#include "ThreadPool.hpp"
 
 using namespace Diligent;
 
@@ -111,4 +113,130 @@ TEST(Common_Array2DTools, GetArray2DMinMaxValue)
     }
 }
 
+
+void GetArray2DMinMaxValueRef(const float* pData, size_t Stride, Uint32 X, Uint32 Y, Uint32 Width, Uint32 Height, float& Min, float& Max)
+{
+    Min = Max = pData[X + Y * Stride];
+    for (size_t row = Y; row < Y + Height; ++row)
+    {
+        for (size_t col = X; col < X + Width; ++col)
+        {
+            Min = std::min(Min, pData[col + row * Stride]);
+            Max = std::max(Max, pData[col + row * Stride]);
+        }
+    }
+}
+
+TEST(Common_Array2DTools, GetArray2DMinMaxValueParallel)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    FastRandFloat Rnd{0, -100, +100};
+    for (Uint32 Height : {1u, 3u, 511u, 1024u})
+    {
+        const Uint32 Width  = 1029;
+        const size_t Stride = Width + 3;
+
+        std::vector<float> Data(Stride * Height);
+        for (auto& Val : Data)
+            Val = Rnd();
+        Data[Stride * (Height - 1) + 17] = -1000;
+        Data[Stride * (Height / 2) + 5]  = +1000;
+
+        float RefMin, RefMax;
+        GetArray2DMinMaxValueRef(Data.data(), Stride, 0, 0, Width, Height, RefMin, RefMax);
+
+        for (Uint32 NumTasks : {0u, 1u, 3u, 8u})
+        {
+            float Min = 0, Max = 0;
+            GetArray2DMinMaxValueParallel(pThreadPool, NumTasks, Data.data(), Stride, Width, Height, Min, Max);
+            EXPECT_EQ(Min, RefMin) << "Height: " << Height << ", tasks: " << NumTasks;
+            EXPECT_EQ(Max, RefMax) << "Height: " << Height << ", tasks: " << NumTasks;
+        }
+
+        float Min = 0, Max = 0;
+        GetArray2DMinMaxValueParallel(nullptr, 4, Data.data(), Stride, Width, Height, Min, Max);
+        EXPECT_EQ(Min, RefMin);
+        EXPECT_EQ(Max, RefMax);
+    }
+}
+
+TEST(Common_Array2DTools, Array2DMinMaxPyramid)
+{
+    FastRandFloat Rnd{0, -100, +100};
+    FastRandInt   RndInt{0, 0, 1 << 14};
+
+    const Uint32 TestSizes[][2] = {{1, 1}, {1, 17}, {23, 1}, {2, 2}, {64, 64}, {137, 91}, {256, 33}};
+    for (const auto& Size : TestSizes)
+    {
+        const Uint32 Width  = Size[0];
+        const Uint32 Height = Size[1];
+        const size_t Stride = Width + 5;
+
+        std::vector<float> Data(Stride * Height);
+        for (auto& Val : Data)
+            Val = Rnd();
+
+        Array2DMinMaxPyramid Pyramid{Data.data(), Stride, Width, Height};
+        EXPECT_EQ(Pyramid.GetWidth(), Width);
+        EXPECT_EQ(Pyramid.GetHeight(), Height);
+
+        const auto TestRects = [&]() {
+            for (Uint32 test = 0; test < 500; ++test)
+            {
+                const Uint32 X = RndInt() % Width;
+                const Uint32 Y = RndInt() % Height;
+                const Uint32 W = 1 + RndInt() % (Width - X);
+                const Uint32 H = 1 + RndInt() % (Height - Y);
+
+                float RefMin, RefMax;
+                GetArray2DMinMaxValueRef(Data.data(), Stride, X, Y, W, H, RefMin, RefMax);
+
+                float Min = 0, Max = 0;
+                EXPECT_TRUE(Pyramid.GetMinMax(X, Y, W, H, Min, Max));
+                if (Min != RefMin || Max != RefMax)
+                {
+                    ADD_FAILURE() << "Array: " << Width << "x" << Height << ", rect: [" << X << ", " << Y << ", " << W << ", " << H << "]";
+                    return;
+                }
+            }
+
+            // Whole array
+            float RefMin, RefMax;
+            GetArray2DMinMaxValueRef(Data.data(), Stride, 0, 0, Width, Height, RefMin, RefMax);
+
+            float Min = 0, Max = 0;
+            EXPECT_TRUE(Pyramid.GetMinMax(0, 0, Width + 10, Height + 10, Min, Max));
+            EXPECT_EQ(Min, RefMin);
+            EXPECT_EQ(Max, RefMax);
+        };
+        TestRects();
+
+        // Empty rectangles
+        {
+            float Min = 0, Max = 0;
+            EXPECT_FALSE(Pyramid.GetMinMax(Width, 0, 10, 10, Min, Max));
+            EXPECT_FALSE(Pyramid.GetMinMax(0, 0, 0, 10, Min, Max));
+            EXPECT_EQ(Min, 0);
+            EXPECT_EQ(Max, 0);
+        }
+
+        // Modify random regions
+        for (Uint32 test = 0; test < 8; ++test)
+        {
+            const Uint32 X = RndInt() % Width;
+            const Uint32 Y = RndInt() % Height;
+            const Uint32 W = 1 + RndInt() % (Width - X);
+            const Uint32 H = 1 + RndInt() % (Height - Y);
+            for (size_t row = Y; row < Y + H; ++row)
+            {
+                for (size_t col = X; col < X + W; ++col)
+                    Data[col + row * Stride] = (test % 2 == 0) ? Rnd() * 2.f : Rnd() * 0.5f;
+            }
+            Pyramid.Update(X, Y, W, H);
+            TestRects();
+        }
+    }
+}
+
 } // namespace
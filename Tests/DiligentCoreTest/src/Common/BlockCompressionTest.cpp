@@ -0,0 +1,143 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "BlockCompression.hpp"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "BasicTypes.h"
+#include "FastRand.hpp"
+
+using namespace Diligent;
+
+namespace
+{
+
+void TestRoundTrip(const std::vector<Uint8>& SrcData, size_t MaxCompressedSize = ~size_t{0})
+{
+    std::vector<Uint8> Compressed(GetCompressedBlockBound(SrcData.size()));
+
+    const auto CompressedSize = CompressBlock(SrcData.data(), SrcData.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+    EXPECT_LE(CompressedSize, Compressed.size());
+    EXPECT_LE(CompressedSize, MaxCompressedSize);
+
+    std::vector<Uint8> Decompressed(SrcData.size());
+    EXPECT_TRUE(DecompressBlock(Compressed.data(), CompressedSize, Decompressed.data(), Decompressed.size()));
+    EXPECT_EQ(Decompressed, SrcData);
+}
+
+TEST(Common_BlockCompression, RoundTrip)
+{
+    // Small blocks are stored as literals
+    for (size_t Size = 0; Size < 32; ++Size)
+    {
+        std::vector<Uint8> Data(Size);
+        for (size_t i = 0; i < Size; ++i)
+            Data[i] = static_cast<Uint8>(i * 7);
+        TestRoundTrip(Data);
+    }
+
+    // Repeated bytes produce overlapping matches
+    TestRoundTrip(std::vector<Uint8>(100000, 0xAB), 1024);
+
+    // Long runs of literals
+    {
+        FastRand           Rnd{0};
+        std::vector<Uint8> Data(100000);
+        for (auto& Byte : Data)
+            Byte = static_cast<Uint8>(Rnd());
+        TestRoundTrip(Data);
+    }
+
+    // Text-like data with repeated fragments
+    {
+        std::string Text;
+        for (int i = 0; i < 2000; ++i)
+            Text += "float4 Color" + std::to_string(i % 37) + " = g_Texture.Sample(g_Sampler, UV" + std::to_string(i % 5) + ");\n";
+        TestRoundTrip(std::vector<Uint8>{Text.begin(), Text.end()}, Text.size() / 4);
+    }
+
+    // Matches farther than the maximum offset
+    {
+        FastRand           Rnd{1};
+        std::vector<Uint8> Data(200000);
+        for (size_t i = 0; i < 70000; ++i)
+            Data[i] = static_cast<Uint8>(Rnd());
+        memcpy(&Data[130000], &Data[0], 70000);
+        TestRoundTrip(Data);
+    }
+}
+
+TEST(Common_BlockCompression, InsufficientDstSize)
+{
+    std::vector<Uint8> Data(1000);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>(i % 17);
+
+    std::vector<Uint8> Compressed(GetCompressedBlockBound(Data.size()));
+
+    const auto CompressedSize = CompressBlock(Data.data(), Data.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+    EXPECT_EQ(CompressBlock(Data.data(), Data.size(), Compressed.data(), CompressedSize - 1), size_t{0});
+}
+
+TEST(Common_BlockCompression, InvalidData)
+{
+    std::vector<Uint8> Data(4096);
+    for (size_t i = 0; i < Data.size(); ++i)
+        Data[i] = static_cast<Uint8>((i * i) % 251);
+
+    std::vector<Uint8> Compressed(GetCompressedBlockBound(Data.size()));
+
+    const auto CompressedSize = CompressBlock(Data.data(), Data.size(), Compressed.data(), Compressed.size());
+    ASSERT_GT(CompressedSize, size_t{0});
+    Compressed.resize(CompressedSize);
+
+    std::vector<Uint8> Decompressed(Data.size());
+    // Wrong decompressed size
+    EXPECT_FALSE(DecompressBlock(Compressed.data(), Compressed.size(), Decompressed.data(), Decompressed.size() - 1));
+    EXPECT_FALSE(DecompressBlock(Compressed.data(), Compressed.size(), Decompressed.data(), Decompressed.size() + 1));
+
+    // Truncated data
+    for (size_t Size = 0; Size < Compressed.size(); ++Size)
+        EXPECT_FALSE(DecompressBlock(Compressed.data(), Size, Decompressed.data(), Decompressed.size()));
+
+    // Corrupted data must never cause out-of-bounds access
+    FastRand Rnd{2};
+    for (Uint32 i = 0; i < 1000; ++i)
+    {
+        auto Corrupted = Compressed;
+        Corrupted[Rnd() % Corrupted.size()] ^= static_cast<Uint8>(1 + Rnd() % 255);
+        DecompressBlock(Corrupted.data(), Corrupted.size(), Decompressed.data(), Decompressed.size());
+    }
+}
+
+} // namespace
@@ -27,8 +27,12 @@
 
 #include "FilteringTools.hpp"
 
+#include <vector>
+
 #include "gtest/gtest.h"
 
+#include "FastRand.hpp"
+
 using namespace Diligent;
 
 namespace Diligent
@@ -292,4 +296,144 @@ TEST(Common_FilteringTools, FilterTexture2DBilinear)
     }
 }
 
+template <TEXTURE_ADDRESS_MODE AddressMode, bool IsNormalizedCoord>
+void VerifyLinearTexFilterSampleInfos(Uint32 Width, const std::vector<float>& Coords)
+{
+    const size_t       NumCoords = Coords.size();
+    std::vector<Int32> I0(NumCoords), I1(NumCoords);
+    std::vector<float> W(NumCoords);
+    GetLinearTexFilterSampleInfos<AddressMode, IsNormalizedCoord>(Width, Coords.data(), NumCoords, I0.data(), I1.data(), W.data());
+    for (size_t i = 0; i < NumCoords; ++i)
+    {
+        const auto RefSampleInfo = GetLinearTexFilterSampleInfo<AddressMode, IsNormalizedCoord>(Width, Coords[i]);
+        EXPECT_EQ((LinearTexFilterSampleInfo{I0[i], I1[i], W[i]}), RefSampleInfo) << "u=" << Coords[i] << " width=" << Width;
+    }
+}
+
+template <TEXTURE_ADDRESS_MODE AddressMode>
+void TestGetLinearTexFilterSampleInfos(Uint32 Width)
+{
+    std::vector<float> Coords;
+    for (float u = -3.f * static_cast<float>(Width); u <= 3.f * static_cast<float>(Width); u += 0.125f)
+        Coords.push_back(u);
+
+    FastRandFloat Rnd{0, -1e+5f, +1e+5f};
+    for (size_t i = 0; i < 1000; ++i)
+        Coords.push_back(Rnd());
+
+    // Coordinates that can't be handled by the SIMD path
+    Coords.push_back(1e+10f);
+    Coords.push_back(-1e+10f);
+    Coords.push_back(16777216.f);
+
+    VerifyLinearTexFilterSampleInfos<AddressMode, false>(Width, Coords);
+
+    for (auto& u : Coords)
+        u /= static_cast<float>(Width);
+    VerifyLinearTexFilterSampleInfos<AddressMode, true>(Width, Coords);
+}
+
+TEST(Common_FilteringTools, GetLinearTexFilterSampleInfos)
+{
+    for (Uint32 Width : {1u, 3u, 128u, 1000u})
+    {
+        TestGetLinearTexFilterSampleInfos<TEXTURE_ADDRESS_CLAMP>(Width);
+        TestGetLinearTexFilterSampleInfos<TEXTURE_ADDRESS_WRAP>(Width);
+        TestGetLinearTexFilterSampleInfos<TEXTURE_ADDRESS_MIRROR>(Width);
+    }
+}
+
+template <typename SrcType, typename DstType, TEXTURE_ADDRESS_MODE AddressMode>
+void TestFilterTexture2DBilinearBatch(Uint32 Width, Uint32 Height, size_t NumSamples)
+{
+    const size_t         Stride = Width + 5;
+    std::vector<SrcType> Data(Stride * Height);
+    FastRandInt          RndInt{0, 0, 255};
+    for (auto& Val : Data)
+        Val = static_cast<SrcType>(RndInt());
+
+    std::vector<float> U(NumSamples), V(NumSamples);
+    FastRandFloat      Rnd{1, -2.5f, +2.5f};
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        U[i] = Rnd();
+        V[i] = Rnd();
+    }
+
+    std::vector<DstType> Samples(NumSamples);
+    FilterTexture2DBilinear<SrcType, DstType, AddressMode, AddressMode, true>(Width, Height, Data.data(), Stride, U.data(), V.data(), NumSamples, Samples.data());
+    for (size_t i = 0; i < NumSamples; ++i)
+    {
+        const auto Ref = FilterTexture2DBilinear<SrcType, DstType, AddressMode, AddressMode, true>(Width, Height, Data.data(), Stride, U[i], V[i]);
+        EXPECT_NEAR(Samples[i], Ref, 1e-4f) << "u=" << U[i] << " v=" << V[i];
+    }
+}
+
+TEST(Common_FilteringTools, FilterTexture2DBilinearBatch)
+{
+    for (size_t NumSamples : {0, 1, 3, 4, 63, 64, 65, 1000})
+    {
+        TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_CLAMP>(17, 9, NumSamples);
+        TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_WRAP>(17, 9, NumSamples);
+        TestFilterTexture2DBilinearBatch<float, float, TEXTURE_ADDRESS_MIRROR>(17, 9, NumSamples);
+
+        TestFilterTexture2DBilinearBatch<Uint8, float, TEXTURE_ADDRESS_CLAMP>(8, 16, NumSamples);
+        TestFilterTexture2DBilinearBatch<Uint16, float, TEXTURE_ADDRESS_WRAP>(8, 16, NumSamples);
+        TestFilterTexture2DBilinearBatch<float, double, TEXTURE_ADDRESS_MIRROR>(8, 16, NumSamples);
+    }
+}
+
+template <typename SrcType, typename DstType, TEXTURE_ADDRESS_MODE AddressModeU, TEXTURE_ADDRESS_MODE AddressModeV>
+void TestResampleTexture2DBilinear(Uint32 SrcWidth, Uint32 SrcHeight, Uint32 DstWidth, Uint32 DstHeight, const float2& UVMin, const float2& UVMax)
+{
+    const size_t         SrcStride = SrcWidth + 3;
+    std::vector<SrcType> SrcData(SrcStride * SrcHeight);
+    FastRandInt          RndInt{0, 0, 255};
+    for (auto& Val : SrcData)
+        Val = static_cast<SrcType>(RndInt());
+
+    const size_t         DstStride = DstWidth + 2;
+    std::vector<DstType> DstData(DstStride * DstHeight);
+    ResampleTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV>(SrcWidth, SrcHeight, SrcData.data(), SrcStride,
+                                                                            DstWidth, DstHeight, DstData.data(), DstStride, UVMin, UVMax);
+
+    for (Uint32 y = 0; y < DstHeight; ++y)
+    {
+        for (Uint32 x = 0; x < DstWidth; ++x)
+        {
+            const float u   = UVMin.x + (UVMax.x - UVMin.x) * ((static_cast<float>(x) + 0.5f) / static_cast<float>(DstWidth));
+            const float v   = UVMin.y + (UVMax.y - UVMin.y) * ((static_cast<float>(y) + 0.5f) / static_cast<float>(DstHeight));
+            const auto  Ref = FilterTexture2DBilinear<SrcType, DstType, AddressModeU, AddressModeV, true>(SrcWidth, SrcHeight, SrcData.data(), SrcStride, u, v);
+            EXPECT_NEAR(DstData[x + y * DstStride], Ref, 1e-4f) << "x=" << x << " y=" << y;
+        }
+    }
+}
+
+TEST(Common_FilteringTools, ResampleTexture2DBilinear)
+{
+    const float2 UVMin{0, 0};
+    const float2 UVMax{1, 1};
+
+    // Upsampling
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP>(16, 8, 67, 45, UVMin, UVMax);
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_WRAP>(16, 8, 67, 45, UVMin, UVMax);
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_MIRROR>(16, 8, 67, 45, UVMin, UVMax);
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_WRAP>(16, 8, 67, 45, UVMin, UVMax);
+
+    // Downsampling
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP>(64, 48, 13, 7, UVMin, UVMax);
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_MIRROR>(64, 48, 13, 7, UVMin, UVMax);
+
+    // Regions
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP>(32, 32, 40, 40, float2{0.25f, 0.125f}, float2{0.5f, 0.75f});
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_WRAP>(32, 32, 40, 40, float2{-1.5f, 0.5f}, float2{1.5f, 2.25f});
+    TestResampleTexture2DBilinear<float, float, TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_MIRROR>(32, 32, 40, 40, float2{0.75f, 1.25f}, float2{-0.75f, -1.f});
+
+    // Other types
+    TestResampleTexture2DBilinear<Uint8, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP>(16, 16, 33, 21, UVMin, UVMax);
+    TestResampleTexture2DBilinear<Uint16, float, TEXTURE_ADDRESS_WRAP, TEXTURE_ADDRESS_WRAP>(16, 16, 33, 21, UVMin, UVMax);
+    TestResampleTexture2DBilinear<float, double, TEXTURE_ADDRESS_MIRROR, TEXTURE_ADDRESS_MIRROR>(16, 16, 33, 21, UVMin, UVMax);
+    TestResampleTexture2DBilinear<Uint8, float, TEXTURE_ADDRESS_CLAMP, TEXTURE_ADDRESS_CLAMP>(1, 1, 5, 3, UVMin, UVMax);
+}
+
 } // namespace
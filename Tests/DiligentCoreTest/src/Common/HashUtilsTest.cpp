@@ -29,6 +29,9 @@
 #include <unordered_set>
 #include <array>
 #include <vector>
+#include <random>
+#include <bitset>
+#include <sstream>
 
 #include "HashUtils.hpp"
 #include "XXH128Hasher.hpp"
@@ -150,7 +153,7 @@ TEST(Common_HashUtils, HashMapStringKey)
     }
 }
 
-TEST(Common_HashUtils, ComputeHashRaw)
+void TestComputeHashRaw(RawHashAlgorithm Algorithm)
 {
     {
         std::array<Uint8, 16> Data{};
@@ -162,7 +165,7 @@ TEST(Common_HashUtils, ComputeHashRaw)
         {
             for (size_t size = 1; size <= Data.size() - start; ++size)
             {
-                auto Hash = ComputeHashRaw(&Data[start], size);
+                auto Hash = ComputeHashRaw(&Data[start], size, Algorithm);
                 EXPECT_NE(Hash, size_t{0});
                 auto inserted = Hashes.insert(Hash).second;
                 EXPECT_TRUE(inserted) << Hash;
@@ -174,18 +177,123 @@ TEST(Common_HashUtils, ComputeHashRaw)
         std::array<Uint8, 16> RefData = {1, 3, 5, 7, 11, 13, 21, 35, 2, 4, 8, 10, 22, 40, 60, 82};
         for (size_t size = 1; size <= RefData.size(); ++size)
         {
-            auto RefHash = ComputeHashRaw(RefData.data(), size);
+            auto RefHash = ComputeHashRaw(RefData.data(), size, Algorithm);
             for (size_t offset = 0; offset < RefData.size() - size; ++offset)
             {
                 std::array<Uint8, RefData.size()> Data{};
                 std::copy(RefData.begin(), RefData.begin() + size, Data.begin() + offset);
-                auto Hash = ComputeHashRaw(&Data[offset], size);
+                auto Hash = ComputeHashRaw(&Data[offset], size, Algorithm);
                 EXPECT_EQ(RefHash, Hash) << offset << " " << size;
             }
         }
     }
 }
 
+TEST(Common_HashUtils, ComputeHashRaw)
+{
+    TestComputeHashRaw(RawHashAlgorithm::Default);
+
+    std::array<Uint8, 64> Data{};
+    for (Uint8 i = 0; i < Data.size(); ++i)
+        Data[i] = 7u + i * 5u;
+    EXPECT_EQ(ComputeHashRaw(Data.data(), Data.size()), ComputeHashRaw(Data.data(), Data.size(), RawHashAlgorithm::Default));
+    // The default algorithm must not change the existing hash values
+    EXPECT_EQ(ComputeHashRaw(Data.data(), Data.size()), ComputeHashRawCombine(Data.data(), Data.size()));
+}
+
+TEST(Common_HashUtils, ComputeHashRaw_Combine)
+{
+    TestComputeHashRaw(RawHashAlgorithm::Combine);
+}
+
+TEST(Common_HashUtils, ComputeHashRaw_MultiplyMix)
+{
+    TestComputeHashRaw(RawHashAlgorithm::MultiplyMix);
+
+    // Test alignment independence and all code paths for larger sizes
+    std::vector<Uint8> RefData(256);
+    for (size_t i = 0; i < RefData.size(); ++i)
+        RefData[i] = static_cast<Uint8>(i * 7u + 3u);
+
+    std::unordered_set<size_t> Hashes;
+    for (size_t size = 0; size <= RefData.size(); ++size)
+    {
+        const auto RefHash = ComputeHashRawMultiplyMix(RefData.data(), size);
+        EXPECT_TRUE(Hashes.insert(RefHash).second) << size;
+        for (size_t offset = 1; offset < 8; ++offset)
+        {
+            std::vector<Uint8> Data(size + offset);
+            std::copy(RefData.begin(), RefData.begin() + size, Data.begin() + offset);
+            EXPECT_EQ(RefHash, ComputeHashRawMultiplyMix(&Data[offset], size)) << offset << " " << size;
+        }
+    }
+}
+
+TEST(Common_HashUtils, ComputeHashRaw_MultiplyMixQuality)
+{
+    std::mt19937 Gen{0x1234u};
+
+    constexpr size_t HashBits = sizeof(size_t) * 8;
+
+    // Avalanche: flipping any input bit must flip about half of the output bits
+    for (size_t Size : {1, 3, 4, 8, 15, 16, 17, 33, 48, 49, 64, 100, 256})
+    {
+        std::vector<Uint8> Data(Size);
+
+        double TotalFlippedBits = 0;
+        size_t NumTests         = 0;
+        for (size_t Iter = 0; Iter < 16; ++Iter)
+        {
+            for (auto& Byte : Data)
+                Byte = static_cast<Uint8>(Gen());
+
+            const auto RefHash = ComputeHashRawMultiplyMix(Data.data(), Size);
+            for (size_t bit = 0; bit < Size * 8; ++bit)
+            {
+                Data[bit / 8] ^= static_cast<Uint8>(1u << (bit % 8));
+                const auto Hash = ComputeHashRawMultiplyMix(Data.data(), Size);
+                Data[bit / 8] ^= static_cast<Uint8>(1u << (bit % 8));
+
+                TotalFlippedBits += static_cast<double>(std::bitset<HashBits>{Hash ^ RefHash}.count());
+                ++NumTests;
+            }
+        }
+        const auto AvgFlippedBits = TotalFlippedBits / static_cast<double>(NumTests);
+        EXPECT_NEAR(AvgFlippedBits, HashBits / 2.0, HashBits * 0.05) << "Size: " << Size;
+    }
+
+    // Collisions: sequential keys differing in a few bits must not collide
+    if (sizeof(size_t) == 8)
+    {
+        std::unordered_set<size_t> Hashes;
+        for (Uint32 Key = 0; Key < 65536; ++Key)
+        {
+            for (size_t Size : {4, 12, 24, 64})
+            {
+                std::array<Uint8, 64> Data{};
+                std::memcpy(Data.data(), &Key, sizeof(Key));
+                EXPECT_TRUE(Hashes.insert(ComputeHashRawMultiplyMix(Data.data(), Size)).second) << Key << " " << Size;
+            }
+        }
+    }
+
+    // Bucket distribution: low bits must be uniformly distributed
+    {
+        constexpr size_t    NumBuckets = 256;
+        constexpr size_t    NumKeys    = NumBuckets * 256;
+        std::vector<size_t> Buckets(NumBuckets);
+        for (Uint32 Key = 0; Key < NumKeys; ++Key)
+        {
+            const Uint32 Data[4] = {Key, 0, Key * 3, 0};
+            ++Buckets[ComputeHashRawMultiplyMix(Data, sizeof(Data)) % NumBuckets];
+        }
+        for (auto Count : Buckets)
+        {
+            EXPECT_GT(Count, NumKeys / NumBuckets / 2);
+            EXPECT_LT(Count, NumKeys / NumBuckets * 2);
+        }
+    }
+}
 
 template <typename Type>
 class StdHasherTestHelper
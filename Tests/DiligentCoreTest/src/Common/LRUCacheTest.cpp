@@ -183,4 +183,215 @@ TEST(Common_LRUCache, Exceptions)
     }
 }
 
+
+template <typename CacheType>
+bool IsCached(CacheType& Cache, int Key)
+{
+    bool IsCached = true;
+    Cache.Get(Key,
+              [&](CacheData& Data, size_t& Size) //
+              {
+                  Data.Value = static_cast<Uint32>(Key);
+                  Size       = 1;
+                  IsCached   = false;
+              });
+    return IsCached;
+}
+
+void TestShardedGet(LRUCacheEvictionPolicy Policy)
+{
+    ShardedLRUCache<int, CacheData> Cache{1024, 4, Policy};
+
+    constexpr Uint32                    NumThreads = 16;
+    std::vector<std::thread>            Threads(NumThreads);
+    std::vector<std::vector<CacheData>> ThreadsData(NumThreads);
+
+    Threading::Signal StartSignal;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        ThreadsData[i].resize(32);
+
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                StartSignal.Wait();
+
+                auto& Data = ThreadsData[ThreadId];
+                for (Uint32 i = 0; i < Data.size(); ++i)
+                {
+                    // Get elements with the same keys from all threads
+                    Data[i] = Cache.Get(i,
+                                        [&](CacheData& Data, size_t& Size) //
+                                        {
+                                            Data.Value = i * NumThreads + ThreadId;
+                                            Size       = 1;
+                                        });
+                }
+            },
+            i);
+    }
+    StartSignal.Trigger(true);
+
+    for (auto& T : Threads)
+        T.join();
+
+    // All keys fit into the cache, so every key must be initialized exactly once
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{32});
+    for (Uint32 i = 0; i < 32; ++i)
+    {
+        const auto Value = ThreadsData[0][i].Value;
+        EXPECT_EQ(Value / NumThreads, i);
+        for (auto& Data : ThreadsData)
+            EXPECT_EQ(Data[i].Value, Value);
+    }
+}
+
+TEST(Common_ShardedLRUCache, Get)
+{
+    TestShardedGet(LRUCacheEvictionPolicy::Exact);
+}
+
+TEST(Common_ShardedLRUCache, Get_Clock)
+{
+    TestShardedGet(LRUCacheEvictionPolicy::Clock);
+}
+
+
+void TestShardedEviction(LRUCacheEvictionPolicy Policy)
+{
+    // Use a single shard to make the eviction order deterministic
+    ShardedLRUCache<int, CacheData> Cache{3, 1, Policy};
+
+    EXPECT_FALSE(IsCached(Cache, 0));
+    EXPECT_FALSE(IsCached(Cache, 1));
+    EXPECT_FALSE(IsCached(Cache, 2));
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{3});
+
+    // Touch the oldest entry
+    EXPECT_TRUE(IsCached(Cache, 0));
+
+    // Entry 1 is now the least recently used one and must be evicted
+    EXPECT_FALSE(IsCached(Cache, 3));
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{3});
+
+    EXPECT_TRUE(IsCached(Cache, 0));
+    EXPECT_TRUE(IsCached(Cache, 2));
+    EXPECT_TRUE(IsCached(Cache, 3));
+    EXPECT_FALSE(IsCached(Cache, 1));
+    EXPECT_EQ(Cache.GetCurrSize(), size_t{3});
+}
+
+TEST(Common_ShardedLRUCache, Eviction)
+{
+    TestShardedEviction(LRUCacheEvictionPolicy::Exact);
+}
+
+TEST(Common_ShardedLRUCache, Eviction_Clock)
+{
+    TestShardedEviction(LRUCacheEvictionPolicy::Clock);
+}
+
+
+void TestShardedBudget(LRUCacheEvictionPolicy Policy)
+{
+    constexpr size_t                MaxSize = 64;
+    ShardedLRUCache<int, CacheData> Cache{MaxSize, 8, Policy};
+
+    constexpr Uint32         NumThreads = 8;
+    std::vector<std::thread> Threads(NumThreads);
+    Threading::Signal        StartSignal;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                StartSignal.Wait();
+                for (int i = 0; i < 1024; ++i)
+                {
+                    const int  Key  = (i * 7 + static_cast<int>(ThreadId)) % 512;
+                    const auto Data = Cache.Get(Key,
+                                                [&](CacheData& Data, size_t& Size) //
+                                                {
+                                                    Data.Value = static_cast<Uint32>(Key);
+                                                    Size       = 1 + Key % 3;
+                                                });
+                    EXPECT_EQ(Data.Value, static_cast<Uint32>(Key));
+                }
+            },
+            i);
+    }
+    StartSignal.Trigger(true);
+
+    for (auto& T : Threads)
+        T.join();
+
+    // Every shard may only exceed its budget by the size of a single entry
+    EXPECT_GT(Cache.GetCurrSize(), size_t{0});
+    EXPECT_LE(Cache.GetCurrSize(), MaxSize + Cache.GetNumShards() * 2);
+}
+
+TEST(Common_ShardedLRUCache, Budget)
+{
+    TestShardedBudget(LRUCacheEvictionPolicy::Exact);
+}
+
+TEST(Common_ShardedLRUCache, Budget_Clock)
+{
+    TestShardedBudget(LRUCacheEvictionPolicy::Clock);
+}
+
+
+TEST(Common_ShardedLRUCache, Exceptions)
+{
+    ShardedLRUCache<int, CacheData> Cache{16, 4, LRUCacheEvictionPolicy::Clock};
+
+    constexpr Uint32                    NumThreads = 15; // Use odd number
+    std::vector<std::thread>            Threads(NumThreads);
+    std::vector<std::vector<CacheData>> ThreadsData(NumThreads);
+
+    Threading::Signal StartSignal;
+    for (Uint32 i = 0; i < NumThreads; ++i)
+    {
+        ThreadsData[i].resize(128);
+
+        Threads[i] = std::thread(
+            [&](Uint32 ThreadId) {
+                StartSignal.Wait();
+
+                auto& Data = ThreadsData[ThreadId];
+                for (Uint32 i = 0; i < Data.size(); ++i)
+                {
+                    try
+                    {
+                        Data[i] = Cache.Get(i,
+                                            [&](CacheData& Data, size_t& Size) //
+                                            {
+                                                // Throw exception from every other request.
+                                                if ((i * NumThreads + ThreadId) % 2 == 0)
+                                                    throw std::runtime_error("test error");
+
+                                                Data.Value = i;
+                                                Size       = 1;
+                                            });
+                    }
+                    catch (...)
+                    {
+                    }
+                }
+            },
+            i);
+    }
+    StartSignal.Trigger(true);
+
+    for (auto& T : Threads)
+        T.join();
+
+    for (auto& Data : ThreadsData)
+    {
+        for (Uint32 i = 0; i < Data.size(); ++i)
+        {
+            auto Value = Data[i].Value;
+            EXPECT_TRUE(Value == ~0u || Value == i);
+        }
+    }
+}
+
 } // namespace
@@ -27,9 +27,13 @@
 
 #include <climits>
 #include <sstream>
+#include <iomanip>
+#include <vector>
 
 #include "BasicMath.hpp"
 #include "AdvancedMath.hpp"
+#include "ParallelCulling.hpp"
+#include "FastRand.hpp"
 
 #include "gtest/gtest.h"
 
@@ -1641,6 +1645,117 @@ TEST(Common_BasicMath, MatrixOpeartorMinusEqual)
 }
 
 
+float4x4 MakeRandomMatrix(FastRandFloat& Rnd)
+{
+    float4x4 m;
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+            m[i][j] = Rnd();
+        // Make the matrix diagonally dominant so that it is well-conditioned
+        m[i][i] += 4;
+    }
+    return m;
+}
+
+// Compares the results against the double-precision scalar implementation, which never uses SIMD
+void CheckNear(const float4x4& m, const double4x4& Ref, double Tolerance)
+{
+    for (int i = 0; i < 4; ++i)
+    {
+        for (int j = 0; j < 4; ++j)
+            EXPECT_NEAR(m[i][j], Ref[i][j], Tolerance) << "i=" << i << " j=" << j;
+    }
+}
+
+TEST(Common_BasicMath, MatrixSIMD)
+{
+    FastRandFloat Rnd{0, -1, 1};
+    for (int Iter = 0; Iter < 256; ++Iter)
+    {
+        const auto m1 = MakeRandomMatrix(Rnd);
+        const auto m2 = MakeRandomMatrix(Rnd);
+        const auto v  = float4{Rnd(), Rnd(), Rnd(), Rnd()};
+
+        const auto m1d = m1.Recast<double>();
+        const auto m2d = m2.Recast<double>();
+
+        // Operators use SIMD implementation when DILIGENT_MATH_SIMD is enabled
+        CheckNear(m1 * m2, m1d * m2d, 1e-4);
+        CheckNear(m1.Transpose(), m1d.Transpose(), 0);
+        CheckNear(m1.Inverse(), m1d.Inverse(), 1e-5);
+        CheckNear(m1 * m1.Inverse(), double4x4::Identity(), 1e-5);
+        {
+            const auto r  = v * m1;
+            const auto rd = v.Recast<double>() * m1d;
+            for (int i = 0; i < 4; ++i)
+                EXPECT_NEAR(r[i], rd[i], 1e-4);
+        }
+
+#if DILIGENT_MATH_SIMD_SUPPORTED
+        {
+            float4x4 m;
+            MathSIMD::MulMatrix4x4(m1.Data(), m2.Data(), m.Data());
+            CheckNear(m, m1d * m2d, 1e-4);
+
+            MathSIMD::TransposeMatrix4x4(m1.Data(), m.Data());
+            CheckNear(m, m1d.Transpose(), 0);
+
+            MathSIMD::InverseMatrix4x4(m1.Data(), m.Data());
+            CheckNear(m, m1d.Inverse(), 1e-5);
+
+            float4 r;
+            MathSIMD::MulVector4Matrix4x4(v.Data(), m1.Data(), r.Data());
+            const auto rd = v.Recast<double>() * m1d;
+            for (int i = 0; i < 4; ++i)
+                EXPECT_NEAR(r[i], rd[i], 1e-4);
+        }
+#endif
+    }
+}
+
+TEST(Common_BasicMath, TransformPoints)
+{
+    FastRandFloat Rnd{0, -10, 10};
+
+    const auto m = float4x4::Scale(1, 2, 3) * float4x4::RotationY(0.5f) * float4x4::Translation(1, 2, 3) * float4x4::Projection(PI_F / 4.f, 1.5f, 0.1f, 100.f, false);
+
+    // Test different counts to cover the tail processing
+    for (size_t Count : {0, 1, 2, 3, 4, 5, 7, 8, 9, 15, 16, 1001})
+    {
+        std::vector<float3> Src(Count);
+        for (auto& Pt : Src)
+            Pt = float3{Rnd(), Rnd(), Rnd() + 20.f};
+
+        std::vector<float3> Points(Count);
+        TransformPoints(Src.data(), Points.data(), Count, m);
+
+        std::vector<float3> Normals(Count);
+        TransformNormals(Src.data(), Normals.data(), Count, m);
+
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const auto RefPoint  = Src[i] * m;
+            const auto RefNormal = float4{Src[i], 0} * m;
+            for (int c = 0; c < 3; ++c)
+            {
+                EXPECT_NEAR(Points[i][c], RefPoint[c], 1e-5f * (std::abs(RefPoint[c]) + 1)) << "Count=" << Count << " i=" << i;
+                EXPECT_NEAR(Normals[i][c], RefNormal[c], 1e-5f * (std::abs(RefNormal[c]) + 1)) << "Count=" << Count << " i=" << i;
+            }
+        }
+
+        // In-place transformation
+        std::vector<float3> InPlace = Src;
+        TransformPoints(InPlace.data(), InPlace.data(), Count, m);
+        EXPECT_EQ(InPlace, Points);
+
+        InPlace = Src;
+        TransformNormals(InPlace.data(), InPlace.data(), Count, m);
+        EXPECT_EQ(InPlace, Normals);
+    }
+}
+
+
 TEST(Common_AdvancedMath, Planes)
 {
     Plane3D plane = {};
@@ -2869,6 +2984,209 @@ TEST(Common_AdvancedMath, GetOrientedBoxVisibilityAgainstPlane)
     }
 }
 
+struct BoundBoxesSoAData
+{
+    std::vector<float> Min[3];
+    std::vector<float> Max[3];
+
+    std::vector<BoundBox> Boxes;
+
+    BoundBoxesSoAData(FastRandFloat& Rnd, size_t Count) :
+        Boxes(Count)
+    {
+        for (int c = 0; c < 3; ++c)
+        {
+            Min[c].resize(Count);
+            Max[c].resize(Count);
+        }
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const float3 Center{Rnd() * 20.f, Rnd() * 20.f, Rnd() * 20.f};
+            const float3 Size{std::abs(Rnd()) * 4.f, std::abs(Rnd()) * 4.f, std::abs(Rnd()) * 4.f};
+            Boxes[i] = BoundBox{Center - Size, Center + Size};
+            for (int c = 0; c < 3; ++c)
+            {
+                Min[c][i] = Boxes[i].Min[c];
+                Max[c][i] = Boxes[i].Max[c];
+            }
+        }
+    }
+
+    BoundBoxesSoA GetSoA() const
+    {
+        BoundBoxesSoA SoA;
+        for (int c = 0; c < 3; ++c)
+        {
+            SoA.Min[c] = Min[c].data();
+            SoA.Max[c] = Max[c].data();
+        }
+        SoA.Count = Boxes.size();
+        return SoA;
+    }
+};
+
+struct OrientedBoundingBoxesSoAData
+{
+    std::vector<float> Center[3];
+    std::vector<float> Axes[3][3];
+    std::vector<float> HalfExtents[3];
+
+    std::vector<OrientedBoundingBox> Boxes;
+
+    OrientedBoundingBoxesSoAData(FastRandFloat& Rnd, size_t Count) :
+        Boxes(Count)
+    {
+        for (size_t i = 0; i < Count; ++i)
+        {
+            const float4x4 Rotation = float4x4::RotationX(Rnd() * PI_F) * float4x4::RotationY(Rnd() * PI_F);
+
+            auto& Box  = Boxes[i];
+            Box.Center = float3{Rnd() * 20.f, Rnd() * 20.f, Rnd() * 20.f};
+            for (int a = 0; a < 3; ++a)
+            {
+                Box.Axes[a]        = float3::MakeVector(Rotation[a]);
+                Box.HalfExtents[a] = std::abs(Rnd()) * 4.f;
+            }
+        }
+
+        for (int a = 0; a < 3; ++a)
+        {
+            for (const auto& Box : Boxes)
+            {
+                Center[a].push_back(Box.Center[a]);
+                HalfExtents[a].push_back(Box.HalfExtents[a]);
+                for (int c = 0; c < 3; ++c)
+                    Axes[a][c].push_back(Box.Axes[a][c]);
+            }
+        }
+    }
+
+    OrientedBoundingBoxesSoA GetSoA() const
+    {
+        OrientedBoundingBoxesSoA SoA;
+        for (int a = 0; a < 3; ++a)
+        {
+            SoA.Center[a]      = Center[a].data();
+            SoA.HalfExtents[a] = HalfExtents[a].data();
+            for (int c = 0; c < 3; ++c)
+                SoA.Axes[a][c] = Axes[a][c].data();
+        }
+        SoA.Count = Boxes.size();
+        return SoA;
+    }
+};
+
+ViewFrustumExt MakeTestFrustum()
+{
+    const float4x4 ViewProj = float4x4::RotationY(0.3f) * float4x4::Translation(1, -2, 5) * float4x4::Projection(PI_F / 3.f, 1.5f, 1.f, 30.f, false);
+
+    ViewFrustumExt Frustum;
+    ExtractViewFrustumPlanesFromMatrix(ViewProj, Frustum, false);
+    return Frustum;
+}
+
+template <typename FrustumType, typename BoxesDataType>
+void TestBoxesVisibility(const FrustumType& Frustum, const BoxesDataType& Data, FRUSTUM_PLANE_FLAGS PlaneFlags, size_t& NumVisible)
+{
+    const auto& Boxes = Data.Boxes;
+
+    std::vector<Uint32> Mask((Boxes.size() + 31) / 32 + 1, 0xDEADBEEF);
+    GetBoxesVisibilityMask(Frustum, Data.GetSoA(), Mask.data(), PlaneFlags);
+
+    std::vector<Uint32> Indices(Boxes.size() + 1, 0xDEADBEEF);
+    const size_t        NumIndices = GetVisibleBoxIndices(Frustum, Data.GetSoA(), Indices.data(), PlaneFlags);
+
+    std::vector<Uint32> RefIndices;
+    for (size_t i = 0; i < Boxes.size(); ++i)
+    {
+        const bool IsVisible = GetBoxVisibility(Frustum, Boxes[i], PlaneFlags) != BoxVisibility::Invisible;
+        EXPECT_EQ((Mask[i / 32] & (1u << (i % 32))) != 0, IsVisible) << "i=" << i;
+        if (IsVisible)
+            RefIndices.push_back(static_cast<Uint32>(i));
+    }
+    if (Boxes.size() % 32 != 0)
+    {
+        EXPECT_EQ(Mask[Boxes.size() / 32] >> (Boxes.size() % 32), 0u) << "Unused bits must be zero";
+    }
+    EXPECT_EQ(Mask[(Boxes.size() + 31) / 32], 0xDEADBEEF);
+
+    ASSERT_EQ(NumIndices, RefIndices.size());
+    EXPECT_TRUE(std::equal(RefIndices.begin(), RefIndices.end(), Indices.begin()));
+    EXPECT_EQ(Indices[Boxes.size()], 0xDEADBEEF);
+
+    NumVisible += NumIndices;
+}
+
+TEST(Common_AdvancedMath, GetBoxesVisibility)
+{
+    const ViewFrustumExt Frustum = MakeTestFrustum();
+
+    FastRandFloat Rnd{0, -1, 1};
+    // Test different counts to cover the tail processing
+    for (size_t Count : {0, 1, 3, 4, 5, 31, 32, 33, 64, 100, 1000})
+    {
+        const BoundBoxesSoAData            AABBs{Rnd, Count};
+        const OrientedBoundingBoxesSoAData OBBs{Rnd, Count};
+        for (auto PlaneFlags : {FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, FRUSTUM_PLANE_FLAG_OPEN_NEAR, FRUSTUM_PLANE_FLAG_NONE})
+        {
+            size_t NumVisible = 0;
+            TestBoxesVisibility(static_cast<const ViewFrustum&>(Frustum), AABBs, PlaneFlags, NumVisible);
+            TestBoxesVisibility(Frustum, AABBs, PlaneFlags, NumVisible);
+            TestBoxesVisibility(static_cast<const ViewFrustum&>(Frustum), OBBs, PlaneFlags, NumVisible);
+            if (Count >= 100)
+            {
+                // Make sure that both visible and invisible boxes are tested
+                EXPECT_GT(NumVisible, 0u);
+                if (PlaneFlags != FRUSTUM_PLANE_FLAG_NONE)
+                {
+                    EXPECT_LT(NumVisible, Count * 3);
+                }
+            }
+        }
+    }
+}
+
+TEST(Common_AdvancedMath, GetBoxesVisibilityParallel)
+{
+    const ViewFrustumExt Frustum = MakeTestFrustum();
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    FastRandFloat Rnd{0, -1, 1};
+    for (size_t Count : {0, 1, 100, 1000, 10001})
+    {
+        const BoundBoxesSoAData AABBs{Rnd, Count};
+        const BoundBoxesSoA     SoA = AABBs.GetSoA();
+
+        std::vector<Uint32> RefMask((Count + 31) / 32);
+        GetBoxesVisibilityMask(Frustum, SoA, RefMask.data());
+
+        std::vector<Uint32> RefIndices(Count);
+        RefIndices.resize(GetVisibleBoxIndices(Frustum, SoA, RefIndices.data()));
+
+        for (size_t MinBoxesPerTask : {1, 50, 100000})
+        {
+            std::vector<Uint32> Mask((Count + 31) / 32);
+            GetBoxesVisibilityMaskParallel(pThreadPool, 5, Frustum, SoA, Mask.data(), FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, MinBoxesPerTask);
+            EXPECT_EQ(Mask, RefMask) << "Count=" << Count << " MinBoxesPerTask=" << MinBoxesPerTask;
+
+            std::vector<Uint32> Indices(Count);
+            Indices.resize(GetVisibleBoxIndicesParallel(pThreadPool, 5, Frustum, SoA, Indices.data(), FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, MinBoxesPerTask));
+            EXPECT_EQ(Indices, RefIndices) << "Count=" << Count << " MinBoxesPerTask=" << MinBoxesPerTask;
+        }
+
+        const OrientedBoundingBoxesSoAData OBBs{Rnd, Count};
+
+        std::vector<Uint32> OBBRefIndices(Count);
+        OBBRefIndices.resize(GetVisibleBoxIndices(Frustum, OBBs.GetSoA(), OBBRefIndices.data()));
+
+        std::vector<Uint32> OBBIndices(Count);
+        OBBIndices.resize(GetVisibleBoxIndicesParallel(pThreadPool, 5, static_cast<const ViewFrustum&>(Frustum), OBBs.GetSoA(), OBBIndices.data(), FRUSTUM_PLANE_FLAG_FULL_FRUSTUM, 64));
+        EXPECT_EQ(OBBIndices, OBBRefIndices);
+    }
+}
+
 TEST(Common_AdvancedMath, GetPointToBoxDistance)
 {
     BoundBox Box{float3{1, 2, 3}, float3{4, 5, 6}};
@@ -3295,4 +3613,152 @@ TEST(Common_AdvancedMath, TriangulatePolygon3D)
     }
 }
 
+template <typename T>
+double GetSignedArea(const std::vector<Vector2<T>>& Polygon)
+{
+    double Area = 0;
+    for (size_t i = 0, j = Polygon.size() - 1; i < Polygon.size(); j = i++)
+        Area += (static_cast<double>(Polygon[j].x) * Polygon[i].y - static_cast<double>(Polygon[i].x) * Polygon[j].y) * 0.5;
+    return Area;
+}
+
+// Checks that the triangles have the same winding as the polygon and cover
+// the area of the polygon minus the area of the holes
+template <typename T>
+void VerifyTriangulation(const std::vector<Vector2<T>>&              Polygon,
+                         const std::vector<std::vector<Vector2<T>>>& Holes,
+                         const std::vector<Uint32>&                  Tris,
+                         double                                      Tolerance)
+{
+    std::vector<Vector2<T>> Verts = Polygon;
+    for (const auto& Hole : Holes)
+        Verts.insert(Verts.end(), Hole.begin(), Hole.end());
+
+    const double PolygonArea = GetSignedArea(Polygon);
+
+    double RefArea = std::abs(PolygonArea);
+    for (const auto& Hole : Holes)
+        RefArea -= std::abs(GetSignedArea(Hole));
+
+    ASSERT_EQ(Tris.size() % 3, size_t{0});
+    double TrisArea = 0;
+    for (size_t i = 0; i < Tris.size(); i += 3)
+    {
+        ASSERT_LT(Tris[i + 0], Verts.size());
+        ASSERT_LT(Tris[i + 1], Verts.size());
+        ASSERT_LT(Tris[i + 2], Verts.size());
+
+        const double TriArea = GetSignedArea(std::vector<Vector2<T>>{Verts[Tris[i]], Verts[Tris[i + 1]], Verts[Tris[i + 2]]});
+        EXPECT_GE(TriArea * PolygonArea, 0) << "Triangle " << i / 3 << " has the wrong winding order";
+        TrisArea += std::abs(TriArea);
+    }
+    EXPECT_NEAR(TrisArea, RefArea, Tolerance * RefArea);
+}
+
+// Creates a star-shaped polygon with many reflex vertices
+std::vector<float2> MakeStarPolygon(size_t NumVerts, float2 Center, float Radius, bool CCW, FastRandFloat& Rnd)
+{
+    std::vector<float2> Polygon(NumVerts);
+    for (size_t i = 0; i < NumVerts; ++i)
+    {
+        const float Angle = static_cast<float>(i) / static_cast<float>(NumVerts) * 2.f * PI_F * (CCW ? 1.f : -1.f);
+        const float R     = Radius * (0.75f + 0.25f * Rnd());
+        Polygon[i]        = Center + float2{std::cos(Angle), std::sin(Angle)} * R;
+    }
+    return Polygon;
+}
+
+TEST(Common_AdvancedMath, TriangulatePolygonWithHoles)
+{
+    {
+        // Small polygons use the same ear test as TriangulatePolygon()
+        const std::vector<int2> Verts = {
+            {0, 0},
+            {1, 0},
+            {1, 1},
+            {0, 1}};
+        const auto Tris = TriangulatePolygonWithHoles<Uint32>(Verts);
+        VerifyTriangulation(Verts, {}, Tris, 0);
+        EXPECT_EQ(Tris.size(), size_t{6});
+    }
+
+    {
+        //   3 ____________ 2
+        //    |  7 ___ 6   |
+        //    |   |   |    |
+        //    |   |___|    |
+        //    |  4     5   |
+        //    |____________|
+        //   0              1
+        const std::vector<float2> Verts = {
+            {0, 0},
+            {3, 0},
+            {3, 3},
+            {0, 3}};
+        const std::vector<std::vector<float2>> Holes = {
+            {
+                {1, 1},
+                {2, 1},
+                {2, 2},
+                {1, 2},
+            },
+        };
+        const auto Tris = TriangulatePolygonWithHoles<Uint32>(Verts, Holes);
+        VerifyTriangulation(Verts, Holes, Tris, 1e-6);
+        EXPECT_EQ(Tris.size(), size_t{8 * 3});
+    }
+
+    FastRandFloat Rnd{0, -1, 1};
+    for (size_t NumVerts : {10, 100, 1000, 10000})
+    {
+        for (bool CCW : {true, false})
+        {
+            const auto Polygon = MakeStarPolygon(NumVerts, float2{0, 0}, 100, CCW, Rnd);
+
+            const auto Tris = TriangulatePolygonWithHoles<Uint32>(Polygon);
+            VerifyTriangulation(Polygon, {}, Tris, 1e-4);
+            EXPECT_EQ(Tris.size(), (NumVerts - 2) * 3);
+
+            // Holes arranged in a grid inside the polygon, with alternating winding
+            std::vector<std::vector<float2>> Holes;
+            for (int x = -1; x <= 1; ++x)
+            {
+                for (int y = -1; y <= 1; ++y)
+                    Holes.emplace_back(MakeStarPolygon(NumVerts / 10 + 3, float2{x * 20.f, y * 20.f}, 8, (x + y) % 2 == 0, Rnd));
+            }
+
+            const auto HoleTris = TriangulatePolygonWithHoles<Uint32>(Polygon, Holes);
+            VerifyTriangulation(Polygon, Holes, HoleTris, 1e-4);
+        }
+    }
+}
+
+TEST(Common_AdvancedMath, TriangulatePolygon3DWithHoles)
+{
+    const std::vector<float3> Verts = {
+        {0, 0, 1},
+        {3, 0, 1},
+        {3, 3, 1},
+        {0, 3, 1}};
+    const std::vector<std::vector<float3>> Holes = {
+        {
+            {1, 1, 1},
+            {2, 1, 1},
+            {2, 2, 1},
+            {1, 2, 1},
+        },
+    };
+    const auto Tris = TriangulatePolygon3DWithHoles<Uint32>(Verts, Holes);
+    ASSERT_EQ(Tris.size(), size_t{8 * 3});
+
+    std::vector<float3> AllVerts = Verts;
+    AllVerts.insert(AllVerts.end(), Holes[0].begin(), Holes[0].end());
+    for (size_t i = 0; i < Tris.size(); i += 3)
+    {
+        // All triangles must face the same direction as the polygon
+        const auto N = cross(AllVerts[Tris[i + 1]] - AllVerts[Tris[i]], AllVerts[Tris[i + 2]] - AllVerts[Tris[i]]);
+        EXPECT_GT(N.z, 0);
+    }
+}
+
 } // namespace
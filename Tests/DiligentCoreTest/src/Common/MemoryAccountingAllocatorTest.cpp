@@ -0,0 +1,245 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#include "MemoryAccountingAllocator.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "STDAllocator.hpp"
+
+#include <array>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+const MemoryAllocationStats* FindStats(const std::vector<MemoryAllocationStats>& Stats, const char* Name)
+{
+    for (const auto& S : Stats)
+    {
+        if (strcmp(S.Name, Name) == 0)
+            return &S;
+    }
+    return nullptr;
+}
+
+std::vector<MemoryAllocationStats> GetGroupStats(IMemoryAccounting& Accounting, MEMORY_ACCOUNTING_GROUP Group)
+{
+    std::vector<MemoryAllocationStats> Stats(Accounting.GetGroupStats(Group, nullptr, 0));
+    EXPECT_EQ(Accounting.GetGroupStats(Group, Stats.data(), static_cast<Uint32>(Stats.size())), Stats.size());
+    return Stats;
+}
+
+TEST(Common_MemoryAccountingAllocator, Tags)
+{
+    MemoryAccountingAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    // Descriptions with the same text are accounted to the same tag even if the pointers are different
+    char PoolTag[] = "Object pool";
+
+    void* pPool0 = Allocator.Allocate(256, "Object pool", "/src/ObjectPool.cpp", __LINE__);
+    void* pPool1 = Allocator.Allocate(512, PoolTag, "C:\\src\\ObjectPool.cpp", __LINE__);
+    void* pCache = Allocator.Allocate(100, "SRB cache", "/src/ShaderResourceCache.cpp", __LINE__);
+    void* pStr   = Allocator.Allocate(10, "Strings", "/src/ObjectPool.cpp", __LINE__);
+    ASSERT_NE(pPool0, nullptr);
+    ASSERT_NE(pPool1, nullptr);
+    EXPECT_EQ(reinterpret_cast<size_t>(pPool0) % alignof(std::max_align_t), size_t{0});
+    memset(pPool0, 0xAB, 256);
+    memset(pPool1, 0xCD, 512);
+
+    PoolTag[0] = 0; // The tag name must have been copied
+
+    {
+        const auto Total = Allocator.GetTotalStats();
+        EXPECT_EQ(Total.Name, nullptr);
+        EXPECT_EQ(Total.LiveBytes, 878u);
+        EXPECT_EQ(Total.PeakBytes, 878u);
+        EXPECT_EQ(Total.LiveAllocations, 4u);
+        EXPECT_EQ(Total.TotalAllocations, 4u);
+        EXPECT_EQ(Total.TotalBytes, 878u);
+
+        const auto Tags = GetGroupStats(Allocator, MEMORY_ACCOUNTING_GROUP_TAG);
+        ASSERT_EQ(Tags.size(), 3u);
+        // Largest consumers go first
+        EXPECT_STREQ(Tags[0].Name, "Object pool");
+        EXPECT_EQ(Tags[0].LiveBytes, 768u);
+        EXPECT_EQ(Tags[0].LiveAllocations, 2u);
+        EXPECT_STREQ(Tags[1].Name, "SRB cache");
+        EXPECT_STREQ(Tags[2].Name, "Strings");
+
+        const auto Subsystems = GetGroupStats(Allocator, MEMORY_ACCOUNTING_GROUP_SUBSYSTEM);
+        ASSERT_EQ(Subsystems.size(), 2u);
+        const auto* pPoolStats = FindStats(Subsystems, "ObjectPool.cpp");
+        ASSERT_NE(pPoolStats, nullptr);
+        EXPECT_EQ(pPoolStats->LiveBytes, 778u);
+        EXPECT_EQ(pPoolStats->LiveAllocations, 3u);
+        const auto* pCacheStats = FindStats(Subsystems, "ShaderResourceCache.cpp");
+        ASSERT_NE(pCacheStats, nullptr);
+        EXPECT_EQ(pCacheStats->LiveBytes, 100u);
+    }
+
+    // Partial query returns the largest group only
+    {
+        MemoryAllocationStats Largest;
+        EXPECT_EQ(Allocator.GetGroupStats(MEMORY_ACCOUNTING_GROUP_TAG, &Largest, 1), 3u);
+        EXPECT_STREQ(Largest.Name, "Object pool");
+    }
+
+    Allocator.Free(pPool0);
+    Allocator.Free(pPool1);
+    {
+        const auto Total = Allocator.GetTotalStats();
+        EXPECT_EQ(Total.LiveBytes, 110u);
+        EXPECT_EQ(Total.PeakBytes, 878u);
+        EXPECT_EQ(Total.LiveAllocations, 2u);
+        EXPECT_EQ(Total.TotalAllocations, 4u);
+
+        const auto  Tags       = GetGroupStats(Allocator, MEMORY_ACCOUNTING_GROUP_TAG);
+        const auto* pPoolStats = FindStats(Tags, "Object pool");
+        ASSERT_NE(pPoolStats, nullptr);
+        EXPECT_EQ(pPoolStats->LiveBytes, 0u);
+        EXPECT_EQ(pPoolStats->PeakBytes, 768u);
+        EXPECT_EQ(pPoolStats->TotalBytes, 768u);
+    }
+
+    Allocator.ResetPeakStats();
+    {
+        const auto Total = Allocator.GetTotalStats();
+        EXPECT_EQ(Total.PeakBytes, 110u);
+
+        const auto  Tags       = GetGroupStats(Allocator, MEMORY_ACCOUNTING_GROUP_TAG);
+        const auto* pPoolStats = FindStats(Tags, "Object pool");
+        ASSERT_NE(pPoolStats, nullptr);
+        EXPECT_EQ(pPoolStats->PeakBytes, 0u);
+    }
+
+    Allocator.Free(pCache);
+    Allocator.Free(pStr);
+    Allocator.Free(nullptr);
+
+    const auto Total = Allocator.GetTotalStats();
+    EXPECT_EQ(Total.LiveBytes, 0u);
+    EXPECT_EQ(Total.LiveAllocations, 0u);
+}
+
+TEST(Common_MemoryAccountingAllocator, RuntimeDescriptions)
+{
+    MemoryAccountingAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    // Descriptions built at run time are accounted by their text
+    std::string Descriptions[] = {"Texture 0", "Texture 1", "Texture 0"};
+
+    void* pTex0 = Allocator.Allocate(100, Descriptions[0].c_str(), __FILE__, __LINE__);
+    void* pTex1 = Allocator.Allocate(200, Descriptions[1].c_str(), __FILE__, __LINE__);
+    void* pTex2 = Allocator.Allocate(300, Descriptions[2].c_str(), __FILE__, __LINE__);
+
+    const auto Tags = GetGroupStats(Allocator, MEMORY_ACCOUNTING_GROUP_TAG);
+    ASSERT_EQ(Tags.size(), 2u);
+    EXPECT_STREQ(Tags[0].Name, "Texture 0");
+    EXPECT_EQ(Tags[0].LiveBytes, 400u);
+    EXPECT_STREQ(Tags[1].Name, "Texture 1");
+    EXPECT_EQ(Tags[1].LiveBytes, 200u);
+
+    Allocator.Free(pTex0);
+    Allocator.Free(pTex1);
+    Allocator.Free(pTex2);
+}
+
+TEST(Common_MemoryAccountingAllocator, STDAllocator)
+{
+    MemoryAccountingAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    {
+        std::vector<Uint32, STDAllocatorRawMem<Uint32>> Vec(STD_ALLOCATOR_RAW_MEM(Uint32, Allocator, "Test vector"));
+        Vec.resize(16);
+
+        MemoryAllocationStats Tag;
+        EXPECT_EQ(Allocator.GetGroupStats(MEMORY_ACCOUNTING_GROUP_TAG, &Tag, 1), 1u);
+        EXPECT_EQ(Tag.LiveBytes, 16 * sizeof(Uint32));
+
+        MemoryAllocationStats Subsystem;
+        EXPECT_EQ(Allocator.GetGroupStats(MEMORY_ACCOUNTING_GROUP_SUBSYSTEM, &Subsystem, 1), 1u);
+
+        // Release builds only keep container allocation descriptions when memory accounting is enabled
+#if defined(DILIGENT_DEVELOPMENT) || defined(DILIGENT_MEMORY_ACCOUNTING)
+        EXPECT_STREQ(Tag.Name, "Test vector");
+        EXPECT_STREQ(Subsystem.Name, "MemoryAccountingAllocatorTest.cpp");
+#else
+        EXPECT_STREQ(Tag.Name, "<Unavailable in release build>");
+        EXPECT_STREQ(Subsystem.Name, "<Unavailable in release build>");
+#endif
+    }
+
+    EXPECT_EQ(Allocator.GetTotalStats().LiveAllocations, 0u);
+}
+
+TEST(Common_MemoryAccountingAllocator, Multithreading)
+{
+    MemoryAccountingAllocator Allocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    constexpr size_t NumThreads     = 4;
+    constexpr size_t NumAllocations = 1000;
+
+    std::vector<std::thread> Threads;
+    for (size_t t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&Allocator, t]() {
+            static const char* Tags[] = {"Tag A", "Tag B", "Tag C"};
+
+            std::vector<void*> Allocations;
+            for (size_t i = 0; i < NumAllocations; ++i)
+            {
+                Allocations.push_back(Allocator.Allocate(16 + i % 64, Tags[(t + i) % _countof(Tags)], __FILE__, __LINE__));
+                if (i % 3 == 0)
+                {
+                    Allocator.Free(Allocations.back());
+                    Allocations.pop_back();
+                }
+            }
+            for (auto* Ptr : Allocations)
+                Allocator.Free(Ptr);
+        });
+    }
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    const auto Total = Allocator.GetTotalStats();
+    EXPECT_EQ(Total.LiveBytes, 0u);
+    EXPECT_EQ(Total.LiveAllocations, 0u);
+    EXPECT_EQ(Total.TotalAllocations, NumThreads * NumAllocations);
+
+    const auto Subsystems = GetGroupStats(Allocator, MEMORY_ACCOUNTING_GROUP_SUBSYSTEM);
+    ASSERT_EQ(Subsystems.size(), 1u);
+    EXPECT_STREQ(Subsystems[0].Name, "MemoryAccountingAllocatorTest.cpp");
+    EXPECT_EQ(Subsystems[0].TotalAllocations, NumThreads * NumAllocations);
+}
+
+} // namespace
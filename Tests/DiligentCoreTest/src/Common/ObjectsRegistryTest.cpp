@@ -70,9 +70,9 @@ struct RegistryDataObj : public ObjectBase<IObject>
 };
 
 template <template <typename T> class StrongPtrType, typename DataType>
-void TestObjectRegistryGet()
+void TestObjectRegistryGet(bool ReadMostly = false)
 {
-    ObjectsRegistry<int, StrongPtrType<DataType>> Registry;
+    ObjectsRegistry<int, StrongPtrType<DataType>> Registry{1024, ReadMostly};
 
     {
         int    Key    = 999;
@@ -131,11 +131,21 @@ TEST(Common_ObjectsRegistry, Get_RefCntAutoPtr)
     TestObjectRegistryGet<RefCntAutoPtr, RegistryDataObj>();
 }
 
+TEST(Common_ObjectsRegistry, Get_SharedPtr_ReadMostly)
+{
+    TestObjectRegistryGet<std::shared_ptr, RegistryData>(true);
+}
+
+TEST(Common_ObjectsRegistry, Get_RefCntAutoPtr_ReadMostly)
+{
+    TestObjectRegistryGet<RefCntAutoPtr, RegistryDataObj>(true);
+}
+
 
 template <template <typename T> class StrongPtrType, typename DataType>
-void TestObjectRegistryCreateDestroyRace()
+void TestObjectRegistryCreateDestroyRace(bool ReadMostly = false)
 {
-    ObjectsRegistry<int, StrongPtrType<DataType>> Registry{64};
+    ObjectsRegistry<int, StrongPtrType<DataType>> Registry{64, ReadMostly};
 
     constexpr Uint32         NumThreads = 16;
     std::vector<std::thread> Threads(NumThreads);
@@ -168,11 +178,21 @@ TEST(Common_ObjectsRegistry, CreateDestroyRace_RefCntAutoPtr)
     TestObjectRegistryCreateDestroyRace<RefCntAutoPtr, RegistryDataObj>();
 }
 
+TEST(Common_ObjectsRegistry, CreateDestroyRace_SharedPtr_ReadMostly)
+{
+    TestObjectRegistryCreateDestroyRace<std::shared_ptr, RegistryData>(true);
+}
+
+TEST(Common_ObjectsRegistry, CreateDestroyRace_RefCntAutoPtr_ReadMostly)
+{
+    TestObjectRegistryCreateDestroyRace<RefCntAutoPtr, RegistryDataObj>(true);
+}
+
 
 template <template <typename T> class StrongPtrType, typename DataType>
-void TestObjectRegistryExceptions()
+void TestObjectRegistryExceptions(bool ReadMostly = false)
 {
-    ObjectsRegistry<int, StrongPtrType<DataType>> Registry{128};
+    ObjectsRegistry<int, StrongPtrType<DataType>> Registry{128, ReadMostly};
 
     constexpr Uint32         NumThreads = 15; // Use odd number
     std::vector<std::thread> Threads(NumThreads);
@@ -244,4 +264,118 @@ TEST(Common_ObjectsRegistry, Exceptions_RefCntAutoPtr)
     TestObjectRegistryExceptions<RefCntAutoPtr, RegistryDataObj>();
 }
 
+TEST(Common_ObjectsRegistry, Exceptions_SharedPtr_ReadMostly)
+{
+    TestObjectRegistryExceptions<std::shared_ptr, RegistryData>(true);
+}
+
+TEST(Common_ObjectsRegistry, Exceptions_RefCntAutoPtr_ReadMostly)
+{
+    TestObjectRegistryExceptions<RefCntAutoPtr, RegistryDataObj>(true);
+}
+
+
+template <template <typename T> class StrongPtrType, typename DataType>
+void TestObjectRegistryReadMostlyReplace()
+{
+    ObjectsRegistry<int, StrongPtrType<DataType>> Registry{1024, true};
+    EXPECT_TRUE(Registry.IsReadMostly());
+
+    constexpr Uint32                     NumObjects = 64;
+    std::vector<StrongPtrType<DataType>> Objects(NumObjects);
+    for (Uint32 i = 0; i < NumObjects; ++i)
+    {
+        Objects[i] = Registry.Get(static_cast<int>(i), std::bind(DataType::Create, i));
+        ASSERT_NE(Objects[i], nullptr);
+    }
+
+    // Repeated lookups will eventually be served from the snapshot
+    for (Uint32 Pass = 0; Pass < 4; ++Pass)
+    {
+        for (Uint32 i = 0; i < NumObjects; ++i)
+            EXPECT_EQ(Registry.Get(static_cast<int>(i)), Objects[i]);
+    }
+
+    // Release one object. The snapshot still references the expired object.
+    Objects[5] = {};
+    EXPECT_EQ(Registry.Get(5), nullptr);
+
+    // Create a new object with the same key. The stale snapshot entry must not be returned.
+    Objects[5] = Registry.Get(5, std::bind(DataType::Create, 1000u));
+    ASSERT_NE(Objects[5], nullptr);
+    EXPECT_EQ(Objects[5]->Value, 1000u);
+    for (Uint32 Pass = 0; Pass < 4; ++Pass)
+    {
+        EXPECT_EQ(Registry.Get(5), Objects[5]);
+        EXPECT_EQ(Registry.Get(5, std::bind(DataType::Create, 2000u)), Objects[5]);
+    }
+
+    Objects.clear();
+    Registry.Purge();
+    for (Uint32 i = 0; i < NumObjects; ++i)
+        EXPECT_EQ(Registry.Get(static_cast<int>(i)), nullptr);
+}
+
+TEST(Common_ObjectsRegistry, ReadMostlyReplace_SharedPtr)
+{
+    TestObjectRegistryReadMostlyReplace<std::shared_ptr, RegistryData>();
+}
+
+TEST(Common_ObjectsRegistry, ReadMostlyReplace_RefCntAutoPtr)
+{
+    TestObjectRegistryReadMostlyReplace<RefCntAutoPtr, RegistryDataObj>();
+}
+
+template <template <typename T> class StrongPtrType, typename DataType>
+void TestObjectRegistryReadMostlyExpired()
+{
+    // Large purge threshold keeps expired entries in the snapshot
+    ObjectsRegistry<int, StrongPtrType<DataType>> Registry{1u << 20u, true};
+
+    constexpr Uint32 NumObjects = 1024;
+    constexpr Uint32 NumThreads = 8;
+    for (Uint32 Iter = 0; Iter < 4; ++Iter)
+    {
+        std::vector<StrongPtrType<DataType>> Objects(NumObjects);
+        for (Uint32 i = 0; i < NumObjects; ++i)
+            Objects[i] = Registry.Get(static_cast<int>(i), std::bind(DataType::Create, i));
+        // Make sure that all objects are in the snapshot
+        for (Uint32 i = 0; i < NumObjects; ++i)
+            EXPECT_EQ(Registry.Get(static_cast<int>(i)), Objects[i]);
+
+        // The snapshot now references expired objects only
+        Objects.clear();
+
+        // Look up expired objects from all threads simultaneously
+        std::vector<std::thread> Threads(NumThreads);
+        Threading::Signal        StartSignal;
+        for (Uint32 i = 0; i < NumThreads; ++i)
+        {
+            Threads[i] = std::thread(
+                [&]() {
+                    StartSignal.Wait();
+                    for (Uint32 Key = 0; Key < NumObjects; ++Key)
+                    {
+                        if (Registry.Get(static_cast<int>(Key)) != nullptr)
+                            ADD_FAILURE() << "Expired object must not be returned";
+                    }
+                });
+        }
+        StartSignal.Trigger(true);
+
+        for (auto& T : Threads)
+            T.join();
+    }
+}
+
+TEST(Common_ObjectsRegistry, ReadMostlyExpired_SharedPtr)
+{
+    TestObjectRegistryReadMostlyExpired<std::shared_ptr, RegistryData>();
+}
+
+TEST(Common_ObjectsRegistry, ReadMostlyExpired_RefCntAutoPtr)
+{
+    TestObjectRegistryReadMostlyExpired<RefCntAutoPtr, RegistryDataObj>();
+}
+
 } // namespace
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2015-2019 Egor Yusov
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+#include "ScratchArena.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+#include "HashUtils.hpp"
+#include "CountingAllocator.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+void PopulateContainers(ScratchArena& Arena, size_t Count)
+{
+    ScratchArena::Scope Scratch{Arena};
+
+    ScratchVector<Uint32> Vec{Scratch.GetSTDAllocator()};
+    for (Uint32 i = 0; i < Count; ++i)
+        Vec.push_back(i);
+
+    ScratchUnorderedMultimap<HashMapStringKey, Uint32> Map{Scratch.GetSTDAllocator()};
+    ScratchUnorderedSet<Uint32>                        Set{Scratch.GetSTDAllocator()};
+
+    static const char* Names[] = {"Tex", "Buff", "Sam", "Tex"};
+    for (Uint32 i = 0; i < Count; ++i)
+    {
+        Map.emplace(Names[i % _countof(Names)], i);
+        Set.insert(i);
+    }
+    EXPECT_EQ(Map.size(), Count);
+    EXPECT_EQ(Set.size(), Count);
+    EXPECT_EQ(Map.count("Tex"), (Count + 1) / 2);
+}
+
+TEST(Common_ScratchArena, SteadyState)
+{
+    CountingAllocator Allocator;
+    {
+        ScratchArena Arena{Allocator, 1024};
+
+        PopulateContainers(Arena, 256);
+        const auto NumWarmUpAllocations = Allocator.NumAllocations;
+        EXPECT_GT(NumWarmUpAllocations, size_t{0});
+        EXPECT_EQ(Arena.GetPageCount(), NumWarmUpAllocations);
+
+        // Once the arena is warmed up, no allocations are made from the backing allocator
+        for (size_t i = 0; i < 16; ++i)
+        {
+            PopulateContainers(Arena, 256);
+            PopulateContainers(Arena, 64);
+        }
+        EXPECT_EQ(Allocator.NumAllocations, NumWarmUpAllocations);
+        EXPECT_EQ(Allocator.NumDeallocations, size_t{0});
+
+        // Larger working set requires new pages
+        PopulateContainers(Arena, 1024);
+        EXPECT_GT(Allocator.NumAllocations, NumWarmUpAllocations);
+    }
+    EXPECT_EQ(Allocator.NumDeallocations, Allocator.NumAllocations);
+}
+
+TEST(Common_ScratchArena, HighWaterTrim)
+{
+    CountingAllocator Allocator;
+    {
+        ScratchArena Arena{Allocator, 1024, 4096};
+
+        PopulateContainers(Arena, 16);
+        const auto NumPages = Arena.GetPageCount();
+        EXPECT_EQ(Allocator.NumDeallocations, size_t{0});
+
+        // A large working set allocates pages beyond the retained size that are
+        // released when the scope ends
+        {
+            ScratchArena::Scope Scratch{Arena};
+            EXPECT_NE(Arena.Allocate(64 << 10, "Scratch arena test", __FILE__, __LINE__), nullptr);
+            EXPECT_GT(Arena.GetPageCount(), NumPages);
+        }
+        EXPECT_EQ(Arena.GetPageCount(), NumPages);
+        EXPECT_EQ(Allocator.NumDeallocations, Allocator.NumAllocations - NumPages);
+    }
+    EXPECT_EQ(Allocator.NumDeallocations, Allocator.NumAllocations);
+}
+
+TEST(Common_ScratchArena, NestedScopes)
+{
+    ScratchArena Arena{DefaultRawMemoryAllocator::GetAllocator(), 1024};
+
+    void* pOuter0 = nullptr;
+    {
+        ScratchArena::Scope Outer{Arena};
+        pOuter0 = Arena.Allocate(64, "Scratch arena test", __FILE__, __LINE__);
+        ASSERT_NE(pOuter0, nullptr);
+        EXPECT_EQ(reinterpret_cast<size_t>(pOuter0) % alignof(std::max_align_t), size_t{0});
+
+        void* pInner = nullptr;
+        {
+            ScratchArena::Scope Inner{Arena};
+            pInner = Arena.Allocate(64, "Scratch arena test", __FILE__, __LINE__);
+            EXPECT_NE(pInner, pOuter0);
+        }
+
+        // The inner scope does not release the memory
+        void* pOuter1 = Arena.Allocate(64, "Scratch arena test", __FILE__, __LINE__);
+        EXPECT_NE(pOuter1, pInner);
+        EXPECT_NE(pOuter1, pOuter0);
+    }
+
+    // The outermost scope resets the arena
+    {
+        ScratchArena::Scope Scope{Arena};
+        EXPECT_EQ(Arena.Allocate(64, "Scratch arena test", __FILE__, __LINE__), pOuter0);
+    }
+    EXPECT_EQ(Arena.GetPageCount(), size_t{1});
+}
+
+} // namespace
@@ -25,13 +25,16 @@
  */
 
 #include <cstring>
+#include <vector>
 
 #include "Serializer.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
+#include "CountingAllocator.hpp"
 
 #include "gtest/gtest.h"
 
 using namespace Diligent;
+using namespace Diligent::Testing;
 
 namespace
 {
@@ -172,4 +175,102 @@ TEST(SerializerTest, SerializerTest)
     }
 }
 
+TEST(SerializerTest, ZeroCopyArrays)
+{
+    const char* const RefStr                 = "odd";
+    const Uint8       RefU8                  = 0x19;
+    const Uint32      RefArraySize           = 5;
+    const Uint32      RefArray[RefArraySize] = {0x7215, 0x3306, 0x9911, 0x6, 0x100};
+    const Uint32      RefArray64Size         = 3;
+    const Uint64      RefArray64[]           = {0x123456789ull, 0xABCDEF012ull, 0x13ull};
+    const Uint32      RefArray16Size         = 2;
+    const Uint16      RefArray16[]           = {0x1234, 0x5678};
+    const Uint32      RefEmptySize           = 0;
+    const Uint32*     RefEmpty               = nullptr;
+
+    const auto WriteData = [&](auto& Ser) {
+        EXPECT_TRUE(Ser(RefStr, RefU8));
+        EXPECT_TRUE(Ser.SerializeArrayRaw(nullptr, RefArray, RefArraySize));
+        EXPECT_TRUE(Ser(RefU8));
+        EXPECT_TRUE(Ser.SerializeArrayRaw(nullptr, RefArray64, RefArray64Size));
+        EXPECT_TRUE(Ser(RefU8));
+        EXPECT_TRUE(Ser.SerializeArrayRaw(nullptr, RefArray16, RefArray16Size));
+        EXPECT_TRUE(Ser.SerializeArrayRaw(nullptr, RefEmpty, RefEmptySize));
+    };
+
+    auto& RawAllocator{DefaultRawMemoryAllocator::GetAllocator()};
+
+    Serializer<SerializerMode::Measure> MSer;
+    WriteData(MSer);
+
+    auto Data = MSer.AllocateData(RawAllocator);
+    {
+        Serializer<SerializerMode::Write> WSer{Data};
+        WriteData(WSer);
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+
+    // Reads the data and returns the number of allocations made by the deserializer
+    const auto ReadData = [&](const SerializedData& Data, bool ExpectInPlace) -> size_t {
+        CountingAllocator      Counter;
+        DynamicLinearAllocator Allocator{Counter};
+        {
+            const auto* const pDataStart = Data.Ptr<const Uint8>();
+            const auto* const pDataEnd   = pDataStart + Data.Size();
+            const auto        IsInPlace  = [&](const void* Ptr) {
+                return Ptr >= pDataStart && Ptr < pDataEnd;
+            };
+
+            Serializer<SerializerMode::Read> RSer{Data};
+
+            const char* Str = nullptr;
+            Uint8       U8  = 0;
+            EXPECT_TRUE(RSer(Str, U8));
+            EXPECT_STREQ(Str, RefStr);
+
+            const Uint32* pArray    = nullptr;
+            Uint32        ArraySize = 0;
+            EXPECT_TRUE(RSer.SerializeArrayRaw(&Allocator, pArray, ArraySize));
+            EXPECT_TRUE(RSer(U8));
+            EXPECT_EQ(ArraySize, RefArraySize);
+            EXPECT_EQ(std::memcmp(pArray, RefArray, sizeof(RefArray)), 0);
+            EXPECT_EQ(IsInPlace(pArray), ExpectInPlace);
+
+            const Uint64* pArray64    = nullptr;
+            Uint32        Array64Size = 0;
+            EXPECT_TRUE(RSer.SerializeArrayRaw(&Allocator, pArray64, Array64Size));
+            EXPECT_TRUE(RSer(U8));
+            EXPECT_EQ(Array64Size, RefArray64Size);
+            EXPECT_EQ(std::memcmp(pArray64, RefArray64, sizeof(RefArray64)), 0);
+            EXPECT_EQ(IsInPlace(pArray64), ExpectInPlace);
+
+            // Non-const pointers always receive a copy
+            Uint16* pArray16    = nullptr;
+            Uint32  Array16Size = 0;
+            EXPECT_TRUE(RSer.SerializeArrayRaw(&Allocator, pArray16, Array16Size));
+            EXPECT_EQ(Array16Size, RefArray16Size);
+            EXPECT_EQ(std::memcmp(pArray16, RefArray16, sizeof(RefArray16)), 0);
+            EXPECT_FALSE(IsInPlace(pArray16));
+
+            const Uint32* pEmpty    = nullptr;
+            Uint32        EmptySize = ~0u;
+            EXPECT_TRUE(RSer.SerializeArrayRaw(&Allocator, pEmpty, EmptySize));
+            EXPECT_EQ(EmptySize, 0u);
+            EXPECT_EQ(pEmpty, nullptr);
+
+            EXPECT_TRUE(RSer.IsEnded());
+        }
+        return Counter.NumAllocations;
+    };
+
+    // Only the non-const array is copied
+    EXPECT_EQ(ReadData(Data, true), 1u);
+
+    // Misaligned source data is copied
+    std::vector<Uint64> MisalignedBuffer(Data.Size() / sizeof(Uint64) + 2);
+    auto*               pMisalignedData = reinterpret_cast<Uint8*>(MisalignedBuffer.data()) + 1;
+    std::memcpy(pMisalignedData, Data.Ptr(), Data.Size());
+    ReadData(SerializedData{pMisalignedData, Data.Size()}, false);
+}
+
 } // namespace
@@ -1,5 +1,5 @@
 /*
- *  Copyright 2019-2022 Diligent Graphics LLC
+ *  Copyright 2019-2023 Diligent Graphics LLC
  *
  *  Licensed under the Apache License, Version 2.0 (the "License");
  *  you may not use this file except in compliance with the License.
@@ -30,8 +30,10 @@
 
 #include <array>
 #include <cmath>
+#include <ctime>
 
 #include "ThreadSignal.hpp"
+#include "Timer.hpp"
 
 
 using namespace Diligent;
@@ -193,11 +195,14 @@ public:
     }
 };
 
-TEST(Common_ThreadPool, RemoveTask)
+void TestRemoveTask(bool EnableWorkStealing)
 {
     constexpr Uint32 NumThreads = 4;
 
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
 
     Threading::Signal Signal;
@@ -246,12 +251,25 @@ TEST(Common_ThreadPool, RemoveTask)
     EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
 }
 
+TEST(Common_ThreadPool, RemoveTask)
+{
+    TestRemoveTask(false);
+}
+
+TEST(Common_ThreadPool, RemoveTask_WorkStealing)
+{
+    TestRemoveTask(true);
+}
+
 
-TEST(Common_ThreadPool, Reprioritize)
+void TestReprioritize(bool EnableWorkStealing)
 {
     constexpr Uint32 NumThreads = 4;
 
-    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
     ASSERT_NE(pThreadPool, nullptr);
 
     Threading::Signal Signal;
@@ -294,16 +312,29 @@ TEST(Common_ThreadPool, Reprioritize)
     pThreadPool->WaitForAllTasks();
 }
 
+TEST(Common_ThreadPool, Reprioritize)
+{
+    TestReprioritize(false);
+}
+
+TEST(Common_ThreadPool, Reprioritize_WorkStealing)
+{
+    TestReprioritize(true);
+}
+
 
-TEST(Common_ThreadPool, Priorities)
+void TestPriorities(bool EnableWorkStealing)
 {
     constexpr Uint32 NumThreads  = 1;
     constexpr Uint32 NumTasks    = 8;
     constexpr Uint32 RepeatCount = 10;
 
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
     for (Uint32 k = 0; k < RepeatCount; ++k)
     {
-        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{NumThreads});
+        auto pThreadPool = CreateThreadPool(PoolCI);
         ASSERT_NE(pThreadPool, nullptr);
 
         Threading::Signal       Signal;
@@ -356,4 +387,389 @@ TEST(Common_ThreadPool, Priorities)
     }
 }
 
+TEST(Common_ThreadPool, Priorities)
+{
+    TestPriorities(false);
+}
+
+TEST(Common_ThreadPool, Priorities_WorkStealing)
+{
+    TestPriorities(true);
+}
+
+
+void TestPrerequisites(bool EnableWorkStealing)
+{
+    constexpr Uint32 NumThreads = 4;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (Uint32 k = 0; k < 16; ++k)
+    {
+        // A -> {B0, ..., Bn} -> C -> D
+        constexpr Uint32 NumB = 32;
+
+        Threading::Signal Signal;
+
+        std::atomic<Uint32> NumBComplete{0};
+        std::atomic<bool>   AComplete{false};
+        std::atomic<bool>   CComplete{false};
+        std::atomic<bool>   DComplete{false};
+
+        auto pA = EnqueueAsyncWork(pThreadPool,
+                                   [&](Uint32 ThreadId) //
+                                   {
+                                       Signal.Wait();
+                                       AComplete.store(true);
+                                   });
+
+        IAsyncTask* pBPrereqs[] = {pA};
+
+        std::array<RefCntAutoPtr<IAsyncTask>, NumB> pB;
+        for (auto& pTask : pB)
+        {
+            pTask = EnqueueAsyncWork(pThreadPool, pBPrereqs, 1,
+                                     [&](Uint32 ThreadId) //
+                                     {
+                                         EXPECT_TRUE(AComplete.load());
+                                         NumBComplete.fetch_add(1);
+                                     });
+        }
+
+        std::array<IAsyncTask*, NumB> pCPrereqs;
+        for (Uint32 i = 0; i < NumB; ++i)
+            pCPrereqs[i] = pB[i];
+
+        auto pC = EnqueueAsyncWork(pThreadPool, pCPrereqs.data(), NumB,
+                                   [&](Uint32 ThreadId) //
+                                   {
+                                       EXPECT_EQ(NumBComplete.load(), NumB);
+                                       CComplete.store(true);
+                                   });
+
+        IAsyncTask* pDPrereqs[] = {pC};
+
+        auto pD = EnqueueAsyncWork(pThreadPool, pDPrereqs, 1,
+                                   [&](Uint32 ThreadId) //
+                                   {
+                                       EXPECT_TRUE(CComplete.load());
+                                       DComplete.store(true);
+                                   });
+
+        // Dependent tasks must not occupy worker threads
+        EXPECT_EQ(pThreadPool->GetWaitingTaskCount(), NumB + 2);
+        EXPECT_LE(pThreadPool->GetQueueSize() + pThreadPool->GetRunningTaskCount(), 1u);
+        EXPECT_EQ(pB[0]->GetStatus(), ASYNC_TASK_STATUS_NOT_STARTED);
+
+        Signal.Trigger(true, 1);
+        pThreadPool->WaitForAllTasks();
+
+        EXPECT_EQ(pThreadPool->GetWaitingTaskCount(), 0u);
+        EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+        EXPECT_EQ(pD->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+        EXPECT_TRUE(DComplete.load());
+
+        // Prerequisites that are already finished
+        std::atomic<bool> EComplete{false};
+
+        IAsyncTask* pEPrereqs[] = {pA, pD};
+
+        auto pE = EnqueueAsyncWork(pThreadPool, pEPrereqs, 2,
+                                   [&](Uint32 ThreadId) //
+                                   {
+                                       EComplete.store(true);
+                                   });
+        pThreadPool->WaitForAllTasks();
+        EXPECT_EQ(pE->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+        EXPECT_TRUE(EComplete.load());
+    }
+}
+
+TEST(Common_ThreadPool, Prerequisites)
+{
+    TestPrerequisites(false);
+}
+
+TEST(Common_ThreadPool, Prerequisites_WorkStealing)
+{
+    TestPrerequisites(true);
+}
+
+TEST(Common_ThreadPool, ReleasePrerequisites)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{2});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal Signal;
+
+    auto pFirst = EnqueueAsyncWork(pThreadPool,
+                                   [&](Uint32 ThreadId) //
+                                   {
+                                       Signal.Wait();
+                                   });
+
+    RefCntWeakPtr<IAsyncTask> pWeakFirst{pFirst};
+
+    // Chain of continuations: only the last task is referenced by the application
+    RefCntAutoPtr<IAsyncTask> pLast = pFirst;
+    for (Uint32 i = 0; i < 16; ++i)
+    {
+        IAsyncTask* pPrereqs[] = {pLast};
+        pLast = EnqueueAsyncWork(pThreadPool, pPrereqs, 1, [](Uint32 ThreadId) {});
+    }
+    pFirst.Release();
+    EXPECT_EQ(pLast->GetPrerequisiteCount(), 1u);
+
+    Signal.Trigger(true, 1);
+    pThreadPool->WaitForAllTasks();
+
+    EXPECT_EQ(pLast->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(pLast->GetPrerequisiteCount(), 0u);
+    EXPECT_FALSE(pWeakFirst.IsValid());
+}
+
+
+class CancelledTask : public AsyncTaskBase
+{
+public:
+    CancelledTask(IReferenceCounters* pRefCounters) :
+        AsyncTaskBase{pRefCounters}
+    {}
+
+    virtual void Run(Uint32 ThreadId) override final
+    {
+        SetStatus(ASYNC_TASK_STATUS_CANCELLED);
+    }
+};
+
+void TestCancellationPropagation(bool EnableWorkStealing)
+{
+    constexpr Uint32 NumThreads = 2;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = EnableWorkStealing;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    RefCntAutoPtr<CancelledTask> pCancelled{MakeNewRCObj<CancelledTask>()()};
+
+    std::atomic<bool> Completed{false};
+
+    auto pTaskA = EnqueueAsyncWork(pThreadPool, [&](Uint32 ThreadId) { Completed.store(true); });
+
+    IAsyncTask* pBPrereqs[] = {pTaskA, pCancelled};
+
+    std::atomic<bool> BRan{false};
+    auto              pTaskB = EnqueueAsyncWork(pThreadPool, pBPrereqs, 2, [&](Uint32 ThreadId) { BRan.store(true); });
+
+    IAsyncTask* pCPrereqs[] = {pTaskB};
+
+    std::atomic<bool> CRan{false};
+    auto              pTaskC = EnqueueAsyncWork(pThreadPool, pCPrereqs, 1, [&](Uint32 ThreadId) { CRan.store(true); });
+
+    std::atomic<Uint32> NumContinuationsCalled{0};
+    pTaskC->AddContinuation([&](IAsyncTask* pTask) {
+        EXPECT_EQ(pTask->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+        NumContinuationsCalled.fetch_add(1);
+    });
+
+    pThreadPool->EnqueueTask(pCancelled);
+    pThreadPool->WaitForAllTasks();
+
+    EXPECT_TRUE(Completed.load());
+    EXPECT_EQ(pTaskA->GetStatus(), ASYNC_TASK_STATUS_COMPLETE);
+    EXPECT_EQ(pTaskB->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    EXPECT_EQ(pTaskC->GetStatus(), ASYNC_TASK_STATUS_CANCELLED);
+    EXPECT_FALSE(BRan.load());
+    EXPECT_FALSE(CRan.load());
+    EXPECT_EQ(NumContinuationsCalled.load(), 1u);
+    EXPECT_EQ(pThreadPool->GetWaitingTaskCount(), 0u);
+
+    // Continuation added to a finished task is called immediately
+    pTaskC->AddContinuation([&](IAsyncTask* pTask) {
+        NumContinuationsCalled.fetch_add(1);
+    });
+    EXPECT_EQ(NumContinuationsCalled.load(), 2u);
+}
+
+TEST(Common_ThreadPool, CancellationPropagation)
+{
+    TestCancellationPropagation(false);
+}
+
+TEST(Common_ThreadPool, CancellationPropagation_WorkStealing)
+{
+    TestCancellationPropagation(true);
+}
+
+
+TEST(Common_ThreadPool, WaitTimeout)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal       Signal;
+    RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+    pThreadPool->EnqueueTask(pWaitTask);
+
+    auto pTask = EnqueueAsyncWork(pThreadPool, [](Uint32 ThreadId) {});
+
+    EXPECT_TRUE(pWaitTask->WaitUntilRunning(10000));
+    EXPECT_FALSE(pTask->WaitUntilRunning(10));
+    EXPECT_FALSE(pWaitTask->WaitForCompletion(10));
+    EXPECT_FALSE(pTask->WaitForCompletion(0));
+
+    Signal.Trigger(true, 1);
+
+    EXPECT_TRUE(pWaitTask->WaitForCompletion(10000));
+    EXPECT_TRUE(pTask->WaitForCompletion(10000));
+    EXPECT_TRUE(pTask->WaitUntilRunning(0));
+}
+
+TEST(Common_ThreadPool, WaitingThreadsAreIdle)
+{
+#if PLATFORM_WIN32 || PLATFORM_UNIVERSAL_WINDOWS
+    GTEST_SKIP() << "std::clock() does not measure CPU time on Windows";
+#endif
+
+    constexpr Uint32 NumWaitingThreads = 8;
+
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{1});
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal       Signal;
+    RefCntAutoPtr<WaitTask> pWaitTask{MakeNewRCObj<WaitTask>()(Signal)};
+    pThreadPool->EnqueueTask(pWaitTask);
+    pWaitTask->WaitUntilRunning();
+
+    std::vector<std::thread> WaitingThreads;
+    for (Uint32 i = 0; i < NumWaitingThreads; ++i)
+    {
+        WaitingThreads.emplace_back(
+            [&pWaitTask, i] //
+            {
+                if (i % 2 == 0)
+                    pWaitTask->WaitForCompletion();
+                else
+                    EXPECT_TRUE(pWaitTask->WaitForCompletion(60000));
+            });
+    }
+
+    // Let the threads get past the spinning phase
+    std::this_thread::sleep_for(std::chrono::milliseconds{50});
+
+    const auto StartCPUTime = std::clock();
+    Timer      T;
+    std::this_thread::sleep_for(std::chrono::milliseconds{200});
+    const auto CPUTime  = static_cast<double>(std::clock() - StartCPUTime) / CLOCKS_PER_SEC;
+    const auto WallTime = T.GetElapsedTime();
+
+    Signal.Trigger(true, 1);
+    for (auto& Thread : WaitingThreads)
+        Thread.join();
+
+    EXPECT_TRUE(pWaitTask->IsFinished());
+
+    // Waiting threads must be parked and must not consume CPU time
+    EXPECT_LT(CPUTime, WallTime * 0.1) << "Waiting threads consumed " << CPUTime << " s of CPU time in " << WallTime << " s";
+}
+
+
+// Enqueues NumRootTasks tasks from the calling thread. Every root task enqueues
+// NumChildTasks tasks from the worker thread, each performing NumIterations iterations.
+void RunNestedTasks(IThreadPool* pThreadPool, Uint32 NumRootTasks, Uint32 NumChildTasks, Uint32 NumIterations, std::atomic<Uint32>& NumTasksComplete)
+{
+    for (Uint32 i = 0; i < NumRootTasks; ++i)
+    {
+        EnqueueAsyncWork(pThreadPool,
+                         [pThreadPool, NumChildTasks, NumIterations, &NumTasksComplete](Uint32 ThreadId) //
+                         {
+                             for (Uint32 j = 0; j < NumChildTasks; ++j)
+                             {
+                                 EnqueueAsyncWork(pThreadPool,
+                                                  [NumIterations, &NumTasksComplete](Uint32 ThreadId) //
+                                                  {
+                                                      float f = 0.5;
+                                                      for (Uint32 k = 0; k < NumIterations; ++k)
+                                                          f = std::sin(f + 1.f);
+                                                      if (f != 0)
+                                                          NumTasksComplete.fetch_add(1);
+                                                  });
+                             }
+                             NumTasksComplete.fetch_add(1);
+                         });
+    }
+
+    pThreadPool->WaitForAllTasks();
+}
+
+TEST(Common_ThreadPool, NestedTasks_WorkStealing)
+{
+    constexpr Uint32 NumThreads    = 4;
+    constexpr Uint32 NumRootTasks  = 16;
+    constexpr Uint32 NumChildTasks = 64;
+
+    ThreadPoolCreateInfo PoolCI{NumThreads};
+    PoolCI.EnableWorkStealing = true;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    for (Uint32 k = 0; k < 4; ++k)
+    {
+        std::atomic<Uint32> NumTasksComplete{0};
+        RunNestedTasks(pThreadPool, NumRootTasks, NumChildTasks, 256, NumTasksComplete);
+
+        EXPECT_EQ(NumTasksComplete.load(), NumRootTasks * (NumChildTasks + 1));
+        EXPECT_EQ(pThreadPool->GetQueueSize(), 0u);
+        EXPECT_EQ(pThreadPool->GetRunningTaskCount(), 0u);
+    }
+}
+
+TEST(Common_ThreadPool, ReprioritizeLocalTask_WorkStealing)
+{
+    ThreadPoolCreateInfo PoolCI{1};
+    PoolCI.EnableWorkStealing = true;
+
+    auto pThreadPool = CreateThreadPool(PoolCI);
+    ASSERT_NE(pThreadPool, nullptr);
+
+    Threading::Signal TasksEnqueuedSignal;
+    Threading::Signal Signal;
+
+    std::vector<int>          CompletionOrder;
+    RefCntAutoPtr<IAsyncTask> pTask0;
+    RefCntAutoPtr<IAsyncTask> pTask1;
+    EnqueueAsyncWork(pThreadPool,
+                     [&](Uint32 ThreadId) //
+                     {
+                         // These tasks go to the local queue of the worker thread
+                         pTask0 = EnqueueAsyncWork(pThreadPool, [&](Uint32) { CompletionOrder.push_back(0); });
+                         pTask1 = EnqueueAsyncWork(pThreadPool, [&](Uint32) { CompletionOrder.push_back(1); });
+                         TasksEnqueuedSignal.Trigger();
+                         Signal.Wait();
+                     });
+
+    TasksEnqueuedSignal.Wait();
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 2u);
+
+    // Local queue is processed in LIFO order, so Task1 would run first.
+    // Raising the priority of Task0 must make it run before Task1.
+    pTask0->SetPriority(1);
+    EXPECT_TRUE(pThreadPool->ReprioritizeTask(pTask0));
+    EXPECT_EQ(pThreadPool->GetQueueSize(), 2u);
+
+    Signal.Trigger(true, 1);
+    pThreadPool->WaitForAllTasks();
+
+    ASSERT_EQ(CompletionOrder.size(), 2u);
+    EXPECT_EQ(CompletionOrder[0], 0);
+    EXPECT_EQ(CompletionOrder[1], 1);
+}
+
 } // namespace
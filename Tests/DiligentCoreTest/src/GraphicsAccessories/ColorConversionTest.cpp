@@ -0,0 +1,212 @@
+/*
+ *  Copyright 2024 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "ColorConversion.h"
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+float HalfToFloatRef(Uint16 h)
+{
+    const int Exp  = (h >> 10) & 0x1F;
+    const int Mant = h & 0x3FF;
+
+    float f = 0;
+    if (Exp == 0)
+        f = std::ldexp(static_cast<float>(Mant), -24);
+    else if (Exp == 31)
+        f = Mant == 0 ? std::numeric_limits<float>::infinity() : std::numeric_limits<float>::quiet_NaN();
+    else
+        f = std::ldexp(static_cast<float>(Mant + 1024), Exp - 25);
+    return (h & 0x8000) != 0 ? -f : f;
+}
+
+double GammaToLinearRef(double x)
+{
+    return x <= 0.04045 ? x / 12.92 : std::pow((x + 0.055) / 1.055, 2.4);
+}
+
+int LinearToSRGB8Ref(float x)
+{
+    if (!(x > 0))
+        return 0;
+    if (x >= 1)
+        return 255;
+
+    const double s = x <= 0.0031308 ? x * 12.92 : 1.055 * std::pow(static_cast<double>(x), 1.0 / 2.4) - 0.055;
+    return static_cast<int>(std::floor(s * 255.0 + 0.5));
+}
+
+TEST(GraphicsAccessories_ColorConversion, SRGBToLinear)
+{
+    std::vector<Uint8> SRGB(256 * 3 + 5);
+    for (size_t i = 0; i < SRGB.size(); ++i)
+        SRGB[i] = static_cast<Uint8>(i);
+
+    std::vector<float> Linear(SRGB.size());
+    SRGBToLinear(SRGB.data(), Linear.data(), SRGB.size());
+    for (size_t i = 0; i < SRGB.size(); ++i)
+    {
+        EXPECT_EQ(Linear[i], GammaToLinear(SRGB[i])) << i;
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, LinearToSRGB)
+{
+    // Test every 61st float in [0, 1] range
+    std::vector<float> Linear;
+    for (Uint32 Bits = 0; Bits <= 0x3F800000u; Bits += 61)
+    {
+        float f;
+        std::memcpy(&f, &Bits, sizeof(f));
+        Linear.push_back(f);
+    }
+
+    // Test the values around every threshold
+    for (int k = 1; k < 256; ++k)
+    {
+        const float t = static_cast<float>(GammaToLinearRef((k - 0.5) / 255.0));
+
+        float f = t;
+        for (int i = 0; i < 4; ++i)
+            f = std::nextafter(f, 0.f);
+        for (int i = 0; i < 9; ++i)
+        {
+            Linear.push_back(f);
+            f = std::nextafter(f, 1.f);
+        }
+    }
+
+    // Special values
+    for (float f : {-1.f, -0.f, 1.5f, 100.f,
+                    std::numeric_limits<float>::infinity(),
+                    -std::numeric_limits<float>::infinity(),
+                    std::numeric_limits<float>::quiet_NaN(),
+                    std::numeric_limits<float>::denorm_min(),
+                    std::nextafter(1.f, 0.f)})
+    {
+        Linear.push_back(f);
+    }
+
+    std::vector<Uint8> SRGB(Linear.size());
+    LinearToSRGB(Linear.data(), SRGB.data(), Linear.size());
+    for (size_t i = 0; i < Linear.size(); ++i)
+    {
+        const int Ref = LinearToSRGB8Ref(Linear[i]);
+        if (SRGB[i] != Ref)
+        {
+            ADD_FAILURE() << "Value: " << Linear[i] << ", result: " << int{SRGB[i]} << ", expected: " << Ref;
+            break;
+        }
+    }
+
+    // Unaligned tails
+    for (size_t Count = 0; Count < 8; ++Count)
+    {
+        std::vector<Uint8> TailSRGB(Count);
+        LinearToSRGB(Linear.data() + 1, TailSRGB.data(), Count);
+        for (size_t i = 0; i < Count; ++i)
+            EXPECT_EQ(TailSRGB[i], SRGB[i + 1]);
+    }
+}
+
+TEST(GraphicsAccessories_ColorConversion, SRGBA8ToLinearRGBA16F)
+{
+    std::vector<Uint8> SRGBA(256 * 4);
+    for (Uint32 i = 0; i < 256; ++i)
+    {
+        SRGBA[i * 4 + 0] = static_cast<Uint8>(i);
+        SRGBA[i * 4 + 1] = static_cast<Uint8>(255 - i);
+        SRGBA[i * 4 + 2] = static_cast<Uint8>(i * 7);
+        SRGBA[i * 4 + 3] = static_cast<Uint8>(i);
+    }
+
+    std::vector<Uint16> RGBA16F(SRGBA.size());
+    SRGBA8ToLinearRGBA16F(SRGBA.data(), RGBA16F.data(), 256);
+    for (size_t i = 0; i < SRGBA.size(); ++i)
+    {
+        const bool   IsAlpha = (i % 4) == 3;
+        const double Ref     = IsAlpha ? SRGBA[i] / 255.0 : GammaToLinearRef(SRGBA[i] / 255.0);
+
+        // The result must be the nearest half value
+        const Uint16 h    = RGBA16F[i];
+        const double Dist = std::abs(HalfToFloatRef(h) - Ref);
+        EXPECT_LE(Dist, std::abs(HalfToFloatRef(static_cast<Uint16>(h + 1)) - Ref)) << i;
+        if (h > 0)
+        {
+            EXPECT_LE(Dist, std::abs(HalfToFloatRef(static_cast<Uint16>(h - 1)) - Ref)) << i;
+        }
+    }
+
+    // Round trip must be lossless
+    std::vector<Uint8> SRGBA2(SRGBA.size());
+    LinearRGBA16FToSRGBA8(RGBA16F.data(), SRGBA2.data(), 256);
+    EXPECT_EQ(SRGBA, SRGBA2);
+}
+
+TEST(GraphicsAccessories_ColorConversion, LinearRGBA16FToSRGBA8)
+{
+    // Test every half value in every channel
+    std::vector<Uint16> RGBA16F(65536 * 4);
+    for (Uint32 h = 0; h < 65536; ++h)
+    {
+        for (Uint32 c = 0; c < 4; ++c)
+            RGBA16F[h * 4 + c] = static_cast<Uint16>(h + c * 16384);
+    }
+
+    std::vector<Uint8> SRGBA(RGBA16F.size());
+    LinearRGBA16FToSRGBA8(RGBA16F.data(), SRGBA.data(), 65536);
+
+    size_t NumErrors = 0;
+    for (size_t i = 0; i < RGBA16F.size() && NumErrors < 10; ++i)
+    {
+        const float f = HalfToFloatRef(RGBA16F[i]);
+
+        int Ref = 0;
+        if ((i % 4) == 3)
+            Ref = f > 0 ? static_cast<int>(std::floor(std::min(f, 1.f) * 255.0 + 0.5)) : 0;
+        else
+            Ref = LinearToSRGB8Ref(f);
+
+        if (SRGBA[i] != Ref)
+        {
+            ADD_FAILURE() << "Half: " << RGBA16F[i] << " (" << f << "), channel: " << i % 4 << ", result: " << int{SRGBA[i]} << ", expected: " << Ref;
+            ++NumErrors;
+        }
+    }
+}
+
+} // namespace
@@ -0,0 +1,297 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+#include "ConcurrentRingBuffer.hpp"
+#include "DefaultRawMemoryAllocator.hpp"
+
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include "gtest/gtest.h"
+
+using namespace Diligent;
+
+namespace
+{
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, AllocDealloc)
+{
+    // Need to define local variable to avoid vexing linker errors
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+    using OffsetType         = ConcurrentRingBuffer::OffsetType;
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    ConcurrentRingBuffer RB(1024, 16, Allocator);
+    EXPECT_TRUE(RB.IsEmpty());
+
+    auto Offset = RB.Allocate(120, 1);
+    //
+    //  O          h
+    //  |          |                                      |
+    //  0         128
+    EXPECT_EQ(Offset, OffsetType{0});
+
+    Offset = RB.Allocate(10, 16);
+    //
+    //  t          O   h
+    //  |          |   |                                  |
+    //  0         128 144
+    EXPECT_EQ(Offset, OffsetType{128});
+
+    Offset = RB.Allocate(64, 64);
+    //
+    //  t                  O       h
+    //  |                  |       |                      |
+    //  0         128 144 192     256
+    EXPECT_EQ(Offset, OffsetType{192});
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{256});
+
+    RB.FinishCurrentFrame(1);
+
+    Offset = RB.Allocate(512, 16);
+    //
+    //  t                          h1       O             h
+    //  |                          |        |             |
+    //  0                         256      768          1024
+    EXPECT_EQ(Offset, OffsetType{256});
+
+    Offset = RB.Allocate(256, 16);
+    EXPECT_EQ(Offset, OffsetType{768});
+    EXPECT_TRUE(RB.IsFull());
+
+    Offset = RB.Allocate(16, 16);
+    EXPECT_EQ(Offset, InvalidOffset);
+    Offset = RB.Allocate(16, 256);
+    EXPECT_EQ(Offset, InvalidOffset);
+
+    RB.FinishCurrentFrame(2);
+    RB.FinishCurrentFrame(3); // ignored
+    RB.ReleaseCompletedFrames(1);
+    //
+    //                             t                      h2
+    //  |                          |                      |
+    //  0                         256                   1024
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{768});
+
+    Offset = RB.Allocate(200, 16);
+    //
+    //  O          h               t                      h2
+    //  |          |               |                      |
+    //  0         208             256                   1024
+    EXPECT_EQ(Offset, OffsetType{0});
+
+    Offset = RB.Allocate(64, 16);
+    EXPECT_EQ(Offset, InvalidOffset);
+
+    Offset = RB.Allocate(48, 16);
+    EXPECT_EQ(Offset, OffsetType{208});
+    EXPECT_TRUE(RB.IsFull());
+
+    RB.FinishCurrentFrame(4);
+    RB.ReleaseCompletedFrames(4);
+    //
+    //                 h4,t
+    //  |               |                                 |
+    //  0              256                              1024
+    EXPECT_TRUE(RB.IsEmpty());
+
+    Offset = RB.Allocate(640, 16);
+    EXPECT_EQ(Offset, OffsetType{256});
+
+    Offset = RB.Allocate(256, 16);
+    //
+    //  The range [896, 1152) crosses the end of the buffer and is left unused.
+    //  The next range [128, 384) overlaps the tail, so the allocation fails.
+    //
+    //        h        t                         h'
+    //  |     |        |                         |        |
+    //  0    128      256                       896     1024
+    EXPECT_EQ(Offset, InvalidOffset);
+    EXPECT_EQ(RB.GetUsedSize(), OffsetType{896});
+
+    Offset = RB.Allocate(128, 16);
+    EXPECT_EQ(Offset, OffsetType{128});
+    EXPECT_TRUE(RB.IsFull());
+
+    RB.FinishCurrentFrame(5);
+    RB.ReleaseCompletedFrames(5);
+    EXPECT_TRUE(RB.IsEmpty());
+
+    Offset = RB.Allocate(600, 16);
+    //
+    //                 t,O                         h
+    //  |               |                          |      |
+    //  0              256                        864   1024
+    EXPECT_EQ(Offset, OffsetType{256});
+
+    Offset = RB.Allocate(200, 256);
+    //
+    //  The aligned offset (1024) does not leave space for the allocation,
+    //  so it is allocated from the beginning of the buffer.
+    //
+    //  O              h,t
+    //  |               |                                 |
+    //  0              256                              1024
+    EXPECT_EQ(Offset, OffsetType{0});
+    EXPECT_TRUE(RB.IsFull());
+
+    RB.FinishCurrentFrame(6);
+    RB.ReleaseCompletedFrames(6);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, MultithreadedAllocation)
+{
+    using OffsetType = ConcurrentRingBuffer::OffsetType;
+
+    constexpr OffsetType MinAlignment         = 16;
+    constexpr size_t     NumFrames            = 64;
+    constexpr size_t     FramesInFlight       = 2;
+    constexpr size_t     AllocationsPerThread = 32;
+
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    // Every allocation takes at most 512 bytes including the alignment. While one frame is
+    // being released, three frames may occupy the buffer, so it is made four frames large
+    // to account for the unused ranges at the end of the buffer.
+    const OffsetType BufferSize = NumThreads * AllocationsPerThread * 512 * 4;
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    ConcurrentRingBuffer RB(BufferSize, MinAlignment, Allocator);
+
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+
+    struct Allocation
+    {
+        OffsetType Offset;
+        OffsetType Size;
+    };
+    std::vector<std::vector<Allocation>> FrameAllocations(NumFrames);
+
+    for (size_t Frame = 0; Frame < NumFrames; ++Frame)
+    {
+        std::vector<std::vector<Allocation>> ThreadAllocations(NumThreads);
+
+        std::vector<std::thread> Threads;
+        Threads.reserve(NumThreads);
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back(
+                [&RB, &Allocations = ThreadAllocations[t], MinAlignment, InvalidOffset, Seed = static_cast<unsigned int>(Frame * NumThreads + t)]() {
+                    std::mt19937 Gen{Seed};
+
+                    std::uniform_int_distribution<OffsetType> SizeDistr{1, 256};
+                    std::uniform_int_distribution<Uint32>     AlignDistr{0, 4};
+                    for (size_t i = 0; i < AllocationsPerThread; ++i)
+                    {
+                        const auto Size      = SizeDistr(Gen);
+                        const auto Alignment = OffsetType{1} << (AlignDistr(Gen) * 2);
+
+                        const auto Offset = RB.Allocate(Size, Alignment);
+                        ASSERT_NE(Offset, InvalidOffset);
+                        EXPECT_EQ(Offset % std::max(Alignment, MinAlignment), OffsetType{0});
+                        Allocations.push_back({Offset, Size});
+                    }
+                });
+        }
+
+        // Release the frame that the GPU has finished while other threads allocate the space
+        if (Frame >= FramesInFlight)
+            RB.ReleaseCompletedFrames(Frame - FramesInFlight);
+
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        RB.FinishCurrentFrame(Frame);
+
+        for (const auto& Allocations : ThreadAllocations)
+            FrameAllocations[Frame].insert(FrameAllocations[Frame].end(), Allocations.begin(), Allocations.end());
+
+        // Allocations of the frames that have not been released must not overlap
+        std::vector<Allocation> LiveAllocations;
+        for (size_t f = Frame >= FramesInFlight ? Frame - FramesInFlight + 1 : 0; f <= Frame; ++f)
+            LiveAllocations.insert(LiveAllocations.end(), FrameAllocations[f].begin(), FrameAllocations[f].end());
+        std::sort(LiveAllocations.begin(), LiveAllocations.end(),
+                  [](const Allocation& A0, const Allocation& A1) { return A0.Offset < A1.Offset; });
+        for (size_t i = 0; i < LiveAllocations.size(); ++i)
+        {
+            const auto& Alloc = LiveAllocations[i];
+            EXPECT_LE(Alloc.Offset + Alloc.Size, BufferSize);
+            if (i + 1 < LiveAllocations.size())
+            {
+                EXPECT_LE(Alloc.Offset + Alloc.Size, LiveAllocations[i + 1].Offset);
+            }
+        }
+    }
+
+    RB.ReleaseCompletedFrames(NumFrames);
+    EXPECT_TRUE(RB.IsEmpty());
+}
+
+TEST(GraphicsAccessories_ConcurrentRingBuffer, Overflow)
+{
+    constexpr ConcurrentRingBuffer::OffsetType BufferSize = 4096;
+
+    const size_t NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    ConcurrentRingBuffer RB(BufferSize, 16, Allocator);
+
+    const auto InvalidOffset = ConcurrentRingBuffer::InvalidOffset;
+
+    for (Uint64 Frame = 0; Frame < 16; ++Frame)
+    {
+        std::atomic<size_t> TotalSize{0};
+
+        std::vector<std::thread> Threads;
+        for (size_t t = 0; t < NumThreads; ++t)
+        {
+            Threads.emplace_back([&]() {
+                // Allocate until the buffer is full
+                while (RB.Allocate(48, 16) != InvalidOffset)
+                    TotalSize.fetch_add(48);
+            });
+        }
+        for (auto& Thread : Threads)
+            Thread.join();
+
+        EXPECT_LE(TotalSize.load(), BufferSize);
+        EXPECT_GT(TotalSize.load(), size_t{0});
+        EXPECT_GE(RB.GetUsedSize(), TotalSize.load());
+        EXPECT_EQ(RB.Allocate(48, 16), InvalidOffset);
+
+        RB.FinishCurrentFrame(Frame);
+        RB.ReleaseCompletedFrames(Frame);
+        EXPECT_TRUE(RB.IsEmpty());
+    }
+}
+
+} // namespace
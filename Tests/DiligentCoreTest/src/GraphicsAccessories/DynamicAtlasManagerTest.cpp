@@ -26,9 +26,11 @@
  */
 
 #include "DynamicAtlasManager.hpp"
+#include "PlatformDefinitions.h"
 
 #include <array>
 #include <algorithm>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -146,26 +148,36 @@ TEST(GraphicsAccessories_DynamicAtlasManager, Region_Hasher)
     EXPECT_NE(H(Region{1, 2, 3, 0}), H(Region{1, 2, 3, 4}));
 }
 
+using PackingMode = DynamicAtlasManager::Mode;
+
 TEST(GraphicsAccessories_DynamicAtlasManager, Empty)
 {
-    DynamicAtlasManager Mgr{16, 8};
-    EXPECT_TRUE(Mgr.IsEmpty());
+    for (auto Mode : {PackingMode::SplitTree, PackingMode::Skyline})
+    {
+        DynamicAtlasManager Mgr{16, 8, Mode};
+        EXPECT_TRUE(Mgr.IsEmpty());
+        EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+        EXPECT_EQ(Mgr.GetOccupancy(), 0.f);
+    }
 }
 
 TEST(GraphicsAccessories_DynamicAtlasManager, Move)
 {
-    DynamicAtlasManager Mgr0{16, 8};
+    for (auto Mode : {PackingMode::SplitTree, PackingMode::Skyline})
+    {
+        DynamicAtlasManager Mgr0{16, 8, Mode};
 
-    auto R = Mgr0.Allocate(16, 8);
+        auto R = Mgr0.Allocate(16, 8);
 
-    DynamicAtlasManager Mgr1{std::move(Mgr0)};
-    Mgr1.Free(std::move(R));
+        DynamicAtlasManager Mgr1{std::move(Mgr0)};
+        Mgr1.Free(std::move(R));
+    }
 }
 
-TEST(GraphicsAccessories_DynamicAtlasManager, Allocate)
+void TestAllocate(PackingMode Mode)
 {
     {
-        DynamicAtlasManager Mgr{16, 8};
+        DynamicAtlasManager Mgr{16, 8, Mode};
         EXPECT_TRUE(Mgr.IsEmpty());
 
         auto R = Mgr.Allocate(16, 8);
@@ -175,28 +187,28 @@ TEST(GraphicsAccessories_DynamicAtlasManager, Allocate)
     }
 
     {
-        DynamicAtlasManager Mgr{16, 16};
+        DynamicAtlasManager Mgr{16, 16, Mode};
 
         auto R = Mgr.Allocate(8, 16);
         Mgr.Free(std::move(R));
     }
 
     {
-        DynamicAtlasManager Mgr{16, 16};
+        DynamicAtlasManager Mgr{16, 16, Mode};
 
         auto R = Mgr.Allocate(16, 8);
         Mgr.Free(std::move(R));
     }
 
     {
-        DynamicAtlasManager Mgr{20, 16};
+        DynamicAtlasManager Mgr{20, 16, Mode};
 
         auto R = Mgr.Allocate(16, 8);
         Mgr.Free(std::move(R));
     }
 
     {
-        DynamicAtlasManager Mgr{16, 20};
+        DynamicAtlasManager Mgr{16, 20, Mode};
 
         auto R = Mgr.Allocate(12, 8);
         Mgr.Free(std::move(R));
@@ -226,7 +238,7 @@ TEST(GraphicsAccessories_DynamicAtlasManager, Allocate)
             if (i == 1)
                 std::swap(AtlasWidth, AtlasHeight);
 
-            DynamicAtlasManager Mgr{AtlasWidth, AtlasHeight};
+            DynamicAtlasManager Mgr{AtlasWidth, AtlasHeight, Mode};
 
             std::array<Region, N> Rs;
             for (Uint32 r = 0; r < N; ++r)
@@ -236,10 +248,19 @@ TEST(GraphicsAccessories_DynamicAtlasManager, Allocate)
                 if (i == 1)
                     std::swap(w, h);
                 Rs[r] = Mgr.Allocate(w, h);
+                // Skyline only places regions at the left edges of its segments,
+                // and may not find the space for all regions in this layout.
+                if (Mode == PackingMode::SplitTree)
+                {
+                    EXPECT_FALSE(Rs[r].IsEmpty());
+                }
             }
 
             for (auto id : ids)
-                Mgr.Free(std::move(Rs[id]));
+            {
+                if (!Rs[id].IsEmpty())
+                    Mgr.Free(std::move(Rs[id]));
+            }
 
         } while (std::next_permutation(ids.begin(), ids.end()));
     }
@@ -445,9 +466,45 @@ TEST(GraphicsAccessories_DynamicAtlasManager, Allocate)
 #endif
 }
 
-TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
+TEST(GraphicsAccessories_DynamicAtlasManager, Allocate)
+{
+    TestAllocate(PackingMode::SplitTree);
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Allocate_Skyline)
+{
+    TestAllocate(PackingMode::Skyline);
+}
+
+void VerifyRegions(const DynamicAtlasManager& Mgr, const std::vector<Region>& Regions)
+{
+    Uint64 Area = 0;
+    for (size_t i = 0; i < Regions.size(); ++i)
+    {
+        const auto& R0 = Regions[i];
+        if (R0.IsEmpty())
+            continue;
+
+        EXPECT_LE(R0.x + R0.width, Mgr.GetWidth());
+        EXPECT_LE(R0.y + R0.height, Mgr.GetHeight());
+        Area += Uint64{R0.width} * Uint64{R0.height};
+
+        for (size_t j = i + 1; j < Regions.size(); ++j)
+        {
+            const auto& R1 = Regions[j];
+            if (R1.IsEmpty())
+                continue;
+
+            const bool Overlap = R0.x < R1.x + R1.width && R1.x < R0.x + R0.width && R0.y < R1.y + R1.height && R1.y < R0.y + R0.height;
+            EXPECT_FALSE(Overlap) << R0 << " overlaps " << R1;
+        }
+    }
+    EXPECT_EQ(Mgr.GetTotalFreeArea(), Uint64{Mgr.GetWidth()} * Uint64{Mgr.GetHeight()} - Area);
+}
+
+void TestAllocateRandom(PackingMode Mode)
 {
-    DynamicAtlasManager Mgr{256, 256};
+    DynamicAtlasManager Mgr{256, 256, Mode};
     const Uint32        NumIterations = 10;
     for (Uint32 i = 0; i < NumIterations; ++i)
     {
@@ -457,12 +514,168 @@ TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
         {
             R = Mgr.Allocate(rnd(), rnd());
         }
+        VerifyRegions(Mgr, Regions);
+
+        // Release every other region and allocate new ones in the holes
+        for (size_t r = 0; r < Regions.size(); r += 2)
+        {
+            if (!Regions[r].IsEmpty())
+                Mgr.Free(std::move(Regions[r]));
+            Regions[r] = Region{};
+        }
+        for (size_t r = 0; r < Regions.size(); r += 2)
+        {
+            Regions[r] = Mgr.Allocate(rnd(), rnd());
+        }
+        VerifyRegions(Mgr, Regions);
+
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+        EXPECT_TRUE(Mgr.IsEmpty());
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom)
+{
+    TestAllocateRandom(PackingMode::SplitTree);
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateRandom_Skyline)
+{
+    TestAllocateRandom(PackingMode::Skyline);
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, Skyline)
+{
+    DynamicAtlasManager Mgr{16, 16, PackingMode::Skyline};
+
+    auto A = Mgr.Allocate(8, 4);
+    EXPECT_EQ(A, Region(0, 0, 8, 4));
+
+    auto B = Mgr.Allocate(4, 6);
+    EXPECT_EQ(B, Region(8, 0, 4, 6));
+
+    auto C = Mgr.Allocate(8, 2);
+    EXPECT_EQ(C, Region(0, 4, 8, 2));
+    //  ________________
+    // |                |
+    // |                |
+    // |________ ___    |
+    // |___C____|   |   |
+    // |        | B |   |
+    // |___A____|___|___|
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 2u);
+
+    auto D = Mgr.Allocate(8, 3);
+    EXPECT_EQ(D, Region(0, 6, 8, 3));
+
+    auto E = Mgr.Allocate(6, 5);
+    EXPECT_EQ(E, Region(8, 6, 6, 5));
+    //  ________________
+    // |                |
+    // |        ______  |
+    // |_______|      | |
+    // |   D   |  E   | |
+    // |_______|______| |
+    // |___C___|   |  | |
+    // |       | B |Fr| |
+    // |___A___|___|ee|_|
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 4u);
+
+    // The free space under the skyline is used first
+    auto F = Mgr.Allocate(2, 4);
+    EXPECT_EQ(F, Region(12, 0, 2, 4));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 4u);
+
+    // Releasing E lowers the skyline, and the free region above F is merged into it
+    Mgr.Free(std::move(E));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 4u);
+
+    Mgr.Free(std::move(B));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 4u);
+
+    // A is under C and D
+    Mgr.Free(std::move(A));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 5u);
+
+    Mgr.Free(std::move(F));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 3u);
+
+    Mgr.Free(std::move(D));
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 3u);
+    EXPECT_EQ(Mgr.GetOccupancy(), 16.f / 256.f);
+
+    Mgr.Free(std::move(C));
+    EXPECT_TRUE(Mgr.IsEmpty());
+    EXPECT_EQ(Mgr.GetFreeRegionCount(), 1u);
+}
+
+void TestAllocateBatch(PackingMode Mode)
+{
+    {
+        DynamicAtlasManager Mgr{64, 64, Mode};
+
+        FastRandInt         rnd{0, 1, 16};
+        std::vector<Region> Regions(48);
+        for (auto& R : Regions)
+        {
+            R.width  = rnd();
+            R.height = rnd();
+        }
+        const auto Sizes = Regions;
+
+        const auto NumAllocated = Mgr.Allocate(Regions.data(), static_cast<Uint32>(Regions.size()));
+        EXPECT_EQ(NumAllocated, static_cast<Uint32>(std::count_if(Regions.begin(), Regions.end(), [](const Region& R) { return !R.IsEmpty(); })));
+        EXPECT_GT(NumAllocated, 0u);
+        for (size_t i = 0; i < Regions.size(); ++i)
+        {
+            if (!Regions[i].IsEmpty())
+            {
+                EXPECT_EQ(Regions[i].width, Sizes[i].width);
+                EXPECT_EQ(Regions[i].height, Sizes[i].height);
+            }
+        }
+        VerifyRegions(Mgr, Regions);
+        EXPECT_GT(Mgr.GetOccupancy(), 0.5f);
+
         for (auto& R : Regions)
         {
             if (!R.IsEmpty())
                 Mgr.Free(std::move(R));
         }
+        EXPECT_TRUE(Mgr.IsEmpty());
     }
+
+    {
+        DynamicAtlasManager Mgr{64, 64, Mode};
+
+        Region Regions[] = {{0, 0, 8, 8}, {0, 0, 40, 40}, {0, 0, 40, 40}};
+
+        EXPECT_EQ(Mgr.Allocate(Regions, _countof(Regions)), 2u);
+        EXPECT_FALSE(Regions[0].IsEmpty());
+        EXPECT_EQ(Regions[1].IsEmpty() + Regions[2].IsEmpty(), 1);
+        // The largest region is allocated first
+        EXPECT_EQ(Regions[1].IsEmpty() ? Regions[2] : Regions[1], Region(0, 0, 40, 40));
+
+        for (auto& R : Regions)
+        {
+            if (!R.IsEmpty())
+                Mgr.Free(std::move(R));
+        }
+    }
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateBatch)
+{
+    TestAllocateBatch(PackingMode::SplitTree);
+}
+
+TEST(GraphicsAccessories_DynamicAtlasManager, AllocateBatch_Skyline)
+{
+    TestAllocateBatch(PackingMode::Skyline);
 }
 
 } // namespace
@@ -28,9 +28,12 @@
 #include "GraphicsUtilities.h"
 #include "FastRand.hpp"
 #include "ColorConversion.h"
+#include "GraphicsAccessories.hpp"
+#include "ThreadPool.hpp"
 
 #include <vector>
 #include <array>
+#include <limits>
 
 #include "gtest/gtest.h"
 
@@ -575,4 +578,294 @@ TEST(GraphicsTools_CalculateMipLevel, sRGB_BOX_AVE)
     EXPECT_TRUE(CoarseData == RefCoarseData);
 }
 
+
+// Coarse levels of a mip chain
+template <typename ChannelType>
+struct TestMipChain
+{
+    TestMipChain(Uint32 Width, Uint32 Height, Uint32 NumChannels, Uint32 NumCoarseMips)
+    {
+        Levels.reserve(NumCoarseMips);
+        for (Uint32 mip = 0; mip < NumCoarseMips; ++mip)
+        {
+            Width  = std::max(Width / 2u, 1u);
+            Height = std::max(Height / 2u, 1u);
+            Levels.emplace_back(size_t{Width} * Height * NumChannels);
+            Widths.push_back(Width);
+            Heights.push_back(Height);
+            pData.push_back(Levels.back().data());
+            Strides.push_back(size_t{Width} * NumChannels * sizeof(ChannelType));
+        }
+    }
+
+    std::vector<std::vector<ChannelType>> Levels;
+    std::vector<Uint32>                   Widths;
+    std::vector<Uint32>                   Heights;
+    std::vector<void*>                    pData;
+    std::vector<size_t>                   Strides;
+};
+
+Uint32 GetNumCoarseMips(Uint32 Width, Uint32 Height)
+{
+    Uint32 NumMips = 0;
+    for (Uint32 Dim = std::max(Width, Height); Dim > 1; Dim /= 2)
+        ++NumMips;
+    return NumMips;
+}
+
+template <typename ChannelType>
+TestMipChain<ChannelType> ComputeTestMipChain(TEXTURE_FORMAT                  Format,
+                                              Uint32                          Width,
+                                              Uint32                          Height,
+                                              Uint32                          NumChannels,
+                                              const std::vector<ChannelType>& BaseData,
+                                              MIP_FILTER_TYPE                 FilterType,
+                                              IThreadPool*                    pThreadPool = nullptr)
+{
+    TestMipChain<ChannelType> Chain{Width, Height, NumChannels, GetNumCoarseMips(Width, Height)};
+
+    ComputeMipChainAttribs Attribs{Format, Width, Height, BaseData.data(), size_t{Width} * NumChannels * sizeof(ChannelType),
+                                   static_cast<Uint32>(Chain.Levels.size()), Chain.pData.data(), Chain.Strides.data(), FilterType};
+    Attribs.pThreadPool = pThreadPool;
+    Attribs.NumTasks    = 4;
+    ComputeMipChain(Attribs);
+    return Chain;
+}
+
+// Computes the mip chain by calling ComputeMipLevel for every level
+template <typename ChannelType>
+TestMipChain<ChannelType> ComputeRefMipChain(TEXTURE_FORMAT                  Format,
+                                             Uint32                          Width,
+                                             Uint32                          Height,
+                                             Uint32                          NumChannels,
+                                             const std::vector<ChannelType>& BaseData,
+                                             MIP_FILTER_TYPE                 FilterType)
+{
+    TestMipChain<ChannelType> Chain{Width, Height, NumChannels, GetNumCoarseMips(Width, Height)};
+
+    const void* pFineData  = BaseData.data();
+    size_t      FineStride = size_t{Width} * NumChannels * sizeof(ChannelType);
+    Uint32      FineWidth  = Width;
+    Uint32      FineHeight = Height;
+    for (size_t mip = 0; mip < Chain.Levels.size(); ++mip)
+    {
+        ComputeMipLevel({Format, FineWidth, FineHeight, pFineData, FineStride, Chain.pData[mip], Chain.Strides[mip], FilterType});
+        pFineData  = Chain.pData[mip];
+        FineStride = Chain.Strides[mip];
+        FineWidth  = Chain.Widths[mip];
+        FineHeight = Chain.Heights[mip];
+    }
+    return Chain;
+}
+
+template <typename ChannelType>
+std::vector<ChannelType> GenerateRandomData(Uint32 Width, Uint32 Height, Uint32 NumChannels, int MaxVal)
+{
+    std::vector<ChannelType> Data(size_t{Width} * Height * NumChannels);
+
+    FastRandInt rnd(0, 0, MaxVal);
+    for (auto& c : Data)
+        c = static_cast<ChannelType>(rnd());
+    return Data;
+}
+
+template <typename ChannelType>
+void TestMipChainMatchesMipLevels(TEXTURE_FORMAT Format, Uint32 NumChannels, MIP_FILTER_TYPE FilterType)
+{
+    const Uint32 TestSizes[][2] = {{64, 64}, {257, 131}, {130, 67}, {1, 37}, {45, 1}};
+    for (const auto& Size : TestSizes)
+    {
+        const auto BaseData = GenerateRandomData<ChannelType>(Size[0], Size[1], NumChannels, std::min(int{std::numeric_limits<ChannelType>::max()}, 4095));
+
+        const auto RefChain = ComputeRefMipChain(Format, Size[0], Size[1], NumChannels, BaseData, FilterType);
+        const auto Chain    = ComputeTestMipChain(Format, Size[0], Size[1], NumChannels, BaseData, FilterType);
+        for (size_t mip = 0; mip < Chain.Levels.size(); ++mip)
+        {
+            EXPECT_EQ(Chain.Levels[mip], RefChain.Levels[mip]) << "Size: " << Size[0] << "x" << Size[1] << ", level: " << mip + 1;
+        }
+    }
+}
+
+TEST(GraphicsTools_ComputeMipChain, UNORM8_BOX_AVE)
+{
+    TestMipChainMatchesMipLevels<Uint8>(TEX_FORMAT_RGBA8_UNORM, 4, MIP_FILTER_TYPE_BOX_AVERAGE);
+    TestMipChainMatchesMipLevels<Uint8>(TEX_FORMAT_RG8_UNORM, 2, MIP_FILTER_TYPE_BOX_AVERAGE);
+    TestMipChainMatchesMipLevels<Uint8>(TEX_FORMAT_R8_UNORM, 1, MIP_FILTER_TYPE_DEFAULT);
+}
+
+TEST(GraphicsTools_ComputeMipChain, GenericFormats)
+{
+    TestMipChainMatchesMipLevels<Uint8>(TEX_FORMAT_RGBA8_UINT, 4, MIP_FILTER_TYPE_DEFAULT);
+    TestMipChainMatchesMipLevels<Uint8>(TEX_FORMAT_RGBA8_UNORM, 4, MIP_FILTER_TYPE_MOST_FREQUENT);
+    TestMipChainMatchesMipLevels<Uint16>(TEX_FORMAT_RGBA16_UNORM, 4, MIP_FILTER_TYPE_BOX_AVERAGE);
+    // Kaiser filter is not supported for 16-bit formats and the box filter is used instead
+    TestMipChainMatchesMipLevels<Uint16>(TEX_FORMAT_R16_UNORM, 1, MIP_FILTER_TYPE_KAISER);
+}
+
+TEST(GraphicsTools_ComputeMipChain, FLOAT32_BOX_AVE)
+{
+    for (Uint32 NumChannels : {1u, 4u})
+    {
+        const Uint32 Width  = 131;
+        const Uint32 Height = 70;
+        const auto   Format = NumChannels == 1 ? TEX_FORMAT_R32_FLOAT : TEX_FORMAT_RGBA32_FLOAT;
+
+        std::vector<float> BaseData(size_t{Width} * Height * NumChannels);
+        FastRandFloat      rnd(0, -10.f, 10.f);
+        for (auto& c : BaseData)
+            c = rnd();
+
+        const auto RefChain = ComputeRefMipChain(Format, Width, Height, NumChannels, BaseData, MIP_FILTER_TYPE_BOX_AVERAGE);
+        const auto Chain    = ComputeTestMipChain(Format, Width, Height, NumChannels, BaseData, MIP_FILTER_TYPE_BOX_AVERAGE);
+        for (size_t mip = 0; mip < Chain.Levels.size(); ++mip)
+        {
+            for (size_t i = 0; i < Chain.Levels[mip].size(); ++i)
+            {
+                EXPECT_NEAR(Chain.Levels[mip][i], RefChain.Levels[mip][i], 1e-5f) << "Level: " << mip + 1 << ", element: " << i;
+            }
+        }
+    }
+}
+
+TEST(GraphicsTools_ComputeMipChain, sRGB_BOX_AVE)
+{
+    const Uint32 Width       = 64;
+    const Uint32 Height      = 32;
+    const Uint32 NumChannels = 4;
+
+    const auto BaseData = GenerateRandomData<Uint8>(Width, Height, NumChannels, 255);
+    const auto Chain    = ComputeTestMipChain(TEX_FORMAT_RGBA8_UNORM_SRGB, Width, Height, NumChannels, BaseData, MIP_FILTER_TYPE_BOX_AVERAGE);
+
+    // Levels are computed from the unquantized linear values of the previous level, so every
+    // texel of a coarse level must match the average of the corresponding block of the base level.
+    for (size_t mip = 0; mip < Chain.Levels.size(); ++mip)
+    {
+        const Uint32 BlockWidth  = Width / Chain.Widths[mip];
+        const Uint32 BlockHeight = Height / Chain.Heights[mip];
+        for (Uint32 y = 0; y < Chain.Heights[mip]; ++y)
+        {
+            for (Uint32 x = 0; x < Chain.Widths[mip]; ++x)
+            {
+                for (Uint32 c = 0; c < NumChannels; ++c)
+                {
+                    double LinearSum = 0;
+                    for (Uint32 by = 0; by < BlockHeight; ++by)
+                    {
+                        for (Uint32 bx = 0; bx < BlockWidth; ++bx)
+                        {
+                            const Uint8 Val = BaseData[((y * BlockHeight + by) * Width + x * BlockWidth + bx) * NumChannels + c];
+                            LinearSum += FastGammaToLinear(Val / 255.f);
+                        }
+                    }
+                    const float fLinearAverage = static_cast<float>(LinearSum / (BlockWidth * BlockHeight));
+                    const float fSRGB          = std::min(std::max(FastLinearToGamma(fLinearAverage) * 255.f, 0.f), 255.f);
+
+                    const int RefVal = static_cast<int>(fSRGB);
+                    const int Val    = Chain.Levels[mip][(y * Chain.Widths[mip] + x) * NumChannels + c];
+                    EXPECT_NEAR(Val, RefVal, 1) << "Level: " << mip + 1 << ", x: " << x << ", y: " << y << ", c: " << c;
+                }
+            }
+        }
+    }
+
+    // The first level must match ComputeMipLevel
+    const auto RefChain = ComputeRefMipChain(TEX_FORMAT_RGBA8_UNORM_SRGB, Width, Height, NumChannels, BaseData, MIP_FILTER_TYPE_BOX_AVERAGE);
+    for (size_t i = 0; i < Chain.Levels[0].size(); ++i)
+    {
+        EXPECT_NEAR(Chain.Levels[0][i], RefChain.Levels[0][i], 1) << "Element: " << i;
+    }
+}
+
+TEST(GraphicsTools_ComputeMipChain, KAISER)
+{
+    // Constant data must remain constant
+    for (auto Format : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB, TEX_FORMAT_RG8_UNORM})
+    {
+        const Uint32 NumChannels = GetTextureFormatAttribs(Format).NumComponents;
+        const Uint32 Width       = 77;
+        const Uint32 Height      = 40;
+
+        std::vector<Uint8> BaseData(size_t{Width} * Height * NumChannels);
+        for (size_t i = 0; i < BaseData.size(); ++i)
+            BaseData[i] = static_cast<Uint8>(50 + 60 * (i % NumChannels));
+
+        const auto Chain = ComputeTestMipChain(Format, Width, Height, NumChannels, BaseData, MIP_FILTER_TYPE_KAISER);
+        for (size_t mip = 0; mip < Chain.Levels.size(); ++mip)
+        {
+            for (size_t i = 0; i < Chain.Levels[mip].size(); ++i)
+            {
+                EXPECT_NEAR(Chain.Levels[mip][i], 50 + 60 * (i % NumChannels), 1) << GetTextureFormatAttribs(Format).Name << ", level: " << mip + 1 << ", element: " << i;
+            }
+        }
+    }
+
+    // The filter is symmetric and must preserve linear functions away from the borders
+    {
+        const Uint32 Width       = 64;
+        const Uint32 Height      = 48;
+        const Uint32 NumChannels = 4;
+
+        std::vector<float> BaseData(size_t{Width} * Height * NumChannels);
+        for (Uint32 y = 0; y < Height; ++y)
+        {
+            for (Uint32 x = 0; x < Width; ++x)
+            {
+                float* pTexel = &BaseData[(y * Width + x) * NumChannels];
+                pTexel[0]     = static_cast<float>(x) + 0.5f;
+                pTexel[1]     = static_cast<float>(y) + 0.5f;
+                pTexel[2]     = static_cast<float>(x + y) + 1.f;
+                pTexel[3]     = 1;
+            }
+        }
+
+        const auto Chain = ComputeTestMipChain(TEX_FORMAT_RGBA32_FLOAT, Width, Height, NumChannels, BaseData, MIP_FILTER_TYPE_KAISER);
+        for (Uint32 y = 2; y + 2 < Chain.Heights[0]; ++y)
+        {
+            for (Uint32 x = 2; x + 2 < Chain.Widths[0]; ++x)
+            {
+                const float* pTexel = &Chain.Levels[0][(y * Chain.Widths[0] + x) * NumChannels];
+                EXPECT_NEAR(pTexel[0], static_cast<float>(x * 2 + 1), 1e-4f);
+                EXPECT_NEAR(pTexel[1], static_cast<float>(y * 2 + 1), 1e-4f);
+                EXPECT_NEAR(pTexel[2], static_cast<float>(x * 2 + y * 2 + 2), 1e-4f);
+                EXPECT_NEAR(pTexel[3], 1.f, 1e-5f);
+            }
+        }
+    }
+
+    // ComputeMipLevel must produce the same result as the first level of the chain
+    {
+        const Uint32 Width       = 95;
+        const Uint32 Height      = 33;
+        const Uint32 NumChannels = 4;
+
+        const auto BaseData = GenerateRandomData<Uint8>(Width, Height, NumChannels, 255);
+        const auto Chain    = ComputeTestMipChain(TEX_FORMAT_RGBA8_UNORM, Width, Height, NumChannels, BaseData, MIP_FILTER_TYPE_KAISER);
+        const auto RefChain = ComputeRefMipChain(TEX_FORMAT_RGBA8_UNORM, Width, Height, NumChannels, BaseData, MIP_FILTER_TYPE_KAISER);
+        EXPECT_EQ(Chain.Levels[0], RefChain.Levels[0]);
+    }
+}
+
+TEST(GraphicsTools_ComputeMipChain, ThreadPool)
+{
+    auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+    const Uint32 Width       = 1031;
+    const Uint32 Height      = 517;
+    const Uint32 NumChannels = 4;
+
+    const auto BaseData = GenerateRandomData<Uint8>(Width, Height, NumChannels, 255);
+    for (auto Format : {TEX_FORMAT_RGBA8_UNORM, TEX_FORMAT_RGBA8_UNORM_SRGB})
+    {
+        for (auto FilterType : {MIP_FILTER_TYPE_BOX_AVERAGE, MIP_FILTER_TYPE_KAISER})
+        {
+            const auto RefChain = ComputeTestMipChain(Format, Width, Height, NumChannels, BaseData, FilterType);
+            const auto Chain    = ComputeTestMipChain(Format, Width, Height, NumChannels, BaseData, FilterType, pThreadPool);
+            for (size_t mip = 0; mip < Chain.Levels.size(); ++mip)
+            {
+                EXPECT_EQ(Chain.Levels[mip], RefChain.Levels[mip]) << GetTextureFormatAttribs(Format).Name << ", filter: " << FilterType << ", level: " << mip + 1;
+            }
+        }
+    }
+}
+
 } // namespace
@@ -26,6 +26,9 @@
  */
 
 #include <memory>
+#include <atomic>
+#include <thread>
+#include <chrono>
 
 #include "ResourceReleaseQueue.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
@@ -128,4 +131,169 @@ TEST(GraphicsAccessories_ResourceReleaseQueue, GetFilterTypeLiteralName)
     }
 }
 
+
+// Resource that counts its destructions
+struct CountedResource
+{
+    explicit CountedResource(std::atomic<int>* _pCounter, int _DestructionDelayMs = 0) :
+        pCounter{_pCounter},
+        DestructionDelayMs{_DestructionDelayMs}
+    {}
+
+    ~CountedResource()
+    {
+        if (DestructionDelayMs > 0)
+            std::this_thread::sleep_for(std::chrono::milliseconds{DestructionDelayMs});
+        if (pCounter != nullptr)
+            pCounter->fetch_add(1);
+    }
+
+    std::atomic<int>* const pCounter;
+    const int               DestructionDelayMs;
+};
+
+void DiscardCountedResources(ResourceReleaseQueue<DynamicStaleResourceWrapper>& Queue, std::atomic<int>& Counter, int NumResources, Uint64 FenceValue, int DestructionDelayMs = 0)
+{
+    for (int i = 0; i < NumResources; ++i)
+    {
+        std::unique_ptr<CountedResource> Res{new CountedResource{&Counter, DestructionDelayMs}};
+        Queue.DiscardResource(std::move(Res), FenceValue);
+    }
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, PurgeWithCountBudget)
+{
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    std::atomic<int> Counter{0};
+    DiscardCountedResources(Queue, Counter, 100, 1);
+    DiscardCountedResources(Queue, Counter, 10, 2);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 110u);
+
+    EXPECT_EQ(Queue.Purge(0, 30, 0), 0u);
+    EXPECT_EQ(Counter, 0);
+
+    EXPECT_EQ(Queue.Purge(1, 30, 0), 30u);
+    EXPECT_EQ(Counter, 30);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 80u);
+
+    // The resources that were not released are carried over to the next call
+    EXPECT_EQ(Queue.Purge(1, 50, 0), 50u);
+    EXPECT_EQ(Counter, 80);
+
+    // Resources with the fence value that is not completed must not be released
+    EXPECT_EQ(Queue.Purge(1, 50, 0), 20u);
+    EXPECT_EQ(Counter, 100);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 10u);
+
+    EXPECT_EQ(Queue.Purge(2, 0, 0), 10u);
+    EXPECT_EQ(Counter, 110);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 0u);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, PurgeWithTimeBudget)
+{
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    constexpr int NumResources = 20;
+
+    std::atomic<int> Counter{0};
+    DiscardCountedResources(Queue, Counter, NumResources, 1, 2);
+
+    // At least one resource is always released
+    EXPECT_EQ(Queue.Purge(1, 0, 1e-9), 1u);
+    EXPECT_EQ(Counter, 1);
+
+    // Each resource takes at least 2 ms to destroy
+    const auto NumReleased = static_cast<int>(Queue.Purge(1, 0, 0.005));
+    EXPECT_GE(NumReleased, 1);
+    EXPECT_LE(NumReleased, 3);
+    EXPECT_EQ(Counter, 1 + NumReleased);
+
+    while (Queue.GetPendingReleaseResourceCount() > 0)
+        Queue.Purge(1, 0, 0.005);
+    EXPECT_EQ(Counter, NumResources);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, Stats)
+{
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    std::atomic<int> Counter{0};
+    for (int i = 0; i < 5; ++i)
+    {
+        std::unique_ptr<CountedResource> Res{new CountedResource{&Counter}};
+        Queue.SafeReleaseResource(std::move(Res), 1);
+    }
+    DiscardCountedResources(Queue, Counter, 10, 1);
+
+    auto Stats = Queue.GetStats();
+    EXPECT_EQ(Stats.StaleResourceCount, 5u);
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, 10u);
+    EXPECT_EQ(Stats.BackgroundReleaseResourceCount, 0u);
+    EXPECT_EQ(Stats.ReleasedResourceCount, 0u);
+    EXPECT_EQ(Stats.MaxReleaseLatency, 0.0);
+
+    Queue.DiscardStaleResources(1, 2);
+    std::this_thread::sleep_for(std::chrono::milliseconds{5});
+    Queue.Purge(1);
+
+    Stats = Queue.GetStats();
+    EXPECT_EQ(Stats.StaleResourceCount, 0u);
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, 5u);
+    EXPECT_EQ(Stats.ReleasedResourceCount, 10u);
+    EXPECT_GE(Stats.MaxReleaseLatency, 0.005);
+    EXPECT_GE(Stats.AvgReleaseLatency, 0.005);
+    EXPECT_LE(Stats.AvgReleaseLatency, Stats.MaxReleaseLatency);
+
+    Queue.Purge(2);
+    Stats = Queue.GetStats();
+    EXPECT_EQ(Stats.PendingReleaseResourceCount, 0u);
+    EXPECT_EQ(Stats.ReleasedResourceCount, 15u);
+
+    Queue.ResetStats();
+    Stats = Queue.GetStats();
+    EXPECT_EQ(Stats.ReleasedResourceCount, 0u);
+    EXPECT_EQ(Stats.AvgReleaseLatency, 0.0);
+    EXPECT_EQ(Stats.MaxReleaseLatency, 0.0);
+    EXPECT_EQ(Counter, 15);
+}
+
+TEST(GraphicsAccessories_ResourceReleaseQueue, BackgroundRelease)
+{
+    ResourceReleaseQueue<DynamicStaleResourceWrapper> Queue(DefaultRawMemoryAllocator::GetAllocator());
+
+    std::atomic<int> Counter{0};
+
+    Queue.StartBackgroundRelease();
+    EXPECT_TRUE(Queue.IsBackgroundReleaseEnabled());
+
+    DiscardCountedResources(Queue, Counter, 100, 1);
+    DiscardCountedResources(Queue, Counter, 10, 2);
+
+    // All completed resources are handed to the thread regardless of the budget
+    EXPECT_EQ(Queue.Purge(1, 10, 0), 100u);
+    EXPECT_EQ(Queue.GetPendingReleaseResourceCount(), 10u);
+
+    for (int i = 0; i < 1000 && Counter < 100; ++i)
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    EXPECT_EQ(Counter, 100);
+
+    Queue.Purge(2);
+    Queue.StopBackgroundRelease();
+    EXPECT_FALSE(Queue.IsBackgroundReleaseEnabled());
+    EXPECT_EQ(Counter, 110);
+
+    const auto Stats = Queue.GetStats();
+    EXPECT_EQ(Stats.BackgroundReleaseResourceCount, 0u);
+    EXPECT_EQ(Stats.ReleasedResourceCount, 110u);
+
+    // Resources are released in place when the thread is stopped
+    DiscardCountedResources(Queue, Counter, 10, 3);
+    EXPECT_EQ(Queue.Purge(3, 5, 0), 5u);
+    EXPECT_EQ(Counter, 115);
+    Queue.Purge(3);
+    EXPECT_EQ(Counter, 120);
+}
+
 } // namespace
@@ -28,6 +28,10 @@
 #include "VariableSizeGPUAllocationsManager.hpp"
 #include "DefaultRawMemoryAllocator.hpp"
 #include "PlatformDefinitions.h"
+#include "FastRand.hpp"
+
+#include <vector>
+#include <algorithm>
 
 #include "gtest/gtest.h"
 
@@ -36,14 +40,16 @@ using namespace Diligent;
 namespace
 {
 
-TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
+using AllocationMode = VariableSizeAllocationsManager::Mode;
+
+void TestAllocateFree(AllocationMode Mode)
 {
     auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
 
     using OffsetType = VariableSizeAllocationsManager::OffsetType;
 
     {
-        VariableSizeAllocationsManager ListMgr(128, Allocator);
+        VariableSizeAllocationsManager ListMgr(128, Allocator, Mode);
         EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
         EXPECT_EQ(ListMgr.GetFreeSize(), size_t{128});
         EXPECT_EQ(ListMgr.GetUsedSize(), size_t{0});
@@ -137,7 +143,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
     }
 
     {
-        VariableSizeAllocationsManager ListMgr(128, Allocator);
+        VariableSizeAllocationsManager ListMgr(128, Allocator, Mode);
 
         auto a1 = ListMgr.Allocate(64, 1);
         EXPECT_EQ(a1.UnalignedOffset, OffsetType{0});
@@ -178,7 +184,17 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
     }
 }
 
-TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree)
+{
+    TestAllocateFree(AllocationMode::BestFit);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateFree_TLSF)
+{
+    TestAllocateFree(AllocationMode::TLSF);
+}
+
+void TestFreeOrder(AllocationMode Mode)
 {
     auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
     using OffsetType = VariableSizeAllocationsManager::OffsetType;
@@ -192,7 +208,7 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
         do
         {
             ++NumPerms;
-            VariableSizeAllocationsManager ListMgr(NumAllocs * 4, Allocator);
+            VariableSizeAllocationsManager ListMgr(NumAllocs * 4, Allocator, Mode);
 
             VariableSizeAllocationsManager::Allocation allocs[NumAllocs];
             for (size_t a = 0; a < NumAllocs; ++a)
@@ -210,11 +226,21 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
     }
 }
 
-TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder)
+{
+    TestFreeOrder(AllocationMode::BestFit);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, FreeOrder_TLSF)
+{
+    TestFreeOrder(AllocationMode::TLSF);
+}
+
+void TestFree(AllocationMode Mode)
 {
     auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
     {
-        VariableSizeGPUAllocationsManager ListMgr(128, Allocator);
+        VariableSizeGPUAllocationsManager ListMgr{VariableSizeAllocationsManager::CreateInfo{Allocator, 128, false, Mode}};
 
         VariableSizeGPUAllocationsManager::Allocation al[16];
         for (size_t o = 0; o < _countof(al); ++o)
@@ -249,4 +275,162 @@ TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
     }
 }
 
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free)
+{
+    TestFree(AllocationMode::BestFit);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, Free_TLSF)
+{
+    TestFree(AllocationMode::TLSF);
+}
+
+void TestAllocateBelow(AllocationMode Mode)
+{
+    auto& Allocator = DefaultRawMemoryAllocator::GetAllocator();
+
+    VariableSizeAllocationsManager ListMgr{VariableSizeAllocationsManager::CreateInfo{Allocator, 128, false, Mode}};
+
+    VariableSizeAllocationsManager::Allocation al[16];
+    for (size_t o = 0; o < _countof(al); ++o)
+        al[o] = ListMgr.Allocate(8, 8);
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    // Free blocks: [8, 16), [24, 48), [80, 88)
+    ListMgr.Free(std::move(al[1]));
+    ListMgr.Free(std::move(al[3]));
+    ListMgr.Free(std::move(al[4]));
+    ListMgr.Free(std::move(al[5]));
+    ListMgr.Free(std::move(al[10]));
+
+    // No free block ends at or before offset 8
+    EXPECT_FALSE(ListMgr.AllocateBelow(8, 8, 8).IsValid());
+
+    // [8, 16) is too small for an allocation aligned by 16
+    auto a0 = ListMgr.AllocateBelow(8, 16, 48);
+    EXPECT_EQ(a0.UnalignedOffset, 24u);
+    EXPECT_EQ(a0.Size, 24u);
+
+    // The block with the lowest offset is used
+    auto a1 = ListMgr.AllocateBelow(8, 8, 128);
+    EXPECT_EQ(a1.UnalignedOffset, 8u);
+    EXPECT_EQ(a1.Size, 8u);
+
+    // [80, 88) ends after offset 84
+    EXPECT_FALSE(ListMgr.AllocateBelow(8, 8, 84).IsValid());
+    auto a2 = ListMgr.AllocateBelow(8, 8, 88);
+    EXPECT_EQ(a2.UnalignedOffset, 80u);
+    EXPECT_EQ(a2.Size, 8u);
+    EXPECT_TRUE(ListMgr.IsFull());
+
+    ListMgr.Free(std::move(a0));
+    ListMgr.Free(std::move(a1));
+    ListMgr.Free(std::move(a2));
+    for (size_t o = 0; o < _countof(al); ++o)
+    {
+        if (al[o].IsValid())
+            ListMgr.Free(std::move(al[o]));
+    }
+    EXPECT_TRUE(ListMgr.IsEmpty());
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateBelow)
+{
+    TestAllocateBelow(AllocationMode::BestFit);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, AllocateBelow_TLSF)
+{
+    TestAllocateBelow(AllocationMode::TLSF);
+}
+
+void TestRandomAllocations(AllocationMode Mode)
+{
+    auto& Allocator  = DefaultRawMemoryAllocator::GetAllocator();
+    using OffsetType = VariableSizeAllocationsManager::OffsetType;
+
+    constexpr OffsetType MaxSize = 4096;
+
+    VariableSizeAllocationsManager::CreateInfo CI{Allocator, MaxSize};
+    CI.DbgDisableDebugValidation = true;
+    CI.AllocationMode            = Mode;
+    VariableSizeAllocationsManager ListMgr{CI};
+
+    FastRandInt SizeRnd{0, 1, 96};
+    FastRandInt AlignRnd{1, 0, 4};
+    FastRandInt ActionRnd{2, 0, 99};
+
+    std::vector<VariableSizeAllocationsManager::Allocation> Allocations;
+    std::vector<bool>                                       UsedBytes(MaxSize);
+
+    OffsetType UsedSize = 0;
+    for (size_t i = 0; i < 20000; ++i)
+    {
+        if (!Allocations.empty() && (ActionRnd() < 45 || ListMgr.GetFreeSize() < 128))
+        {
+            const auto Idx   = static_cast<size_t>(ActionRnd()) % Allocations.size();
+            auto&      Alloc = Allocations[Idx];
+            for (auto b = Alloc.UnalignedOffset; b < Alloc.UnalignedOffset + Alloc.Size; ++b)
+                UsedBytes[b] = false;
+            UsedSize -= Alloc.Size;
+            ListMgr.Free(std::move(Alloc));
+            Allocations[Idx] = Allocations.back();
+            Allocations.pop_back();
+        }
+        else
+        {
+            const OffsetType Size      = static_cast<OffsetType>(SizeRnd());
+            const OffsetType Alignment = OffsetType{1} << AlignRnd();
+
+            auto Alloc = ListMgr.Allocate(Size, Alignment);
+            if (!Alloc.IsValid())
+            {
+                EXPECT_LT(ListMgr.GetMaxFreeBlockSize(), AlignUp(Size, Alignment) + Alignment);
+                continue;
+            }
+
+            const auto AlignedOffset = AlignUp(Alloc.UnalignedOffset, Alignment);
+            EXPECT_LE(AlignedOffset + Size, Alloc.UnalignedOffset + Alloc.Size);
+            for (auto b = Alloc.UnalignedOffset; b < Alloc.UnalignedOffset + Alloc.Size; ++b)
+            {
+                ASSERT_FALSE(UsedBytes[b]) << "Allocations overlap at offset " << b;
+                UsedBytes[b] = true;
+            }
+            UsedSize += Alloc.Size;
+            Allocations.emplace_back(Alloc);
+        }
+        ASSERT_EQ(ListMgr.GetUsedSize(), UsedSize);
+
+        if (i % 16 == 0)
+        {
+            // Free blocks are always merged, so the largest one is the longest run of free bytes
+            OffsetType MaxFreeBlockSize = 0;
+            OffsetType FreeRunSize      = 0;
+            for (OffsetType b = 0; b < MaxSize; ++b)
+            {
+                FreeRunSize      = UsedBytes[b] ? 0 : FreeRunSize + 1;
+                MaxFreeBlockSize = std::max(MaxFreeBlockSize, FreeRunSize);
+            }
+            ASSERT_EQ(ListMgr.GetMaxFreeBlockSize(), MaxFreeBlockSize);
+        }
+    }
+
+    for (auto& Alloc : Allocations)
+        ListMgr.Free(std::move(Alloc));
+
+    EXPECT_TRUE(ListMgr.IsEmpty());
+    EXPECT_EQ(ListMgr.GetNumFreeBlocks(), size_t{1});
+    EXPECT_EQ(ListMgr.GetMaxFreeBlockSize(), MaxSize);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, RandomAllocations)
+{
+    TestRandomAllocations(AllocationMode::BestFit);
+}
+
+TEST(GraphicsAccessories_VariableSizeGPUAllocationsManager, RandomAllocations_TLSF)
+{
+    TestRandomAllocations(AllocationMode::TLSF);
+}
+
 } // namespace
@@ -0,0 +1,284 @@
+/*
+ *  Copyright 2019-2022 Diligent Graphics LLC
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *  In no event and under no legal theory, whether in tort (including negligence),
+ *  contract, or otherwise, unless required by applicable law (such as deliberate
+ *  and grossly negligent acts) or agreed to in writing, shall any Contributor be
+ *  liable for any damages, including any direct, indirect, special, incidental,
+ *  or consequential damages of any character arising as a result of this License or
+ *  out of the use or inability to use the software (including but not limited to damages
+ *  for loss of goodwill, work stoppage, computer failure or malfunction, or any and
+ *  all other commercial damages or losses), even if such Contributor has been advised
+ *  of the possibility of such damages.
+ */
+
+
+#include "DeviceObjectArchiveTestHelpers.hpp"
+
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include "gtest/gtest.h"
+
+#include "DataBlobImpl.hpp"
+#include "MappedFileDataBlob.hpp"
+#include "FileWrapper.hpp"
+#include "TempDirectory.hpp"
+#include "TestingEnvironment.hpp"
+#include "ThreadPool.hpp"
+
+using namespace Diligent;
+using namespace Diligent::Testing;
+
+namespace
+{
+
+using ResourceType = DeviceObjectArchive::ResourceType;
+using DeviceType   = DeviceObjectArchive::DeviceType;
+using ArchiveFlags = DeviceObjectArchive::ArchiveFlags;
+
+void CheckArchive(const DeviceObjectArchive& Ref, const DeviceObjectArchive& Archive)
+{
+    EXPECT_EQ(Archive.GetContentVersion(), Ref.GetContentVersion());
+
+    const auto* pData    = static_cast<const Uint8*>(Archive.GetData()->GetConstDataPtr());
+    const auto  DataSize = Archive.GetData()->GetSize();
+
+    const auto IsCompressed = (Archive.GetFlags() & ArchiveFlags::CompressedData) != ArchiveFlags::None;
+
+    auto CheckDataBlock = [&](const SerializedData& RefBlock, const SerializedData& ArchiveBlock) {
+        const auto& Block = Archive.GetUncompressedData(ArchiveBlock);
+        EXPECT_EQ(RefBlock, Block);
+        if (Block && !IsCompressed)
+        {
+            // Data must reference the archive blob
+            EXPECT_GE(Block.Ptr<const Uint8>(), pData);
+            EXPECT_LE(Block.Ptr<const Uint8>() + Block.Size(), pData + DataSize);
+            EXPECT_EQ((Block.Ptr<const Uint8>() - pData) % 8, 0);
+        }
+    };
+
+    const auto& RefResources = Ref.GetNamedResources();
+    const auto& Resources    = Archive.GetNamedResources();
+    ASSERT_EQ(Resources.size(), RefResources.size());
+    for (const auto& it : RefResources)
+    {
+        auto res_it = Resources.find(it.first);
+        ASSERT_NE(res_it, Resources.end()) << it.first.GetName();
+
+        CheckDataBlock(it.second.Common, res_it->second.Common);
+        for (size_t dev = 0; dev < it.second.DeviceSpecific.size(); ++dev)
+            CheckDataBlock(it.second.DeviceSpecific[dev], res_it->second.DeviceSpecific[dev]);
+    }
+
+    for (Uint32 dev = 0; dev < static_cast<Uint32>(DeviceType::Count); ++dev)
+    {
+        const auto DevType = static_cast<DeviceType>(dev);
+        for (size_t i = 0; i < NumTestArchiveShaders + 1; ++i)
+            CheckDataBlock(Ref.GetSerializedShader(DevType, i), Archive.GetSerializedShader(DevType, i));
+    }
+}
+
+TEST(DeviceObjectArchiveTest, SerializeDeserialize)
+{
+    DeviceObjectArchive RefArchive{TestArchiveVersion};
+    PopulateTestArchive(RefArchive);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    RefArchive.Serialize(&pData);
+    ASSERT_NE(pData, nullptr);
+
+    {
+        DeviceObjectArchive Archive{{pData, TestArchiveVersion, false}};
+        CheckArchive(RefArchive, Archive);
+    }
+
+    // Serialize the archive that references the data blob
+    {
+        DeviceObjectArchive Archive{{pData, TestArchiveVersion, false}};
+
+        RefCntAutoPtr<IDataBlob> pData2;
+        Archive.Serialize(&pData2);
+        ASSERT_NE(pData2, nullptr);
+        EXPECT_EQ(pData2->GetSize(), pData->GetSize());
+
+        DeviceObjectArchive Archive2{{pData2, TestArchiveVersion, false}};
+        CheckArchive(RefArchive, Archive2);
+    }
+}
+
+TEST(DeviceObjectArchiveTest, TruncatedData)
+{
+    DeviceObjectArchive RefArchive{TestArchiveVersion};
+    PopulateTestArchive(RefArchive);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    RefArchive.Serialize(&pData);
+    ASSERT_NE(pData, nullptr);
+
+    auto pTruncatedData = DataBlobImpl::Create(pData->GetSize() - 1, pData->GetConstDataPtr());
+
+    TestingEnvironment::ErrorScope ExpectedErrors{"Device object archive data is truncated"};
+    EXPECT_THROW(DeviceObjectArchive({pTruncatedData, TestArchiveVersion, false}), std::runtime_error);
+}
+
+TEST(DeviceObjectArchiveTest, MappedFile)
+{
+    DeviceObjectArchive RefArchive{TestArchiveVersion};
+    PopulateTestArchive(RefArchive);
+
+    RefCntAutoPtr<IDataBlob> pData;
+    RefArchive.Serialize(&pData);
+    ASSERT_NE(pData, nullptr);
+
+    TempDirectory TmpDir;
+    const auto    FilePath = TmpDir.Get() + FileSystem::SlashSymbol + "Archive.bin";
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(pData->GetConstDataPtr(), pData->GetSize()));
+    }
+
+    {
+        auto pFileData = MappedFileDataBlob::Create(FilePath.c_str());
+        ASSERT_NE(pFileData, nullptr);
+
+        DeviceObjectArchive Archive{{pFileData, TestArchiveVersion, false}};
+        CheckArchive(RefArchive, Archive);
+    }
+
+    FileSystem::DeleteFile(FilePath.c_str());
+}
+
+TEST(DeviceObjectArchiveTest, CompressedData)
+{
+    DeviceObjectArchive RefArchive{TestArchiveVersion};
+    PopulateTestArchive(RefArchive, /*Compressible = */ true);
+
+    auto pData = SerializeTestArchive(RefArchive, ArchiveFlags::None);
+    ASSERT_NE(pData, nullptr);
+
+    auto pCompressedData = SerializeTestArchive(RefArchive, ArchiveFlags::CompressedData);
+    ASSERT_NE(pCompressedData, nullptr);
+    EXPECT_LT(pCompressedData->GetSize(), pData->GetSize());
+
+    {
+        DeviceObjectArchive Archive{{pCompressedData, TestArchiveVersion, false}};
+        EXPECT_EQ(Archive.GetFlags(), ArchiveFlags::CompressedData);
+        CheckArchive(RefArchive, Archive);
+    }
+
+    // Decompress the archive
+    {
+        DeviceObjectArchive Archive{{pCompressedData, TestArchiveVersion, false}};
+
+        auto pData2 = SerializeTestArchive(Archive, ArchiveFlags::None);
+        ASSERT_NE(pData2, nullptr);
+        EXPECT_EQ(pData2->GetSize(), pData->GetSize());
+
+        DeviceObjectArchive Archive2{{pData2, TestArchiveVersion, false}};
+        EXPECT_EQ(Archive2.GetFlags(), ArchiveFlags::None);
+        CheckArchive(RefArchive, Archive2);
+    }
+
+    // Incompressible data is stored as is
+    {
+        DeviceObjectArchive RndArchive{TestArchiveVersion};
+        PopulateTestArchive(RndArchive, /*Compressible = */ false);
+
+        auto pRndData           = SerializeTestArchive(RndArchive, ArchiveFlags::None);
+        auto pRndCompressedData = SerializeTestArchive(RndArchive, ArchiveFlags::CompressedData);
+        ASSERT_NE(pRndData, nullptr);
+        ASSERT_NE(pRndCompressedData, nullptr);
+        EXPECT_LT(pRndCompressedData->GetSize(), pRndData->GetSize() * 11 / 10);
+
+        DeviceObjectArchive Archive{{pRndCompressedData, TestArchiveVersion, false}};
+        CheckArchive(RndArchive, Archive);
+    }
+}
+
+TEST(DeviceObjectArchiveTest, ParallelDecompression)
+{
+    DeviceObjectArchive RefArchive{TestArchiveVersion};
+    PopulateTestArchive(RefArchive, /*Compressible = */ true);
+
+    auto pCompressedData = SerializeTestArchive(RefArchive, ArchiveFlags::CompressedData);
+    ASSERT_NE(pCompressedData, nullptr);
+
+    DeviceObjectArchive Archive{{pCompressedData, TestArchiveVersion, false}};
+
+    const auto NumThreads = std::max(std::thread::hardware_concurrency(), 4u);
+
+    std::vector<std::thread> Threads;
+    std::vector<Uint32>      NumErrors(NumThreads);
+    for (Uint32 t = 0; t < NumThreads; ++t)
+    {
+        Threads.emplace_back([&, t]() {
+            // Access the same blocks from all threads in different order
+            for (Uint32 i = 0; i < NumTestArchiveResources; ++i)
+            {
+                const auto  Idx     = (i + t * 7) % NumTestArchiveResources;
+                const auto  Name    = GetTestArchiveResourceName(Idx);
+                const auto  ResType = GetTestArchiveResourceType(Idx);
+                const auto& RefData = RefArchive.GetNamedResources().find({ResType, Name.c_str()})->second;
+
+                for (Uint32 dev = 0; dev < static_cast<Uint32>(DeviceType::Count); ++dev)
+                {
+                    if (Archive.GetDeviceSpecificData(ResType, Name.c_str(), static_cast<DeviceType>(dev)) != RefData.DeviceSpecific[dev])
+                        ++NumErrors[t];
+                }
+            }
+
+            for (Uint32 i = 0; i < NumTestArchiveShaders; ++i)
+            {
+                const auto Idx = (i + t * 5) % NumTestArchiveShaders;
+                if (Archive.GetSerializedShader(DeviceType::Vulkan, Idx) != RefArchive.GetSerializedShader(DeviceType::Vulkan, Idx))
+                    ++NumErrors[t];
+            }
+        });
+    }
+
+    for (auto& Thread : Threads)
+        Thread.join();
+
+    for (Uint32 t = 0; t < NumThreads; ++t)
+        EXPECT_EQ(NumErrors[t], 0u) << "Thread " << t;
+}
+
+TEST(DeviceObjectArchiveTest, DecompressBlocks)
+{
+    DeviceObjectArchive RefArchive{TestArchiveVersion};
+    PopulateTestArchive(RefArchive, /*Compressible = */ true);
+
+    auto pCompressedData = SerializeTestArchive(RefArchive, ArchiveFlags::CompressedData);
+    ASSERT_NE(pCompressedData, nullptr);
+
+    {
+        DeviceObjectArchive Archive{{pCompressedData, TestArchiveVersion, false}};
+        Archive.DecompressBlocks(nullptr, 4);
+        CheckArchive(RefArchive, Archive);
+    }
+
+    {
+        auto pThreadPool = CreateThreadPool(ThreadPoolCreateInfo{4});
+
+        DeviceObjectArchive Archive{{pCompressedData, TestArchiveVersion, false}};
+        Archive.DecompressBlocks(pThreadPool, 5);
+        CheckArchive(RefArchive, Archive);
+    }
+}
+
+} // namespace
@@ -30,12 +30,15 @@
 #include <algorithm>
 #include <array>
 #include <cstring>
+#include <vector>
 
 #include "gtest/gtest.h"
 
 #include "PipelineState.h"
+#include "CountingAllocator.hpp"
 
 using namespace Diligent;
+using namespace Diligent::Testing;
 
 namespace
 {
@@ -767,4 +770,101 @@ TEST(PSOSerializerTest, SerializeShaderCI_Source)
     SerializeShaderCreateInfo(false);
 }
 
+TEST(PSOSerializerTest, DeserializeInPlace)
+{
+    using ShaderIndexArray = DeviceObjectArchive::ShaderIndexArray;
+
+    // Shader indices of a large pipeline library
+    constexpr Uint32    NumPipelines = 2000;
+    std::vector<Uint32> RefIndices;
+    for (Uint32 i = 0; i < NumPipelines * 5; ++i)
+        RefIndices.push_back(i * 7 % 1001);
+
+    const auto GetRefShaders = [&](Uint32 i) {
+        // Odd counts make sure that the arrays are not naturally aligned
+        return ShaderIndexArray{&RefIndices[i * 5], 1 + i % 5};
+    };
+
+    AttachmentReference   RTAttachments[] = {{0, RESOURCE_STATE_RENDER_TARGET}, {1, RESOURCE_STATE_RENDER_TARGET}};
+    AttachmentReference   DSAttachment{2, RESOURCE_STATE_DEPTH_WRITE};
+    Uint32                PreserveAttachments[] = {3};
+    SubpassDependencyDesc Dependency{0, 1, PIPELINE_STAGE_FLAG_RENDER_TARGET, PIPELINE_STAGE_FLAG_PIXEL_SHADER, ACCESS_FLAG_RENDER_TARGET_WRITE, ACCESS_FLAG_SHADER_READ};
+
+    RenderPassAttachmentDesc Attachments[4] = {};
+    SubpassDesc              Subpasses[2]   = {};
+    for (auto& Subpass : Subpasses)
+    {
+        Subpass.RenderTargetAttachmentCount = _countof(RTAttachments);
+        Subpass.pRenderTargetAttachments    = RTAttachments;
+        Subpass.pDepthStencilAttachment     = &DSAttachment;
+        Subpass.PreserveAttachmentCount     = _countof(PreserveAttachments);
+        Subpass.pPreserveAttachments        = PreserveAttachments;
+    }
+
+    RenderPassDesc RefRP;
+    RefRP.AttachmentCount = _countof(Attachments);
+    RefRP.pAttachments    = Attachments;
+    RefRP.SubpassCount    = _countof(Subpasses);
+    RefRP.pSubpasses      = Subpasses;
+    RefRP.DependencyCount = 1;
+    RefRP.pDependencies   = &Dependency;
+
+    const auto WriteData = [&](auto& Ser) {
+        constexpr auto Mode = std::remove_reference<decltype(Ser)>::type::GetMode();
+        for (Uint32 i = 0; i < NumPipelines; ++i)
+        {
+            const auto Shaders = GetRefShaders(i);
+            EXPECT_TRUE(PSOSerializer<Mode>::SerializeShaderIndices(Ser, Shaders, nullptr));
+        }
+        EXPECT_TRUE(RPSerializer<Mode>::SerializeDesc(Ser, RefRP, nullptr));
+    };
+
+    SerializedData Data;
+    {
+        Serializer<SerializerMode::Measure> MSer;
+        WriteData(MSer);
+        Data = MSer.AllocateData(GetRawAllocator());
+
+        Serializer<SerializerMode::Write> WSer{Data};
+        WriteData(WSer);
+        EXPECT_TRUE(WSer.IsEnded());
+    }
+
+    const auto IsInPlace = [&Data](const void* Ptr) {
+        return Ptr >= Data.Ptr() && Ptr < Data.Ptr<Uint8>() + Data.Size();
+    };
+
+    CountingAllocator      Counter;
+    DynamicLinearAllocator Allocator{Counter};
+
+    Serializer<SerializerMode::Read> RSer{Data};
+    for (Uint32 i = 0; i < NumPipelines; ++i)
+    {
+        ShaderIndexArray Shaders;
+        EXPECT_TRUE(PSOSerializer<SerializerMode::Read>::SerializeShaderIndices(RSer, Shaders, &Allocator));
+
+        const auto RefShaders = GetRefShaders(i);
+        ASSERT_EQ(Shaders.Count, RefShaders.Count);
+        EXPECT_TRUE(std::equal(Shaders.pIndices, Shaders.pIndices + Shaders.Count, RefShaders.pIndices));
+        EXPECT_TRUE(IsInPlace(Shaders.pIndices));
+    }
+    // Shader indices reference the source data and require no allocations
+    EXPECT_EQ(Counter.NumAllocations, 0u);
+
+    RenderPassDesc RP;
+    EXPECT_TRUE(RPSerializer<SerializerMode::Read>::SerializeDesc(RSer, RP, &Allocator));
+    EXPECT_TRUE(RSer.IsEnded());
+    EXPECT_EQ(RP, RefRP);
+
+    // Only the attachment and subpass descriptions are allocated
+    EXPECT_EQ(Counter.NumAllocations, 1u);
+    EXPECT_TRUE(IsInPlace(RP.pDependencies));
+    for (Uint32 i = 0; i < RP.SubpassCount; ++i)
+    {
+        EXPECT_TRUE(IsInPlace(RP.pSubpasses[i].pRenderTargetAttachments));
+        EXPECT_TRUE(IsInPlace(RP.pSubpasses[i].pDepthStencilAttachment));
+        EXPECT_TRUE(IsInPlace(RP.pSubpasses[i].pPreserveAttachments));
+    }
+}
+
 } // namespace
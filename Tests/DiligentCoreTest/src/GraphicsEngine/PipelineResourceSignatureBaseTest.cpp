@@ -25,7 +25,9 @@
  */
 
 #include "../../../../Graphics/GraphicsEngine/include/PipelineResourceSignatureBase.hpp"
+#include "../../../../Graphics/GraphicsEngine/include/EngineMemory.h"
 #include "CommonlyUsedStates.h"
+#include "ScratchArena.hpp"
 
 #include "gtest/gtest.h"
 
@@ -179,4 +181,38 @@ TEST(PipelineResourceSignatureBaseTest, Compatibility)
     }
 }
 
+TEST(PipelineResourceSignatureBaseTest, ValidationScratchMemory)
+{
+    const PipelineResourceDesc Resources[] = //
+        {
+            {SHADER_TYPE_VERTEX | SHADER_TYPE_PIXEL, "Buff", 1u, SHADER_RESOURCE_TYPE_CONSTANT_BUFFER, SHADER_RESOURCE_VARIABLE_TYPE_STATIC},
+            {SHADER_TYPE_PIXEL, "Tex", 1u, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL, "Tex_sampler", 1u, SHADER_RESOURCE_TYPE_SAMPLER, SHADER_RESOURCE_VARIABLE_TYPE_MUTABLE},
+            {SHADER_TYPE_PIXEL, "Tex2", 4u, SHADER_RESOURCE_TYPE_TEXTURE_SRV, SHADER_RESOURCE_VARIABLE_TYPE_DYNAMIC} //
+        };
+
+    const ImmutableSamplerDesc ImtblSamplers[] = //
+        {
+            {SHADER_TYPE_PIXEL, "Tex2", Sam_LinearClamp} //
+        };
+
+    PipelineResourceSignatureDesc Desc;
+    Desc.Name                       = "Scratch memory test PRS";
+    Desc.NumResources               = _countof(Resources);
+    Desc.Resources                  = Resources;
+    Desc.NumImmutableSamplers       = _countof(ImtblSamplers);
+    Desc.ImmutableSamplers          = ImtblSamplers;
+    Desc.UseCombinedTextureSamplers = true;
+
+    ValidatePipelineResourceSignatureDesc(Desc, nullptr, RENDER_DEVICE_TYPE_VULKAN);
+
+    // Temporary validation data is allocated from the thread's scratch arena,
+    // which must not request new pages once it is warmed up.
+    const auto PageCount = GetThreadScratchArena().GetPageCount();
+    EXPECT_GT(PageCount, size_t{0});
+    for (size_t i = 0; i < 100; ++i)
+        ValidatePipelineResourceSignatureDesc(Desc, nullptr, RENDER_DEVICE_TYPE_VULKAN);
+    EXPECT_EQ(GetThreadScratchArena().GetPageCount(), PageCount);
+}
+
 } // namespace
@@ -36,6 +36,9 @@
 #include "FileWrapper.hpp"
 #include "FastRand.hpp"
 #include "DataBlobImpl.hpp"
+#include "MappedFileDataBlob.hpp"
+#include "MappedFileStream.hpp"
+#include "MemoryFileStream.hpp"
 
 using namespace Diligent;
 using namespace Diligent::Testing;
@@ -467,6 +470,136 @@ TEST(Platforms_FileSystem, File)
     EXPECT_FALSE(FileSystem::FileExists(FilePath.c_str()));
 }
 
+TEST(Platforms_FileSystem, MappedFileDataBlob)
+{
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+
+    std::vector<Int32> Data(4096);
+
+    FastRandInt rnd{0, 0, static_cast<Int32>(FastRand::Max - 1)};
+    for (auto& Elem : Data)
+        Elem = rnd();
+    const auto FilePath = TmpDirPath + FileSystem::SlashSymbol + "TestFile1.ext";
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Data.data(), Data.size() * sizeof(Data[0])));
+    }
+
+    {
+        auto pBlob = MappedFileDataBlob::Create(FilePath.c_str());
+        ASSERT_NE(pBlob, nullptr);
+        ASSERT_EQ(pBlob->GetSize(), Data.size() * sizeof(Data[0]));
+        EXPECT_EQ(memcmp(pBlob->GetConstDataPtr(), Data.data(), pBlob->GetSize()), 0);
+
+        // Modifications must not be written to the file
+        static_cast<Int32*>(pBlob->GetDataPtr())[0] = ~Data[0];
+    }
+
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Read};
+        ASSERT_TRUE(File);
+        std::vector<Int32> InData(Data.size());
+        EXPECT_TRUE(File->Read(InData.data(), InData.size() * sizeof(InData[0])));
+        EXPECT_EQ(InData, Data);
+    }
+
+    const auto EmptyFilePath = TmpDirPath + FileSystem::SlashSymbol + "TestFile2.ext";
+    {
+        FileWrapper File{EmptyFilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+    }
+
+    {
+        auto pBlob = MappedFileDataBlob::Create(EmptyFilePath.c_str());
+        ASSERT_NE(pBlob, nullptr);
+        EXPECT_EQ(pBlob->GetSize(), size_t{0});
+    }
+
+    FileSystem::DeleteFile(FilePath.c_str());
+    FileSystem::DeleteFile(EmptyFilePath.c_str());
+}
+
+TEST(Platforms_FileSystem, MappedFileStream)
+{
+    TempDirectory TmpDir;
+    const auto&   TmpDirPath = TmpDir.Get();
+
+    std::vector<Int32> Data(4096);
+
+    FastRandInt rnd{0, 0, static_cast<Int32>(FastRand::Max - 1)};
+    for (auto& Elem : Data)
+        Elem = rnd();
+    const auto FilePath = TmpDirPath + FileSystem::SlashSymbol + "TestFile1.ext";
+    {
+        FileWrapper File{FilePath.c_str(), EFileAccessMode::Overwrite};
+        ASSERT_TRUE(File);
+        EXPECT_TRUE(File->Write(Data.data(), Data.size() * sizeof(Data[0])));
+    }
+
+    for (auto Pattern : {EFileAccessPattern::Normal, EFileAccessPattern::Sequential, EFileAccessPattern::Random})
+    {
+        auto pStream = MappedFileStream::Create(FilePath.c_str(), Pattern);
+        ASSERT_NE(pStream, nullptr);
+        EXPECT_TRUE(pStream->IsValid());
+        EXPECT_EQ(pStream->GetSize(), Data.size() * sizeof(Data[0]));
+
+        constexpr size_t NumHeadElements = 16;
+
+        Int32 Head[NumHeadElements] = {};
+        EXPECT_TRUE(pStream->Read(Head, sizeof(Head)));
+        EXPECT_EQ(memcmp(Head, Data.data(), sizeof(Head)), 0);
+
+        {
+            auto pTail = DataBlobImpl::Create();
+            pStream->ReadBlob(pTail);
+            ASSERT_EQ(pTail->GetSize(), (Data.size() - NumHeadElements) * sizeof(Data[0]));
+            EXPECT_EQ(memcmp(pTail->GetConstDataPtr(), &Data[NumHeadElements], pTail->GetSize()), 0);
+        }
+
+        // The stream is at the end
+        EXPECT_FALSE(pStream->Read(Head, sizeof(Head)));
+    }
+
+    {
+        auto pStream = MappedFileStream::Create(FilePath.c_str());
+        ASSERT_NE(pStream, nullptr);
+
+        auto pData = ReadFileStreamData(pStream);
+        ASSERT_NE(pData, nullptr);
+        ASSERT_EQ(pData->GetSize(), Data.size() * sizeof(Data[0]));
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Data.data(), pData->GetSize()), 0);
+        EXPECT_EQ(ReadFileStreamData(pStream)->GetSize(), size_t{0});
+
+        // Partially read stream
+        auto pStream2 = MappedFileStream::Create(FilePath.c_str());
+        ASSERT_NE(pStream2, nullptr);
+        Int32 Head = 0;
+        EXPECT_TRUE(pStream2->Read(&Head, sizeof(Head)));
+        EXPECT_EQ(Head, Data[0]);
+
+        auto pTail = ReadFileStreamData(pStream2);
+        ASSERT_NE(pTail, nullptr);
+        ASSERT_EQ(pTail->GetSize(), (Data.size() - 1) * sizeof(Data[0]));
+        EXPECT_EQ(memcmp(pTail->GetConstDataPtr(), &Data[1], pTail->GetSize()), 0);
+    }
+
+    // Other streams are read into a new blob
+    {
+        auto pSrcData = DataBlobImpl::Create(Data.size() * sizeof(Data[0]), Data.data());
+        auto pStream  = MemoryFileStream::Create(pSrcData);
+
+        auto pData = ReadFileStreamData(pStream);
+        ASSERT_NE(pData, nullptr);
+        ASSERT_EQ(pData->GetSize(), pSrcData->GetSize());
+        EXPECT_NE(pData->GetConstDataPtr(), pSrcData->GetConstDataPtr());
+        EXPECT_EQ(memcmp(pData->GetConstDataPtr(), Data.data(), pData->GetSize()), 0);
+    }
+
+    FileSystem::DeleteFile(FilePath.c_str());
+}
+
 TEST(Platforms_FileSystem, Directories)
 {
     TempDirectory TmpDir;